@@ -51,6 +51,8 @@ SineWaveInferenceHandler::SineWaveInferenceHandler(InferenceResultListener liste
 
 SineWaveInferenceHandler::~SineWaveInferenceHandler()
 {
+	/* Inference workers call onInferenceFinished(), stop them before members are released */
+	stop();
 	if (mPostProcessedData) {
 		delete[] mPostProcessedData;
 		mPostProcessedData = NULL;
@@ -0,0 +1,266 @@
+/****************************************************************************
+ *
+ * Copyright 2025 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <tinyara/config.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <time.h>
+#include <errno.h>
+#include <sys/ioctl.h>
+#include <tinyara/fs/fs.h>
+#include <tinyara/fs/ioctl.h>
+#include <tinyara/fs/mtd.h>
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define BCH_PERF_MINOR   CONFIG_EXAMPLES_BCH_CACHE_PERFORMANCE_MINOR
+#define BCH_PERF_SIZE    CONFIG_EXAMPLES_BCH_CACHE_PERFORMANCE_SIZE
+#define BCH_PERF_IOSIZE  CONFIG_EXAMPLES_BCH_CACHE_PERFORMANCE_IOSIZE
+#define BCH_PERF_SPAN    CONFIG_EXAMPLES_BCH_CACHE_PERFORMANCE_SPAN
+#define BCH_PERF_OPS     CONFIG_EXAMPLES_BCH_CACHE_PERFORMANCE_OPS
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+struct bch_perf_case_s {
+	FAR const char *name;
+	struct bch_cacheconfig_s config;
+};
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static const struct bch_perf_case_s g_cases[] = {
+	{"1 sector, write-through",    {1, 0, false}},
+	{"4 sectors, write-through",   {4, 0, false}},
+	{"16 sectors, write-through",  {16, 0, false}},
+	{"4 sectors, write-back",      {4, 0, true}},
+	{"16 sectors, write-back",     {16, 0, true}},
+	{"16 sectors, wb + readahead", {16, 4, true}},
+};
+
+static char g_chardev[16];
+static bool g_registered;
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+static int bch_perf_setup(void)
+{
+	FAR struct mtd_dev_s *mtd;
+	FAR uint8_t *ram;
+	char blockdev[16];
+	int ret;
+
+	snprintf(blockdev, sizeof(blockdev), "/dev/mtdblock%d", BCH_PERF_MINOR);
+	snprintf(g_chardev, sizeof(g_chardev), "/dev/mtd%d", BCH_PERF_MINOR);
+
+	if (g_registered) {
+		return OK;
+	}
+
+	/* The RAM MTD stays registered, so its memory is never released */
+
+	ram = (FAR uint8_t *)malloc(BCH_PERF_SIZE);
+	if (!ram) {
+		printf("Failed to allocate %d bytes for the RAM MTD\n", BCH_PERF_SIZE);
+		return -ENOMEM;
+	}
+
+	mtd = rammtd_initialize(ram, BCH_PERF_SIZE);
+	if (!mtd) {
+		printf("Failed to create the RAM MTD\n");
+		free(ram);
+		return -ENODEV;
+	}
+
+	(void)mtd->ioctl(mtd, MTDIOC_BULKERASE, 0);
+
+	ret = ftl_initialize(BCH_PERF_MINOR, mtd);
+	if (ret < 0) {
+		printf("ftl_initialize %s failed: %d\n", blockdev, ret);
+		return ret;
+	}
+
+	ret = bchdev_register(blockdev, g_chardev, false);
+	if (ret < 0) {
+		printf("bchdev_register %s failed: %d\n", g_chardev, ret);
+		return ret;
+	}
+
+	g_registered = true;
+	return OK;
+}
+
+static int bch_perf_run(int fd, FAR const struct bch_cacheconfig_s *config, FAR long long *usec)
+{
+	struct timespec start;
+	struct timespec end;
+	char buffer[BCH_PERF_IOSIZE];
+	off_t span = (off_t)BCH_PERF_SPAN * CONFIG_RAMMTD_BLOCKSIZE - BCH_PERF_IOSIZE;
+	off_t offset;
+	int ret;
+	int i;
+
+	if (span > BCH_PERF_SIZE - BCH_PERF_IOSIZE) {
+		span = BCH_PERF_SIZE - BCH_PERF_IOSIZE;
+	}
+
+	ret = ioctl(fd, DIOC_SETCACHE, (unsigned long)config);
+	if (ret < 0) {
+		return ret;
+	}
+
+	/* Every configuration replays the same sequence */
+
+	srand(1);
+	for (i = 0; i < BCH_PERF_IOSIZE; i++) {
+		buffer[i] = (char)i;
+	}
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+
+	for (i = 0; i < BCH_PERF_OPS; i++) {
+		offset = rand() % span;
+		if (lseek(fd, offset, SEEK_SET) != offset) {
+			return -EIO;
+		}
+
+		if (rand() & 1) {
+			ret = write(fd, buffer, BCH_PERF_IOSIZE);
+		} else {
+			ret = read(fd, buffer, BCH_PERF_IOSIZE);
+		}
+
+		if (ret != BCH_PERF_IOSIZE) {
+			return -EIO;
+		}
+	}
+
+	/* Setting the configuration again writes back what is still dirty */
+
+	ret = ioctl(fd, DIOC_SETCACHE, (unsigned long)config);
+	clock_gettime(CLOCK_MONOTONIC, &end);
+
+	*usec = (long long)(end.tv_sec - start.tv_sec) * 1000000LL + (end.tv_nsec - start.tv_nsec) / 1000;
+	return ret;
+}
+
+/* Whole-sector transfers bypass the BCH cache and reach the FTL directly,
+ * so this measures the rwbuffer read-ahead and write buffering of the FTL
+ * (CONFIG_FTL_READAHEAD / CONFIG_FTL_WRITEBUFFER).  Two interleaved
+ * sequential readers are followed by single-sector writes at random
+ * positions.
+ */
+
+static int bch_perf_blockio(int fd)
+{
+	struct timespec start;
+	struct timespec end;
+	char buffer[CONFIG_RAMMTD_BLOCKSIZE];
+	off_t half = (BCH_PERF_SIZE / 2 / CONFIG_RAMMTD_BLOCKSIZE) * CONFIG_RAMMTD_BLOCKSIZE;
+	off_t offset;
+	long long usec;
+	int i;
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	for (offset = 0; offset < half; offset += CONFIG_RAMMTD_BLOCKSIZE) {
+		for (i = 0; i < 2; i++) {
+			if (lseek(fd, offset + i * half, SEEK_SET) < 0 || read(fd, buffer, CONFIG_RAMMTD_BLOCKSIZE) != CONFIG_RAMMTD_BLOCKSIZE) {
+				return -EIO;
+			}
+		}
+	}
+	clock_gettime(CLOCK_MONOTONIC, &end);
+
+	usec = (long long)(end.tv_sec - start.tv_sec) * 1000000LL + (end.tv_nsec - start.tv_nsec) / 1000;
+	printf("%-28s %10lld %10lld KB/s\n", "2 sequential readers", usec, usec > 0 ? (long long)half * 2 * 1000000LL / 1024 / usec : 0);
+
+	srand(2);
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	for (i = 0; i < BCH_PERF_OPS; i++) {
+		offset = (rand() % (2 * half / CONFIG_RAMMTD_BLOCKSIZE)) * CONFIG_RAMMTD_BLOCKSIZE;
+		if (lseek(fd, offset, SEEK_SET) < 0 || write(fd, buffer, CONFIG_RAMMTD_BLOCKSIZE) != CONFIG_RAMMTD_BLOCKSIZE) {
+			return -EIO;
+		}
+	}
+	clock_gettime(CLOCK_MONOTONIC, &end);
+
+	usec = (long long)(end.tv_sec - start.tv_sec) * 1000000LL + (end.tv_nsec - start.tv_nsec) / 1000;
+	printf("%-28s %10lld %10lld KB/s\n", "random sector writes", usec, usec > 0 ? (long long)BCH_PERF_OPS * CONFIG_RAMMTD_BLOCKSIZE * 1000000LL / 1024 / usec : 0);
+	return OK;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+#ifdef CONFIG_BUILD_KERNEL
+int main(int argc, FAR char *argv[])
+#else
+int bch_cache_perf_main(int argc, char *argv[])
+#endif
+{
+	long long usec;
+	int fd;
+	int ret;
+	int i;
+
+	ret = bch_perf_setup();
+	if (ret < 0) {
+		return -1;
+	}
+
+	fd = open(g_chardev, O_RDWR);
+	if (fd < 0) {
+		printf("Failed to open %s\n", g_chardev);
+		return -1;
+	}
+
+	printf("%d random %d-byte reads/writes within %d sectors of %s\n", BCH_PERF_OPS, BCH_PERF_IOSIZE, BCH_PERF_SPAN, g_chardev);
+	printf("%-28s %10s %10s\n", "cache", "usec", "ops/s");
+	for (i = 0; i < sizeof(g_cases) / sizeof(g_cases[0]); i++) {
+		ret = bch_perf_run(fd, &g_cases[i].config, &usec);
+		if (ret < 0) {
+			printf("%-28s failed: %d\n", g_cases[i].name, ret);
+			continue;
+		}
+
+		printf("%-28s %10lld %10lld\n", g_cases[i].name, usec, usec > 0 ? BCH_PERF_OPS * 1000000LL / usec : 0);
+	}
+
+	printf("\nWhole-sector I/O (FTL rwbuffer)\n");
+	ret = bch_perf_blockio(fd);
+	if (ret < 0) {
+		printf("Block I/O test failed: %d\n", ret);
+	}
+
+	close(fd);
+	return 0;
+}
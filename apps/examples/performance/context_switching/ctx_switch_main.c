@@ -28,6 +28,12 @@
 
 #define SWITCHING_ITERATIONS 1000000
 
+#ifdef CONFIG_EXAMPLES_CTX_SWITCH_NTASKS
+#define SWITCHING_TASKS CONFIG_EXAMPLES_CTX_SWITCH_NTASKS
+#else
+#define SWITCHING_TASKS 2
+#endif
+
 static int yield_task_1(int a, char *b[])
 {
 	int cnt = SWITCHING_ITERATIONS;
@@ -45,7 +51,7 @@ static int yield_task_1(int a, char *b[])
 
 	diff_time = ((double)end.tv_sec + 1.0e-9 * end.tv_nsec) - ((double)start.tv_sec + 1.0e-9 * start.tv_nsec);
 
-	printf("%d-th Average Context Switching Time is %.10f seconds\n", SWITCHING_ITERATIONS, (double)diff_time / (2 * SWITCHING_ITERATIONS));
+	printf("%d-th Average Context Switching Time is %.10f seconds (%d tasks)\n", SWITCHING_ITERATIONS, (double)diff_time / (SWITCHING_TASKS * SWITCHING_ITERATIONS), SWITCHING_TASKS);
 
 	return 0;
 }
@@ -67,13 +73,17 @@ int main(int argc, FAR char *argv[])
 int ctx_switch_main(int argc, char *argv[])
 #endif
 {
+	int i;
+
 	printf("Context Switching Performance Measurement\n");
 
 	/* Do not context switching until making two tasks */
 	sched_lock();
 
 	task_create("A_Task", SCHED_PRIORITY_MAX, 1024, yield_task_1, NULL);
-	task_create("B_Task", SCHED_PRIORITY_MAX, 1024, yield_task_2, NULL);
+	for (i = 1; i < SWITCHING_TASKS; i++) {
+		task_create("B_Task", SCHED_PRIORITY_MAX, 1024, yield_task_2, NULL);
+	}
 
 	sched_unlock();
 
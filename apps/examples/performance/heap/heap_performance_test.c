@@ -27,9 +27,39 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <time.h>
+#if defined(CONFIG_MM_PERCPU_CACHE) && defined(CONFIG_BUILD_FLAT)
+#include <tinyara/mm/mm.h>
+#endif
 
 #define NUM_ALLOC 100
 
+/* Sizes up to this are served by the per-CPU cache of the heap when
+ * CONFIG_MM_PERCPU_CACHE is enabled.  They are measured a second time with
+ * malloc() immediately followed by free(), which is the pattern the cache
+ * is made for.
+ */
+#define PAIR_MAX_SIZE 256
+
+static uint32_t heap_elapsed_ms(struct timespec *ts1, struct timespec *ts2)
+{
+	return ((ts2->tv_sec - ts1->tv_sec) * 1000 + (ts2->tv_nsec - ts1->tv_nsec) / 1000000);
+}
+
+#if defined(CONFIG_MM_PERCPU_CACHE) && defined(CONFIG_BUILD_FLAT)
+static void heap_print_cache_stats(void)
+{
+	int cpu;
+
+	for (cpu = 0; cpu < CONFIG_SMP_NCPUS; cpu++) {
+		printf("CPU%d cache : %u hits, %u misses, %u flushes\n", cpu,
+			BASE_HEAP->mm_cache[cpu].hits, BASE_HEAP->mm_cache[cpu].misses,
+			BASE_HEAP->mm_cache[cpu].flushes);
+	}
+}
+#else
+#define heap_print_cache_stats()
+#endif
+
 static int heap_performance_test(int argc, char *argv[])
 {
 	struct timespec ts1, ts2;
@@ -95,7 +125,7 @@ static int heap_performance_test(int argc, char *argv[])
 		}
 
 		if (k > 0) {
-			elapsed = ((ts2.tv_sec - ts1.tv_sec) * 1000 + (ts2.tv_nsec - ts1.tv_nsec) / 1000000);
+			elapsed = heap_elapsed_ms(&ts1, &ts2);
 			total_elapsed += elapsed;
 			printf("Size %u bytes	: %u mseconds.\n", size, elapsed);
 		}
@@ -105,6 +135,38 @@ static int heap_performance_test(int argc, char *argv[])
 
 	printf("Total elapsed time : %u mseconds\n", total_elapsed);
 
+	printf("\nElapsed time doing malloc() immediately followed by free() %u times:\n", NUM_ALLOC * repeat);
+
+	total_elapsed = 0;
+	for (k = 1; k < test_repeat && sizes[k] <= PAIR_MAX_SIZE; ++k) {
+		size = sizes[k];
+		if (clock_gettime(CLOCK_REALTIME, &ts1) == -1) {
+			printf("gettime error occured.\n");
+			return 0;
+		}
+
+		for (i = 0; i < repeat * NUM_ALLOC; ++i) {
+			data[0] = (char *)malloc(size);
+			if (data[0] == NULL) {
+				printf("With size %d, %d-th, Test failed due to malloc failure.\n", size, i);
+				return 0;
+			}
+			free(data[0]);
+		}
+
+		if (clock_gettime(CLOCK_REALTIME, &ts2) == -1) {
+			printf("gettime error occured.\n");
+			return 0;
+		}
+
+		elapsed = heap_elapsed_ms(&ts1, &ts2);
+		total_elapsed += elapsed;
+		printf("Size %u bytes	: %u mseconds.\n", size, elapsed);
+	}
+
+	printf("Total elapsed time : %u mseconds\n", total_elapsed);
+	heap_print_cache_stats();
+
 	return 0;
 }
 
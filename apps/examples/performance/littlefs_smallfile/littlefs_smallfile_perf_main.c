@@ -0,0 +1,231 @@
+/****************************************************************************
+ *
+ * Copyright 2025 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <tinyara/config.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <time.h>
+#include <errno.h>
+#include <sys/mount.h>
+#include <tinyara/fs/mtd.h>
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define LFS_PERF_MINOR     CONFIG_EXAMPLES_LITTLEFS_SMALLFILE_PERFORMANCE_MINOR
+#define LFS_PERF_SIZE      CONFIG_EXAMPLES_LITTLEFS_SMALLFILE_PERFORMANCE_SIZE
+#define LFS_PERF_MOUNTPT   CONFIG_EXAMPLES_LITTLEFS_SMALLFILE_PERFORMANCE_MOUNTPT
+#define LFS_PERF_NFILES    CONFIG_EXAMPLES_LITTLEFS_SMALLFILE_PERFORMANCE_NFILES
+#define LFS_PERF_FILESIZE  CONFIG_EXAMPLES_LITTLEFS_SMALLFILE_PERFORMANCE_FILESIZE
+
+#define LFS_PERF_CACHE     (4 * CONFIG_RAMMTD_BLOCKSIZE)
+#define LFS_PERF_LOOKAHEAD (LFS_PERF_SIZE / CONFIG_RAMMTD_ERASESIZE / 8 + 8)
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static char g_devname[16];
+static bool g_registered;
+static char g_buffer[LFS_PERF_FILESIZE];
+static char g_check[LFS_PERF_FILESIZE];
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+static int lfs_perf_setup(void)
+{
+	FAR struct mtd_dev_s *mtd;
+	FAR uint8_t *ram;
+	int ret;
+
+	snprintf(g_devname, sizeof(g_devname), "/dev/little%d", LFS_PERF_MINOR);
+
+	if (g_registered) {
+		return OK;
+	}
+
+	/* The RAM MTD stays registered, so its memory is never released */
+
+	ram = (FAR uint8_t *)malloc(LFS_PERF_SIZE);
+	if (!ram) {
+		printf("Failed to allocate %d bytes for the RAM MTD\n", LFS_PERF_SIZE);
+		return -ENOMEM;
+	}
+
+	mtd = rammtd_initialize(ram, LFS_PERF_SIZE);
+	if (!mtd) {
+		printf("Failed to create the RAM MTD\n");
+		free(ram);
+		return -ENODEV;
+	}
+
+	ret = little_initialize(LFS_PERF_MINOR, mtd, NULL);
+	if (ret < 0) {
+		printf("little_initialize %s failed: %d\n", g_devname, ret);
+		return ret;
+	}
+
+	g_registered = true;
+	return OK;
+}
+
+static long long lfs_perf_elapsed(FAR const struct timespec *start)
+{
+	struct timespec end;
+
+	clock_gettime(CLOCK_MONOTONIC, &end);
+	return (long long)(end.tv_sec - start->tv_sec) * 1000000LL + (end.tv_nsec - start->tv_nsec) / 1000;
+}
+
+static void lfs_perf_print(FAR const char *phase, long long usec)
+{
+	printf("  %-8s %10lld usec %8lld files/s\n", phase, usec, usec > 0 ? LFS_PERF_NFILES * 1000000LL / usec : 0);
+}
+
+static int lfs_perf_run(FAR const char *options)
+{
+	struct timespec start;
+	char path[64];
+	long long usec;
+	int ret = OK;
+	int fd;
+	int i;
+
+	if (mount(g_devname, LFS_PERF_MOUNTPT, "littlefs", 0, options) < 0) {
+		ret = -errno;
+		printf("  mount failed, errno %d\n", -ret);
+		return ret;
+	}
+
+	/* Create */
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	for (i = 0; i < LFS_PERF_NFILES; i++) {
+		snprintf(path, sizeof(path), "%s/f%d", LFS_PERF_MOUNTPT, i);
+		memset(g_buffer, (char)i, LFS_PERF_FILESIZE);
+		fd = open(path, O_WRONLY | O_CREAT | O_TRUNC, 0666);
+		if (fd < 0) {
+			ret = -errno;
+			printf("  create %s failed, errno %d\n", path, -ret);
+			goto errout;
+		}
+
+		if (write(fd, g_buffer, LFS_PERF_FILESIZE) != LFS_PERF_FILESIZE) {
+			printf("  write %s failed, errno %d\n", path, errno);
+			close(fd);
+			ret = -EIO;
+			goto errout;
+		}
+
+		close(fd);
+	}
+	usec = lfs_perf_elapsed(&start);
+	lfs_perf_print("create", usec);
+
+	/* Read back, in the order the files were created */
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	for (i = 0; i < LFS_PERF_NFILES; i++) {
+		snprintf(path, sizeof(path), "%s/f%d", LFS_PERF_MOUNTPT, i);
+		fd = open(path, O_RDONLY);
+		if (fd < 0) {
+			ret = -errno;
+			printf("  open %s failed, errno %d\n", path, -ret);
+			goto errout;
+		}
+
+		if (read(fd, g_check, LFS_PERF_FILESIZE) != LFS_PERF_FILESIZE) {
+			printf("  read %s failed, errno %d\n", path, errno);
+			close(fd);
+			ret = -EIO;
+			goto errout;
+		}
+
+		close(fd);
+		memset(g_buffer, (char)i, LFS_PERF_FILESIZE);
+		if (memcmp(g_buffer, g_check, LFS_PERF_FILESIZE) != 0) {
+			printf("  %s has wrong contents\n", path);
+			ret = -EIO;
+			goto errout;
+		}
+	}
+	usec = lfs_perf_elapsed(&start);
+	lfs_perf_print("read", usec);
+
+	/* Delete */
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	for (i = 0; i < LFS_PERF_NFILES; i++) {
+		snprintf(path, sizeof(path), "%s/f%d", LFS_PERF_MOUNTPT, i);
+		if (unlink(path) < 0) {
+			ret = -errno;
+			printf("  unlink %s failed, errno %d\n", path, -ret);
+			goto errout;
+		}
+	}
+	usec = lfs_perf_elapsed(&start);
+	lfs_perf_print("delete", usec);
+
+errout:
+	umount(LFS_PERF_MOUNTPT);
+	return ret;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+#ifdef CONFIG_BUILD_KERNEL
+int main(int argc, FAR char *argv[])
+#else
+int littlefs_smallfile_perf_main(int argc, char *argv[])
+#endif
+{
+	char options[5][96];
+	int i;
+
+	if (lfs_perf_setup() < 0) {
+		return -1;
+	}
+
+	/* Every run formats the device so that all start from the same state */
+
+	snprintf(options[0], sizeof(options[0]), "forceformat");
+	snprintf(options[1], sizeof(options[1]), "forceformat,cache=%d", LFS_PERF_CACHE);
+	snprintf(options[2], sizeof(options[2]), "forceformat,lookahead=%d", LFS_PERF_LOOKAHEAD);
+	snprintf(options[3], sizeof(options[3]), "forceformat,blkcache=16");
+	snprintf(options[4], sizeof(options[4]), "forceformat,cache=%d,lookahead=%d,blkcache=16", LFS_PERF_CACHE, LFS_PERF_LOOKAHEAD);
+
+	printf("%d files of %d bytes on %s (%d bytes of RAM MTD)\n", LFS_PERF_NFILES, LFS_PERF_FILESIZE, g_devname, LFS_PERF_SIZE);
+	for (i = 0; i < sizeof(options) / sizeof(options[0]); i++) {
+		printf("%s\n", options[i]);
+		(void)lfs_perf_run(options[i]);
+	}
+
+	return 0;
+}
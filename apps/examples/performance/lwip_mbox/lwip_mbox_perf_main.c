@@ -0,0 +1,80 @@
+/****************************************************************************
+ *
+ * Copyright 2025 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <tinyara/config.h>
+#include <stdio.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <tinyara/os_api_test_drv.h>
+#include <lwip/arch/sys_arch.h>
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define MBOX_PERF_PRODUCERS  CONFIG_EXAMPLES_LWIP_MBOX_PERFORMANCE_PRODUCERS
+#define MBOX_PERF_MESSAGES   CONFIG_EXAMPLES_LWIP_MBOX_PERFORMANCE_MESSAGES
+#define MBOX_PERF_QUEUE_SIZE CONFIG_EXAMPLES_LWIP_MBOX_PERFORMANCE_QUEUE_SIZE
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+int lwip_mbox_perf_main(int argc, char *argv[])
+{
+	struct sys_mbox_perf_args args;
+	long long total;
+	int producers;
+	int fd;
+	int ret;
+
+	fd = open(OS_API_TEST_DRVPATH, O_WRONLY);
+	if (fd < 0) {
+		printf("Failed to open %s\n", OS_API_TEST_DRVPATH);
+		return -1;
+	}
+
+	printf("producers  messages  queue      usec     msgs/s  ns/msg\n");
+	for (producers = 1; producers <= MBOX_PERF_PRODUCERS; producers++) {
+		args.producers = producers;
+		args.messages = MBOX_PERF_MESSAGES;
+		args.queue_size = MBOX_PERF_QUEUE_SIZE;
+		args.elapsed_us = 0;
+
+		ret = ioctl(fd, TESTIOC_NET_MBOX_PERF, (unsigned long)&args);
+		if (ret < 0) {
+			printf("TESTIOC_NET_MBOX_PERF failed, producers %d ret %d\n", producers, ret);
+			break;
+		}
+
+		total = (long long)producers * MBOX_PERF_MESSAGES;
+		if (args.elapsed_us == 0) {
+			args.elapsed_us = 1;
+		}
+		printf("%9d %9lld %6d %9u %10lld %7lld\n", producers, total, args.queue_size,
+			   (unsigned int)args.elapsed_us, total * 1000000 / args.elapsed_us,
+			   (long long)args.elapsed_us * 1000 / total);
+	}
+
+	close(fd);
+	return 0;
+}
@@ -0,0 +1,91 @@
+/****************************************************************************
+ *
+ * Copyright 2025 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+//***************************************************************************
+// Included Files
+//***************************************************************************
+
+#include <tinyara/config.h>
+#include <stdio.h>
+#include <time.h>
+#include <media/MediaPlayer.h>
+
+#define MEDIA_COMMAND_ITERATIONS 1000
+
+using namespace media;
+
+//***************************************************************************
+// Private Functions
+//***************************************************************************
+
+static long elapsed_usec(struct timespec *start, struct timespec *end)
+{
+	return (end->tv_sec - start->tv_sec) * 1000000L + (end->tv_nsec - start->tv_nsec) / 1000L;
+}
+
+//***************************************************************************
+// Public Functions
+//***************************************************************************
+
+extern "C" {
+int media_command_main(int argc, char *argv[])
+{
+	MediaPlayer mp;
+	struct timespec start;
+	struct timespec end;
+	long usec;
+	long total = 0;
+	long min = -1;
+	long max = 0;
+	int i;
+
+	if (mp.create() != PLAYER_OK) {
+		printf("MediaPlayer create failed\n");
+		return -1;
+	}
+
+	/* MediaPlayer::start() needs a prepared player owning the audio focus.
+	 * setLooping() takes the same path through the PlayerWorker queue, from
+	 * the API call until the worker has run the command and signaled back,
+	 * and is valid on an idle player.
+	 */
+	for (i = 0; i < MEDIA_COMMAND_ITERATIONS; i++) {
+		clock_gettime(CLOCK_MONOTONIC, &start);
+		if (mp.setLooping(false) != PLAYER_OK) {
+			printf("MediaPlayer setLooping failed\n");
+			break;
+		}
+		clock_gettime(CLOCK_MONOTONIC, &end);
+
+		usec = elapsed_usec(&start, &end);
+		total += usec;
+		if (min < 0 || usec < min) {
+			min = usec;
+		}
+		if (usec > max) {
+			max = usec;
+		}
+	}
+
+	if (i > 0) {
+		printf("%d commands, latency avg %ld usec, min %ld usec, max %ld usec\n", i, total / i, min, max);
+	}
+
+	mp.destroy();
+	return 0;
+}
+}
@@ -0,0 +1,307 @@
+/****************************************************************************
+ *
+ * Copyright 2025 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <tinyara/config.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <fcntl.h>
+#include <mqueue.h>
+#include <pthread.h>
+#include <time.h>
+#include <errno.h>
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define PINGPONG_ITER     CONFIG_EXAMPLES_MQUEUE_PINGPONG_PERFORMANCE_ITER
+#define PINGPONG_DEPTH    CONFIG_EXAMPLES_MQUEUE_PINGPONG_PERFORMANCE_DEPTH
+#define PINGPONG_MSGSIZE  CONFIG_MQ_MAXMSGSIZE
+#define PINGPONG_SMALL    (PINGPONG_MSGSIZE < 16 ? PINGPONG_MSGSIZE : 16)
+
+#ifdef CONFIG_MQ_REFERENCE
+#define PINGPONG_PAYLOAD  CONFIG_MQ_REFERENCE_BUFSIZE
+#define PINGPONG_CHUNKS   ((PINGPONG_PAYLOAD + PINGPONG_MSGSIZE - 1) / PINGPONG_MSGSIZE)
+#endif
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+enum pingpong_mode_e {
+	PINGPONG_ECHO,				/* Receive from g_ping, answer on g_pong */
+	PINGPONG_STREAM,			/* Send PINGPONG_ITER messages on g_ping */
+#ifdef CONFIG_MQ_REFERENCE
+	PINGPONG_STREAM_COPY,		/* Send large payloads in chunks on g_ping */
+	PINGPONG_STREAM_REF,		/* Send large payloads by reference on g_ping */
+#endif
+};
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static mqd_t g_ping;
+static mqd_t g_pong;
+static volatile int g_peer_error;
+
+#ifdef CONFIG_MQ_REFERENCE
+static char g_payload[PINGPONG_PAYLOAD];
+static char g_received[PINGPONG_PAYLOAD];
+#endif
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+static long long pingpong_elapsed(FAR const struct timespec *start)
+{
+	struct timespec end;
+
+	clock_gettime(CLOCK_MONOTONIC, &end);
+	return (long long)(end.tv_sec - start->tv_sec) * 1000000LL + (end.tv_nsec - start->tv_nsec) / 1000;
+}
+
+static FAR void *pingpong_peer(FAR void *arg)
+{
+	enum pingpong_mode_e mode = (enum pingpong_mode_e)(intptr_t)arg;
+	char msg[PINGPONG_MSGSIZE];
+	ssize_t len;
+	int i;
+#ifdef CONFIG_MQ_REFERENCE
+	FAR char *buffer;
+	int chunk;
+#endif
+
+	memset(msg, 0x5a, sizeof(msg));
+	for (i = 0; i < PINGPONG_ITER; i++) {
+		switch (mode) {
+		case PINGPONG_ECHO:
+			len = mq_receive(g_ping, msg, sizeof(msg), NULL);
+			if (len < 0 || mq_send(g_pong, msg, len, 0) < 0) {
+				g_peer_error = errno;
+				return NULL;
+			}
+			break;
+
+		case PINGPONG_STREAM:
+			if (mq_send(g_ping, msg, sizeof(msg), 0) < 0) {
+				g_peer_error = errno;
+				return NULL;
+			}
+			break;
+
+#ifdef CONFIG_MQ_REFERENCE
+		case PINGPONG_STREAM_COPY:
+			for (chunk = 0; chunk < PINGPONG_CHUNKS; chunk++) {
+				len = PINGPONG_PAYLOAD - chunk * PINGPONG_MSGSIZE;
+				if (len > PINGPONG_MSGSIZE) {
+					len = PINGPONG_MSGSIZE;
+				}
+
+				if (mq_send(g_ping, g_payload + chunk * PINGPONG_MSGSIZE, len, 0) < 0) {
+					g_peer_error = errno;
+					return NULL;
+				}
+			}
+			break;
+
+		case PINGPONG_STREAM_REF:
+			buffer = mq_refalloc(PINGPONG_PAYLOAD);
+			if (!buffer) {
+				g_peer_error = errno;
+				return NULL;
+			}
+
+			memcpy(buffer, g_payload, PINGPONG_PAYLOAD);
+			if (mq_sendref(g_ping, buffer, PINGPONG_PAYLOAD, 0) < 0) {
+				g_peer_error = errno;
+				mq_reffree(buffer);
+				return NULL;
+			}
+			break;
+#endif
+		}
+	}
+
+	return NULL;
+}
+
+static int pingpong_open(FAR const char *name, int maxmsg, size_t msgsize, FAR mqd_t *mqdes)
+{
+	struct mq_attr attr;
+
+	attr.mq_maxmsg = maxmsg;
+	attr.mq_msgsize = msgsize;
+	attr.mq_flags = 0;
+
+	*mqdes = mq_open(name, O_CREAT | O_RDWR, 0666, &attr);
+	if (*mqdes == (mqd_t)ERROR) {
+		printf("mq_open %s failed, errno %d\n", name, errno);
+		return ERROR;
+	}
+
+	return OK;
+}
+
+static void pingpong_close(void)
+{
+	mq_close(g_ping);
+	mq_unlink("pp_ping");
+	if (g_pong != (mqd_t)ERROR) {
+		mq_close(g_pong);
+		mq_unlink("pp_pong");
+	}
+}
+
+/* Start the peer thread, run the local side of the test and report the
+ * elapsed time of both.
+ */
+
+static int pingpong_run(FAR const char *name, enum pingpong_mode_e mode, int maxmsg, size_t msgsize, long long bytes)
+{
+	struct timespec start;
+	pthread_t peer;
+	char msg[PINGPONG_MSGSIZE];
+	long long usec;
+	int ret = OK;
+	int i;
+#ifdef CONFIG_MQ_REFERENCE
+	FAR void *buffer;
+	ssize_t len;
+	int chunk;
+#endif
+
+	g_peer_error = 0;
+	g_pong = (mqd_t)ERROR;
+	if (pingpong_open("pp_ping", maxmsg, msgsize, &g_ping) < 0) {
+		return ERROR;
+	}
+
+	if (mode == PINGPONG_ECHO && pingpong_open("pp_pong", maxmsg, msgsize, &g_pong) < 0) {
+		pingpong_close();
+		return ERROR;
+	}
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+
+	if (pthread_create(&peer, NULL, pingpong_peer, (FAR void *)(intptr_t)mode) != 0) {
+		printf("pthread_create failed\n");
+		pingpong_close();
+		return ERROR;
+	}
+
+	memset(msg, 0xa5, sizeof(msg));
+	for (i = 0; i < PINGPONG_ITER && ret == OK; i++) {
+		switch (mode) {
+		case PINGPONG_ECHO:
+			if (mq_send(g_ping, msg, msgsize, 0) < 0 || mq_receive(g_pong, msg, sizeof(msg), NULL) != (ssize_t)msgsize) {
+				ret = ERROR;
+			}
+			break;
+
+		case PINGPONG_STREAM:
+			if (mq_receive(g_ping, msg, sizeof(msg), NULL) != (ssize_t)msgsize) {
+				ret = ERROR;
+			}
+			break;
+
+#ifdef CONFIG_MQ_REFERENCE
+		case PINGPONG_STREAM_COPY:
+			for (chunk = 0; chunk < PINGPONG_CHUNKS && ret == OK; chunk++) {
+				len = mq_receive(g_ping, msg, sizeof(msg), NULL);
+				if (len < 0) {
+					ret = ERROR;
+				} else {
+					memcpy(g_received + chunk * PINGPONG_MSGSIZE, msg, len);
+				}
+			}
+			break;
+
+		case PINGPONG_STREAM_REF:
+			len = mq_receiveref(g_ping, &buffer, NULL);
+			if (len != PINGPONG_PAYLOAD) {
+				ret = ERROR;
+			} else {
+				g_received[0] = ((FAR char *)buffer)[0];
+				mq_reffree(buffer);
+			}
+			break;
+#endif
+		}
+	}
+
+	if (ret != OK) {
+		printf("%-28s failed, errno %d\n", name, errno);
+
+		/* The peer may be blocked on a queue; mq_send and mq_receive are
+		 * cancellation points.
+		 */
+
+		pthread_cancel(peer);
+		pthread_join(peer, NULL);
+		pingpong_close();
+		return ERROR;
+	}
+
+	pthread_join(peer, NULL);
+	usec = pingpong_elapsed(&start);
+	pingpong_close();
+
+	if (g_peer_error != 0) {
+		printf("%-28s peer failed, errno %d\n", name, g_peer_error);
+		return ERROR;
+	}
+
+	printf("%-28s %10lld %10lld %10lld\n", name, usec, usec > 0 ? PINGPONG_ITER * 1000000LL / usec : 0, usec > 0 ? bytes * 1000000LL / 1024 / usec : 0);
+	return OK;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+#ifdef CONFIG_BUILD_KERNEL
+int main(int argc, FAR char *argv[])
+#else
+int mqueue_pingpong_main(int argc, char *argv[])
+#endif
+{
+	printf("%d iterations, CONFIG_MQ_MAXMSGSIZE %d, per-queue preallocation %s\n", PINGPONG_ITER, PINGPONG_MSGSIZE,
+#ifdef CONFIG_MQ_QUEUE_PREALLOC
+		   "on"
+#else
+		   "off"
+#endif
+		  );
+	printf("%-28s %10s %10s %10s\n", "test", "usec", "iter/s", "KB/s");
+
+	(void)pingpong_run("round trip", PINGPONG_ECHO, 1, PINGPONG_SMALL, 2LL * PINGPONG_ITER * PINGPONG_SMALL);
+	(void)pingpong_run("one way", PINGPONG_STREAM, PINGPONG_DEPTH, PINGPONG_MSGSIZE, (long long)PINGPONG_ITER * PINGPONG_MSGSIZE);
+#ifdef CONFIG_MQ_REFERENCE
+	memset(g_payload, 0x3c, sizeof(g_payload));
+	(void)pingpong_run("large payload, copied", PINGPONG_STREAM_COPY, PINGPONG_DEPTH, PINGPONG_MSGSIZE, (long long)PINGPONG_ITER * PINGPONG_PAYLOAD);
+	(void)pingpong_run("large payload, reference", PINGPONG_STREAM_REF, PINGPONG_DEPTH, MQ_REF_MSGSIZE, (long long)PINGPONG_ITER * PINGPONG_PAYLOAD);
+#endif
+
+	return 0;
+}
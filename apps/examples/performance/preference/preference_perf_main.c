@@ -0,0 +1,159 @@
+/****************************************************************************
+ *
+ * Copyright 2025 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <tinyara/config.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <dirent.h>
+#include <sys/statfs.h>
+#include <tinyara/preference.h>
+#include <preference/preference.h>
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define PREF_PERF_KEYS      CONFIG_EXAMPLES_PREFERENCE_PERFORMANCE_KEYS
+#define PREF_PERF_ROUNDS    CONFIG_EXAMPLES_PREFERENCE_PERFORMANCE_ROUNDS
+#define SMARTFS_PROCFS_PATH "/proc/fs/smartfs"
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+static long elapsed_usec(struct timespec *start, struct timespec *end)
+{
+	return (end->tv_sec - start->tv_sec) * 1000000L + (end->tv_nsec - start->tv_nsec) / 1000L;
+}
+
+/* Sum of the free sectors of all smartfs mounts, -1 if unknown */
+
+static long smartfs_free_sectors(void)
+{
+	DIR *dir;
+	FILE *fp;
+	struct dirent *entry;
+	char path[64];
+	char line[64];
+	long total = -1;
+	long value;
+
+	dir = opendir(SMARTFS_PROCFS_PATH);
+	if (dir == NULL) {
+		return -1;
+	}
+
+	while ((entry = readdir(dir)) != NULL) {
+		snprintf(path, sizeof(path), "%s/%s/status", SMARTFS_PROCFS_PATH, entry->d_name);
+		fp = fopen(path, "r");
+		if (fp == NULL) {
+			continue;
+		}
+		while (fgets(line, sizeof(line), fp) != NULL) {
+			if (sscanf(line, "Free Sectors %ld", &value) == 1) {
+				total = (total < 0 ? 0 : total) + value;
+			}
+		}
+		fclose(fp);
+	}
+	closedir(dir);
+
+	return total;
+}
+
+static void print_result(const char *name, int count, long usec)
+{
+	if (usec <= 0) {
+		usec = 1;
+	}
+	printf("%-6s : %d ops, %ld usec, %ld usec/op, %ld ops/sec\n", name, count, usec, usec / count, (long)((long long)count * 1000000 / usec));
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+int preference_perf_main(int argc, char *argv[])
+{
+	struct timespec start;
+	struct timespec end;
+	struct statfs fs;
+	char key[16];
+	long free_before;
+	long free_after;
+	int round;
+	int value;
+	int ret;
+	int i;
+
+	if (statfs(PREF_PATH, &fs) < 0) {
+		printf("Failed to get the file system of %s\n", PREF_PATH);
+		return -1;
+	}
+	free_before = smartfs_free_sectors();
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	for (round = 0; round < PREF_PERF_ROUNDS; round++) {
+		for (i = 0; i < PREF_PERF_KEYS; i++) {
+			snprintf(key, sizeof(key), "perf%d", i);
+			ret = preference_set_int(key, round * PREF_PERF_KEYS + i);
+			if (ret != OK) {
+				printf("preference_set_int %s failed, %d\n", key, ret);
+				goto errout;
+			}
+		}
+	}
+	clock_gettime(CLOCK_MONOTONIC, &end);
+	print_result("set", PREF_PERF_ROUNDS * PREF_PERF_KEYS, elapsed_usec(&start, &end));
+
+	/* Give background syncs a chance to reach the flash before counting */
+
+	sleep(2);
+	free_after = smartfs_free_sectors();
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	for (round = 0; round < PREF_PERF_ROUNDS; round++) {
+		for (i = 0; i < PREF_PERF_KEYS; i++) {
+			snprintf(key, sizeof(key), "perf%d", i);
+			ret = preference_get_int(key, &value);
+			if (ret != OK || value != (PREF_PERF_ROUNDS - 1) * PREF_PERF_KEYS + i) {
+				printf("preference_get_int %s failed, %d\n", key, ret);
+				goto errout;
+			}
+		}
+	}
+	clock_gettime(CLOCK_MONOTONIC, &end);
+	print_result("get", PREF_PERF_ROUNDS * PREF_PERF_KEYS, elapsed_usec(&start, &end));
+
+	if (free_before >= 0 && free_after >= 0) {
+		printf("flash  : %ld sectors of %ld bytes, %ld bytes/update\n", free_before - free_after, (long)fs.f_bsize,
+			   (free_before - free_after) * (long)fs.f_bsize / (PREF_PERF_ROUNDS * PREF_PERF_KEYS));
+	} else {
+		printf("flash  : smartfs status is not available\n");
+	}
+
+errout:
+	(void)preference_remove_all();
+	return 0;
+}
@@ -0,0 +1,189 @@
+/****************************************************************************
+ *
+ * Copyright 2025 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <tinyara/config.h>
+#include <stdio.h>
+#include <stdbool.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <time.h>
+#include <errno.h>
+#include <sys/stat.h>
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define DENTRY_PERF_PATH   CONFIG_EXAMPLES_SMARTFS_DENTRY_PERFORMANCE_PATH
+#define DENTRY_PERF_DEPTH  CONFIG_EXAMPLES_SMARTFS_DENTRY_PERFORMANCE_DEPTH
+#define DENTRY_PERF_FILES  CONFIG_EXAMPLES_SMARTFS_DENTRY_PERFORMANCE_FILES
+#define DENTRY_PERF_LOOPS  CONFIG_EXAMPLES_SMARTFS_DENTRY_PERFORMANCE_LOOPS
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static char g_path[CONFIG_PATH_MAX];
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/* Build the name of the directory at 'level' (0 is DENTRY_PERF_PATH) */
+
+static int dentry_perf_dirname(int level)
+{
+	int len;
+	int i;
+
+	len = snprintf(g_path, sizeof(g_path), "%s", DENTRY_PERF_PATH);
+	for (i = 0; i < level && len < sizeof(g_path); i++) {
+		len += snprintf(&g_path[len], sizeof(g_path) - len, "/d%d", i);
+	}
+
+	return len < sizeof(g_path) ? len : -ENAMETOOLONG;
+}
+
+/* Create the tree unless it is already there, e.g. from a nxfuse image */
+
+static int dentry_perf_populate(void)
+{
+	struct stat st;
+	int level;
+	int len;
+	int fd;
+	int i;
+
+	for (level = 0; level <= DENTRY_PERF_DEPTH; level++) {
+		len = dentry_perf_dirname(level);
+		if (len < 0) {
+			return len;
+		}
+
+		if (stat(g_path, &st) < 0 && mkdir(g_path, 0777) < 0) {
+			printf("Failed to create %s, errno %d\n", g_path, errno);
+			return -errno;
+		}
+
+		for (i = 0; i < DENTRY_PERF_FILES; i++) {
+			snprintf(&g_path[len], sizeof(g_path) - len, "/f%d", i);
+			if (stat(g_path, &st) == 0) {
+				continue;
+			}
+
+			fd = open(g_path, O_WRONLY | O_CREAT, 0666);
+			if (fd < 0) {
+				printf("Failed to create %s, errno %d\n", g_path, errno);
+				return -errno;
+			}
+
+			close(fd);
+		}
+	}
+
+	return OK;
+}
+
+/* stat() every file of the tree, or as many missing names, 'loops' times */
+
+static int dentry_perf_run(bool missing, int loops, FAR long long *usec, FAR int *nops)
+{
+	struct timespec start;
+	struct timespec end;
+	struct stat st;
+	int level;
+	int len;
+	int ret;
+	int i;
+
+	*nops = 0;
+	clock_gettime(CLOCK_MONOTONIC, &start);
+
+	while (loops-- > 0) {
+		for (level = missing ? DENTRY_PERF_DEPTH : 0; level <= DENTRY_PERF_DEPTH; level++) {
+			len = dentry_perf_dirname(level);
+			if (len < 0) {
+				return len;
+			}
+
+			for (i = 0; i < DENTRY_PERF_FILES; i++) {
+				snprintf(&g_path[len], sizeof(g_path) - len, missing ? "/x%d" : "/f%d", i);
+				ret = stat(g_path, &st);
+				if ((ret == 0) == missing) {
+					printf("Unexpected stat() result %d for %s\n", ret, g_path);
+					return -EIO;
+				}
+
+				(*nops)++;
+			}
+		}
+	}
+
+	clock_gettime(CLOCK_MONOTONIC, &end);
+
+	*usec = (long long)(end.tv_sec - start.tv_sec) * 1000000LL + (end.tv_nsec - start.tv_nsec) / 1000;
+	return OK;
+}
+
+static void dentry_perf_report(FAR const char *name, bool missing, int loops)
+{
+	long long usec;
+	int nops;
+	int ret;
+
+	ret = dentry_perf_run(missing, loops, &usec, &nops);
+	if (ret < 0) {
+		printf("%-24s failed: %d\n", name, ret);
+		return;
+	}
+
+	printf("%-24s %8d %10lld %10lld\n", name, nops, usec, nops > 0 ? usec / nops : 0);
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+#ifdef CONFIG_BUILD_KERNEL
+int main(int argc, FAR char *argv[])
+#else
+int smartfs_dentry_perf_main(int argc, char *argv[])
+#endif
+{
+	int ret;
+
+	ret = dentry_perf_populate();
+	if (ret < 0) {
+		return -1;
+	}
+
+	printf("stat() on %d levels of %d files under %s\n", DENTRY_PERF_DEPTH + 1, DENTRY_PERF_FILES, DENTRY_PERF_PATH);
+	printf("%-24s %8s %10s %10s\n", "lookup", "ops", "usec", "usec/op");
+
+	/* The first pass pays for whatever is not cached yet */
+
+	dentry_perf_report("first pass", false, 1);
+	dentry_perf_report("repeated", false, DENTRY_PERF_LOOPS);
+	dentry_perf_report("missing, deepest dir", true, DENTRY_PERF_LOOPS);
+
+	return 0;
+}
@@ -0,0 +1,208 @@
+/****************************************************************************
+ *
+ * Copyright 2025 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <tinyara/config.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <time.h>
+#include <errno.h>
+#include <sys/mount.h>
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define APPEND_PERF_MOUNTPT    CONFIG_EXAMPLES_TMPFS_APPEND_PERFORMANCE_MOUNTPT
+#define APPEND_PERF_FILESIZE   CONFIG_EXAMPLES_TMPFS_APPEND_PERFORMANCE_FILESIZE
+#define APPEND_PERF_WRITESIZE  CONFIG_EXAMPLES_TMPFS_APPEND_PERFORMANCE_WRITESIZE
+#define APPEND_PERF_FILE       APPEND_PERF_MOUNTPT "/append.bin"
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+struct append_heap_s {
+	int base;			/* Heap in use before the test */
+	int peak;			/* Largest heap in use seen */
+	int minfree;		/* Smallest largest free chunk seen */
+};
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static char g_buffer[APPEND_PERF_WRITESIZE];
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+static void append_perf_mallinfo(FAR struct mallinfo *info)
+{
+#ifdef CONFIG_CAN_PASS_STRUCTS
+	*info = mallinfo();
+#else
+	(void)mallinfo(info);
+#endif
+}
+
+static long long append_perf_usec(FAR struct timespec *start, FAR struct timespec *end)
+{
+	return (long long)(end->tv_sec - start->tv_sec) * 1000000LL + (end->tv_nsec - start->tv_nsec) / 1000;
+}
+
+/* Build the file in APPEND_PERF_WRITESIZE appends.  If heap is not NULL,
+ * sample the heap after every write.  Returns the number of bytes written.
+ */
+
+static int append_perf_write(FAR struct append_heap_s *heap, FAR long long *usec)
+{
+	struct timespec start;
+	struct timespec end;
+	struct mallinfo info;
+	int written = 0;
+	int ret;
+	int fd;
+
+	fd = open(APPEND_PERF_FILE, O_WRONLY | O_CREAT | O_TRUNC, 0666);
+	if (fd < 0) {
+		printf("Failed to create %s, errno %d\n", APPEND_PERF_FILE, errno);
+		return -errno;
+	}
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	while (written < APPEND_PERF_FILESIZE) {
+		ret = write(fd, g_buffer, APPEND_PERF_WRITESIZE);
+		if (ret != APPEND_PERF_WRITESIZE) {
+			printf("write() failed at offset %d, errno %d\n", written, errno);
+			break;
+		}
+
+		written += ret;
+
+		if (heap != NULL) {
+			append_perf_mallinfo(&info);
+			if (info.uordblks > heap->peak) {
+				heap->peak = info.uordblks;
+			}
+
+			if (info.mxordblk < heap->minfree) {
+				heap->minfree = info.mxordblk;
+			}
+		}
+	}
+
+	clock_gettime(CLOCK_MONOTONIC, &end);
+	close(fd);
+
+	*usec = append_perf_usec(&start, &end);
+	return written;
+}
+
+static int append_perf_read(FAR long long *usec)
+{
+	struct timespec start;
+	struct timespec end;
+	int nread = 0;
+	int ret;
+	int fd;
+
+	fd = open(APPEND_PERF_FILE, O_RDONLY);
+	if (fd < 0) {
+		return -errno;
+	}
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	while ((ret = read(fd, g_buffer, APPEND_PERF_WRITESIZE)) > 0) {
+		nread += ret;
+	}
+
+	clock_gettime(CLOCK_MONOTONIC, &end);
+	close(fd);
+
+	*usec = append_perf_usec(&start, &end);
+	return nread;
+}
+
+static void append_perf_report(FAR const char *name, int nbytes, long long usec)
+{
+	printf("%-12s %10d bytes %10lld usec %8lld KB/s\n", name, nbytes, usec,
+		   usec > 0 ? (long long)nbytes * 1000000LL / 1024 / usec : 0);
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+#ifdef CONFIG_BUILD_KERNEL
+int main(int argc, FAR char *argv[])
+#else
+int tmpfs_append_perf_main(int argc, char *argv[])
+#endif
+{
+	struct append_heap_s heap;
+	struct mallinfo info;
+	long long usec;
+	int nbytes;
+
+	memset(g_buffer, 0x5a, sizeof(g_buffer));
+
+	if (mount(NULL, APPEND_PERF_MOUNTPT, "tmpfs", 0, NULL) < 0) {
+		printf("Failed to mount tmpfs at %s, errno %d\n", APPEND_PERF_MOUNTPT, errno);
+		return -1;
+	}
+
+	printf("%d byte file in %d byte writes on %s\n", APPEND_PERF_FILESIZE, APPEND_PERF_WRITESIZE, APPEND_PERF_MOUNTPT);
+
+	append_perf_mallinfo(&info);
+	heap.base    = info.uordblks;
+	heap.peak    = info.uordblks;
+	heap.minfree = info.mxordblk;
+
+	/* Timed pass without heap sampling */
+
+	nbytes = append_perf_write(NULL, &usec);
+	if (nbytes >= 0) {
+		append_perf_report("append", nbytes, usec);
+	}
+
+	nbytes = append_perf_read(&usec);
+	if (nbytes >= 0) {
+		append_perf_report("read", nbytes, usec);
+	}
+
+	/* Untimed pass sampling the heap after every write.  O_TRUNC releases
+	 * the file data of the first pass before it starts.
+	 */
+
+	nbytes = append_perf_write(&heap, &usec);
+	printf("heap peak    %10d bytes above start, largest free chunk down to %d\n", heap.peak - heap.base, heap.minfree);
+
+	unlink(APPEND_PERF_FILE);
+	append_perf_mallinfo(&info);
+	printf("heap after   %10d bytes above start\n", info.uordblks - heap.base);
+
+	umount(APPEND_PERF_MOUNTPT);
+	return 0;
+}
@@ -0,0 +1,164 @@
+/****************************************************************************
+ *
+ * Copyright 2025 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <tinyara/config.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <protocols/webserver/http_server.h>
+#include <protocols/webserver/http_keyvalue_list.h>
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define WEB_PERF_PATH  CONFIG_EXAMPLES_WEBSERVER_FILE_PERFORMANCE_PATH
+#define WEB_PERF_SIZE  CONFIG_EXAMPLES_WEBSERVER_FILE_PERFORMANCE_SIZE
+#define WEB_PERF_PORT  CONFIG_EXAMPLES_WEBSERVER_FILE_PERFORMANCE_PORT
+#define WEB_PERF_BLOCK 1024
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static struct http_server_t *g_perf_server;
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+static long elapsed_usec(struct timespec *start, struct timespec *end)
+{
+	return (end->tv_sec - start->tv_sec) * 1000000L + (end->tv_nsec - start->tv_nsec) / 1000L;
+}
+
+/* Create the served file unless it is already there with the right size */
+
+static int create_file(void)
+{
+	struct stat st;
+	char *buf;
+	int fd;
+	int i;
+	int len;
+	int remain = WEB_PERF_SIZE;
+
+	if (stat(WEB_PERF_PATH, &st) == 0 && st.st_size == WEB_PERF_SIZE) {
+		return 0;
+	}
+
+	buf = (char *)malloc(WEB_PERF_BLOCK);
+	if (buf == NULL) {
+		return -1;
+	}
+	for (i = 0; i < WEB_PERF_BLOCK; i++) {
+		buf[i] = 'a' + i % 26;
+	}
+
+	fd = open(WEB_PERF_PATH, O_WRONLY | O_CREAT | O_TRUNC, 0666);
+	if (fd < 0) {
+		free(buf);
+		return -1;
+	}
+	while (remain > 0) {
+		len = remain < WEB_PERF_BLOCK ? remain : WEB_PERF_BLOCK;
+		if (write(fd, buf, len) != len) {
+			break;
+		}
+		remain -= len;
+	}
+	close(fd);
+	free(buf);
+	return remain == 0 ? 0 : -1;
+}
+
+static void http_get_file(struct http_client_t *client, struct http_req_message *req)
+{
+	struct timespec start;
+	struct timespec end;
+	long usec;
+	int ret;
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	ret = http_send_response_file(client, 200, "OK", WEB_PERF_PATH, NULL);
+	clock_gettime(CLOCK_MONOTONIC, &end);
+
+	usec = elapsed_usec(&start, &end);
+	if (usec == 0) {
+		usec = 1;
+	}
+	if (ret < 0) {
+		printf("GET %s failed after %ld usec\n", req->url, usec);
+		return;
+	}
+	printf("GET %s : %d bytes, %ld usec, %ld KB/s\n", req->url, WEB_PERF_SIZE, usec,
+		   (long)((long long)WEB_PERF_SIZE * 1000000 / usec / 1024));
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+int webserver_file_perf_main(int argc, char *argv[])
+{
+	if (argc == 2 && strcmp(argv[1], "start") == 0) {
+		if (g_perf_server != NULL) {
+			printf("Server is already running\n");
+			return -1;
+		}
+		if (create_file() < 0) {
+			printf("Fail to create %s\n", WEB_PERF_PATH);
+			return -1;
+		}
+		g_perf_server = http_server_init(WEB_PERF_PORT);
+		if (g_perf_server == NULL) {
+			printf("Fail to init the server\n");
+			return -1;
+		}
+		http_server_register_cb(g_perf_server, HTTP_METHOD_GET, "/file", http_get_file);
+		if (http_server_start(g_perf_server) < 0) {
+			printf("Fail to start the server\n");
+			http_server_deregister_cb(g_perf_server, HTTP_METHOD_GET, "/file");
+			http_server_release(&g_perf_server);
+			return -1;
+		}
+		printf("Serving %s (%d bytes) on GET http://<ip>:%d/file\n", WEB_PERF_PATH, WEB_PERF_SIZE, WEB_PERF_PORT);
+		return 0;
+	}
+
+	if (argc == 2 && strcmp(argv[1], "stop") == 0) {
+		if (g_perf_server == NULL) {
+			printf("Server is not running\n");
+			return -1;
+		}
+		http_server_stop(g_perf_server);
+		http_server_deregister_cb(g_perf_server, HTTP_METHOD_GET, "/file");
+		http_server_release(&g_perf_server);
+		return 0;
+	}
+
+	printf("Usage: webserver_file_perf start|stop\n");
+	return -1;
+}
@@ -29,6 +29,12 @@
 #include <fcntl.h>
 #include <debug.h>
 #include <arpa/inet.h>
+#ifdef CONFIG_EXAMPLES_SELECT_TEST_EPOLL_BENCH
+#include <stdint.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/epoll.h>
+#endif
 
 #ifndef CONFIG_NET_LWIP
 #include <arpa/inet.h>
@@ -298,6 +304,185 @@ done:
 
 }
 
+#ifdef CONFIG_EXAMPLES_SELECT_TEST_EPOLL_BENCH
+
+/* Measure one wakeup of a waiter that watches one active pipe next to a
+ * set of idle pipes.  select() sets up and tears down every descriptor on
+ * each call while epoll registers them once, so the gap between the two
+ * grows with the number of idle descriptors.
+ */
+
+#define BENCH_MAX_IDLE 64
+#define BENCH_ITER     CONFIG_EXAMPLES_SELECT_TEST_BENCH_ITER
+
+static int g_bench_idle[BENCH_MAX_IDLE][2];
+static int g_bench_active[2];
+
+static uint32_t bench_elapsed_us(struct timespec *start, struct timespec *end)
+{
+	return (end->tv_sec - start->tv_sec) * 1000000 + (end->tv_nsec - start->tv_nsec) / 1000;
+}
+
+static void bench_close(int nidle)
+{
+	int i;
+
+	for (i = 0; i < nidle; i++) {
+		close(g_bench_idle[i][0]);
+		close(g_bench_idle[i][1]);
+	}
+
+	close(g_bench_active[0]);
+	close(g_bench_active[1]);
+}
+
+static int bench_open(int nidle)
+{
+	int i;
+
+	if (pipe(g_bench_active) < 0) {
+		return -1;
+	}
+
+	for (i = 0; i < nidle; i++) {
+		if (pipe(g_bench_idle[i]) < 0) {
+			bench_close(i);
+			return -1;
+		}
+	}
+
+	return 0;
+}
+
+static int bench_select(int nidle, uint32_t *usec)
+{
+	fd_set rfds;
+	struct timeval tv;
+	struct timespec start;
+	struct timespec end;
+	char ch = 'x';
+	int max_fd;
+	int iter;
+	int i;
+
+	max_fd = g_bench_active[0];
+	for (i = 0; i < nidle; i++) {
+		max_fd = MAX(max_fd, g_bench_idle[i][0]);
+	}
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	for (iter = 0; iter < BENCH_ITER; iter++) {
+		write(g_bench_active[1], &ch, 1);
+
+		FD_ZERO(&rfds);
+		FD_SET(g_bench_active[0], &rfds);
+		for (i = 0; i < nidle; i++) {
+			FD_SET(g_bench_idle[i][0], &rfds);
+		}
+
+		tv.tv_sec = 1;
+		tv.tv_usec = 0;
+		if (select(max_fd + 1, &rfds, NULL, NULL, &tv) != 1) {
+			return -1;
+		}
+
+		read(g_bench_active[0], &ch, 1);
+	}
+	clock_gettime(CLOCK_MONOTONIC, &end);
+
+	*usec = bench_elapsed_us(&start, &end);
+	return 0;
+}
+
+static int bench_epoll(int nidle, uint32_t *usec)
+{
+	struct epoll_event ev;
+	struct timespec start;
+	struct timespec end;
+	char ch = 'x';
+	int epfd;
+	int ret = -1;
+	int iter;
+	int i;
+
+	epfd = epoll_create1(0);
+	if (epfd < 0) {
+		return -1;
+	}
+
+	ev.events = EPOLLIN;
+	ev.data.fd = g_bench_active[0];
+	if (epoll_ctl(epfd, EPOLL_CTL_ADD, g_bench_active[0], &ev) < 0) {
+		goto done;
+	}
+
+	for (i = 0; i < nidle; i++) {
+		ev.events = EPOLLIN;
+		ev.data.fd = g_bench_idle[i][0];
+		if (epoll_ctl(epfd, EPOLL_CTL_ADD, g_bench_idle[i][0], &ev) < 0) {
+			goto done;
+		}
+	}
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	for (iter = 0; iter < BENCH_ITER; iter++) {
+		write(g_bench_active[1], &ch, 1);
+
+		if (epoll_wait(epfd, &ev, 1, 1000) != 1 || ev.data.fd != g_bench_active[0]) {
+			goto done;
+		}
+
+		read(g_bench_active[0], &ch, 1);
+	}
+	clock_gettime(CLOCK_MONOTONIC, &end);
+
+	*usec = bench_elapsed_us(&start, &end);
+	ret = 0;
+
+done:
+	/* Closing the epoll descriptor tears down every registered pipe */
+
+	close(epfd);
+	return ret;
+}
+
+static void bench_main(void)
+{
+	static const int nidle[] = { 8, 16, 32, 64 };
+	uint32_t select_us;
+	uint32_t epoll_us;
+	int i;
+
+	printf("\nselect vs. epoll, %d wakeups per set\n", BENCH_ITER);
+	printf("%8s %16s %16s\n", "idle fds", "select ns/wakeup", "epoll ns/wakeup");
+
+	for (i = 0; i < sizeof(nidle) / sizeof(nidle[0]); i++) {
+		/* Two descriptors per pipe, the epoll descriptor and stdio */
+
+		if (2 * (nidle[i] + 1) + 4 > CONFIG_NFILE_DESCRIPTORS) {
+			printf("%8d skipped, needs %d file descriptors\n", nidle[i], 2 * (nidle[i] + 1) + 4);
+			continue;
+		}
+
+		if (bench_open(nidle[i]) < 0) {
+			printf("%8d failed to create pipes\n", nidle[i]);
+			continue;
+		}
+
+		if (bench_select(nidle[i], &select_us) < 0 || bench_epoll(nidle[i], &epoll_us) < 0) {
+			printf("%8d failed\n", nidle[i]);
+		} else {
+			printf("%8d %16u %16u\n", nidle[i],
+				   (unsigned int)((uint64_t)select_us * 1000 / BENCH_ITER),
+				   (unsigned int)((uint64_t)epoll_us * 1000 / BENCH_ITER));
+		}
+
+		bench_close(nidle[i]);
+	}
+}
+
+#endif
+
 #ifdef CONFIG_BUILD_KERNEL
 int main(int argc, FAR char *argv[])
 #else
@@ -306,8 +491,18 @@ int select_test_main(int argc, char *argv[])
 {
 	int result = -1;
 
+#ifdef CONFIG_EXAMPLES_SELECT_TEST_EPOLL_BENCH
+	if (argc == 2 && strcmp(argv[1], "bench") == 0) {
+		bench_main();
+		return 0;
+	}
+#endif
+
 	if (argc < 6) {
 		printf("\n[USAGE] select_test a b c d e\n");
+#ifdef CONFIG_EXAMPLES_SELECT_TEST_EPOLL_BENCH
+		printf("[USAGE] select_test bench\n");
+#endif
 		return 0;
 	}
 
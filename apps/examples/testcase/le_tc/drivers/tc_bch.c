@@ -19,6 +19,7 @@
 /// @file tc_bch.c
 /// @brief Test Case Example for bch driver
 #include <tinyara/config.h>
+#include <tinyara/fs/fs.h>
 #include <tinyara/fs/ioctl.h>
 #include <stdio.h>
 #include <fcntl.h>
@@ -255,6 +256,115 @@ static void tc_driver_bch_read_write(void)
 	TC_SUCCESS_RESULT();
 }
 
+/**
+* @fn                   :tc_driver_bch_cache
+* @brief                :Test the bch driver multi-sector cache
+* @scenario             :Configure a write-back cache with read-ahead, do small writes
+*                        spread over several sectors and a full-sector write over a
+*                        cached sector, then check the data before and after close
+* API's covered         :ioctl, read, write, seek, close
+* Preconditions         :none
+* Postconditions        :none
+* @return               :void
+*/
+static void tc_driver_bch_cache(void)
+{
+	struct bch_cacheconfig_s config;
+	int fd = 0;
+	int ret = 0;
+	int i;
+	char *buf = malloc(4 * SECT_SIZE);
+	char *orig = malloc(4 * SECT_SIZE);
+
+	TC_ASSERT_GT("malloc", buf, 0);
+	TC_ASSERT_GT_CLEANUP("malloc", orig, 0, free(buf));
+
+	fd = open("/dev/tmpbchdevrw", O_RDWR);
+	TC_ASSERT_GT_CLEANUP("bch_open", fd, 0, free(orig); free(buf));
+
+	/* Negative test cases */
+	ret = ioctl(fd, DIOC_SETCACHE, 0);
+	TC_ASSERT_LT_CLEANUP("bch_ioctl", ret, 0, free(orig); cleanup(fd, buf));
+
+	config.nsectors = 2;
+	config.readahead = 2;
+	config.writeback = false;
+	ret = ioctl(fd, DIOC_SETCACHE, (unsigned long)&config);
+	TC_ASSERT_LT_CLEANUP("bch_ioctl", ret, 0, free(orig); cleanup(fd, buf));
+
+	/* Keep the original contents of the first four sectors */
+	ret = read(fd, orig, 4 * SECT_SIZE);
+	TC_ASSERT_EQ_CLEANUP("bch_read", ret, 4 * SECT_SIZE, free(orig); cleanup(fd, buf));
+
+	config.nsectors = 3;
+	config.readahead = 1;
+	config.writeback = true;
+	ret = ioctl(fd, DIOC_SETCACHE, (unsigned long)&config);
+	TC_ASSERT_EQ_CLEANUP("bch_ioctl", ret, OK, free(orig); cleanup(fd, buf));
+
+	/* Small writes that touch every sector, more sectors than the cache holds */
+	for (i = 0; i < 4 * SECT_SIZE; i++) {
+		buf[i] = (char)(i * 7);
+	}
+
+	for (i = 0; i < 4 * SECT_SIZE; i += 64) {
+		ret = lseek(fd, (i * 5) % (4 * SECT_SIZE), SEEK_SET);
+		TC_ASSERT_EQ_CLEANUP("bch_seek", ret, (i * 5) % (4 * SECT_SIZE), free(orig); cleanup(fd, buf));
+		ret = write(fd, &buf[ret], 64);
+		TC_ASSERT_EQ_CLEANUP("bch_write", ret, 64, free(orig); cleanup(fd, buf));
+	}
+
+	/* A full-sector write over a sector that is cached and dirty */
+	ret = lseek(fd, SECT_SIZE, SEEK_SET);
+	TC_ASSERT_EQ_CLEANUP("bch_seek", ret, SECT_SIZE, free(orig); cleanup(fd, buf));
+	ret = write(fd, &buf[SECT_SIZE], SECT_SIZE);
+	TC_ASSERT_EQ_CLEANUP("bch_write", ret, SECT_SIZE, free(orig); cleanup(fd, buf));
+
+	/* Read back with the cache, across sector boundaries */
+	for (i = 0; i < 4 * SECT_SIZE; i += 100) {
+		char tmp[100];
+		int len = 4 * SECT_SIZE - i < 100 ? 4 * SECT_SIZE - i : 100;
+
+		ret = lseek(fd, i, SEEK_SET);
+		TC_ASSERT_EQ_CLEANUP("bch_seek", ret, i, free(orig); cleanup(fd, buf));
+		ret = read(fd, tmp, len);
+		TC_ASSERT_EQ_CLEANUP("bch_read", ret, len, free(orig); cleanup(fd, buf));
+		TC_ASSERT_EQ_CLEANUP("bch_read", memcmp(tmp, &buf[i], len), 0, free(orig); cleanup(fd, buf));
+	}
+
+	/* close() writes the dirty sectors back */
+	ret = close(fd);
+	TC_ASSERT_EQ_CLEANUP("bch_close", ret, OK, free(orig); free(buf));
+
+	fd = open("/dev/tmpbchdevrw", O_RDWR);
+	TC_ASSERT_GT_CLEANUP("bch_open", fd, 0, free(orig); free(buf));
+
+	config.nsectors = 1;
+	config.readahead = 0;
+	config.writeback = false;
+	ret = ioctl(fd, DIOC_SETCACHE, (unsigned long)&config);
+	TC_ASSERT_EQ_CLEANUP("bch_ioctl", ret, OK, free(orig); cleanup(fd, buf));
+
+	for (i = 0; i < 4 * SECT_SIZE; i += SECT_SIZE) {
+		char tmp[SECT_SIZE];
+
+		ret = read(fd, tmp, SECT_SIZE);
+		TC_ASSERT_EQ_CLEANUP("bch_read", ret, SECT_SIZE, free(orig); cleanup(fd, buf));
+		TC_ASSERT_EQ_CLEANUP("bch_read", memcmp(tmp, &buf[i], SECT_SIZE), 0, free(orig); cleanup(fd, buf));
+	}
+
+	/* Restore the original contents */
+	ret = lseek(fd, 0, SEEK_SET);
+	TC_ASSERT_EQ_CLEANUP("bch_seek", ret, 0, free(orig); cleanup(fd, buf));
+	ret = write(fd, orig, 4 * SECT_SIZE);
+	TC_ASSERT_EQ_CLEANUP("bch_write", ret, 4 * SECT_SIZE, free(orig); cleanup(fd, buf));
+
+	free(orig);
+	cleanup(fd, buf);
+
+	TC_SUCCESS_RESULT();
+}
+
 /**
 * @fn                   :tc_driver_bch_ioctl
 * @brief                :Test the bch driver ioctl
@@ -336,6 +446,7 @@ void bch_main(void)
 	tc_driver_bch_register();
 	tc_driver_bch_open_close();
 	tc_driver_bch_read_write();
+	tc_driver_bch_cache();
 	tc_driver_bch_ioctl();
 	tc_driver_bch_unregister();
 #ifndef CONFIG_DISABLE_PSEUDOFS_OPERATIONS
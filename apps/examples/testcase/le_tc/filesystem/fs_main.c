@@ -36,6 +36,7 @@
 #include <string.h>
 #ifndef CONFIG_DISABLE_POLL
 #include <poll.h>
+#include <sys/epoll.h>
 #endif
 #include <errno.h>
 #include <sys/ioctl.h>
@@ -2724,6 +2725,111 @@ static void tc_fs_vfs_poll_p(void)
 	TC_SUCCESS_RESULT();
 }
 
+/**
+ * @testcase         tc_fs_vfs_epoll_p
+ * @brief            Persistent polling for I/O
+ * @scenario         Register a regular file once and check that epoll_wait reports it
+ *                   level-triggered, only once with EPOLLONESHOT, and not after it is closed.
+ *                   A dup() of the epoll descriptor still works after the original is closed
+ * @apicovered       epoll_create1, epoll_ctl, epoll_wait, dup
+ * @precondition     CONFIG_DISABLE_POLL should be disabled
+ * @postcondition    NA
+ */
+static void tc_fs_vfs_epoll_p(void)
+{
+	struct epoll_event ev;
+	int epfd;
+	int epfd2;
+	int ret;
+	int fd;
+	char *filename = VFS_FILE_PATH;
+
+	/* Init */
+	vfs_mount();
+
+	fd = open(filename, O_RDWR | O_CREAT | O_TRUNC);
+	TC_ASSERT_GEQ_CLEANUP("open", fd, 0, vfs_unmount());
+
+	epfd = epoll_create1(0);
+	TC_ASSERT_GEQ_CLEANUP("epoll_create1", epfd, 0, close(fd); vfs_unmount());
+
+	/* Testcase */
+	ev.events = EPOLLIN;
+	ev.data.fd = fd;
+	ret = epoll_ctl(epfd, EPOLL_CTL_ADD, fd, &ev);
+	TC_ASSERT_EQ_CLEANUP("epoll_ctl", ret, OK, close(epfd); close(fd); vfs_unmount());
+
+	ret = epoll_ctl(epfd, EPOLL_CTL_ADD, fd, &ev);
+	TC_ASSERT_EQ_CLEANUP("epoll_ctl", ret, ERROR, close(epfd); close(fd); vfs_unmount());
+	TC_ASSERT_EQ_CLEANUP("epoll_ctl", errno, EEXIST, close(epfd); close(fd); vfs_unmount());
+
+	/* Regular files are always readable, so level-triggered waits keep reporting them */
+	memset(&ev, 0, sizeof(ev));
+	ret = epoll_wait(epfd, &ev, 1, 0);
+	TC_ASSERT_EQ_CLEANUP("epoll_wait", ret, 1, close(epfd); close(fd); vfs_unmount());
+	TC_ASSERT_CLEANUP("epoll_wait", ev.events & EPOLLIN, close(epfd); close(fd); vfs_unmount());
+	TC_ASSERT_EQ_CLEANUP("epoll_wait", ev.data.fd, fd, close(epfd); close(fd); vfs_unmount());
+
+	ret = epoll_wait(epfd, &ev, 1, 0);
+	TC_ASSERT_EQ_CLEANUP("epoll_wait", ret, 1, close(epfd); close(fd); vfs_unmount());
+
+	/* A one-shot registration is reported once until it is modified again */
+	ev.events = EPOLLIN | EPOLLONESHOT;
+	ev.data.fd = fd;
+	ret = epoll_ctl(epfd, EPOLL_CTL_MOD, fd, &ev);
+	TC_ASSERT_EQ_CLEANUP("epoll_ctl", ret, OK, close(epfd); close(fd); vfs_unmount());
+
+	ret = epoll_wait(epfd, &ev, 1, 0);
+	TC_ASSERT_EQ_CLEANUP("epoll_wait", ret, 1, close(epfd); close(fd); vfs_unmount());
+
+	ret = epoll_wait(epfd, &ev, 1, 0);
+	TC_ASSERT_EQ_CLEANUP("epoll_wait", ret, 0, close(epfd); close(fd); vfs_unmount());
+
+	ret = epoll_ctl(epfd, EPOLL_CTL_DEL, fd, NULL);
+	TC_ASSERT_EQ_CLEANUP("epoll_ctl", ret, OK, close(epfd); close(fd); vfs_unmount());
+
+	ret = epoll_ctl(epfd, EPOLL_CTL_DEL, fd, NULL);
+	TC_ASSERT_EQ_CLEANUP("epoll_ctl", ret, ERROR, close(epfd); close(fd); vfs_unmount());
+	TC_ASSERT_EQ_CLEANUP("epoll_ctl", errno, ENOENT, close(epfd); close(fd); vfs_unmount());
+
+	/* Closing a registered descriptor removes it from the interest list */
+	ev.events = EPOLLIN;
+	ev.data.fd = fd;
+	ret = epoll_ctl(epfd, EPOLL_CTL_ADD, fd, &ev);
+	TC_ASSERT_EQ_CLEANUP("epoll_ctl", ret, OK, close(epfd); close(fd); vfs_unmount());
+
+	close(fd);
+	ret = epoll_wait(epfd, &ev, 1, 0);
+	TC_ASSERT_EQ_CLEANUP("epoll_wait", ret, 0, close(epfd); vfs_unmount());
+
+	ret = epoll_ctl(epfd, EPOLL_CTL_DEL, fd, NULL);
+	TC_ASSERT_EQ_CLEANUP("epoll_ctl", ret, ERROR, close(epfd); vfs_unmount());
+	TC_ASSERT_EQ_CLEANUP("epoll_ctl", errno, ENOENT, close(epfd); vfs_unmount());
+
+	/* A duplicate keeps the instance alive after the original is closed */
+	epfd2 = dup(epfd);
+	TC_ASSERT_GEQ_CLEANUP("dup", epfd2, 0, close(epfd); vfs_unmount());
+	close(epfd);
+
+	fd = open(filename, O_RDONLY);
+	TC_ASSERT_GEQ_CLEANUP("open", fd, 0, close(epfd2); vfs_unmount());
+
+	ev.events = EPOLLIN;
+	ev.data.fd = fd;
+	ret = epoll_ctl(epfd2, EPOLL_CTL_ADD, fd, &ev);
+	TC_ASSERT_EQ_CLEANUP("epoll_ctl", ret, OK, close(epfd2); close(fd); vfs_unmount());
+
+	ret = epoll_wait(epfd2, &ev, 1, 0);
+	TC_ASSERT_EQ_CLEANUP("epoll_wait", ret, 1, close(epfd2); close(fd); vfs_unmount());
+
+	/* Deinit */
+	close(epfd2);
+	close(fd);
+	vfs_unmount();
+
+	TC_SUCCESS_RESULT();
+}
+
 #ifndef CONFIG_DISABLE_MANUAL_TESTCASE
 /**
  * @testcase         tc_fs_vfs_select_p
@@ -5465,6 +5571,98 @@ static void tc_libc_stdio_stdsostream_invalid_permission_n(void)
 	TC_SUCCESS_RESULT();
 }
 
+#ifdef CONFIG_FS_TMPFS
+/**
+ * @testcase         tc_fs_tmpfs_rw_p
+ * @brief            Read and write a tmpfs file larger than its growth unit
+ * @scenario         Append in small chunks, write past the end of file, truncate down and up,
+ *                   and check the content including the zero-filled holes
+ * @apicovered       write, lseek, read, ftruncate
+ * @precondition     NA
+ * @postcondition    NA
+ */
+static void tc_fs_tmpfs_rw_p(void)
+{
+	char path[CONFIG_PATH_MAX];
+	char buf[100];
+	bool tmpfs_mount_exist = false;
+	int ret;
+	int fd;
+	int i;
+	int j;
+
+	/* Init */
+	ret = mount(NULL, CONFIG_LIBC_TMPDIR, "tmpfs", 0, NULL);
+	if (ret < 0) {
+		TC_ASSERT_EQ("mount", errno, EEXIST);
+		tmpfs_mount_exist = true;
+	}
+
+	snprintf(path, sizeof(path), "%s/tc_tmpfs_rw", CONFIG_LIBC_TMPDIR);
+	fd = open(path, O_RDWR | O_CREAT | O_TRUNC, 0666);
+	TC_ASSERT_GEQ_CLEANUP("open", fd, 0, goto errout);
+
+	/* Testcase: 3000 bytes in 100 byte appends */
+	for (i = 0; i < 30; i++) {
+		memset(buf, 'a' + i % 26, sizeof(buf));
+		ret = write(fd, buf, sizeof(buf));
+		TC_ASSERT_EQ_CLEANUP("write", ret, sizeof(buf), goto errout_with_fd);
+	}
+
+	/* Write 10 bytes 700 bytes past the end of file, leaving a hole */
+	ret = lseek(fd, 3700, SEEK_SET);
+	TC_ASSERT_EQ_CLEANUP("lseek", ret, 3700, goto errout_with_fd);
+	ret = write(fd, "0123456789", 10);
+	TC_ASSERT_EQ_CLEANUP("write", ret, 10, goto errout_with_fd);
+
+	ret = lseek(fd, 0, SEEK_SET);
+	TC_ASSERT_EQ_CLEANUP("lseek", ret, 0, goto errout_with_fd);
+	for (i = 0; i < 37; i++) {
+		ret = read(fd, buf, sizeof(buf));
+		TC_ASSERT_EQ_CLEANUP("read", ret, sizeof(buf), goto errout_with_fd);
+		for (j = 0; j < sizeof(buf); j++) {
+			TC_ASSERT_EQ_CLEANUP("read", buf[j], i < 30 ? 'a' + i % 26 : 0, goto errout_with_fd);
+		}
+	}
+
+	ret = read(fd, buf, sizeof(buf));
+	TC_ASSERT_EQ_CLEANUP("read", ret, 10, goto errout_with_fd);
+	TC_ASSERT_EQ_CLEANUP("read", strncmp(buf, "0123456789", 10), 0, goto errout_with_fd);
+
+	/* Truncate into the data and grow again, the regrown range reads as zero */
+	ret = ftruncate(fd, 650);
+	TC_ASSERT_EQ_CLEANUP("ftruncate", ret, OK, goto errout_with_fd);
+	ret = ftruncate(fd, 1200);
+	TC_ASSERT_EQ_CLEANUP("ftruncate", ret, OK, goto errout_with_fd);
+
+	ret = lseek(fd, 600, SEEK_SET);
+	TC_ASSERT_EQ_CLEANUP("lseek", ret, 600, goto errout_with_fd);
+	ret = read(fd, buf, sizeof(buf));
+	TC_ASSERT_EQ_CLEANUP("read", ret, sizeof(buf), goto errout_with_fd);
+	for (j = 0; j < sizeof(buf); j++) {
+		TC_ASSERT_EQ_CLEANUP("read", buf[j], j < 50 ? 'a' + 6 : 0, goto errout_with_fd);
+	}
+
+	/* Deinit */
+	close(fd);
+	unlink(path);
+	if (false == tmpfs_mount_exist) {
+		umount(CONFIG_LIBC_TMPDIR);
+	}
+
+	TC_SUCCESS_RESULT();
+	return;
+
+errout_with_fd:
+	close(fd);
+	unlink(path);
+errout:
+	if (false == tmpfs_mount_exist) {
+		umount(CONFIG_LIBC_TMPDIR);
+	}
+}
+#endif
+
 /**
  * @testcase         tc_libc_stdio_mktemp_p
  * @brief            The mktemp() function generates a unique temporary filename from template.
@@ -6229,6 +6427,7 @@ int tc_filesystem_main(int argc, char *argv[])
 	tc_fs_vfs_fdopen_invalid_fp_n();
 #ifndef CONFIG_DISABLE_POLL
 	tc_fs_vfs_poll_p();
+	tc_fs_vfs_epoll_p();
 #ifndef CONFIG_DISABLE_MANUAL_TESTCASE
 	tc_fs_vfs_select_p();
 #endif
@@ -6305,6 +6504,9 @@ int tc_filesystem_main(int argc, char *argv[])
 	tc_libc_stdio_lib_snoflush_p();
 #endif
 	tc_libc_stdio_lib_sprintf_p();
+#ifdef CONFIG_FS_TMPFS
+	tc_fs_tmpfs_rw_p();
+#endif
 	tc_libc_stdio_mktemp_p();
 	tc_libc_stdio_mktemp_invalid_path_n();
 	tc_libc_stdio_mkstemp_p();
@@ -59,6 +59,9 @@
 #define VAL_CRC32_1 2564639436UL
 #define VAL_CRC32_2 450215437UL
 #define VAL_CRC32_3 3051332929UL
+#define VAL_CRC32_CHECK 0xcbf43926UL // crc32 of "123456789"
+#define VAL_CRC32_SEQ 0x29058c73UL // crc32 of the bytes 0 .. 255
+#define CRC_CHECK_LEN 9
 
 /**
  * @fn                  :tc_libc_misc_crc8
@@ -369,7 +372,10 @@ static void tc_libc_misc_crc32part(void)
 {
 	uint32_t ret_chk;
 	uint8_t src_arr[1] = { VAL_100 };
+	const uint8_t check_arr[] = "123456789";
+	uint8_t seq_arr[BUFF_SIZE];
 	uint32_t crc_32val = 0;
+	int split;
 
 	/* Return value should be 0x4adfa541 as calculated by crc32part */
 
@@ -382,6 +388,26 @@ static void tc_libc_misc_crc32part(void)
 	ret_chk = (uint32_t)crc32part(src_arr, SRC_LEN, crc_32val);
 	TC_ASSERT_EQ("crc32part", ret_chk, (uint32_t)VAL_CRC32_3);
 
+	/* Split at every offset, so that the parts start unaligned and cover
+	 * both the word and the byte loops of the sliced tables.
+	 */
+
+	for (split = 0; split <= CRC_CHECK_LEN; split++) {
+		crc_32val = crc32part(check_arr, split, 0);
+		ret_chk = crc32part(check_arr + split, CRC_CHECK_LEN - split, crc_32val);
+		TC_ASSERT_EQ("crc32part", ret_chk, (uint32_t)VAL_CRC32_CHECK);
+	}
+
+	for (split = 0; split < BUFF_SIZE; split++) {
+		seq_arr[split] = split;
+	}
+
+	for (split = 0; split < 8; split++) {
+		crc_32val = crc32part(seq_arr, split, 0);
+		ret_chk = crc32part(seq_arr + split, BUFF_SIZE - split, crc_32val);
+		TC_ASSERT_EQ("crc32part", ret_chk, (uint32_t)VAL_CRC32_SEQ);
+	}
+
 	TC_SUCCESS_RESULT();
 }
 
@@ -938,6 +938,130 @@ errout:
 	mq_unlink("mqsetattr");	
 }
 
+/* Fill and drain a small queue several times so that every message slot of
+ * the queue is used and reused (CONFIG_MQ_QUEUE_PREALLOC).
+ */
+
+static void tc_mqueue_mq_fill_drain(void)
+{
+	mqd_t mqdes;
+	struct mq_attr attr;
+	char buf[8];
+	int round;
+	int i;
+	int ret_chk;
+
+	attr.mq_maxmsg = 4;
+	attr.mq_msgsize = 4;
+	attr.mq_flags = 0;
+
+	mqdes = mq_open("mqfill", O_CREAT | O_RDWR | O_NONBLOCK, 0666, &attr);
+	TC_ASSERT_NEQ("mq_open", mqdes, (mqd_t)ERROR);
+
+	for (round = 0; round < 3; round++) {
+		for (i = 0; i < 4; i++) {
+			buf[0] = 'a' + round;
+			buf[1] = '0' + i;
+			ret_chk = mq_send(mqdes, buf, 2 + i % 3, 1);
+			TC_ASSERT_EQ_CLEANUP("mq_send", ret_chk, OK, goto errout);
+		}
+
+		ret_chk = mq_send(mqdes, buf, 1, 1);
+		TC_ASSERT_EQ_CLEANUP("mq_send", ret_chk, ERROR, goto errout);
+		TC_ASSERT_EQ_CLEANUP("mq_send", errno, EAGAIN, goto errout);
+
+		for (i = 0; i < 4; i++) {
+			ret_chk = mq_receive(mqdes, buf, sizeof(buf), NULL);
+			TC_ASSERT_EQ_CLEANUP("mq_receive", ret_chk, 2 + i % 3, goto errout);
+			TC_ASSERT_EQ_CLEANUP("mq_receive", buf[0], 'a' + round, goto errout);
+			TC_ASSERT_EQ_CLEANUP("mq_receive", buf[1], '0' + i, goto errout);
+		}
+
+		ret_chk = mq_receive(mqdes, buf, sizeof(buf), NULL);
+		TC_ASSERT_EQ_CLEANUP("mq_receive", ret_chk, ERROR, goto errout);
+		TC_ASSERT_EQ_CLEANUP("mq_receive", errno, EAGAIN, goto errout);
+	}
+
+	mq_close(mqdes);
+	mq_unlink("mqfill");
+	TC_SUCCESS_RESULT();
+	return;
+
+errout:
+	mq_close(mqdes);
+	mq_unlink("mqfill");
+}
+
+#ifdef CONFIG_MQ_REFERENCE
+static void tc_mqueue_mq_sendref_receiveref(void)
+{
+	mqd_t mqdes;
+	struct mq_attr attr;
+	FAR void *bufs[CONFIG_MQ_REFERENCE_NBUFFERS + 1];
+	FAR char *sbuf;
+	FAR void *rbuf = NULL;
+	size_t size;
+	int i;
+	int ret_chk;
+
+	attr.mq_maxmsg = 2;
+	attr.mq_msgsize = MQ_REF_MSGSIZE;
+	attr.mq_flags = 0;
+
+	mqdes = mq_open("mqref", O_CREAT | O_RDWR | O_NONBLOCK, 0666, &attr);
+	TC_ASSERT_NEQ("mq_open", mqdes, (mqd_t)ERROR);
+
+	/* One pooled buffer and one too large for the pool */
+
+	for (i = 0; i < 2; i++) {
+		size = i == 0 ? 100 : CONFIG_MQ_REFERENCE_BUFSIZE + 1;
+		sbuf = mq_refalloc(size);
+		TC_ASSERT_NEQ_CLEANUP("mq_refalloc", sbuf, NULL, goto errout);
+		memset(sbuf, 'r' + i, size);
+
+		ret_chk = mq_sendref(mqdes, sbuf, size, 0);
+		TC_ASSERT_EQ_CLEANUP("mq_sendref", ret_chk, OK, mq_reffree(sbuf); goto errout);
+
+		ret_chk = mq_receiveref(mqdes, &rbuf, NULL);
+		TC_ASSERT_EQ_CLEANUP("mq_receiveref", ret_chk, size, goto errout);
+		TC_ASSERT_EQ_CLEANUP("mq_receiveref", rbuf, sbuf, mq_reffree(rbuf); goto errout);
+		TC_ASSERT_EQ_CLEANUP("mq_receiveref", ((FAR char *)rbuf)[size - 1], 'r' + i, mq_reffree(rbuf); goto errout);
+		mq_reffree(rbuf);
+	}
+
+	/* Running out of pooled buffers falls back to the heap */
+
+	for (i = 0; i <= CONFIG_MQ_REFERENCE_NBUFFERS; i++) {
+		bufs[i] = mq_refalloc(16);
+		if (!bufs[i]) {
+			break;
+		}
+	}
+
+	ret_chk = i;
+	while (--i >= 0) {
+		mq_reffree(bufs[i]);
+	}
+	TC_ASSERT_EQ_CLEANUP("mq_refalloc", ret_chk, CONFIG_MQ_REFERENCE_NBUFFERS + 1, goto errout);
+
+	/* A message that is not a reference is rejected */
+
+	ret_chk = mq_send(mqdes, "x", 1, 0);
+	TC_ASSERT_EQ_CLEANUP("mq_send", ret_chk, OK, goto errout);
+	ret_chk = mq_receiveref(mqdes, &rbuf, NULL);
+	TC_ASSERT_EQ_CLEANUP("mq_receiveref", ret_chk, ERROR, goto errout);
+	TC_ASSERT_EQ_CLEANUP("mq_receiveref", errno, EBADMSG, goto errout);
+
+	mq_close(mqdes);
+	mq_unlink("mqref");
+	TC_SUCCESS_RESULT();
+	return;
+
+errout:
+	mq_close(mqdes);
+	mq_unlink("mqref");
+}
+#endif
 
 /****************************************************************************
  * Name: mqueue
@@ -952,6 +1076,10 @@ int mqueue_main(void)
 
 	tc_mqueue_mq_getattr();
 	tc_mqueue_mq_setattr();
+	tc_mqueue_mq_fill_drain();
+#ifdef CONFIG_MQ_REFERENCE
+	tc_mqueue_mq_sendref_receiveref();
+#endif
 
 	return 0;
 }
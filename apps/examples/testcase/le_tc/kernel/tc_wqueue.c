@@ -27,6 +27,7 @@
 #include <tinyara/clock.h>
 #include <tinyara/wqueue.h>
 #include <stdio.h>
+#include <errno.h>
 #include <sys/types.h>
 #include "tc_internal.h"
 
@@ -40,6 +41,8 @@
 **************************************************************************/
 
 static clock_t start_time;
+static volatile int g_order[3];
+static volatile int g_norder;
 
 /**************************************************************************
 * Private Functions
@@ -64,6 +67,12 @@ static void wq_test3(void *arg)
 	cur_time = clock();
 	printf("workqueue_test 3 : test 3 requested delay is (%u) ticks, executed delay is (%llu) ticks.\n", (uint32_t)arg, (uint64_t)cur_time - (uint64_t)start_time);
 }
+static void wq_order(void *arg)
+{
+	if (g_norder < 3) {
+		g_order[g_norder++] = (int)arg;
+	}
+}
 /**************************************************************************
 * Public Functions
 **************************************************************************/
@@ -108,6 +117,39 @@ cleanup:
 	TC_SUCCESS_RESULT();
 }
 #endif
+#ifdef CONFIG_SCHED_LPWORK
+static void tc_wqueue_work_queue_order(void)
+{
+	int result;
+	static struct work_s order_work[3];
+
+	g_norder = 0;
+
+	/* Queue in the reverse order of the deadlines, run in deadline order */
+
+	result = work_queue(LPWORK, &order_work[2], wq_order, (void *)2, 30);
+	TC_ASSERT_EQ("work_queue", result, OK);
+	result = work_queue(LPWORK, &order_work[1], wq_order, (void *)1, 20);
+	TC_ASSERT_EQ("work_queue", result, OK);
+	result = work_queue(LPWORK, &order_work[0], wq_order, (void *)0, 10);
+	TC_ASSERT_EQ("work_queue", result, OK);
+
+	/* Pending work cannot be queued again */
+
+	result = work_queue(LPWORK, &order_work[1], wq_order, (void *)1, 20);
+	TC_ASSERT_EQ("work_queue", result, -EALREADY);
+
+	sleep(1);
+
+	TC_ASSERT_EQ("work_queue", g_norder, 3);
+	TC_ASSERT_EQ("work_queue", g_order[0], 0);
+	TC_ASSERT_EQ("work_queue", g_order[1], 1);
+	TC_ASSERT_EQ("work_queue", g_order[2], 2);
+	TC_ASSERT("work_available", work_available(&order_work[0]));
+
+	TC_SUCCESS_RESULT();
+}
+#endif
 /****************************************************************************
  * Name: mqueue
  ****************************************************************************/
@@ -115,6 +157,9 @@ int wqueue_main(void)
 {
 #if defined(CONFIG_SCHED_HPWORK) || defined(CONFIG_SCHED_LPWORK)
 	tc_wqueue_work_queue_cancel();
+#endif
+#ifdef CONFIG_SCHED_LPWORK
+	tc_wqueue_work_queue_order();
 #endif
 	return 0;
 }
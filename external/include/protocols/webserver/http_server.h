@@ -330,6 +330,23 @@ int http_send_response_with_status_msg(struct http_client_t *client, int status,
  */
 int http_send_response_with_status(struct http_client_t *client, int status, const char* status_message, const char* body, int body_len, struct http_keyvalue_list_t *headers);
 
+/**
+ * @brief http_send_response_file() sends the response with a file as body.
+ *
+ * On plain connections the file is sent with sendfile(), so it is not
+ * copied through the application.  The Content-Length header is taken
+ * from the file size.
+ *
+ * @param[in] client a pointer of HTTP client.
+ * @param[in] status status code of a response.
+ * @param[in] status_message status message associated with status code.
+ * @param[in] path path of the file to send.
+ * @param[in] headers HTTP headers of a response.
+ * @return On success, HTTP_OK(0) is returned.
+ *         On failure, HTTP_ERROR(-1) is returned.
+ */
+int http_send_response_file(struct http_client_t *client, int status, const char *status_message, const char *path, struct http_keyvalue_list_t *headers);
+
 /**
  * @brief http_send_response_chunk() sends the response in chunk form.
  *
@@ -17,6 +17,8 @@
  ****************************************************************************/
 
 #include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/sendfile.h>
 #include <protocols/webserver/http_err.h>
 #include <protocols/webserver/http_keyvalue_list.h>
 #include <protocols/webclient.h>
@@ -1253,6 +1255,139 @@ int http_send_response_helper(struct http_client_t *client, int status, const ch
 	return HTTP_OK;
 }
 
+/* Send 'size' bytes of the file through a buffer, for TLS connections */
+
+static int http_send_file_copy(struct http_client_t *client, int fd, off_t size)
+{
+	char *buf;
+	ssize_t nread;
+	int ret = 0;
+
+	buf = HTTP_MALLOC(HTTP_CONF_MAX_REQUEST_LENGTH);
+	if (buf == NULL) {
+		HTTP_LOGE("Error: Fail to malloc buffer\n");
+		return -1;
+	}
+
+	while (size > 0) {
+		nread = read(fd, buf, HTTP_CONF_MAX_REQUEST_LENGTH);
+		if (nread <= 0) {
+			HTTP_LOGE("Error: Fail to read file errno[%d]\n", errno);
+			ret = -1;
+			break;
+		}
+		if (http_send_buffer(client, buf, nread) < 0) {
+			ret = -1;
+			break;
+		}
+		size -= nread;
+	}
+
+	HTTP_FREE(buf);
+	return ret;
+}
+
+int http_send_response_file(struct http_client_t *client, int status, const char *status_message,
+							const char *path, struct http_keyvalue_list_t *headers)
+{
+	char *buf;
+	int buflen;
+	int fd;
+	int ret = HTTP_ERROR;
+	off_t size;
+	ssize_t sent;
+	struct stat st;
+	struct http_keyvalue_t *cur;
+
+	fd = open(path, O_RDONLY);
+	if (fd < 0) {
+		HTTP_LOGE("Error: Fail to open %s\n", path);
+		return HTTP_ERROR;
+	}
+
+	if (fstat(fd, &st) < 0) {
+		HTTP_LOGE("Error: Fail to stat %s\n", path);
+		close(fd);
+		return HTTP_ERROR;
+	}
+
+	buf = HTTP_MALLOC(HTTP_CONF_MAX_REQUEST_LENGTH);
+	if (buf == NULL) {
+		HTTP_LOGE("Error: Fail to malloc buffer\n");
+		close(fd);
+		return HTTP_ERROR;
+	}
+
+	/* Every snprintf() is checked, the size passed to the next one must
+	 * stay positive.
+	 */
+	buflen = snprintf(buf, HTTP_CONF_MAX_REQUEST_LENGTH, "HTTP/1.1 %d %s\r\n", status, status_message);
+	if (buflen >= HTTP_CONF_MAX_REQUEST_LENGTH) {
+		goto errout_toolong;
+	}
+	if (headers) {
+		for (cur = headers->head->next; cur != headers->tail; cur = cur->next) {
+			if (strcmp(cur->key, "Content-Length") == 0 || strcmp(cur->key, "Keep-Alive") == 0) {
+				continue;
+			}
+			buflen += snprintf(buf + buflen, HTTP_CONF_MAX_REQUEST_LENGTH - buflen,
+							   "%s: %s\r\n", cur->key, cur->value);
+			if (buflen >= HTTP_CONF_MAX_REQUEST_LENGTH) {
+				goto errout_toolong;
+			}
+		}
+	} else {
+		buflen += snprintf(buf + buflen, HTTP_CONF_MAX_REQUEST_LENGTH - buflen,
+						   "Connection: %s\r\nContent-Type: application/octet-stream\r\n",
+						   client->keep_alive ? "Keep-Alive" : "close");
+		if (buflen >= HTTP_CONF_MAX_REQUEST_LENGTH) {
+			goto errout_toolong;
+		}
+	}
+	buflen += snprintf(buf + buflen, HTTP_CONF_MAX_REQUEST_LENGTH - buflen,
+					   "Content-Length: %ld\r\nKeep-Alive: timeout=%d, max=%d\r\n\r\n",
+					   (long)st.st_size, client->keep_alive_timeout, client->max_request);
+	if (buflen >= HTTP_CONF_MAX_REQUEST_LENGTH) {
+		goto errout_toolong;
+	}
+
+	if (http_send_buffer(client, buf, buflen) < 0) {
+		HTTP_LOGE("Error: failed to send buffer \n");
+		goto errout;
+	}
+
+	size = st.st_size;
+#ifdef CONFIG_NET_SECURITY_TLS
+	if (client->server->tls_init) {
+		if (http_send_file_copy(client, fd, size) == 0) {
+			ret = HTTP_OK;
+		}
+		goto errout;
+	}
+#endif
+
+	/* Plain connections hand the file to the kernel */
+
+	while (size > 0) {
+		sent = sendfile(client->client_fd, fd, NULL, size);
+		if (sent <= 0) {
+			HTTP_LOGE("Error: Fail to send file sent[%d] errno[%d]\n", (int)sent, errno);
+			goto errout;
+		}
+		size -= sent;
+	}
+	ret = HTTP_OK;
+	goto errout;
+
+errout_toolong:
+	HTTP_LOGE("Error: Headers are too long\n");
+
+errout:
+	HTTP_FREE(buf);
+	close(fd);
+	return ret;
+}
+
 int http_send_response(struct http_client_t *client, int status, const char *body, struct http_keyvalue_list_t *headers)
 {
 	const char* status_message = (status == 200) ? "OK" : body;
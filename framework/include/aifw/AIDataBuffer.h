@@ -27,11 +27,10 @@
 namespace aifw {
 
 class AIModel;
-class AIDataBufferNode;
 
 /**
  * @class AIDataBuffer
- * @brief This class creates a doubly linked list and provides API to perform operations on that list.
+ * @brief This class stores rows of values in a single circular block and provides API to perform operations on those rows.
  */
 class AIDataBuffer
 {
@@ -64,6 +63,26 @@ public:
 	 */
 	AIFW_RESULT readData(float *buffer, uint16_t startCol, uint16_t endCol, uint16_t row);
 
+	/**
+	 * @brief Get a row of data buffer without copying it.
+	 * The view is valid until the data buffer is written or cleared.
+	 * @param [in] row: Index of row to read, 0 being latest row.
+	 * @return: Pointer to the values of the row, NULL if row is invalid.
+	 */
+	const float *getRowView(uint16_t row);
+
+	/**
+	 * @brief Get the latest rows of data buffer in chronological order without copying them.
+	 * Rows are stored back to back in a ring, so the window is made of at most two contiguous parts.
+	 * The views are valid until the data buffer is written or cleared.
+	 * @param [in] count: Number of latest rows in the window.
+	 * @param [out] first: Oldest rows of the window.
+	 * @param [out] firstRows: Number of rows in first.
+	 * @param [out] second: Newer rows of the window, (count - firstRows) rows. NULL if the window is contiguous.
+	 * @return: AIFW_RESULT enum object.
+	 */
+	AIFW_RESULT getWindowView(uint16_t count, const float **first, uint16_t *firstRows, const float **second);
+
 	/**
 	 * @brief Gives number of filled rows in the streaming buffer.
 	 * @return: Negative value indicates an error. Non negative value tells number of filled rows in buffer.
@@ -87,16 +106,16 @@ public:
 	friend class AIModel;
 private:
 	/**
-	 * @brief Creates a doubly linked list with node count equal to row and node size equal to size.
-	 * @param [in] row: Number of rows/nodes needed in streaming buffer.
-	 * @param [in] size: Number of values in a single row/node.
-	 * @return: AIFW_RESULT enum object. Before returning any error, it releases all the memory allocated.
+	 * @brief Allocates a single block of row * size values for the streaming buffer.
+	 * @param [in] row: Number of rows needed in streaming buffer.
+	 * @param [in] size: Number of values in a single row.
+	 * @return: AIFW_RESULT enum object.
 	 */
 	AIFW_RESULT init(uint16_t row, uint16_t size);
 
 	/**
 	 * @brief Modifies the streaming buffer.
-	 * It compares row and size with previous set value of row and size and according to that it modifies the existing nodes or create more nodes or both.
+	 * It compares row and size with previous set value of row and size and according to that it moves the existing rows into a new block.
 	 * @param [in] row: Number of rows needed in the streaming buffer.
 	 * @param [in] size: Number of values in a single row.
 	 * @return: AIFW_RESULT enum object. In case of any error, previously allocated memory is not released.
@@ -105,13 +124,13 @@ private:
 
 	/**
 	 * @brief Deinitializes the streaming buffer.
-	 * It clears the memory allocated to doubly linked list and resets class member variables.
+	 * It releases the memory block and resets class member variables.
 	 */
 	void deinit(void);
 
 	/**
 	 * @brief Writes a row into streaming buffer.
-	 * Last node is detached and attached at the starting of the linked list. Values are then written in that node.
+	 * The oldest row is reused as the latest row. Values are then written in that row.
 	 * @param [in] buffer: Input buffer from which data values are copied.
 	 * @param [in] size: Number of values in input buffer.
 	 * @return: AIFW_RESULT enum object.
@@ -135,21 +154,35 @@ private:
 	AIFW_RESULT deleteData(uint16_t row);
 
 	/**
-	 * @brief Clears the memory allocated to the list with head pointer equal to ptr.
-	 * @param [in] ptr: Pointer to the head of list.
+	 * @brief Hides the latest rows, so that the row before them is read and written as the 0th index row again.
+	 * It lets a model complete a sample after rows of the following samples are written.
+	 * @param [in] count: Number of latest rows to hide.
+	 * @return: AIFW_RESULT enum object. AIFW_INVALID_ARG if no row would be left.
 	 */
-	void clearMemory(AIDataBufferNode *ptr);
+	AIFW_RESULT holdRows(uint16_t count);
 
 	/**
-	 * @brief Insert count number of nodes in a doubly linked list.
-	 * @param [in] count: Number of nodes in the list.
-	 * @param [in] size: Number of values in a single node.
-	 * @return: AIFW_RESULT enum object.
+	 * @brief Shows the rows hidden by holdRows() again.
+	 * @param [in] count: Number of rows passed to holdRows().
+	 */
+	void releaseRows(uint16_t count);
+
+	/**
+	 * @brief Gives the values of a row.
+	 * @param [in] row: Index of row, 0 being latest row. It may exceed the number of filled rows.
+	 * @return: Pointer to the values of the row in the memory block.
+	 */
+	float *getRow(uint16_t row);
+
+	/**
+	 * @brief Marks count rows empty starting from row offset and moves them to the end of the streaming buffer.
+	 * @param [IN] offset: Offset of row to start clearing.
+	 * @param [IN] count: Count of rows to clear.
 	 */
-	AIFW_RESULT createList(uint16_t count, uint16_t size);
+	void removeRows(uint16_t offset, uint16_t count);
 
-	AIDataBufferNode *mStart;
-	AIDataBufferNode *mEnd;
+	float *mData;
+	uint16_t mTail;
 	uint16_t mMaxRows;
 	uint16_t mRowSize;
 	uint16_t mRowCount;
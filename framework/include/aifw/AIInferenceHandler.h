@@ -22,8 +22,13 @@
 
 #pragma once
 
+#include <tinyara/config.h>
 #include <stdlib.h>
+#ifdef CONFIG_AIFW_PARALLEL_INFERENCE
+#include <pthread.h>
+#endif
 #include "aifw/aifw.h"
+#include "aifw/aifw_timer.h"
 #include "aifw/AIModel.h"
 
 namespace aifw {
@@ -45,13 +50,22 @@ public:
 
 	/**
 	 * @brief AIInferenceHandler destructor
+	 * It does not wait for inference workers: call stop() before the handler is destroyed.
 	 */
-	virtual ~AIInferenceHandler()
-	{
-	}
+	virtual ~AIInferenceHandler();
+
+	/**
+	 * @brief Waits for the inference cycles in progress and stops the inference workers.
+	 * Workers call onInferenceFinished() of the derived class, so with CONFIG_AIFW_PARALLEL_INFERENCE a derived class
+	 * must call it from its own destructor at the latest. Later pushData calls run the models in sequence.
+	 * It does nothing if parallel inference is not enabled, and may be called more than once.
+	 */
+	void stop(void);
 
 	/**
 	 * @brief Pushes incoming raw data to all attached models for pre-processing, invoke, post processing and finally ensembling.
+	 * With parallel inference enabled, it returns once the data is pre-processed in every model; the models then run on the
+	 * inference workers and the result listener is called from a worker thread.
 	 * @param [in] data: Incoming sensor data to be passed for inference.
 	 * @param [in] count: Length of incoming sensor data array.
 	 * @return: AIFW_RESULT enum object.
@@ -64,6 +78,12 @@ public:
 	 */
 	uint16_t getModelServiceInterval(void);
 
+	/**
+	 * @brief Gives latency statistics of the inference cycles, from pushData until the final result is ready.
+	 * @param [out] latency: Latency statistics in microseconds.
+	 */
+	void getLatency(aifw_latency *latency);
+
 	/**
 	 * @brief It creates process handler object specific to model and pass them as an argument while creating AIModel object.
 	 * Process handler does not need to be created if model does not require parsing, pre/post processing of data.
@@ -110,11 +130,55 @@ protected:
 	 */
 	void attachModel(std::shared_ptr<AIModel> model);
 
+#ifdef CONFIG_AIFW_PARALLEL_INFERENCE
+	/**
+	 * @brief Runs the attached models concurrently on a pool of worker threads.
+	 * It is enabled by default with CONFIG_AIFW_PARALLEL_INFERENCE, the workers start with the first pushData.
+	 * Only for model sets whose models do not depend on each other: every model receives each sample, and
+	 * AIFW_INFERENCE_FINISHED of a model no longer stops the following models. While the workers invoke sample N,
+	 * pushData parses and pre-processes sample N+1, before the invoke output of sample N is in the data buffer.
+	 * A handler whose models or pre-processing do not allow this calls it with false from prepare().
+	 * @param [in] enable: true to run models concurrently, false to run them in sequence.
+	 * @return: AIFW_RESULT enum object.
+	 */
+	AIFW_RESULT setParallelInference(bool enable);
+#endif
+
 private:
+	AIFW_RESULT allocateResult(void);
+	void finishInference(AIFW_RESULT res, uint16_t idx, uint64_t start);
+#ifdef CONFIG_AIFW_PARALLEL_INFERENCE
+	AIFW_RESULT pushDataParallel(void *data, uint16_t count, uint64_t start);
+	void waitIdle(void);
+	void stopWorkers(void);
+	void workerLoop(void);
+	static void *workerThread(void *arg);
+#endif
+
 	uint16_t mMaxModelsCount;
 	uint16_t mModelIndex;
 	std::shared_ptr<std::shared_ptr<AIModel>> mModels;
 	InferenceResultListener mInferenceResultListener;
+	float *mResult;
+	uint16_t mResultCount;
+	aifw_latency mLatency;
+#ifdef CONFIG_AIFW_PARALLEL_INFERENCE
+	bool mParallel;
+	bool mParallelDisabled;
+	bool mStopWorkers;
+	pthread_t mWorkers[CONFIG_AIFW_INFERENCE_WORKERS];
+	uint16_t mWorkerCount;
+	pthread_mutex_t mLock;
+	pthread_cond_t mCond;
+	AIFW_RESULT *mBufferResults; /* bufferData() result of each model for the sample being pushed */
+	AIFW_RESULT *mSampleResults; /* result of each model for the sample being run */
+	uint16_t *mJobs;
+	uint16_t mJobCount;
+	uint16_t mNextJob;
+	uint16_t mRemaining;
+	bool mSamplePending;
+	uint64_t mSampleStart;
+#endif
 };
 
 } /* namespace aifw */
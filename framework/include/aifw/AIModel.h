@@ -20,6 +20,9 @@
 
 #include "tinyara/config.h"
 #include <memory>
+#ifdef CONFIG_AIFW_PARALLEL_INFERENCE
+#include <pthread.h>
+#endif
 #include "aifw/aifw.h"
 
 namespace aifw {
@@ -78,6 +81,45 @@ public:
 	 */
 	AIFW_RESULT pushData(void *data, uint16_t count);
 
+	/**
+	 * @brief Parses incoming raw data and writes it to the data buffer, without running inference.
+	 * pushData() is bufferData() followed by runInference().
+	 * @param [in] data: Incoming sensor data to be passed for inference.
+	 * @param [in] count: Length of incoming sensor data array.
+	 * @return: AIFW_RESULT enum object. AIFW_INFERENCE_PROCEEDING means more data is needed before inference.
+	 */
+	AIFW_RESULT bufferData(void *data, uint16_t count);
+
+	/**
+	 * @brief Runs pre-processing, invoke, and post-processing on the data buffered by bufferData().
+	 * @return: AIFW_RESULT enum object.
+	 */
+	AIFW_RESULT runInference(void);
+
+#ifdef CONFIG_AIFW_PARALLEL_INFERENCE
+	/**
+	 * @brief Parses incoming raw data, writes it to the data buffer and pre-processes it into a staged model input.
+	 * The model input is double-buffered, so it may run while the previous sample is invoked by runStagedInference().
+	 * Pre-processing then runs before the invoke output of the previous sample is written to the data buffer.
+	 * @param [in] data: Incoming sensor data to be passed for inference.
+	 * @param [in] count: Length of incoming sensor data array.
+	 * @return: AIFW_RESULT enum object. AIFW_INFERENCE_PROCEEDING means more data is needed before inference.
+	 */
+	AIFW_RESULT stageData(void *data, uint16_t count);
+
+	/**
+	 * @brief Hands the input staged by stageData() over to the next runStagedInference().
+	 * It must not be called before the previous runStagedInference() returned.
+	 */
+	void commitStage(void);
+
+	/**
+	 * @brief Invokes the model with the input committed by commitStage() and runs post-processing.
+	 * @return: AIFW_RESULT enum object.
+	 */
+	AIFW_RESULT runStagedInference(void);
+#endif
+
 	/**
 	 * @brief Gives AIModelAttribute structure variable containing model attributes.
 	 * @return: Returns mModelAttribute.
@@ -140,6 +182,58 @@ private:
 	 */
 	AIFW_RESULT invoke(void);
 
+	/**
+	 * @brief Without a data processor, it copies the latest windowSize buffer rows into the engine input sets.
+	 * @param [out] inputs: Engine input sets.
+	 * @param [in] inputSetCount: Number of input sets.
+	 * @param [in] inputSizes: Size of each input set.
+	 * @return: AIFW_INFERENCE_PROCEEDING until the window is filled, else AIFW_RESULT enum object.
+	 */
+	AIFW_RESULT readWindow(float **inputs, uint16_t inputSetCount, const uint16_t *inputSizes);
+
+#ifdef CONFIG_AIFW_MULTI_INOUT_SUPPORT
+	/**
+	 * @brief Fills the model input sets: pre-processed data, the window or the latest buffer row.
+	 * @param [out] inputs: Model input sets.
+	 * @return: AIFW_RESULT enum object.
+	 */
+	AIFW_RESULT prepareInput(float **inputs);
+
+	/**
+	 * @brief Keeps the invoke result, writes it to the data buffer and runs post-processing.
+	 * @param [in] invokeResult: Output sets of the engine.
+	 * @return: AIFW_RESULT enum object.
+	 */
+	AIFW_RESULT completeInvoke(float **invokeResult);
+#else
+	/**
+	 * @brief Fills the model input: pre-processed data, the window or the latest buffer row.
+	 * @param [out] input: Model input.
+	 * @return: AIFW_RESULT enum object.
+	 */
+	AIFW_RESULT prepareInput(float *input);
+
+	/**
+	 * @brief Keeps the invoke result, writes it to the data buffer and runs post-processing.
+	 * @param [in] invokeResult: Output of the engine.
+	 * @return: AIFW_RESULT enum object.
+	 */
+	AIFW_RESULT completeInvoke(float *invokeResult);
+#endif
+
+#ifdef CONFIG_AIFW_PARALLEL_INFERENCE
+	/**
+	 * @brief Initializes the staged model input, its buffers are allocated by allocateStage() on first use.
+	 */
+	void initStage(void);
+
+	/**
+	 * @brief Allocates the two staged model input buffers.
+	 * @return: AIFW_RESULT enum object.
+	 */
+	AIFW_RESULT allocateStage(void);
+#endif
+
 	/**
 	 * @brief It loads manifest information from file specified by scriptPath and fills it into mModelAttribute's member variables.
 	 * @param [in] path: Manifest file path.
@@ -169,10 +263,9 @@ private:
 	std::shared_ptr<AIDataBuffer> mBuffer;
 	std::shared_ptr<AIEngine> mAIEngine;
 #ifndef CONFIG_AIFW_MULTI_INOUT_SUPPORT
-	float *mInvokeInput;
 	float *mInvokeOutput;
 #else
-	float **mInvokeInput;
+	float **mInvokeInput; /* per input set, points to the engine input or into the data buffer */
 	float **mInvokeOutput;
 	float **mInvokeResult;
 	uint16_t *mInputSizeList;
@@ -184,6 +277,17 @@ private:
 	float *mParsedData;
 	float *mPostProcessedData;
 	std::shared_ptr<AIProcessHandler> mDataProcessor;
+#ifdef CONFIG_AIFW_PARALLEL_INFERENCE
+	pthread_mutex_t mStageLock; /* serializes the data buffer between stageData() and completion of the invoked sample */
+	float *mStageData[2];
+#ifdef CONFIG_AIFW_MULTI_INOUT_SUPPORT
+	float **mStageInput[2]; /* per input set, points into mStageData */
+#endif
+	uint16_t mStageNext; /* stage filled by stageData() */
+	uint16_t mStageRun; /* stage read by runStagedInference() */
+	uint16_t mRowsAhead; /* rows written to the data buffer after the sample being invoked */
+	bool mStageInFlight;
+#endif
 };
 
 } /* namespace aifw */
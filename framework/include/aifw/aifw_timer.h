@@ -18,6 +18,7 @@
 
 #pragma once
 
+#include <stdint.h>
 #include <time.h>
 #include <semaphore.h>
 
@@ -118,3 +119,34 @@ aifw_timer_result aifw_timer_stop(aifw_timer *timer);
 */
 aifw_timer_result aifw_timer_destroy(aifw_timer *timer);
 
+/**
+ * @brief This structure keeps latency statistics of an operation in microseconds.
+ * count: Number of measured operations.
+ * last: Latency of last operation.
+ * min, max: Lowest and highest latency.
+ * total: Sum of all latencies, total / count is the average.
+*/
+struct aifw_latency {
+	uint32_t count;
+	uint32_t last;
+	uint32_t min;
+	uint32_t max;
+	uint64_t total;
+};
+
+/**
+ * @brief get current time in microseconds, to be used as start time of a latency measurement
+ *
+ * @return current time in microseconds
+*/
+uint64_t aifw_timer_get_usec(void);
+
+/**
+ * @brief add latency of an operation which started at 'start' and ends now
+ *
+ * @param[in] latency  :  pointer to a aifw_latency structure object, zero-filled before first use
+ * @param[in] start    :  start time of operation from aifw_timer_get_usec
+ *
+ * @return latency of operation in microseconds
+*/
+uint32_t aifw_latency_update(aifw_latency *latency, uint64_t start);
@@ -16,9 +16,10 @@
  *
  ****************************************************************************/
 
+#include <errno.h>
+#include <string.h>
 #include "aifw/aifw_log.h"
 #include "aifw/AIDataBuffer.h"
-#include "include/AIDataBufferNode.h"
 #define _UNLOCK                                    \
 	{                                              \
 		int status = pthread_mutex_unlock(&mLock); \
@@ -54,8 +55,11 @@
 
 namespace aifw {
 
+/* Size of the per-row list node which used to hold each row: empty flag, data pointer and two links. */
+#define AIFW_DATABUFFER_NODE_SIZE (4 * sizeof(void *))
+
 AIDataBuffer::AIDataBuffer() :
-	mStart(NULL), mEnd(NULL), mMaxRows(0), mRowSize(0), mRowCount(0), mLock(PTHREAD_MUTEX_INITIALIZER)
+	mData(NULL), mTail(0), mMaxRows(0), mRowSize(0), mRowCount(0), mLock(PTHREAD_MUTEX_INITIALIZER)
 {
 	AIFW_LOGV("AIDataBuffer Constructor");
 }
@@ -69,13 +73,22 @@ AIDataBuffer::~AIDataBuffer()
 AIFW_RESULT AIDataBuffer::init(uint16_t row, uint16_t size)
 {
 	_LOCK
-	AIFW_RESULT ret = createList(row, size);
-	if (ret == AIFW_OK) {
-		mMaxRows = row;
-		mRowSize = size;
+	float *data = (float *)calloc((size_t)row * size, sizeof(float));
+	if (!data && row != 0 && size != 0) {
+		AIFW_LOGE("buffer creation failed with errno %d, error message: %s", errno, strerror(errno));
+		_UNLOCK
+		return AIFW_NO_MEM;
 	}
+	free(mData);
+	mData = data;
+	mTail = 0;
+	mRowCount = 0;
+	mMaxRows = row;
+	mRowSize = size;
+	AIFW_LOGI("%d rows of %d values in one block of %zu bytes, saved %d allocations and %zu bytes of row nodes",
+		row, size, (size_t)row * size * sizeof(float), (row ? 2 * row - 1 : 0), (size_t)row * AIFW_DATABUFFER_NODE_SIZE);
 	_UNLOCK
-	return ret;
+	return AIFW_OK;
 }
 
 AIFW_RESULT AIDataBuffer::reinit(uint16_t row, uint16_t size)
@@ -84,63 +97,85 @@ AIFW_RESULT AIDataBuffer::reinit(uint16_t row, uint16_t size)
 		return AIFW_OK;
 	}
 	_LOCK
-	if (size != mRowSize) {
-		AIDataBufferNode *tempNode = mStart;
-		float *tempPtr = nullptr;
-		while (tempNode) {
-			tempPtr = (float *)realloc(tempNode->mData, size * sizeof(float));
-			if (!tempPtr) {
-				AIFW_LOGE("node creation failed with errno %d, error message: %s", errno, strerror(errno));
-				_UNLOCK
-				return AIFW_NO_MEM;
-			}
-			tempNode->mData = tempPtr;
-			tempNode = tempNode->mNext;
-		}
-	}
-	if (row > mMaxRows) {
-		AIFW_RESULT ret = createList(row - mMaxRows, size);
-		if (ret == AIFW_OK) {
-			mMaxRows = row;
-			mRowSize = size;
-		}
+	/* Rows are never dropped, only added */
+	uint16_t maxRows = (row > mMaxRows) ? row : mMaxRows;
+	float *data = (float *)calloc((size_t)maxRows * size, sizeof(float));
+	if (!data && maxRows != 0 && size != 0) {
+		AIFW_LOGE("buffer creation failed with errno %d, error message: %s", errno, strerror(errno));
 		_UNLOCK
-		return ret;
+		return AIFW_NO_MEM;
+	}
+	/* Move filled rows to the new block, oldest row first */
+	uint16_t columns = (size < mRowSize) ? size : mRowSize;
+	for (uint16_t i = 0; i < mRowCount; i++) {
+		memcpy(data + (size_t)(mRowCount - 1 - i) * size, getRow(i), columns * sizeof(float));
 	}
+	free(mData);
+	mData = data;
+	mTail = (maxRows != 0) ? (mRowCount % maxRows) : 0;
+	mMaxRows = maxRows;
 	mRowSize = size;
+	AIFW_LOGI("%d rows of %d values in one block of %zu bytes", mMaxRows, mRowSize, (size_t)mMaxRows * mRowSize * sizeof(float));
 	_UNLOCK
 	return AIFW_OK;
 }
 
 void AIDataBuffer::deinit(void)
 {
-	clearMemory(mStart);
-	mStart = NULL;
-	mEnd = NULL;
+	free(mData);
+	mData = NULL;
+	mTail = 0;
 	mRowSize = 0;
 	mMaxRows = 0;
 	mRowCount = 0;
 }
 
-void AIDataBuffer::clearMemory(AIDataBufferNode *ptr)
+float *AIDataBuffer::getRow(uint16_t row)
 {
-	AIDataBufferNode *current = ptr;
-	AIDataBufferNode *temp = ptr;
-	while (current) {
-		temp = current->mNext;
-		delete current;
-		current = temp;
+	/* Rows are stored oldest to latest, mTail being the next row to write */
+	uint32_t index = ((uint32_t)mTail + mMaxRows - 1 - (row % mMaxRows)) % mMaxRows;
+	return mData + (size_t)index * mRowSize;
+}
+
+void AIDataBuffer::removeRows(uint16_t offset, uint16_t count)
+{
+	/* Older rows move up to fill the gap, freed rows become the oldest ones */
+	for (uint16_t i = offset; i + count < mRowCount; i++) {
+		memcpy(getRow(i), getRow(i + count), mRowSize * sizeof(float));
+	}
+	for (uint16_t i = mRowCount - count; i < mRowCount; i++) {
+		memset(getRow(i), '\0', mRowSize * sizeof(float));
 	}
+	mRowCount -= count;
+}
+
+AIFW_RESULT AIDataBuffer::holdRows(uint16_t count)
+{
+	if (count >= mRowCount) {
+		AIFW_LOGE("Invalid argument - hold rows %d row count %d", count, mRowCount);
+		return AIFW_INVALID_ARG;
+	}
+	_LOCK
+	/* Hidden rows keep their values, only the ring tail moves back */
+	mTail = ((uint32_t)mTail + mMaxRows - count) % mMaxRows;
+	mRowCount -= count;
+	_UNLOCK
+	return AIFW_OK;
+}
+
+void AIDataBuffer::releaseRows(uint16_t count)
+{
+	pthread_mutex_lock(&mLock);
+	mTail = ((uint32_t)mTail + count) % mMaxRows;
+	mRowCount += count;
+	pthread_mutex_unlock(&mLock);
 }
 
 AIFW_RESULT AIDataBuffer::clear(void)
 {
 	_LOCK
-	AIDataBufferNode *current = mStart;
-	while (current) {
-		current->mIsEmpty = true;
-		memset(current->mData, '\0', mRowSize * sizeof(float));
-		current = current->mNext;
+	if (mData) {
+		memset(mData, '\0', (size_t)mMaxRows * mRowSize * sizeof(float));
 	}
 	mRowCount = 0;
 	_UNLOCK
@@ -158,82 +193,11 @@ AIFW_RESULT AIDataBuffer::clear(uint16_t offset, uint16_t count)
 		return AIFW_INVALID_ARG;
 	}
 	_LOCK
-	AIDataBufferNode *current = mStart;
-	uint16_t i = 0;
-	while (i < offset) {
-		current = current->mNext;
-		i++;
-	}
-	AIDataBufferNode *firstNode = current;
-	AIDataBufferNode *prevToFirstNode = firstNode->mPrev;
-
-	i = 0;
-	while (i < count - 1) {
-		current->mIsEmpty = true;
-		memset(current->mData, '\0', mRowSize * sizeof(float));
-		current = current->mNext;
-		i++;
-	}
-	current->mIsEmpty = true;
-	memset(current->mData, '\0', mRowSize * sizeof(float));
-	mRowCount -= count;
-	AIDataBufferNode *lastNode = current;
-	AIDataBufferNode *nextToLastNode = lastNode->mNext;
-
-	if (!nextToLastNode) {
-		_UNLOCK;
-		return AIFW_OK;
-	} else if (!prevToFirstNode) {
-		mStart = nextToLastNode;
-	} else {
-		prevToFirstNode->mNext = nextToLastNode;
-	}
-	nextToLastNode->mPrev = prevToFirstNode;
-	lastNode->mNext = NULL;
-	firstNode->mPrev = mEnd;
-	mEnd->mNext = firstNode;
-	mEnd = lastNode;
+	removeRows(offset, count);
 	_UNLOCK
 	return AIFW_OK;
 }
 
-AIFW_RESULT AIDataBuffer::createList(uint16_t count, uint16_t size)
-{
-	AIDataBufferNode *newNode = nullptr;
-	AIDataBufferNode *firstNode = nullptr;
-	AIDataBufferNode *lastNode = nullptr;
-	for (uint16_t i = 0; i < count; i++) {
-		newNode = new AIDataBufferNode(size);
-		if (!newNode || !newNode->mData) {
-			AIFW_LOGE("node creation failed with errno %d, error message: %s", errno, strerror(errno));
-			if (newNode) {
-				delete newNode;
-			}
-			clearMemory(firstNode);
-			return AIFW_NO_MEM;
-		}
-		if (firstNode == NULL) {
-			firstNode = newNode;
-			lastNode = newNode;
-		} else {
-			lastNode->mNext = newNode;
-			newNode->mPrev = lastNode;
-			lastNode = newNode;
-		}
-	}
-	if (!mStart) {
-		mStart = firstNode;
-		mEnd = lastNode;
-		return AIFW_OK;
-	}
-	mEnd->mNext = firstNode;
-	if (firstNode) {
-		firstNode->mPrev = mEnd;
-		mEnd = lastNode;
-	}
-	return AIFW_OK;
-}
-
 AIFW_RESULT AIDataBuffer::readData(float *buffer, uint16_t row)
 {
 	if (buffer == NULL) {
@@ -245,13 +209,7 @@ AIFW_RESULT AIDataBuffer::readData(float *buffer, uint16_t row)
 		return AIFW_INVALID_ARG;
 	}
 	_LOCK
-	uint16_t temp = 0;
-	AIDataBufferNode *tempNode = mStart;
-	while (temp < row) {
-		tempNode = tempNode->mNext;
-		++temp;
-	}
-	memcpy(buffer, tempNode->mData, mRowSize * sizeof(float));
+	memcpy(buffer, getRow(row), mRowSize * sizeof(float));
 	DUMP_BUFFER("buffer read done, values: ", mRowSize, buffer, 0)
 	_UNLOCK;
 	return AIFW_OK;
@@ -276,18 +234,43 @@ AIFW_RESULT AIDataBuffer::readData(float *buffer, uint16_t startCol, uint16_t en
 		return AIFW_INVALID_ARG;
 	}
 	_LOCK
-	uint16_t temp = 0;
-	AIDataBufferNode *tempNode = mStart;
-	while (temp < row) {
-		tempNode = tempNode->mNext;
-		++temp;
-	}
-	memcpy(buffer, (tempNode->mData + startCol), (endCol - startCol) * sizeof(float));
+	memcpy(buffer, (getRow(row) + startCol), (endCol - startCol) * sizeof(float));
 	DUMP_BUFFER("buffer read done, values: ", endCol - startCol, buffer, 0)
 	_UNLOCK;
 	return AIFW_OK;
 }
 
+const float *AIDataBuffer::getRowView(uint16_t row)
+{
+	if (row >= mRowCount) {
+		AIFW_LOGE("Invalid argument - row index %d row count %d", row, mRowCount);
+		return NULL;
+	}
+	return getRow(row);
+}
+
+AIFW_RESULT AIDataBuffer::getWindowView(uint16_t count, const float **first, uint16_t *firstRows, const float **second)
+{
+	if (first == NULL || firstRows == NULL || second == NULL) {
+		AIFW_LOGE("Invalid argument - output view");
+		return AIFW_INVALID_ARG;
+	}
+	if (count == 0 || count > mRowCount) {
+		AIFW_LOGE("Invalid argument - window rows %d row count %d", count, mRowCount);
+		return AIFW_INVALID_ARG;
+	}
+	uint16_t start = ((uint32_t)mTail + mMaxRows - count) % mMaxRows;
+	*first = mData + (size_t)start * mRowSize;
+	if (start + count <= mMaxRows) {
+		*firstRows = count;
+		*second = NULL;
+	} else {
+		*firstRows = mMaxRows - start;
+		*second = mData;
+	}
+	return AIFW_OK;
+}
+
 AIFW_RESULT AIDataBuffer::writeData(float *buffer, uint16_t size)
 {
 	if (buffer == NULL) {
@@ -300,18 +283,10 @@ AIFW_RESULT AIDataBuffer::writeData(float *buffer, uint16_t size)
 	}
 	DUMP_BUFFER("buffer write operation, values: ", size, buffer, 0)
 	_LOCK
-	if (mStart != mEnd) {
-		AIDataBufferNode *last = mEnd;
-		mEnd = last->mPrev;
-		mEnd->mNext = NULL;
-		last->mPrev = NULL;
-		last->mNext = mStart;
-		mStart->mPrev = last;
-		mStart = last;
-	}
-	memcpy(mStart->mData, buffer, size * sizeof(float));
-	DUMP_BUFFER("buffer write operation done, values: ", size, mStart->mData, 0)
-	mStart->mIsEmpty = false;
+	float *row = mData + (size_t)mTail * mRowSize;
+	memcpy(row, buffer, size * sizeof(float));
+	DUMP_BUFFER("buffer write operation done, values: ", size, row, 0)
+	mTail = (mTail + 1) % mMaxRows;
 	if (mRowCount < mMaxRows) {
 		++mRowCount;
 	}
@@ -332,8 +307,9 @@ AIFW_RESULT AIDataBuffer::writeData(float *buffer, uint16_t size, uint16_t offse
 	}
 	DUMP_BUFFER("buffer write operation, values: ", size, buffer, 0)
 	_LOCK
-	memcpy((mStart->mData + offset), buffer, size * sizeof(float));
-	DUMP_BUFFER("buffer write operation done, values: ", size, mStart->mData, offset)
+	float *row = getRow(0);
+	memcpy((row + offset), buffer, size * sizeof(float));
+	DUMP_BUFFER("buffer write operation done, values: ", size, row, offset)
 	AIFW_LOGI("resultData Written");
 	_UNLOCK
 	return AIFW_OK;
@@ -346,30 +322,7 @@ AIFW_RESULT AIDataBuffer::deleteData(uint16_t row)
 		return AIFW_INVALID_ARG;
 	}
 	_LOCK
-	AIDataBufferNode *current = mStart;
-	uint16_t i = 0;
-	while (i < row) {
-		current = current->mNext;
-		i++;
-	}
-	memset(current->mData, 0, mRowSize * sizeof(float));
-	current->mIsEmpty = true;
-	mRowCount--;
-	AIDataBufferNode *nextToCurrent = current->mNext;
-	AIDataBufferNode *prevToCurrent = current->mPrev;
-	if (nextToCurrent == NULL) {
-		_UNLOCK
-		return AIFW_OK;
-	} else if (prevToCurrent == NULL) {
-		mStart = nextToCurrent;
-	} else {
-		prevToCurrent->mNext = nextToCurrent;
-	}
-	nextToCurrent->mPrev = prevToCurrent;
-	current->mNext = NULL;
-	current->mPrev = mEnd;
-	mEnd->mNext = current;
-	mEnd = current;
+	removeRows(row, 1);
 	_UNLOCK
 	return AIFW_OK;
 }
@@ -380,4 +333,3 @@ uint16_t AIDataBuffer::getRowCount()
 }
 
 } // namespace aifw
-
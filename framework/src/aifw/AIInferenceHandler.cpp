@@ -16,9 +16,10 @@
  *
  ****************************************************************************/
 
+#include <string.h>
 #include "aifw/aifw.h"
 #include "aifw/aifw_log.h"
-#include "aifw/AIInferenceHandler.h"	
+#include "aifw/AIInferenceHandler.h"
 
 namespace aifw {
 
@@ -37,8 +38,44 @@ struct _arrayDeleter {
 AIInferenceHandler::AIInferenceHandler(uint16_t countOfModels, InferenceResultListener listener) :
 	mMaxModelsCount(countOfModels), mModelIndex(0),
 	mModels(new std::shared_ptr<AIModel>[mMaxModelsCount], _arrayDeleter<std::shared_ptr<AIModel>>()),
-	mInferenceResultListener(listener)
+	mInferenceResultListener(listener), mResult(NULL), mResultCount(0)
+#ifdef CONFIG_AIFW_PARALLEL_INFERENCE
+	, mParallel(false), mParallelDisabled(false), mStopWorkers(false), mWorkerCount(0), mBufferResults(NULL), mSampleResults(NULL),
+	mJobs(NULL), mJobCount(0), mNextJob(0), mRemaining(0), mSamplePending(false), mSampleStart(0)
+#endif
 {
+	memset(&mLatency, 0, sizeof(mLatency));
+#ifdef CONFIG_AIFW_PARALLEL_INFERENCE
+	pthread_mutex_init(&mLock, NULL);
+	pthread_cond_init(&mCond, NULL);
+#endif
+}
+
+AIInferenceHandler::~AIInferenceHandler()
+{
+#ifdef CONFIG_AIFW_PARALLEL_INFERENCE
+	/* The derived part is already destroyed here, workers must have been stopped by stop() */
+	if (mParallel) {
+		AIFW_LOGE("inference workers still running, stop() was not called before destruction");
+	}
+	pthread_cond_destroy(&mCond);
+	pthread_mutex_destroy(&mLock);
+	delete[] mBufferResults;
+	delete[] mSampleResults;
+	delete[] mJobs;
+#endif
+	if (mResult) {
+		delete[] mResult;
+		mResult = NULL;
+	}
+}
+
+void AIInferenceHandler::stop(void)
+{
+#ifdef CONFIG_AIFW_PARALLEL_INFERENCE
+	mParallelDisabled = true;
+	stopWorkers();
+#endif
 }
 
 void AIInferenceHandler::attachModel(std::shared_ptr<AIModel> model)
@@ -51,22 +88,85 @@ uint16_t AIInferenceHandler::getModelServiceInterval(void)
 	return mModels.get()[0]->getModelAttribute().inferenceInterval;
 }
 
+void AIInferenceHandler::getLatency(aifw_latency *latency)
+{
+#ifdef CONFIG_AIFW_PARALLEL_INFERENCE
+	pthread_mutex_lock(&mLock);
+	*latency = mLatency;
+	pthread_mutex_unlock(&mLock);
+#else
+	*latency = mLatency;
+#endif
+}
+
+AIFW_RESULT AIInferenceHandler::allocateResult(void)
+{
+	/* The result buffer is allocated once and reused by every inference cycle */
+	if (mResult) {
+		return AIFW_OK;
+	}
+	mResultCount = mModels.get()[0]->getModelAttribute().inferenceResultCount;
+	mResult = new float[mResultCount];
+	if (!mResult) {
+		AIFW_LOGE("Memory Allocation failed for final result buffer");
+		return AIFW_NO_MEM;
+	}
+	return AIFW_OK;
+}
+
+void AIInferenceHandler::finishInference(AIFW_RESULT res, uint16_t idx, uint64_t start)
+{
+	memset(mResult, 0, mResultCount * sizeof(float));
+
+	/* Proper result of inference should be handled by onInferenceFinished to get final result */
+	if ((res == AIFW_OK) || (res == AIFW_INFERENCE_FINISHED)) {
+		res = onInferenceFinished(idx, (void *)mResult);
+		if (res != AIFW_OK) {
+			AIFW_LOGE("ensemble operation error: %d", res);
+		}
+	}
+
+#ifdef CONFIG_AIFW_PARALLEL_INFERENCE
+	pthread_mutex_lock(&mLock);
+#endif
+	uint32_t usec = aifw_latency_update(&mLatency, start);
+	AIFW_LOGD("inference latency %u us, min %u us, max %u us, avg %u us", usec, mLatency.min, mLatency.max, (uint32_t)(mLatency.total / mLatency.count));
+#ifdef CONFIG_AIFW_PARALLEL_INFERENCE
+	pthread_mutex_unlock(&mLock);
+#endif
+
+	/* Regardless type result, result will be shared through inferenceResultListener */
+	mInferenceResultListener(res, (void *)mResult, mResultCount);
+}
+
 AIFW_RESULT AIInferenceHandler::pushData(void *data, uint16_t count)
 {
 	if (!data) {
 		AIFW_LOGE("raw data argument is null");
 		return AIFW_INVALID_ARG;
 	}
+	uint64_t start = aifw_timer_get_usec();
 	AIFW_RESULT res;
 	uint16_t idx;
 
 	/* First create result buffer */
-	uint16_t inferenceResultCount = mModels.get()[0]->getModelAttribute().inferenceResultCount;
-	char *finalResult = new char[inferenceResultCount * sizeof(float)];
-	if (!finalResult) {
-		AIFW_LOGE("Memory Allocation failed for final result buffer");
-		return AIFW_NO_MEM;
+	res = allocateResult();
+	if (res != AIFW_OK) {
+		return res;
+	}
+
+#ifdef CONFIG_AIFW_PARALLEL_INFERENCE
+	if (!mParallel && !mParallelDisabled) {
+		/* Workers start with the first sample, prepare() has attached the models by then */
+		if (setParallelInference(true) != AIFW_OK) {
+			AIFW_LOGE("inference workers not started, models run in sequence");
+			mParallelDisabled = true;
+		}
+	}
+	if (mParallel) {
+		return pushDataParallel(data, count, start);
 	}
+#endif
 
 	/* Now inference each of model */
 	res = AIFW_OK;
@@ -89,31 +189,189 @@ AIFW_RESULT AIInferenceHandler::pushData(void *data, uint16_t count)
 
 	/* We do nothing if Inference is in progress */
 	if (res == AIFW_INFERENCE_PROCEEDING) {
-		delete[] finalResult;
-		finalResult = NULL;
 		return AIFW_OK;
 	}
 
-	/* Proper result of inference should be handled by onInferenceFinished to get final result */
-	if ((res == AIFW_OK) || (res == AIFW_INFERENCE_FINISHED)) {
-		res = onInferenceFinished(idx, (void *)finalResult);
-		if (res != AIFW_OK) {
-			AIFW_LOGE("ensemble operation error: %d", res);
+	finishInference(res, idx, start);
+	return AIFW_OK;
+}
+
+#ifdef CONFIG_AIFW_PARALLEL_INFERENCE
+AIFW_RESULT AIInferenceHandler::setParallelInference(bool enable)
+{
+	mParallelDisabled = !enable;
+	if (!enable) {
+		stopWorkers();
+		return AIFW_OK;
+	}
+	if (mParallel) {
+		return AIFW_OK;
+	}
+	if (mModelIndex == 0) {
+		AIFW_LOGE("No model attached");
+		return AIFW_ERROR;
+	}
+	if (!mBufferResults) {
+		mBufferResults = new AIFW_RESULT[mMaxModelsCount];
+		mSampleResults = new AIFW_RESULT[mMaxModelsCount];
+		mJobs = new uint16_t[mMaxModelsCount];
+		if (!mBufferResults || !mSampleResults || !mJobs) {
+			AIFW_LOGE("Memory Allocation failed for inference workers");
+			return AIFW_NO_MEM;
 		}
 	}
+	mJobCount = 0;
+	mNextJob = 0;
+	mRemaining = 0;
+	mSamplePending = false;
+	mStopWorkers = false;
 
-	/* Regardless type result, result will be shared through inferenceResultListener */
-	mInferenceResultListener(res, (void *)finalResult, inferenceResultCount);
-	if (finalResult) {
-		delete[] finalResult;
-		finalResult = NULL;
+	/* No more workers than models, a model runs on one worker at a time */
+	uint16_t workers = (mModelIndex < CONFIG_AIFW_INFERENCE_WORKERS) ? mModelIndex : CONFIG_AIFW_INFERENCE_WORKERS;
+	pthread_attr_t attr;
+	pthread_attr_init(&attr);
+	pthread_attr_setstacksize(&attr, CONFIG_AIFW_INFERENCE_WORKER_STACKSIZE);
+	for (mWorkerCount = 0; mWorkerCount < workers; mWorkerCount++) {
+		int status = pthread_create(&mWorkers[mWorkerCount], &attr, workerThread, this);
+		if (status != 0) {
+			AIFW_LOGE("inference worker %d creation failed, error: %d", mWorkerCount, status);
+			break;
+		}
+		pthread_setname_np(mWorkers[mWorkerCount], "aifw_worker");
+	}
+	pthread_attr_destroy(&attr);
+	if (mWorkerCount == 0) {
+		return AIFW_ERROR;
+	}
+	mParallel = true;
+	AIFW_LOGV("%d inference workers for %d models", mWorkerCount, mModelIndex);
+	return AIFW_OK;
+}
+
+void AIInferenceHandler::waitIdle(void)
+{
+	pthread_mutex_lock(&mLock);
+	while (mSamplePending) {
+		pthread_cond_wait(&mCond, &mLock);
+	}
+	pthread_mutex_unlock(&mLock);
+}
+
+void AIInferenceHandler::stopWorkers(void)
+{
+	if (!mParallel) {
+		return;
+	}
+	waitIdle();
+	pthread_mutex_lock(&mLock);
+	mStopWorkers = true;
+	pthread_cond_broadcast(&mCond);
+	pthread_mutex_unlock(&mLock);
+	for (uint16_t i = 0; i < mWorkerCount; i++) {
+		pthread_join(mWorkers[i], NULL);
+	}
+	mWorkerCount = 0;
+	mParallel = false;
+}
+
+AIFW_RESULT AIInferenceHandler::pushDataParallel(void *data, uint16_t count, uint64_t start)
+{
+	AIFW_RESULT res = AIFW_OK;
+	uint16_t idx;
+
+	/* Parse and pre-process the sample into the free input stage of each model,
+	 * while the workers may still invoke the previous sample.
+	 */
+	for (idx = 0; idx < mModelIndex; idx++) {
+		mBufferResults[idx] = mModels.get()[idx]->stageData(data, count);
+		if (mBufferResults[idx] < AIFW_OK) {
+			AIFW_LOGE("Push Data of model %d failed.", idx);
+			res = mBufferResults[idx];
+			break;
+		}
+	}
+
+	/* Results of the previous sample have to be ensembled before the models overwrite them */
+	pthread_mutex_lock(&mLock);
+	while (mSamplePending) {
+		pthread_cond_wait(&mCond, &mLock);
+	}
+	if (res < AIFW_OK) {
+		pthread_mutex_unlock(&mLock);
+		finishInference(res, idx, start);
+		return AIFW_OK;
+	}
+	mJobCount = 0;
+	for (idx = 0; idx < mModelIndex; idx++) {
+		mSampleResults[idx] = mBufferResults[idx];
+		if (mBufferResults[idx] == AIFW_OK) {
+			mModels.get()[idx]->commitStage();
+			mJobs[mJobCount++] = idx;
+		}
 	}
+	if (mJobCount == 0) {
+		/* Every model is collecting more data */
+		pthread_mutex_unlock(&mLock);
+		return AIFW_OK;
+	}
+	mNextJob = 0;
+	mRemaining = mJobCount;
+	mSampleStart = start;
+	mSamplePending = true;
+	pthread_cond_broadcast(&mCond);
+	pthread_mutex_unlock(&mLock);
 	return AIFW_OK;
 }
 
+void *AIInferenceHandler::workerThread(void *arg)
+{
+	((AIInferenceHandler *)arg)->workerLoop();
+	return NULL;
+}
+
+void AIInferenceHandler::workerLoop(void)
+{
+	pthread_mutex_lock(&mLock);
+	while (!mStopWorkers) {
+		if (mNextJob >= mJobCount) {
+			pthread_cond_wait(&mCond, &mLock);
+			continue;
+		}
+		uint16_t job = mJobs[mNextJob++];
+		pthread_mutex_unlock(&mLock);
+		AIFW_RESULT res = mModels.get()[job]->runStagedInference();
+		pthread_mutex_lock(&mLock);
+		mSampleResults[job] = res;
+		if (--mRemaining == 0) {
+			/* Last model of the sample, combine the results in model order like the sequential loop */
+			uint16_t idx;
+			res = AIFW_OK;
+			for (idx = 0; idx < mModelIndex; idx++) {
+				res = mSampleResults[idx];
+				if (res < AIFW_OK || res == AIFW_INFERENCE_FINISHED) {
+					break;
+				}
+			}
+			uint64_t start = mSampleStart;
+			pthread_mutex_unlock(&mLock);
+			if (res != AIFW_INFERENCE_PROCEEDING) {
+				finishInference(res, idx, start);
+			}
+			pthread_mutex_lock(&mLock);
+			mSamplePending = false;
+		}
+		pthread_cond_broadcast(&mCond);
+	}
+	pthread_mutex_unlock(&mLock);
+}
+#endif /* CONFIG_AIFW_PARALLEL_INFERENCE */
+
 AIFW_RESULT AIInferenceHandler::clearData(void)
 {
 	AIFW_RESULT res = AIFW_OK;
+#ifdef CONFIG_AIFW_PARALLEL_INFERENCE
+	waitIdle();
+#endif
 	for (uint16_t idx = 0; idx < mModelIndex; idx++) {
 		res = mModels.get()[idx]->clearRawData();
 	}
@@ -123,6 +381,9 @@ AIFW_RESULT AIInferenceHandler::clearData(void)
 AIFW_RESULT AIInferenceHandler::clearData(uint16_t offset, uint16_t count)
 {
 	AIFW_RESULT res = AIFW_OK;
+#ifdef CONFIG_AIFW_PARALLEL_INFERENCE
+	waitIdle();
+#endif
 	for (uint16_t idx = 0; idx < mModelIndex; idx++) {
 		res = mModels.get()[idx]->clearRawData(offset, count);
 	}
@@ -132,6 +393,9 @@ AIFW_RESULT AIInferenceHandler::clearData(uint16_t offset, uint16_t count)
 AIFW_RESULT AIInferenceHandler::resetInferenceState(void)
 {
 	AIFW_RESULT res = AIFW_OK;
+#ifdef CONFIG_AIFW_PARALLEL_INFERENCE
+	waitIdle();
+#endif
 	for (uint16_t idx = 0; idx < mModelIndex; idx++) {
 		res = mModels.get()[idx]->resetInferenceState();
 		if (res != AIFW_OK) {
@@ -143,4 +407,3 @@ AIFW_RESULT AIInferenceHandler::resetInferenceState(void)
 }
 
 } /* namespace aifw */
-
@@ -33,11 +33,14 @@ namespace aifw {
 
 AIModel::AIModel(void) :
 #ifdef CONFIG_AIFW_MULTI_INOUT_SUPPORT
-	mInvokeResult(NULL), mInputSizeList(NULL), mOutputSizeList(NULL), mInputSetCount(0), mOutputSetCount(0),
+	mInvokeInput(NULL), mInvokeResult(NULL), mInputSizeList(NULL), mOutputSizeList(NULL), mInputSetCount(0), mOutputSetCount(0),
 #endif
-	mInvokeInput(NULL), mInvokeOutput(NULL), mParsedData(NULL), mPostProcessedData(NULL), mDataProcessor(nullptr), mBuffer(nullptr)
+	mInvokeOutput(NULL), mParsedData(NULL), mPostProcessedData(NULL), mDataProcessor(nullptr), mBuffer(nullptr)
 {
 	memset(&mModelAttribute, '\0', sizeof(AIModelAttribute));
+#ifdef CONFIG_AIFW_PARALLEL_INFERENCE
+	initStage();
+#endif
 #ifdef CONFIG_AIFW_USE_ONERT_MICRO
 	mAIEngine = std::make_shared<ONERTM>();
 	AIFW_LOGE("Model Engine is OneRT");
@@ -52,11 +55,14 @@ AIModel::AIModel(void) :
 
 AIModel::AIModel(std::shared_ptr<AIProcessHandler> dataProcessor) :
 #ifdef CONFIG_AIFW_MULTI_INOUT_SUPPORT
-	mInvokeResult(NULL), mInputSizeList(NULL), mOutputSizeList(NULL), mInputSetCount(0), mOutputSetCount(0),
+	mInvokeInput(NULL), mInvokeResult(NULL), mInputSizeList(NULL), mOutputSizeList(NULL), mInputSetCount(0), mOutputSetCount(0),
 #endif
-	mInvokeInput(NULL), mInvokeOutput(NULL), mParsedData(NULL), mPostProcessedData(NULL), mDataProcessor(dataProcessor), mBuffer(nullptr)
+	mInvokeOutput(NULL), mParsedData(NULL), mPostProcessedData(NULL), mDataProcessor(dataProcessor), mBuffer(nullptr)
 {
 	memset(&mModelAttribute, '\0', sizeof(AIModelAttribute));
+#ifdef CONFIG_AIFW_PARALLEL_INFERENCE
+	initStage();
+#endif
 #ifdef CONFIG_AIFW_USE_ONERT_MICRO
 	mAIEngine = std::make_shared<ONERTM>();
 	AIFW_LOGE("Model Engine is OneRT");
@@ -93,23 +99,12 @@ AIModel::~AIModel()
 {
 	clearModelAttribute();
 #ifndef CONFIG_AIFW_MULTI_INOUT_SUPPORT
-	if (mInvokeInput) {
-		delete[] mInvokeInput;
-		mInvokeInput = NULL;
-	}
-
 	if (mInvokeOutput) {
 		delete[] mInvokeOutput;
 		mInvokeOutput = NULL;
 	}
 #else
 	if (mInvokeInput) {
-		for (uint16_t i = 0; i < mInputSetCount; i++) {
-			if (mInvokeInput[i]) {
-				delete[] mInvokeInput[i];
-				mInvokeInput[i] = NULL;
-			}
-		}
 		delete[] mInvokeInput;
 		mInvokeInput = NULL;
 	}
@@ -139,6 +134,15 @@ AIModel::~AIModel()
 		delete[] mPostProcessedData;
 		mPostProcessedData = NULL;
 	}
+#ifdef CONFIG_AIFW_PARALLEL_INFERENCE
+	for (int s = 0; s < 2; s++) {
+		delete[] mStageData[s];
+#ifdef CONFIG_AIFW_MULTI_INOUT_SUPPORT
+		delete[] mStageInput[s];
+#endif
+	}
+	pthread_mutex_destroy(&mStageLock);
+#endif
 }
 
 AIFW_RESULT AIModel::createDataBuffer(void)
@@ -151,6 +155,13 @@ AIFW_RESULT AIModel::createDataBuffer(void)
 	}
 	if (mDataProcessor) {
 		res = mBuffer->init(mModelAttribute.maxRowsDataBuffer, (mModelAttribute.rawDataCount + mModelAttribute.invokeOutputCount));
+	} else if (mModelAttribute.windowSize > 1) {
+		/* Each row holds one sample and the engine input is the window of the latest windowSize rows */
+		if ((mModelAttribute.invokeInputCount % mModelAttribute.windowSize) != 0 || mModelAttribute.maxRowsDataBuffer < mModelAttribute.windowSize) {
+			AIFW_LOGE("window size %d does not fit invoke input count %d and buffer rows %d", mModelAttribute.windowSize, mModelAttribute.invokeInputCount, mModelAttribute.maxRowsDataBuffer);
+			return AIFW_INVALID_ATTRIBUTE;
+		}
+		res = mBuffer->init(mModelAttribute.maxRowsDataBuffer, mModelAttribute.invokeInputCount / mModelAttribute.windowSize);
 	} else {
 		res = mBuffer->init(mModelAttribute.maxRowsDataBuffer, (mModelAttribute.invokeInputCount + mModelAttribute.invokeOutputCount));
 	}
@@ -162,6 +173,45 @@ AIFW_RESULT AIModel::createDataBuffer(void)
 	return res;
 }
 
+AIFW_RESULT AIModel::readWindow(float **inputs, uint16_t inputSetCount, const uint16_t *inputSizes)
+{
+	if (mBuffer->getRowCount() < mModelAttribute.windowSize) {
+		AIFW_LOGV("collecting window, %d of %d rows", mBuffer->getRowCount(), mModelAttribute.windowSize);
+		return AIFW_INFERENCE_PROCEEDING;
+	}
+	const float *first;
+	const float *second;
+	uint16_t firstRows;
+	AIFW_RESULT res = mBuffer->getWindowView(mModelAttribute.windowSize, &first, &firstRows, &second);
+	if (res != AIFW_OK) {
+		AIFW_LOGE("Getting window from the buffer failed, error: %d", res);
+		return res;
+	}
+	/* Both parts of the window are copied once, straight into the input sets */
+	uint32_t firstCount = (uint32_t)firstRows * (mModelAttribute.invokeInputCount / mModelAttribute.windowSize);
+	uint32_t offset = 0;
+	for (uint16_t i = 0; i < inputSetCount; i++) {
+		uint32_t size = inputSizes[i];
+		if (offset + size > mModelAttribute.invokeInputCount) {
+			AIFW_LOGE("input sets are larger than window, invoke input count %d", mModelAttribute.invokeInputCount);
+			return AIFW_INVALID_ATTRIBUTE;
+		}
+		float *dst = inputs[i];
+		if (offset < firstCount) {
+			uint32_t n = (firstCount - offset < size) ? (firstCount - offset) : size;
+			memcpy(dst, first + offset, n * sizeof(float));
+			dst += n;
+			offset += n;
+			size -= n;
+		}
+		if (size > 0) {
+			memcpy(dst, second + (offset - firstCount), size * sizeof(float));
+			offset += size;
+		}
+	}
+	return AIFW_OK;
+}
+
 AIFW_RESULT AIModel::allocateMemory(void)
 {
 #ifndef CONFIG_AIFW_MULTI_INOUT_SUPPORT
@@ -170,11 +220,6 @@ AIFW_RESULT AIModel::allocateMemory(void)
 		AIFW_LOGE("Memory Allocation failed - model output buffer");
 		return AIFW_NO_MEM;
 	}
-	mInvokeInput = new float[mModelAttribute.invokeInputCount];
-	if (!mInvokeInput) {
-		AIFW_LOGE("Memory Allocation failed - model input buffer");
-		return AIFW_NO_MEM;
-	}
 #else
 	mAIEngine->getModelDimensions(&mInputSetCount, &mInputSizeList, &mOutputSetCount, &mOutputSizeList);
 	AIFW_LOGD("Model dimensions extracted");
@@ -198,17 +243,10 @@ AIFW_RESULT AIModel::allocateMemory(void)
 	AIFW_LOGD("model output memory allocated");
 	mInvokeInput = new float *[mInputSetCount];
 	if (!mInvokeInput) {
-		AIFW_LOGE("Memory Allocation failed - model input buffer");
+		AIFW_LOGE("Memory Allocation failed - model input list");
 		return AIFW_NO_MEM;
 	}
-	for (uint16_t i = 0; i < mInputSetCount; i++) {
-		mInvokeInput[i] = new float[mInputSizeList[i]];
-		if (!mInvokeInput[i]) {
-			AIFW_LOGE("Memory Allocation failed - model input buffer");
-			return AIFW_NO_MEM;
-		}
-	}
-	AIFW_LOGD("model input memory allocated");
+	AIFW_LOGD("model input list allocated");
 #endif /* CONFIG_AIFW_MULTI_INOUT_SUPPORT */
 	if (mDataProcessor) {
 		mParsedData = new float[mModelAttribute.rawDataCount];
@@ -367,56 +405,56 @@ AIFW_RESULT AIModel::loadModel(const AIModelAttribute &modelAttribute)
 }
 
 #ifdef CONFIG_AIFW_MULTI_INOUT_SUPPORT
-AIFW_RESULT AIModel::invoke(void)
+AIFW_RESULT AIModel::prepareInput(float **inputs)
 {
 	AIFW_RESULT res;
-	int outputOffset = 0; /* to write 2d output in 1d buffer. */
-	float **invokeResult = new float *[mOutputSetCount];
-	for (uint16_t i = 0; i < mInputSetCount; i++) {
-		memset(mInvokeInput[i], '\0', mInputSizeList[i] * sizeof(float));
-	}
-	for (uint16_t i = 0; i < mOutputSetCount; i++) {
-		memset(mInvokeOutput[i], '\0', mOutputSizeList[i] * sizeof(float));
-	}
 	if (mDataProcessor) {
-		AIFW_LOGV("data processor is set");
-		memset(mPostProcessedData, '\0', mModelAttribute.postProcessResultCount * sizeof(float));
-		res = mDataProcessor->preProcessData(mBuffer, mInputSetCount, mInvokeInput, &mModelAttribute);
-		if (res != AIFW_OK) {
-			AIFW_LOGE("preProcessData failed, error: %d", res);
-			return res;
-		}
-#ifdef CONFIG_AIFW_LOGV
-		printf("invoke Input\n");
 		for (uint16_t i = 0; i < mInputSetCount; i++) {
-			printf("inputset [%d]: ", i);
-			for (uint16_t j = 0; j < mInputSizeList[i]; j++) {
-				printf("%f,", mInvokeInput[i][j]);
-			}
-			printf("\n");
+			memset(inputs[i], '\0', mInputSizeList[i] * sizeof(float));
 		}
-#endif
-		res = mAIEngine->invoke(mInvokeInput, invokeResult);
+		res = mDataProcessor->preProcessData(mBuffer, mInputSetCount, inputs, &mModelAttribute);
 		if (res != AIFW_OK) {
-			AIFW_LOGE("Engine Invoke failed.");
-			return AIFW_ERROR;
+			AIFW_LOGE("preProcessData failed, error: %d", res);
 		}
-		AIFW_LOGV("invoke completed fine");
-		for (uint16_t i = 0; i < mOutputSetCount; i++) {
-			for (uint16_t j = 0; j < mOutputSizeList[i]; j++) {
-				mInvokeOutput[i][j] = invokeResult[i][j];
-			}
+		return res;
+	}
+	if (mModelAttribute.windowSize > 1) {
+		return readWindow(inputs, mInputSetCount, mInputSizeList);
+	}
+	const float *row = mBuffer->getRowView(0);
+	if (!row) {
+		AIFW_LOGE("Reading Data from the buffer failed");
+		return AIFW_INVALID_ARG;
+	}
+	int inputOffset = 0;  /* to read 2d input from 1d buffer. */
+	for (uint16_t i = 0; i < mInputSetCount; i++) {
+		memcpy(inputs[i], row + inputOffset, mInputSizeList[i] * sizeof(float));
+		inputOffset += mInputSizeList[i];
+	}
+	return AIFW_OK;
+}
+
+AIFW_RESULT AIModel::completeInvoke(float **invokeResult)
+{
+	AIFW_RESULT res = AIFW_OK;
+	int outputOffset = 0; /* to write 2d output in 1d buffer. */
+	for (uint16_t i = 0; i < mOutputSetCount; i++) {
+		for (uint16_t j = 0; j < mOutputSizeList[i]; j++) {
+			mInvokeOutput[i][j] = invokeResult[i][j];
 		}
+	}
 #ifdef CONFIG_AIFW_LOGV
-		printf("invoke Output\n");
-		for (uint16_t i = 0; i < mOutputSetCount; i++) {
-			printf("outputset [%d]: ", i);
-			for (uint16_t j = 0; j < mOutputSizeList[i]; j++) {
-				printf("%f,", mInvokeOutput[i][j]);
-			}
-			printf("\n");
+	printf("invoke Output\n");
+	for (uint16_t i = 0; i < mOutputSetCount; i++) {
+		printf("outputset [%d]: ", i);
+		for (uint16_t j = 0; j < mOutputSizeList[i]; j++) {
+			printf("%f,", mInvokeOutput[i][j]);
 		}
+		printf("\n");
+	}
 #endif
+	if (mDataProcessor) {
+		memset(mPostProcessedData, '\0', mModelAttribute.postProcessResultCount * sizeof(float));
 		for (uint16_t i = 0; i < mOutputSetCount; i++) {
 			res = mBuffer->writeData(mInvokeOutput[i], mOutputSizeList[i], mModelAttribute.rawDataCount + outputOffset);
 			outputOffset += mOutputSizeList[i];
@@ -431,99 +469,116 @@ AIFW_RESULT AIModel::invoke(void)
 		}
 		AIFW_LOGV("pre-process, invoke and post-process completed OK");
 		return res;
-	} else {
+	}
+	if (mModelAttribute.windowSize > 1) {
+		/* Window rows have no output columns, the result stays in mInvokeOutput */
+		AIFW_LOGV("read window and invoke completed OK");
+		return AIFW_OK;
+	}
+	for (uint16_t i = 0; i < mOutputSetCount; i++) {
+		res = mBuffer->writeData(mInvokeOutput[i], mOutputSizeList[i], mModelAttribute.invokeInputCount + outputOffset);
+		outputOffset += mOutputSizeList[i];
+		if (res != AIFW_OK) {
+			AIFW_LOGE("Writing invoke result to the buffer failed, error: %d", res);
+			return res;
+		}
+	}
+	AIFW_LOGV("read data, invoke and write data completed OK");
+	return res;
+}
+
+AIFW_RESULT AIModel::invoke(void)
+{
+	AIFW_RESULT res;
+	for (uint16_t i = 0; i < mOutputSetCount; i++) {
+		memset(mInvokeOutput[i], '\0', mOutputSizeList[i] * sizeof(float));
+	}
+	if (!mDataProcessor && mModelAttribute.windowSize <= 1) {
 		AIFW_LOGV("No data processor case");
+		/* The engine reads the input sets straight from the latest buffer row */
+		const float *row = mBuffer->getRowView(0);
+		if (!row) {
+			AIFW_LOGE("Reading Data from the buffer failed");
+			return AIFW_INVALID_ARG;
+		}
 		int inputOffset = 0;  /* to read 2d input from 1d buffer. */
 		for (uint16_t i = 0; i < mInputSetCount; i++) {
-			res = mBuffer->readData(mInvokeInput[i], inputOffset, inputOffset+mInputSizeList[i], 0);
+			mInvokeInput[i] = (float *)row + inputOffset;
 			inputOffset += mInputSizeList[i];
-			if (res != AIFW_OK) {
-				AIFW_LOGE("Reading Data from the buffer failed, error: %d", res);
-				return res;
-			}
-		}
-#ifdef CONFIG_AIFW_LOGV
-		printf("invoke Input\n");
-		for (uint16_t i = 0; i < mInputSetCount; i++) {
-			printf("inputset [%d]: ", i);
-			for (uint16_t j = 0; j < mInputSizeList[i]; j++) {
-				printf("%f,", mInvokeInput[i][j]);
-			}
-			printf("\n");
 		}
-#endif
-		res = mAIEngine->invoke(mInvokeInput, invokeResult);
+	} else {
+		/* Pre-processed data or the window is written straight to the engine input tensors */
+		res = mAIEngine->getInputBuffers(mInvokeInput);
 		if (res != AIFW_OK) {
-			AIFW_LOGE("Engine Invoke failed.");
-			return AIFW_ERROR;
+			AIFW_LOGE("Getting engine input failed, error: %d", res);
+			return res;
 		}
-		AIFW_LOGV("invoke completed fine");
-		for (uint16_t i = 0; i < mOutputSetCount; i++) {
-			for (uint16_t j = 0; j < mOutputSizeList[i]; j++) {
-				mInvokeOutput[i][j] = invokeResult[i][j];
-			}
+		res = prepareInput(mInvokeInput);
+		if (res != AIFW_OK) {
+			return res;
 		}
+	}
 #ifdef CONFIG_AIFW_LOGV
-		printf("invoke Output\n");
-		for (uint16_t i = 0; i < mOutputSetCount; i++) {
-			printf("outputset [%d]: ", i);
-			for (uint16_t j = 0; j < mOutputSizeList[i]; j++) {
-				printf("%f,", mInvokeOutput[i][j]);
-			}
-			printf("\n");
+	printf("invoke Input\n");
+	for (uint16_t i = 0; i < mInputSetCount; i++) {
+		printf("inputset [%d]: ", i);
+		for (uint16_t j = 0; j < mInputSizeList[i]; j++) {
+			printf("%f,", mInvokeInput[i][j]);
 		}
+		printf("\n");
+	}
 #endif
-		for (uint16_t i = 0; i < mOutputSetCount; i++) {
-			res = mBuffer->writeData(mInvokeOutput[i], mOutputSizeList[i], mModelAttribute.invokeInputCount + outputOffset);
-			outputOffset += mOutputSizeList[i];
-			if (res != AIFW_OK) {
-				AIFW_LOGE("Writing invoke result to the buffer failed, error: %d", res);
-				return res;
-			}
-		}
-		AIFW_LOGV("read data, invoke and write data completed OK");
-		return res;
+	if (!mDataProcessor && mModelAttribute.windowSize <= 1) {
+		res = mAIEngine->invoke(mInvokeInput, mInvokeResult);
+	} else {
+		res = mAIEngine->invokeInPlace(mInvokeResult);
+	}
+	if (res != AIFW_OK) {
+		AIFW_LOGE("Engine Invoke failed.");
+		return AIFW_ERROR;
 	}
+	AIFW_LOGV("invoke completed fine");
+	return completeInvoke(mInvokeResult);
 }
 #else
-AIFW_RESULT AIModel::invoke(void)
+AIFW_RESULT AIModel::prepareInput(float *input)
 {
 	AIFW_RESULT res;
-	float *invokeResult = nullptr;
-	memset(mInvokeInput, '\0', mModelAttribute.invokeInputCount * sizeof(float));
-	memset(mInvokeOutput, '\0', mModelAttribute.invokeOutputCount * sizeof(float));
 	if (mDataProcessor) {
-		AIFW_LOGV("data processor is set");
-		memset(mPostProcessedData, '\0', mModelAttribute.postProcessResultCount * sizeof(float));
-
-		res = mDataProcessor->preProcessData(mBuffer, mInvokeInput, &mModelAttribute);
+		memset(input, '\0', mModelAttribute.invokeInputCount * sizeof(float));
+		res = mDataProcessor->preProcessData(mBuffer, input, &mModelAttribute);
 		if (res != AIFW_OK) {
 			AIFW_LOGE("preProcessData failed, error: %d", res);
-			return res;
-		}
-#ifdef CONFIG_AIFW_LOGV
-		printf("invoke Input: ");
-		for (uint16_t i = 0; i < mModelAttribute.invokeInputCount; i++) {
-			printf("%f,", mInvokeInput[i]);
-		}
-		printf("\n");
-#endif
-		invokeResult = (float *)mAIEngine->invoke(mInvokeInput);
-		if (!invokeResult) {
-			AIFW_LOGE("Engine Invoke failed.");
-			return AIFW_ERROR;
-		}
-		AIFW_LOGV("invoke completed fine");
-		for (uint16_t i = 0; i < mModelAttribute.invokeOutputCount; i++) {
-			mInvokeOutput[i] = invokeResult[i];
 		}
+		return res;
+	}
+	if (mModelAttribute.windowSize > 1) {
+		return readWindow(&input, 1, &mModelAttribute.invokeInputCount);
+	}
+	const float *row = mBuffer->getRowView(0);
+	if (!row) {
+		AIFW_LOGE("Reading Data from the buffer failed");
+		return AIFW_INVALID_ARG;
+	}
+	memcpy(input, row, mModelAttribute.invokeInputCount * sizeof(float));
+	return AIFW_OK;
+}
+
+AIFW_RESULT AIModel::completeInvoke(float *invokeResult)
+{
+	AIFW_RESULT res;
+	for (uint16_t i = 0; i < mModelAttribute.invokeOutputCount; i++) {
+		mInvokeOutput[i] = invokeResult[i];
+	}
 #ifdef CONFIG_AIFW_LOGV
-		printf("invoke Output: ");
-		for (uint16_t i = 0; i < mModelAttribute.invokeOutputCount; i++) {
-			printf("%f,", mInvokeOutput[i]);
-		}
-		printf("\n");
+	printf("invoke Output: ");
+	for (uint16_t i = 0; i < mModelAttribute.invokeOutputCount; i++) {
+		printf("%f,", mInvokeOutput[i]);
+	}
+	printf("\n");
 #endif
+	if (mDataProcessor) {
+		memset(mPostProcessedData, '\0', mModelAttribute.postProcessResultCount * sizeof(float));
 		res = mBuffer->writeData(mInvokeOutput, mModelAttribute.invokeOutputCount, mModelAttribute.rawDataCount);
 		if (res != AIFW_OK) {
 			AIFW_LOGE("model output data write to buffer failed, error: %d", res);
@@ -535,48 +590,200 @@ AIFW_RESULT AIModel::invoke(void)
 		}
 		AIFW_LOGV("pre-process, invoke and post-process completed OK");
 		return res;
-	} else {
+	}
+	if (mModelAttribute.windowSize > 1) {
+		/* Window rows have no output columns, the result stays in mInvokeOutput */
+		AIFW_LOGV("read window and invoke completed OK");
+		return AIFW_OK;
+	}
+	res = mBuffer->writeData(mInvokeOutput, mModelAttribute.invokeOutputCount, mModelAttribute.invokeInputCount);
+	if (res != AIFW_OK) {
+		AIFW_LOGE("Writing invoke result to the buffer failed, error: %d", res);
+		return res;
+	}
+	AIFW_LOGV("read data, invoke and write data completed OK");
+	return res;
+}
+
+AIFW_RESULT AIModel::invoke(void)
+{
+	AIFW_RESULT res;
+	float *invokeResult = nullptr;
+	memset(mInvokeOutput, '\0', mModelAttribute.invokeOutputCount * sizeof(float));
+	if (!mDataProcessor && mModelAttribute.windowSize <= 1) {
 		AIFW_LOGV("No data processor case");
-		res = mBuffer->readData(mInvokeInput, 0, mModelAttribute.invokeInputCount, 0);
-		if (res != AIFW_OK) {
-			AIFW_LOGE("Reading Data from the buffer failed, error: %d", res);
-			return res;
+		/* The engine reads the input straight from the latest buffer row */
+		const float *row = mBuffer->getRowView(0);
+		if (!row) {
+			AIFW_LOGE("Reading Data from the buffer failed");
+			return AIFW_INVALID_ARG;
 		}
 #ifdef CONFIG_AIFW_LOGV
 		printf("invoke Input: ");
 		for (uint16_t i = 0; i < mModelAttribute.invokeInputCount; i++) {
-			printf("%f,", mInvokeInput[i]);
+			printf("%f,", row[i]);
 		}
 		printf("\n");
 #endif
-		invokeResult = (float *)mAIEngine->invoke(mInvokeInput);
-		if (!invokeResult) {
-			AIFW_LOGE("Engine Invoke failed.");
+		invokeResult = (float *)mAIEngine->invoke((void *)row);
+	} else {
+		/* Pre-processed data or the window is written straight to the engine input tensor */
+		float *invokeInput = mAIEngine->getInputBuffer();
+		if (!invokeInput) {
+			AIFW_LOGE("Getting engine input failed");
 			return AIFW_ERROR;
 		}
-		AIFW_LOGV("invoke completed fine");
-		for (uint16_t i = 0; i < mModelAttribute.invokeOutputCount; i++) {
-			mInvokeOutput[i] = invokeResult[i];
+		res = prepareInput(invokeInput);
+		if (res != AIFW_OK) {
+			return res;
 		}
 #ifdef CONFIG_AIFW_LOGV
-		printf("invoke Output: ");
-		for (uint16_t i = 0; i < mModelAttribute.invokeOutputCount; i++) {
-			printf("%f,", mInvokeOutput[i]);
+		printf("invoke Input: ");
+		for (uint16_t i = 0; i < mModelAttribute.invokeInputCount; i++) {
+			printf("%f,", invokeInput[i]);
 		}
 		printf("\n");
 #endif
-		res = mBuffer->writeData(mInvokeOutput, mModelAttribute.invokeOutputCount, mModelAttribute.invokeInputCount);
-		if (res != AIFW_OK) {
-			AIFW_LOGE("Writing invoke result to the buffer failed, error: %d", res);
-			return res;
+		invokeResult = (float *)mAIEngine->invokeInPlace();
+	}
+	if (!invokeResult) {
+		AIFW_LOGE("Engine Invoke failed.");
+		return AIFW_ERROR;
+	}
+	AIFW_LOGV("invoke completed fine");
+	return completeInvoke(invokeResult);
+}
+#endif /* CONFIG_AIFW_MULTI_INOUT_SUPPORT */
+
+#ifdef CONFIG_AIFW_PARALLEL_INFERENCE
+void AIModel::initStage(void)
+{
+	pthread_mutex_init(&mStageLock, NULL);
+	for (int s = 0; s < 2; s++) {
+		mStageData[s] = NULL;
+#ifdef CONFIG_AIFW_MULTI_INOUT_SUPPORT
+		mStageInput[s] = NULL;
+#endif
+	}
+	mStageNext = 0;
+	mStageRun = 0;
+	mRowsAhead = 0;
+	mStageInFlight = false;
+}
+
+AIFW_RESULT AIModel::allocateStage(void)
+{
+	if (mStageData[0]) {
+		return AIFW_OK;
+	}
+#ifdef CONFIG_AIFW_MULTI_INOUT_SUPPORT
+	uint32_t size = 0;
+	for (uint16_t i = 0; i < mInputSetCount; i++) {
+		size += mInputSizeList[i];
+	}
+#else
+	uint32_t size = mModelAttribute.invokeInputCount;
+#endif
+	for (int s = 0; s < 2; s++) {
+		mStageData[s] = new float[size];
+		if (!mStageData[s]) {
+			AIFW_LOGE("Memory Allocation failed - staged model input");
+			return AIFW_NO_MEM;
+		}
+#ifdef CONFIG_AIFW_MULTI_INOUT_SUPPORT
+		mStageInput[s] = new float *[mInputSetCount];
+		if (!mStageInput[s]) {
+			AIFW_LOGE("Memory Allocation failed - staged model input list");
+			return AIFW_NO_MEM;
+		}
+		uint32_t offset = 0;
+		for (uint16_t i = 0; i < mInputSetCount; i++) {
+			mStageInput[s][i] = mStageData[s] + offset;
+			offset += mInputSizeList[i];
 		}
-		AIFW_LOGV("read data, invoke and write data completed OK");
+#endif
+	}
+	return AIFW_OK;
+}
+
+AIFW_RESULT AIModel::stageData(void *data, uint16_t count)
+{
+	AIFW_RESULT res = allocateStage();
+	if (res != AIFW_OK) {
 		return res;
 	}
+	pthread_mutex_lock(&mStageLock);
+	res = bufferData(data, count);
+	if (res >= AIFW_OK && mStageInFlight) {
+		/* Row written after the sample being invoked, see runStagedInference() */
+		mRowsAhead++;
+	}
+	if (res == AIFW_OK) {
+#ifdef CONFIG_AIFW_MULTI_INOUT_SUPPORT
+		res = prepareInput(mStageInput[mStageNext]);
+#else
+		res = prepareInput(mStageData[mStageNext]);
+#endif
+	}
+	pthread_mutex_unlock(&mStageLock);
+	return res;
+}
+
+void AIModel::commitStage(void)
+{
+	pthread_mutex_lock(&mStageLock);
+	mStageRun = mStageNext;
+	mStageNext ^= 1;
+	mRowsAhead = 0;
+	mStageInFlight = true;
+	pthread_mutex_unlock(&mStageLock);
 }
-#endif /* CONFIG_AIFW_MULTI_INOUT_SUPPORT */
+
+AIFW_RESULT AIModel::runStagedInference(void)
+{
+	AIFW_RESULT res;
+	/* The engine copies the staged input, the other stage may be filled by stageData() meanwhile */
+#ifdef CONFIG_AIFW_MULTI_INOUT_SUPPORT
+	for (uint16_t i = 0; i < mOutputSetCount; i++) {
+		memset(mInvokeOutput[i], '\0', mOutputSizeList[i] * sizeof(float));
+	}
+	res = mAIEngine->invoke(mStageInput[mStageRun], mInvokeResult);
+	float **invokeResult = mInvokeResult;
+#else
+	memset(mInvokeOutput, '\0', mModelAttribute.invokeOutputCount * sizeof(float));
+	float *invokeResult = (float *)mAIEngine->invoke(mStageData[mStageRun]);
+	res = invokeResult ? AIFW_OK : AIFW_ERROR;
+#endif
+	pthread_mutex_lock(&mStageLock);
+	if (res != AIFW_OK) {
+		AIFW_LOGE("Engine Invoke failed.");
+		res = AIFW_ERROR;
+	} else {
+		/* Rows of later samples are hidden, so that the row of this sample is the latest one while it completes */
+		res = mBuffer->holdRows(mRowsAhead);
+		if (res == AIFW_OK) {
+			res = completeInvoke(invokeResult);
+			mBuffer->releaseRows(mRowsAhead);
+		} else {
+			AIFW_LOGE("row of the sample was overwritten by %d later rows", mRowsAhead);
+		}
+	}
+	mStageInFlight = false;
+	pthread_mutex_unlock(&mStageLock);
+	return res;
+}
+#endif /* CONFIG_AIFW_PARALLEL_INFERENCE */
 
 AIFW_RESULT AIModel::pushData(void *data, uint16_t count)
+{
+	AIFW_RESULT res = bufferData(data, count);
+	if (res != AIFW_OK) {
+		return res;
+	}
+	return runInference();
+}
+
+AIFW_RESULT AIModel::bufferData(void *data, uint16_t count)
 {
 	if (!data) {
 		AIFW_LOGE("raw data argument is null");
@@ -610,7 +817,12 @@ AIFW_RESULT AIModel::pushData(void *data, uint16_t count)
 			return AIFW_INFERENCE_PROCEEDING;
 		}
 	} else {
-		if (count > mModelAttribute.invokeInputCount) {
+		/* With a window, each pushed sample fills one row of invokeInputCount / windowSize values */
+		uint16_t rowCount = mModelAttribute.invokeInputCount;
+		if (mModelAttribute.windowSize > 1) {
+			rowCount /= mModelAttribute.windowSize;
+		}
+		if (count > rowCount) {
 			AIFW_LOGE("size of raw data buffer is greater than required size (raw data count)");
 			return AIFW_NOT_ENOUGH_SPACE;
 		}
@@ -620,8 +832,12 @@ AIFW_RESULT AIModel::pushData(void *data, uint16_t count)
 			return res;
 		}
 	}
+	return AIFW_OK;
+}
 
-	res = invoke();
+AIFW_RESULT AIModel::runInference(void)
+{
+	AIFW_RESULT res = invoke();
 	/* AIFW_OK or AIFW_INFERENCE_FINISHED or AIFW_INFERENCE_PROCEEDING is fine */
 	if (res < AIFW_OK) {
 		AIFW_LOGE("Invoke Failed, error: %d", res);
@@ -0,0 +1,96 @@
+/****************************************************************************
+ *
+ * Copyright 2025 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+#include "tinyara/config.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <tinyara/fs/ioctl.h>
+#include "aifw/aifw_log.h"
+#include "include/AIModelFile.h"
+
+namespace aifw {
+
+AIFW_RESULT getModelFileData(const char *file, const char **model, char **buffer, int *mapfd)
+{
+	*mapfd = -1;
+	int fd = open(file, O_RDONLY);
+	if (fd < 0) {
+		AIFW_LOGE("File %s open operation failed errno : %d", file, errno);
+		return AIFW_ERROR_FILE_ACCESS;
+	}
+#ifdef CONFIG_AIFW_MODEL_XIP
+	void *addr = NULL;
+	if (ioctl(fd, FIOC_MMAP, (unsigned long)((uintptr_t)&addr)) == 0 && addr != NULL) {
+		/* The mapping is valid only while the file is open */
+		*mapfd = fd;
+		*model = (const char *)addr;
+		*buffer = NULL;
+		AIFW_LOGI("Model file %s used in place at %p", file, addr);
+		return AIFW_OK;
+	}
+	AIFW_LOGV("Model file %s can not be mapped, errno %d, reading it", file, errno);
+#endif
+	off_t size = lseek(fd, 0, SEEK_END);
+	if (size <= 0 || lseek(fd, 0, SEEK_SET) != 0) {
+		close(fd);
+		AIFW_LOGE("File %s size read as %d is invalid, errno %d", file, (int)size, errno);
+		return AIFW_ERROR_FILE_ACCESS;
+	}
+	AIFW_LOGV("Model File Size: %d", (int)size);
+	char *data = (char *)malloc(size);
+	if (!data) {
+		close(fd);
+		AIFW_LOGE("Memory not enough to allocate %d", (int)size);
+		return AIFW_NO_MEM;
+	}
+	off_t total = 0;
+	while (total < size) {
+		ssize_t nread = read(fd, data + total, size - total);
+		if (nread <= 0) {
+			if (nread < 0 && errno == EINTR) {
+				continue;
+			}
+			free(data);
+			close(fd);
+			AIFW_LOGE("File %s read failed at %d of %d, errno %d", file, (int)total, (int)size, errno);
+			return AIFW_ERROR_FILE_ACCESS;
+		}
+		total += nread;
+	}
+	close(fd);
+	*model = data;
+	*buffer = data;
+	return AIFW_OK;
+}
+
+void releaseModelFileData(char **buffer, int *fd)
+{
+	if (*buffer) {
+		free(*buffer);
+		*buffer = NULL;
+	}
+	if (*fd >= 0) {
+		close(*fd);
+		*fd = -1;
+	}
+}
+
+} /* namespace aifw */
@@ -17,16 +17,18 @@
  ****************************************************************************/
 
 #include <iostream>
+#include <string.h>
 
 #include "tinyara/config.h"
 #include "aifw/aifw_log.h"
 #include "include/ONERTM.h"
+#include "include/AIModelFile.h"
 #include "luci_interpreter/Interpreter.h"
 
 namespace aifw {
 
 ONERTM::ONERTM() :
-	mBuf(NULL), mInterpreter(NULL),
+	mBuf(NULL), mAllocatedBuf(NULL), mFd(-1), mInterpreter(NULL),
 #ifndef CONFIG_AIFW_MULTI_INOUT_SUPPORT
 	mModelInputSize(0), mModelOutputSize(0)
 #else
@@ -38,11 +40,7 @@ ONERTM::ONERTM() :
 ONERTM::~ONERTM()
 {
 	AIFW_LOGV(":DEINIT:");
-	if (mBuf) {
-		free(mBuf);
-		mBuf = NULL;
-	}
-	mInterpreter.reset();
+	releaseModel();
 #ifdef CONFIG_AIFW_MULTI_INOUT_SUPPORT
 	if (this->mInputSizeList) {
 		delete[] this->mInputSizeList;
@@ -109,42 +107,32 @@ AIFW_RESULT ONERTM::_loadModel(void)
 	return AIFW_OK;
 }
 
+void ONERTM::releaseModel(void)
+{
+	/* The interpreter points into the model, drop it before the model file data */
+	this->mInterpreter.reset();
+	releaseModelFileData(&this->mAllocatedBuf, &this->mFd);
+	this->mBuf = NULL;
+}
+
 AIFW_RESULT ONERTM::loadModel(const char *file)
 {
 	AIFW_LOGV("GetModel from File:%s", file);
-	FILE *fp = fopen(file, "r");
-	if (fp == NULL) {
-		AIFW_LOGE("File %s open operation failed errno : %d", file, errno);
-		return AIFW_ERROR_FILE_ACCESS;
-	}
-	fseek(fp, 0, SEEK_END);
-	int size = ftell(fp);
-	fseek(fp, 0, SEEK_SET);
-	if (size < 0) {
-		fclose(fp);
-		AIFW_LOGE("File %s size read as %d is invalid, errno %d", file, size, errno);
-		return AIFW_ERROR_FILE_ACCESS;
-	}
-	AIFW_LOGV("Model File Size: %d", size);
-	this->mBuf = (char *)malloc(size);
-	if (!this->mBuf) {
-		fclose(fp);
-		AIFW_LOGE("Memory not enough to allocate %d", size);
-		return AIFW_NO_MEM;
+	releaseModel();
+	AIFW_RESULT res = getModelFileData(file, &this->mBuf, &this->mAllocatedBuf, &this->mFd);
+	if (res != AIFW_OK) {
+		return res;
 	}
-	fread(this->mBuf, 1, size, fp);
-	fclose(fp);
-
-	AIFW_LOGV("GetModel from Model file");
 
 	AIFW_LOGV("Model read from file %s", file);
-	
+
 	return _loadModel();
 }
 
 AIFW_RESULT ONERTM::loadModel(const unsigned char *model)
 {
-	this->mBuf = reinterpret_cast<char*>(const_cast<unsigned char *>(model));
+	releaseModel();
+	this->mBuf = reinterpret_cast<const char *>(model);
 	return _loadModel();
 }
 
@@ -160,32 +148,54 @@ void ONERTM::getModelDimensions(uint16_t *inputSetCount, uint16_t **inputSizeLis
 #endif /* CONFIG_AIFW_MULTI_INOUT_SUPPORT */
 
 #ifndef CONFIG_AIFW_MULTI_INOUT_SUPPORT
+float *ONERTM::getInputBuffer(void)
+{
+	return reinterpret_cast<float *>(this->mInterpreter->allocateInputTensor(0));
+}
+
 /* Run inference : with input data "features" and return output data ptr(Use output dimension to parse it) */
 void *ONERTM::invoke(void *inputData)
 {
-	float *value = (float *)(inputData);
-	auto *data = this->mInterpreter->allocateInputTensor(0);
-	for (uint32_t i = 0; i < this->mModelInputSize/sizeof(float); ++i) {
-		reinterpret_cast<float *>(data)[i] = value[i];
-	}
+	memcpy(getInputBuffer(), inputData, this->mModelInputSize);
+	return invokeInPlace();
+}
+
+/* Run inference : with input data already written to the input tensor and return output data ptr */
+void *ONERTM::invokeInPlace(void)
+{
 	AIFW_START_TIMER
 	this->mInterpreter->interpret();
 	AIFW_END_TIMER
 	return this->mInterpreter->readOutputTensor(0);
 }
 #else
+AIFW_RESULT ONERTM::getInputBuffers(float **inputData)
+{
+	for (uint16_t i = 0; i < this->mInputSetCount; i++) {
+		inputData[i] = reinterpret_cast<float *>(this->mInterpreter->allocateInputTensor(i));
+		if (!inputData[i]) {
+			AIFW_LOGE("Input tensor %d allocation failed", i);
+			return AIFW_NO_MEM;
+		}
+	}
+	return AIFW_OK;
+}
+
 /* Run inference : with input data "features", store output data in outputData parameter and return AIFW_OK on success */
 AIFW_RESULT ONERTM::invoke(void *inputData, void *outputData)
 {
 	float **value = (float **)(inputData);
-	float **output = (float **)(outputData);
 	for (uint16_t i = 0; i < this->mInputSetCount; i++) {
 		auto *data = this->mInterpreter->allocateInputTensor(i);
-		for (uint32_t j = 0; j < this->mInputSizeList[i]; j++) {
-			reinterpret_cast<float *>(data)[j] = value[i][j];
-		}
+		memcpy(data, value[i], this->mInputSizeList[i] * sizeof(float));
 	}
+	return invokeInPlace(outputData);
+}
 
+/* Run inference : with input data already written to the input tensors, store output data in outputData parameter */
+AIFW_RESULT ONERTM::invokeInPlace(void *outputData)
+{
+	float **output = (float **)(outputData);
 	AIFW_START_TIMER
 	this->mInterpreter->interpret();
 	AIFW_END_TIMER
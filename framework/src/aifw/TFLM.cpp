@@ -18,6 +18,7 @@
 
 #include "tinyara/config.h"
 #include <iostream>
+#include <string.h>
 #include <tensorflow/lite/c/common.h>
 #include <tensorflow/lite/schema/schema_generated.h>
 #include <tensorflow/lite/micro/all_ops_resolver.h>
@@ -27,6 +28,7 @@
 
 #include "aifw/aifw_log.h"
 #include "include/TFLM.h"
+#include "include/AIModelFile.h"
 
 #ifndef CONFIG_TFLM_MEM_POOL_SIZE
 #define AIFW_TFLM_POOL_SIZE 8192
@@ -39,7 +41,7 @@ namespace aifw {
 tflite::AllOpsResolver g_Resolver;
 tflite::MicroProfiler g_Profiler;
 TFLM::TFLM() :
-	mModel(NULL), mBuf(NULL), mInterpreter(NULL), mErrorReporter(NULL),
+	mModel(NULL), mBuf(NULL), mFd(-1), mInterpreter(NULL), mErrorReporter(NULL),
 #ifndef CONFIG_AIFW_MULTI_INOUT_SUPPORT
 	mInput(NULL), mOutput(NULL), mModelInputSize(0), mModelOutputSize(0)
 #else
@@ -79,12 +81,7 @@ void TFLM::clearMemory(void) {
 TFLM::~TFLM()
 {
 	AIFW_LOGV(":DEINIT:");
-	if (mBuf) {
-		free(mBuf);
-		mBuf = NULL;
-	}
-	mErrorReporter.reset();
-	mInterpreter.reset();
+	releaseModel();
 #ifdef CONFIG_AIFW_MULTI_INOUT_SUPPORT
 	clearMemory();
 #endif /* CONFIG_AIFW_MULTI_INOUT_SUPPORT */
@@ -233,34 +230,31 @@ AIFW_RESULT TFLM::_loadModel(void)
 	return AIFW_OK;
 }
 
+void TFLM::releaseModel(void)
+{
+	/* The interpreter and the tensors point into the model, drop them before the model file data */
+	this->mErrorReporter.reset();
+	this->mInterpreter.reset();
+	this->mModel = NULL;
+#ifndef CONFIG_AIFW_MULTI_INOUT_SUPPORT
+	this->mInput = NULL;
+	this->mOutput = NULL;
+#endif
+	releaseModelFileData(&this->mBuf, &this->mFd);
+}
+
 AIFW_RESULT TFLM::loadModel(const char *file)
 {
 	AIFW_LOGV("GetModel from File:%s", file);
-	FILE *fp = fopen(file, "r");
-	if (fp == NULL) {
-		AIFW_LOGE("File %s open operation failed errno : %d", file, errno);
-		return AIFW_ERROR_FILE_ACCESS;
-	}
-	fseek(fp, 0, SEEK_END);
-	int size = ftell(fp);
-	fseek(fp, 0, SEEK_SET);
-	if (size < 0) {
-		fclose(fp);
-		AIFW_LOGE("File %s size read as %d is invalid, errno %d", file, size, errno);
-		return AIFW_ERROR_FILE_ACCESS;
-	}
-	AIFW_LOGV("Model File Size: %d", size);
-	this->mBuf = (char *)malloc(size);
-	if (!this->mBuf) {
-		fclose(fp);
-		AIFW_LOGE("Memory not enough to allocate %d", size);
-		return AIFW_NO_MEM;
+	releaseModel();
+	const char *model;
+	AIFW_RESULT res = getModelFileData(file, &model, &this->mBuf, &this->mFd);
+	if (res != AIFW_OK) {
+		return res;
 	}
-	fread(this->mBuf, 1, size, fp);
-	fclose(fp);
 
 	AIFW_LOGV("GetModel from Model file");
-	this->mModel = tflite::GetModel((const void *)this->mBuf);
+	this->mModel = tflite::GetModel((const void *)model);
 
 	if (this->mModel->version() != TFLITE_SCHEMA_VERSION) {
 		AIFW_LOGE("Error:Model Version Mismatch");
@@ -273,6 +267,7 @@ AIFW_RESULT TFLM::loadModel(const char *file)
 
 AIFW_RESULT TFLM::loadModel(const unsigned char *model)
 {
+	releaseModel();
 	this->mModel = tflite::GetModel(model);
 	if (this->mModel->version() != TFLITE_SCHEMA_VERSION) {
 		AIFW_LOGE("GetModel from array failed");
@@ -294,13 +289,21 @@ void TFLM::getModelDimensions(uint16_t *inputSetCount, uint16_t **inputSizeList,
 #endif /* CONFIG_AIFW_MULTI_INOUT_SUPPORT */
 
 #ifndef CONFIG_AIFW_MULTI_INOUT_SUPPORT
+float *TFLM::getInputBuffer(void)
+{
+	return this->mInput->data.f;
+}
+
 /* Run inference : with input data "features" and return output data ptr(Use output dimension to parse it) */
 void *TFLM::invoke(void *inputData)
 {
-	float *value = (float *)(inputData);
-	for (int i = 0; i < this->mModelInputSize; i++) {
-		this->mInput->data.f[i] = value[i];
-	}
+	memcpy(getInputBuffer(), inputData, this->mModelInputSize * sizeof(float));
+	return invokeInPlace();
+}
+
+/* Run inference : with input data already written to the input tensor and return output data ptr */
+void *TFLM::invokeInPlace(void)
+{
 	AIFW_START_TIMER
 	TfLiteStatus invokeStatus = this->mInterpreter->Invoke();
 	AIFW_END_TIMER
@@ -312,15 +315,27 @@ void *TFLM::invoke(void *inputData)
 	return this->mOutput->data.data;
 }
 #else
+AIFW_RESULT TFLM::getInputBuffers(float **inputData)
+{
+	for (uint16_t i = 0; i < this->mInputSetCount; i++) {
+		inputData[i] = this->mInputList[i]->data.f;
+	}
+	return AIFW_OK;
+}
+
 /* Run inference : with input data "features", store output data in outputData parameter and return AIFW_OK on success */
 AIFW_RESULT TFLM::invoke(void *inputData, void *outputData)
 {
 	float **value = (float **)(inputData);
 	for (uint16_t i = 0; i < this->mInputSetCount; i++) {
-		for (uint16_t j = 0; j < this->mInputSizeList[i]; j++) {
-			this->mInputList[i]->data.f[j] = value[i][j];
-		}
+		memcpy(this->mInputList[i]->data.f, value[i], this->mInputSizeList[i] * sizeof(float));
 	}
+	return invokeInPlace(outputData);
+}
+
+/* Run inference : with input data already written to the input tensors, store output data in outputData parameter */
+AIFW_RESULT TFLM::invokeInPlace(void *outputData)
+{
 	AIFW_START_TIMER
 	TfLiteStatus invokeStatus = this->mInterpreter->Invoke();
 	AIFW_END_TIMER
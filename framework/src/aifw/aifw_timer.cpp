@@ -15,6 +15,7 @@
  * language governing permissions and limitations under the License.
  *
  ****************************************************************************/
+#include <tinyara/config.h>
 #include <semaphore.h>
 #include <signal.h>
 #include <memory>
@@ -127,6 +128,32 @@ aifw_timer_result aifw_timer_destroy(aifw_timer *timer)
 	return AIFW_TIMER_SUCCESS;
 }
 
+uint64_t aifw_timer_get_usec(void)
+{
+	struct timespec ts;
+#ifdef CONFIG_CLOCK_MONOTONIC
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+#else
+	clock_gettime(CLOCK_REALTIME, &ts);
+#endif
+	return (uint64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+uint32_t aifw_latency_update(aifw_latency *latency, uint64_t start)
+{
+	uint32_t usec = (uint32_t)(aifw_timer_get_usec() - start);
+	if (latency->count == 0 || usec < latency->min) {
+		latency->min = usec;
+	}
+	if (usec > latency->max) {
+		latency->max = usec;
+	}
+	latency->last = usec;
+	latency->total += usec;
+	latency->count++;
+	return usec;
+}
+
 static void *aifw_timerthread_cb(void *parameter)
 {
 	sigset_t sigset;
@@ -87,6 +87,19 @@ public:
 	 * @return: Void * pointer to output result data.
 	 */
 	virtual void *invoke(void *inputData) = 0;
+
+	/**
+	 * @brief Get the input tensor of the model, so that input data can be written there directly.
+	 * The pointer has to be fetched again before each invoke.
+	 * @return: Pointer to the model input, NULL on failure.
+	 */
+	virtual float *getInputBuffer(void) = 0;
+
+	/**
+	 * @brief Run the inference with the data already written to the buffer from getInputBuffer().
+	 * @return: Void * pointer to output result data.
+	 */
+	virtual void *invokeInPlace(void) = 0;
 #else
 	/**
 	 * @brief Run the inference with the given inputData.
@@ -96,6 +109,21 @@ public:
 	 */
 	virtual AIFW_RESULT invoke(void *inputData, void *outputData) = 0;
 
+	/**
+	 * @brief Get the input tensors of the model, so that input data can be written there directly.
+	 * The pointers have to be fetched again before each invoke.
+	 * @param [out] inputData: Array of input set count pointers, filled with the model inputs.
+	 * @return: AIFW_RESULT enum object.
+	 */
+	virtual AIFW_RESULT getInputBuffers(float **inputData) = 0;
+
+	/**
+	 * @brief Run the inference with the data already written to the buffers from getInputBuffers().
+	 * @param [out] outputData: Pointer to Output Data for storing output of invoke.
+	 * @return: AIFW_RESULT enum object.
+	 */
+	virtual AIFW_RESULT invokeInPlace(void *outputData) = 0;
+
 	/**
 	 * @brief Pass model dimensions to AIModel to allocate memory.
 	 * @param [in] inputSetCount: Number of Input sets for model invoke.
@@ -0,0 +1,53 @@
+/****************************************************************************
+ *
+ * Copyright 2025 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+/**
+ * @file AIModelFile.h
+ * @brief Access to the contents of a model file.
+ */
+
+#pragma once
+
+#include "aifw/aifw.h"
+
+namespace aifw {
+
+/**
+ * @brief Get the contents of a model file.
+ * When the file system can map the file (e.g. romfs on XIP flash), the model is used where it is stored,
+ * *buffer is set to NULL and the file is kept open in *fd: file systems such as tmpfs release the storage
+ * of an unlinked file only once it is closed. The file must not be written or truncated while it is mapped.
+ * Otherwise the file is read into a buffer allocated with malloc, which is returned in *buffer, and *fd is -1.
+ * Either way, releaseModelFileData has to be called once the model is no longer used.
+ * @param [in] file: Path of model file.
+ * @param [out] model: Start of model data.
+ * @param [out] buffer: Allocated buffer holding model data, NULL if the model is used in place.
+ * @param [out] fd: Descriptor keeping the mapped file open, -1 if the model is read into a buffer.
+ * @return: AIFW_RESULT enum object.
+ */
+AIFW_RESULT getModelFileData(const char *file, const char **model, char **buffer, int *fd);
+
+/**
+ * @brief Release the model data returned by getModelFileData: free the buffer or close the mapped file.
+ * Both are reset, so it may be called again.
+ * @param [in,out] buffer: Allocated buffer holding model data, or NULL.
+ * @param [in,out] fd: Descriptor keeping the mapped file open, or -1.
+ */
+void releaseModelFileData(char **buffer, int *fd);
+
+} /* namespace aifw */
@@ -53,16 +53,23 @@ public:
 	AIFW_RESULT loadModel(const unsigned char *model);
 #ifndef CONFIG_AIFW_MULTI_INOUT_SUPPORT
 	void *invoke(void *inputData);
+	float *getInputBuffer(void);
+	void *invokeInPlace(void);
 #else
 	AIFW_RESULT invoke(void *inputData, void *outputData);
+	AIFW_RESULT getInputBuffers(float **inputData);
+	AIFW_RESULT invokeInPlace(void *outputData);
 	void getModelDimensions(uint16_t *inputSetCount, uint16_t **inputSizeList, uint16_t *outputSetCount, uint16_t **outputSizeList);
 #endif /* CONFIG_AIFW_MULTI_INOUT_SUPPORT */
 	AIFW_RESULT resetInferenceState(void);
 
 private:
 	AIFW_RESULT _loadModel(void);
+	void releaseModel(void);
 
-	char *mBuf;
+	const char *mBuf;
+	char *mAllocatedBuf;
+	int mFd;
 	std::shared_ptr<luci_interpreter::Interpreter> mInterpreter;
 #ifndef CONFIG_AIFW_MULTI_INOUT_SUPPORT
 	uint16_t mModelInputSize;
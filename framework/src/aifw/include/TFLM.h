@@ -56,20 +56,26 @@ public:
 	AIFW_RESULT loadModel(const unsigned char *model);
 #ifndef CONFIG_AIFW_MULTI_INOUT_SUPPORT
 	void *invoke(void *inputData);
+	float *getInputBuffer(void);
+	void *invokeInPlace(void);
 #else
 	AIFW_RESULT invoke(void *inputData, void *outputData);
+	AIFW_RESULT getInputBuffers(float **inputData);
+	AIFW_RESULT invokeInPlace(void *outputData);
 	void getModelDimensions(uint16_t *inputSetCount, uint16_t **inputSizeList, uint16_t *outputSetCount, uint16_t **outputSizeList);
 #endif /* CONFIG_AIFW_MULTI_INOUT_SUPPORT */
 	AIFW_RESULT resetInferenceState(void);
 
 private:
 	AIFW_RESULT _loadModel(void);
+	void releaseModel(void);
 	void clearMemory(void);
 	AIFW_RESULT allocateMemory(void);
 	size_t mTensorArenaSize;
 	std::shared_ptr<uint8_t> mTensorArena;
 	const tflite::Model *mModel;
 	char *mBuf;
+	int mFd;
 	std::shared_ptr<tflite::MicroInterpreter> mInterpreter;
 	std::shared_ptr<tflite::ErrorReporter> mErrorReporter;
 #ifndef CONFIG_AIFW_MULTI_INOUT_SUPPORT
@@ -30,10 +30,14 @@
 #define CONFIG_FOCUS_MANAGER_THREAD_PRIORITY 199
 #endif
 
+#ifndef CONFIG_FOCUS_MANAGER_QUEUE_SIZE
+#define CONFIG_FOCUS_MANAGER_QUEUE_SIZE 8
+#endif
+
 using namespace std;
 
 namespace media {
-FocusManagerWorker::FocusManagerWorker()
+FocusManagerWorker::FocusManagerWorker() : MediaWorker(CONFIG_FOCUS_MANAGER_QUEUE_SIZE)
 {
 	mThreadName = "FocusManagerWorker";
 	mStacksize = CONFIG_FOCUS_MANAGER_STACKSIZE;
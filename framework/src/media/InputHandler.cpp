@@ -276,6 +276,16 @@ ssize_t InputHandler::writeToStreamBuffer(unsigned char *buf, size_t size)
 			break;
 		}
 
+#ifdef CONFIG_STREAM_BUFFER_LOCKFREE
+		if (mDecoder) {
+			ret = decodeToStreamBuffer(buffES, sizeES);
+			if (ret < 0) {
+				return ret;
+			}
+			continue;
+		}
+#endif
+
 		size_t usedES = 0;
 		while (1) {
 			unsigned char *buffPCM = buf;
@@ -468,6 +478,55 @@ ssize_t InputHandler::getPCM(unsigned char *buf, size_t size, size_t *used, unsi
 	return (ssize_t)(*expect);
 }
 
+#ifdef CONFIG_STREAM_BUFFER_LOCKFREE
+ssize_t InputHandler::decodeToStreamBuffer(unsigned char *buf, size_t size)
+{
+	size_t used = 0;
+	while (1) {
+		if (used < size) {
+			ssize_t ret = mDecoder->pushData(buf + used, size - used);
+			if (ret <= 0) {
+				meddbg("push data to decoder failed! error: %d\n", ret);
+				return EOF;
+			}
+			used += (size_t)ret;
+		}
+
+		// Decode PCM data straight into the stream buffer, no intermediate copy
+		unsigned char *region;
+		size_t sizePCM = mBufferWriter->getWriteRegion(&region);
+		if (sizePCM == 0) {
+			meddbg("End of writting!\n");
+			return EOF;
+		}
+
+		sizePCM &= ~0x1;
+		if (sizePCM == 0) {
+			// Only one byte left before the wrap of an odd-sized buffer
+			unsigned char sample[2];
+			sizePCM = sizeof(sample);
+			if (!getDecodeFrames(sample, &sizePCM)) {
+				// normal case: decoder want more data
+				break;
+			}
+			if (mBufferWriter->write(sample, sizePCM) != sizePCM) {
+				meddbg("End of writting!\n");
+				return EOF;
+			}
+			continue;
+		}
+
+		if (!getDecodeFrames(region, &sizePCM)) {
+			// normal case: decoder want more data
+			break;
+		}
+		mBufferWriter->commitWrite(sizePCM);
+	}
+
+	return (ssize_t)size;
+}
+#endif
+
 size_t InputHandler::fetchData(unsigned char *buf, size_t size, size_t *used, unsigned char **out, size_t *expect)
 {
 	if (*used < size) {
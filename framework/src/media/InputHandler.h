@@ -76,6 +76,9 @@ private:
 	const char *getWorkerName(void) const override { return "InputHandler"; };
 	ssize_t getElementaryStream(unsigned char *buf, size_t size, size_t *used, unsigned char **out, size_t *expect);
 	ssize_t getPCM(unsigned char *buf, size_t size, size_t *used, unsigned char **out, size_t *expect);
+#ifdef CONFIG_STREAM_BUFFER_LOCKFREE
+	ssize_t decodeToStreamBuffer(unsigned char *buf, size_t size);
+#endif
 	size_t fetchData(unsigned char *buf, size_t size, size_t *used, unsigned char **out, size_t *expect);
 	ssize_t readFromSource(unsigned char *buf, size_t size);
 
@@ -16,39 +16,69 @@
  *
  ******************************************************************/
 
+#include <assert.h>
 #include "MediaQueue.h"
 
 namespace media {
-MediaQueue::MediaQueue()
+MediaQueue::MediaQueue(size_t size) : mSize(size), mHead(0), mCount(0)
 {
+	assert(mSize > 0);
+	mQueueData = new MediaCommand[mSize];
 }
 MediaQueue::~MediaQueue()
 {
+	delete[] mQueueData;
 }
 
-std::function<void()> MediaQueue::deQueue()
+/* Called with mQueueMtx held, returns the slot to set the new command in */
+MediaCommand &MediaQueue::push()
+{
+	mQueueCv.notify_one();
+	if (mCount < mSize) {
+		return mQueueData[(mHead + mCount++) % mSize];
+	}
+	mOverflow.emplace_back();
+	return mOverflow.back();
+}
+
+MediaCommand MediaQueue::deQueue()
 {
 	std::unique_lock<std::mutex> lock(mQueueMtx);
-	if (mQueueData.empty()) {
+	while (mCount == 0) {
 		mQueueCv.wait(lock);
 	}
 
-	auto data = std::move(mQueueData.front());
-	mQueueData.pop();
+	MediaCommand data = std::move(mQueueData[mHead]);
+	mHead = (mHead + 1) % mSize;
+	if (!mOverflow.empty()) {
+		/* Keep the order, the freed slot takes the oldest overflowed command */
+		mQueueData[(mHead + mCount - 1) % mSize] = std::move(mOverflow.front());
+		mOverflow.pop_front();
+	} else {
+		mCount--;
+		mQueueFullCv.notify_one();
+	}
 	return data;
 }
 
 bool MediaQueue::isEmpty()
 {
-	std::unique_lock<std::mutex> lock(mQueueMtx);
-	return mQueueData.empty();
+	return mCount == 0;
+}
+
+bool MediaQueue::isFull()
+{
+	return mCount == mSize;
 }
 
 void MediaQueue::clearQueue(void)
 {
 	std::unique_lock<std::mutex> lock(mQueueMtx);
-   	std::queue<std::function<void()>> empty;
-	empty.push(std::move(std::function<void()>())); //push an empty function so, that pop() in dequeue will not crash if called after clearQueue().
-   	std::swap(mQueueData, empty);
+	for (; mCount > 0; mCount--) {
+		mQueueData[mHead].reset();
+		mHead = (mHead + 1) % mSize;
+	}
+	mOverflow.clear();
+	mQueueFullCv.notify_all();
 }
 } // namespace media
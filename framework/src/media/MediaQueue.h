@@ -21,31 +21,130 @@
 
 #include <mutex>
 #include <condition_variable>
-#include <queue>
 #include <atomic>
 #include <iostream>
 #include <functional>
+#include <list>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+/* Inline storage of one command. It's large enough for a member function
+ * bound to a shared_ptr and a few more arguments, bigger callables are
+ * rejected at compile time.
+ */
+#define MEDIA_COMMAND_STORAGE_SIZE (12 * sizeof(void *))
 
 namespace media {
+/**
+ * Callable stored inline, a std::function<void()> which never allocates.
+ */
+class MediaCommand
+{
+public:
+	MediaCommand() : mOps(nullptr) {}
+	~MediaCommand() { reset(); }
+	MediaCommand(MediaCommand &&other) : mOps(nullptr) { *this = std::move(other); }
+	MediaCommand &operator=(MediaCommand &&other) {
+		if (this != &other) {
+			reset();
+			if (other.mOps) {
+				other.mOps->move(&mStorage, &other.mStorage);
+				mOps = other.mOps;
+				other.reset();
+			}
+		}
+		return *this;
+	}
+	MediaCommand(const MediaCommand &) = delete;
+	MediaCommand &operator=(const MediaCommand &) = delete;
+
+	template <typename _Callable>
+	void set(_Callable &&__f) {
+		typedef typename std::decay<_Callable>::type _Functor;
+		static_assert(sizeof(_Functor) <= sizeof(mStorage), "Command is too large for MEDIA_COMMAND_STORAGE_SIZE");
+		static_assert(alignof(_Functor) <= alignof(decltype(mStorage)), "Command alignment is not supported");
+		reset();
+		new (&mStorage) _Functor(std::forward<_Callable>(__f));
+		mOps = &Manager<_Functor>::sOps;
+	}
+	void reset() {
+		if (mOps) {
+			mOps->destroy(&mStorage);
+			mOps = nullptr;
+		}
+	}
+	void operator()() { mOps->invoke(&mStorage); }
+	explicit operator bool() const { return mOps != nullptr; }
+
+private:
+	struct Ops {
+		void (*invoke)(void *);
+		void (*move)(void *, void *);
+		void (*destroy)(void *);
+	};
+
+	template <typename _Functor>
+	struct Manager {
+		static void invoke(void *f) { (*static_cast<_Functor *>(f))(); }
+		static void move(void *dst, void *src) { new (dst) _Functor(std::move(*static_cast<_Functor *>(src))); }
+		static void destroy(void *f) { static_cast<_Functor *>(f)->~_Functor(); }
+		static const Ops sOps;
+	};
+
+	const Ops *mOps;
+	typename std::aligned_storage<MEDIA_COMMAND_STORAGE_SIZE>::type mStorage;
+};
+
+template <typename _Functor>
+const MediaCommand::Ops MediaCommand::Manager<_Functor>::sOps = {
+	&MediaCommand::Manager<_Functor>::invoke,
+	&MediaCommand::Manager<_Functor>::move,
+	&MediaCommand::Manager<_Functor>::destroy,
+};
+
+/**
+ * Bounded FIFO of commands. All slots are allocated once when the queue is
+ * created, so queuing a command doesn't touch the heap. enQueue() waits
+ * while the queue is full. enQueueNoWait() never waits, commands posted to
+ * a full queue go to an overflow list allocated from the heap instead, and
+ * move to the slots in order as they free up.
+ */
 class MediaQueue
 {
 public:
-	MediaQueue();
+	MediaQueue(size_t size);
 	~MediaQueue();
 	template <typename _Callable, typename... _Args>
 	void enQueue(_Callable &&__f, _Args &&... __args) {
 		std::unique_lock<std::mutex> lock(mQueueMtx);
-		std::function<void()> func = std::bind(std::forward<_Callable>(__f), std::forward<_Args>(__args)...);
-		mQueueData.push(func);
-		mQueueCv.notify_one();
+		while (mCount == mSize) {
+			mQueueFullCv.wait(lock);
+		}
+		push().set(std::bind(std::forward<_Callable>(__f), std::forward<_Args>(__args)...));
 	}
-	std::function<void()> deQueue();
+	template <typename _Callable, typename... _Args>
+	void enQueueNoWait(_Callable &&__f, _Args &&... __args) {
+		std::unique_lock<std::mutex> lock(mQueueMtx);
+		push().set(std::bind(std::forward<_Callable>(__f), std::forward<_Args>(__args)...));
+	}
+	MediaCommand deQueue();
 	bool isEmpty();
+	bool isFull();
 	void clearQueue(void);
 
 private:
-	std::queue<std::function<void()>> mQueueData;
+	MediaCommand &push();
+
+	MediaCommand *mQueueData;
+	size_t mSize;
+	size_t mHead;
+	/* Written with mQueueMtx held, but also polled without it by the worker */
+	std::atomic<size_t> mCount;
+	/* Not empty only while all slots are in use */
+	std::list<MediaCommand> mOverflow;
 	std::condition_variable mQueueCv;
+	std::condition_variable mQueueFullCv;
 	std::mutex mQueueMtx;
 };
 } // namespace media
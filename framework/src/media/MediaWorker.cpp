@@ -23,10 +23,14 @@
 
 namespace media {
 
-MediaWorker::MediaWorker() :
+static std::mutex gWorkerListMtx;
+static MediaWorker *gWorkerList;
+
+MediaWorker::MediaWorker(size_t queueSize) :
 	mStacksize(PTHREAD_STACK_DEFAULT),
 	mPriority(100),
 	mThreadName("MediaWorker"),
+	mWorkerQueue(queueSize),
 	mIsRunning(false),
 	mRefCnt(0),
 	mWorkerThread(0),
@@ -34,10 +38,32 @@ MediaWorker::MediaWorker() :
 	mMAX_START_THREAD_WAIT_COUNT(10)
 {
 	medvdbg("MediaWorker::MediaWorker()\n");
+	std::lock_guard<std::mutex> lock(gWorkerListMtx);
+	mNextWorker = gWorkerList;
+	gWorkerList = this;
 }
 MediaWorker::~MediaWorker()
 {
 	medvdbg("MediaWorker::~MediaWorker()\n");
+	std::lock_guard<std::mutex> lock(gWorkerListMtx);
+	for (MediaWorker **link = &gWorkerList; *link; link = &(*link)->mNextWorker) {
+		if (*link == this) {
+			*link = mNextWorker;
+			break;
+		}
+	}
+}
+
+bool MediaWorker::isWorkerThread()
+{
+	pthread_t self = pthread_self();
+	std::lock_guard<std::mutex> lock(gWorkerListMtx);
+	for (MediaWorker *worker = gWorkerList; worker; worker = worker->mNextWorker) {
+		if (worker->mInsideThreadFunc && pthread_equal(self, worker->mWorkerThread)) {
+			return true;
+		}
+	}
+	return false;
 }
 
 void MediaWorker::startWorker()
@@ -93,7 +119,7 @@ void MediaWorker::stopWorker()
 			meddbg("%s::stopWorker() - setting exit condition of mWorkerthread\n", mThreadName);
 		} else {
 			std::atomic<bool> &refBool = mIsRunning;
-			mWorkerQueue.enQueue([&refBool]() {
+			enQueue([&refBool]() {
 				refBool = false;
 			});
 			pthread_join(mWorkerThread, NULL);
@@ -102,7 +128,7 @@ void MediaWorker::stopWorker()
 	}
 }
 
-std::function<void()> MediaWorker::deQueue()
+MediaCommand MediaWorker::deQueue()
 {
 	return mWorkerQueue.deQueue();
 }
@@ -126,9 +152,9 @@ void *MediaWorker::mediaLooper(void *arg)
 			pthread_yield();
 		}
 
-		std::function<void()> run = worker->deQueue();
+		MediaCommand run = worker->deQueue();
 		medvdbg("MediaWorker : deQueue\n");
-		if (run != nullptr) {
+		if (run) {
 			run();
 		}
 	}
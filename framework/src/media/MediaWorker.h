@@ -20,26 +20,43 @@
 #define __MEDIA_MEDIAWORKER_HPP
 
 #include <sys/types.h>
+#include <pthread.h>
+#include <debug.h>
 #include <atomic>
 #include <mutex>
 
 #include "MediaQueue.h"
 
+#define MEDIA_WORKER_QUEUE_SIZE_DEFAULT 8
+
 namespace media {
 class MediaWorker
 {
 public:
-	MediaWorker();
+	MediaWorker(size_t queueSize = MEDIA_WORKER_QUEUE_SIZE_DEFAULT);
 	virtual ~MediaWorker();
 
 	void startWorker();
 	void stopWorker();
 
+	/**
+	 * Post a command. Application threads wait while the queue is full.
+	 * Media worker threads never wait, the queue overflows instead: a worker
+	 * posting to its own queue would wait forever, and two workers posting
+	 * to each other (the player and its observer) would deadlock.
+	 */
 	template <typename _Callable, typename... _Args>
 	void enQueue(_Callable &&__f, _Args &&... __args) {
+		if (isWorkerThread()) {
+			if (mWorkerQueue.isFull()) {
+				medwdbg("%s queue is full, overflow the command\n", mThreadName);
+			}
+			mWorkerQueue.enQueueNoWait(__f, __args...);
+			return;
+		}
 		mWorkerQueue.enQueue(__f, __args...);
 	}
-	std::function<void()> deQueue();
+	MediaCommand deQueue();
 	bool isAlive();
 	void clearQueue(void);
 
@@ -51,6 +68,7 @@ protected:
 
 private:
 	static void *mediaLooper(void *);
+	static bool isWorkerThread();
 
 	MediaQueue mWorkerQueue;
 	std::atomic<bool> mIsRunning;
@@ -59,6 +77,8 @@ private:
 	std::mutex mRefMtx;
 	std::atomic<bool> mInsideThreadFunc;
 	unsigned short mMAX_START_THREAD_WAIT_COUNT;
+	/* All the workers, to tell whether the caller is one of their threads */
+	MediaWorker *mNextWorker;
 };
 } // namespace media
 #endif
@@ -122,6 +122,33 @@ void OutputHandler::resetWorker()
 	mIsFlushing = false;
 }
 
+#ifdef CONFIG_STREAM_BUFFER_LOCKFREE
+void OutputHandler::writeToSource(size_t size)
+{
+	// Hand data to the output source straight from the stream buffer
+	while (size > 0) {
+		const unsigned char *region;
+		size_t len = mBufferReader->getReadRegion(&region);
+		if (len == 0) {
+			meddbg("StreamBufferReader::getReadRegion failed! size : %u\n", size);
+			return;
+		}
+		if (len > size) {
+			len = size;
+		}
+
+		auto written = mOutputDataSource->write(const_cast<unsigned char *>(region), len);
+		mBufferReader->commitRead(len);
+		if (written <= 0) {
+			// Error occurred, stop outputting
+			meddbg("OutputDataSource::write returned <= 0! size : %u, written : %d\n", len, written);
+			mBufferWriter->setEndOfStream();
+			return;
+		}
+		size -= len;
+	}
+}
+#else
 void OutputHandler::writeToSource(size_t size)
 {
 	auto buf = new unsigned char[size];
@@ -141,6 +168,7 @@ void OutputHandler::writeToSource(size_t size)
 
 	delete[] buf;
 }
+#endif
 
 bool OutputHandler::processWorker()
 {
@@ -27,9 +27,12 @@
 #ifndef CONFIG_MEDIA_PLAYER_OBSERVER_THREAD_PRIORITY
 #define CONFIG_MEDIA_PLAYER_OBSERVER_THREAD_PRIORITY 199
 #endif
+#ifndef CONFIG_MEDIA_PLAYER_OBSERVER_QUEUE_SIZE
+#define CONFIG_MEDIA_PLAYER_OBSERVER_QUEUE_SIZE 16
+#endif
 
 namespace media {
-PlayerObserverWorker::PlayerObserverWorker()
+PlayerObserverWorker::PlayerObserverWorker() : MediaWorker(CONFIG_MEDIA_PLAYER_OBSERVER_QUEUE_SIZE)
 {
 	mThreadName = "PlayerObserverWorker";
 	mStacksize = CONFIG_MEDIA_PLAYER_OBSERVER_STACKSIZE;
@@ -48,6 +48,10 @@ namespace stream {
 StreamBuffer::StreamBuffer(size_t bufferSize, size_t threshold)
 	: mObserver(nullptr), mEOS(false), mBufferSize(bufferSize), mThreshold(threshold)
 {
+#ifdef CONFIG_STREAM_BUFFER_LOCKFREE
+	mReaderWaiting = false;
+	mWriterWaiting = false;
+#endif
 	mRingBuf.buf = nullptr;
 	mRingBuf.depth = 0;
 	mRingBuf.rd_idx = 0;
@@ -92,6 +96,26 @@ size_t StreamBuffer::write(unsigned char *buf, size_t size)
 	return rb_write(&mRingBuf, buf, size);
 }
 
+size_t StreamBuffer::writeRegion(unsigned char **region)
+{
+	return rb_write_region(&mRingBuf, (void **)region);
+}
+
+size_t StreamBuffer::commitWrite(size_t size)
+{
+	return rb_write_commit(&mRingBuf, size);
+}
+
+size_t StreamBuffer::readRegion(const unsigned char **region)
+{
+	return rb_read_region(&mRingBuf, (const void **)region);
+}
+
+size_t StreamBuffer::commitRead(size_t size)
+{
+	return rb_read_commit(&mRingBuf, size);
+}
+
 size_t StreamBuffer::sizeOfSpace()
 {
 	return rb_avail(&mRingBuf);
@@ -112,6 +136,54 @@ bool StreamBuffer::isEndOfStream()
 	return mEOS;
 }
 
+#ifdef CONFIG_STREAM_BUFFER_LOCKFREE
+/*
+ * Reader and writer access the ring buffer without mMutex, it is only taken
+ * to sleep on a real underrun or overrun. The waiting flag is published before
+ * the ring buffer is checked again, and the other side publishes its index
+ * before checking the flag, so one of them always sees the other.
+ */
+void StreamBuffer::waitForData()
+{
+	std::unique_lock<std::mutex> lock(mMutex);
+	mReaderWaiting.store(true, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	while (rb_used(&mRingBuf) == 0 && !mEOS) {
+		mCondv.wait(lock);
+	}
+	mReaderWaiting.store(false, std::memory_order_relaxed);
+}
+
+void StreamBuffer::waitForSpace()
+{
+	std::unique_lock<std::mutex> lock(mMutex);
+	mWriterWaiting.store(true, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	while (rb_avail(&mRingBuf) == 0 && !mEOS) {
+		mCondv.wait(lock);
+	}
+	mWriterWaiting.store(false, std::memory_order_relaxed);
+}
+
+void StreamBuffer::wakeReader()
+{
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	if (mReaderWaiting.load(std::memory_order_relaxed)) {
+		std::lock_guard<std::mutex> lock(mMutex);
+		mCondv.notify_all();
+	}
+}
+
+void StreamBuffer::wakeWriter()
+{
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	if (mWriterWaiting.load(std::memory_order_relaxed)) {
+		std::lock_guard<std::mutex> lock(mMutex);
+		mCondv.notify_all();
+	}
+}
+#endif
+
 void StreamBuffer::setObserver(BufferObserverInterface *observer)
 {
 	mObserver = observer;
@@ -119,6 +191,10 @@ void StreamBuffer::setObserver(BufferObserverInterface *observer)
 
 void StreamBuffer::notifyObserver(State st, ...)
 {
+#ifdef CONFIG_STREAM_BUFFER_LOCKFREE
+	// Reader and writer may notify at the same time, observers expect it in turn
+	std::lock_guard<std::mutex> lock(mObserverMutex);
+#endif
 	if (mObserver) {
 		switch (st) {
 		case State::OVERRUN:
@@ -19,8 +19,10 @@
 #ifndef __MEDIA_STREAMBUFFER_H
 #define __MEDIA_STREAMBUFFER_H
 
+#include <tinyara/config.h>
 #include <memory>
 #include <mutex>
+#include <atomic>
 #include <condition_variable>
 #include "utils/rb.h"
 
@@ -87,6 +89,24 @@ public:
 	 * Write(push) data into stream buffer.
 	 */
 	size_t write(unsigned char *buf, size_t size);
+	/**
+	 * Get the contiguous free space at the write position.
+	 * Data filled there is published by commitWrite().
+	 */
+	size_t writeRegion(unsigned char **region);
+	/**
+	 * Publish data filled in the region got by writeRegion().
+	 */
+	size_t commitWrite(size_t size);
+	/**
+	 * Get the contiguous data at the read position.
+	 * Data used there is released by commitRead().
+	 */
+	size_t readRegion(const unsigned char **region);
+	/**
+	 * Release data used in the region got by readRegion().
+	 */
+	size_t commitRead(size_t size);
 	/**
 	 * Get bytes of data available in stream buffer.
 	 */
@@ -106,12 +126,38 @@ public:
 	size_t getBufferSize() { return mBufferSize; }
 	size_t getThreshold() { return mThreshold; }
 
+#ifdef CONFIG_STREAM_BUFFER_LOCKFREE
+	/**
+	 * Block the reader until there's data or the end-of-stream flag was set.
+	 */
+	void waitForData();
+	/**
+	 * Block the writer until there's space or the end-of-stream flag was set.
+	 */
+	void waitForSpace();
+	/**
+	 * Wake the reader up if it is blocked in waitForData().
+	 */
+	void wakeReader();
+	/**
+	 * Wake the writer up if it is blocked in waitForSpace().
+	 */
+	void wakeWriter();
+#endif
+
 private:
 	std::mutex mMutex;
 	std::condition_variable mCondv;
 	BufferObserverInterface *mObserver;
 	rb_t mRingBuf;
+#ifdef CONFIG_STREAM_BUFFER_LOCKFREE
+	std::mutex mObserverMutex;
+	std::atomic<bool> mReaderWaiting;
+	std::atomic<bool> mWriterWaiting;
+	std::atomic<bool> mEOS;
+#else
 	bool mEOS;
+#endif
 	size_t mBufferSize;
 	size_t mThreshold;
 };
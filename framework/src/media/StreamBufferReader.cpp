@@ -33,6 +33,100 @@ StreamBufferReader::StreamBufferReader(std::shared_ptr<StreamBuffer> stream)
 	assert(mStream);
 }
 
+#ifdef CONFIG_STREAM_BUFFER_LOCKFREE
+/*
+ * Single-producer/single-consumer mode: the ring buffer indices are published
+ * atomically, so data is read without the stream mutex. The reader only
+ * blocks (in waitForData) on a real underrun.
+ */
+size_t StreamBufferReader::copy(unsigned char *buf, size_t size, size_t offset)
+{
+	medvdbg("offset %lu, size %lu\n", offset, size);
+	size_t len = mStream->copy(buf, size, offset);
+	medvdbg("copied %lu\n", len);
+	return len;
+}
+
+size_t StreamBufferReader::read(unsigned char *buf, size_t size, bool sync)
+{
+	medvdbg("size %lu sync %c\n", size, sync ? 'Y' : 'N');
+
+	size_t rlen = 0;
+
+	while (true) {
+		// Read data from stream as much as possible
+		size_t temp = mStream->read(buf + rlen, size - rlen);
+		mStream->notifyObserver(StreamBuffer::State::UPDATED, -((ssize_t) temp));
+		rlen += temp;
+		if (temp > 0) {
+			// Writer may be waiting for more spaces
+			mStream->wakeWriter();
+		}
+
+		if (!sync || rlen == size) {
+			break;
+		}
+
+		// There's not enough data
+		if (mStream->isEndOfStream()) {
+			// Data written just before EOS was set may not have been read yet
+			if (mStream->sizeOfData() > 0) {
+				continue;
+			}
+			// End of stream, break reading
+			medvdbg("EOS break\n");
+			break;
+		}
+
+		medvdbg("read %lu/%lu\n", rlen, size);
+		// Notify observer, shouldn't be blocked.
+		mStream->notifyObserver(StreamBuffer::State::UNDERRUN);
+		// Then wait for writer.
+		mStream->waitForData();
+	}
+
+	assert(!sync || rlen == size || mStream->isEndOfStream());
+
+	medvdbg("read %lu\n", rlen);
+	return rlen;
+}
+
+size_t StreamBufferReader::getReadRegion(const unsigned char **region, bool sync)
+{
+	size_t len;
+
+	while ((len = mStream->readRegion(region)) == 0) {
+		if (!sync || mStream->isEndOfStream()) {
+			// Data written just before EOS was set may not have been seen yet
+			return mStream->readRegion(region);
+		}
+
+		mStream->notifyObserver(StreamBuffer::State::UNDERRUN);
+		mStream->waitForData();
+	}
+
+	return len;
+}
+
+size_t StreamBufferReader::commitRead(size_t size)
+{
+	size_t len = mStream->commitRead(size);
+	mStream->notifyObserver(StreamBuffer::State::UPDATED, -((ssize_t) len));
+	// Writer may be waiting for more spaces
+	mStream->wakeWriter();
+	return len;
+}
+
+size_t StreamBufferReader::sizeOfData()
+{
+	return mStream->sizeOfData();
+}
+
+bool StreamBufferReader::isEndOfStream()
+{
+	return mStream->isEndOfStream();
+}
+#else
 size_t StreamBufferReader::copy(unsigned char *buf, size_t size, size_t offset)
 {
 	medvdbg("offset %lu, size %lu\n", offset, size);
@@ -92,11 +186,44 @@ size_t StreamBufferReader::sizeOfData()
 	return mStream->sizeOfData();
 }
 
+size_t StreamBufferReader::getReadRegion(const unsigned char **region, bool sync)
+{
+	std::unique_lock<std::mutex> lock(mStream->getMutex());
+
+	size_t len;
+
+	while ((len = mStream->readRegion(region)) == 0) {
+		if (!sync || mStream->isEndOfStream()) {
+			break;
+		}
+
+		// Notify observer, shouldn't be blocked.
+		mStream->notifyObserver(StreamBuffer::State::UNDERRUN);
+		// Writer may be waiting for more spaces, so it's necessary to notify before waiting.
+		mStream->getCondv().notify_one();
+		// Then wait notification from writer.
+		mStream->getCondv().wait(lock);
+	}
+
+	return len;
+}
+
+size_t StreamBufferReader::commitRead(size_t size)
+{
+	std::lock_guard<std::mutex> lock(mStream->getMutex());
+	size_t len = mStream->commitRead(size);
+	mStream->notifyObserver(StreamBuffer::State::UPDATED, -((ssize_t) len));
+	// Writer may be waiting for more spaces, so it's necessary to notify after reading.
+	mStream->getCondv().notify_one();
+	return len;
+}
+
 bool StreamBufferReader::isEndOfStream()
 {
 	std::lock_guard<std::mutex> lock(mStream->getMutex());
 	return mStream->isEndOfStream();
 }
+#endif
 
 } // namespace stream
 } // namespace media
@@ -34,6 +34,13 @@ public:
 	virtual size_t copy(unsigned char *buf, size_t size, size_t offset = 0);
 	virtual size_t read(unsigned char *buf, size_t size, bool sync = true);
 	virtual size_t sizeOfData();
+	/**
+	 * Get contiguous data in stream buffer, to use it in place without copy.
+	 * In sync mode, wait until there's data, 0 is returned only at end-of-stream.
+	 * The data must be released by commitRead() before the next read.
+	 */
+	virtual size_t getReadRegion(const unsigned char **region, bool sync = true);
+	virtual size_t commitRead(size_t size);
 
 public:
 	bool isEndOfStream();
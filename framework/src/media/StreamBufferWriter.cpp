@@ -33,6 +33,91 @@ StreamBufferWriter::StreamBufferWriter(std::shared_ptr<StreamBuffer> stream)
 	assert(mStream);
 }
 
+#ifdef CONFIG_STREAM_BUFFER_LOCKFREE
+/*
+ * Single-producer/single-consumer mode, see StreamBufferReader.cpp.
+ * The writer only blocks (in waitForSpace) on a real overrun.
+ */
+size_t StreamBufferWriter::write(unsigned char *buf, size_t size, bool sync)
+{
+	medvdbg("size %lu sync %c\n", size, sync ? 'Y' : 'N');
+
+	size_t wlen = 0;
+
+	while (true) {
+		// Streaming may be stopped (EOS was set)
+		if (sync && mStream->isEndOfStream()) {
+			// Don't need to write anymore
+			medvdbg("EOS break\n");
+			break;
+		}
+
+		// Write data into stream as much as possible
+		size_t temp = mStream->write(buf + wlen, size - wlen);
+		mStream->notifyObserver(StreamBuffer::State::UPDATED, (ssize_t) temp);
+		wlen += temp;
+		if (temp > 0) {
+			// Reader may be waiting for more data
+			mStream->wakeReader();
+		}
+
+		if (!sync || wlen == size) {
+			break;
+		}
+
+		medvdbg("written %lu/%lu\n", wlen, size);
+		// There's not enough space
+		// Notify observer, shouldn't be blocked.
+		mStream->notifyObserver(StreamBuffer::State::OVERRUN);
+		// Then wait for reader.
+		mStream->waitForSpace();
+	}
+
+	medvdbg("written %lu\n", wlen);
+	return wlen;
+}
+
+size_t StreamBufferWriter::getWriteRegion(unsigned char **region, bool sync)
+{
+	size_t len = 0;
+
+	while (!mStream->isEndOfStream()) {
+		len = mStream->writeRegion(region);
+		if (len > 0 || !sync) {
+			break;
+		}
+
+		mStream->notifyObserver(StreamBuffer::State::OVERRUN);
+		mStream->waitForSpace();
+	}
+
+	return len;
+}
+
+size_t StreamBufferWriter::commitWrite(size_t size)
+{
+	size_t len = mStream->commitWrite(size);
+	mStream->notifyObserver(StreamBuffer::State::UPDATED, (ssize_t) len);
+	// Reader may be waiting for more data
+	mStream->wakeReader();
+	return len;
+}
+
+size_t StreamBufferWriter::sizeOfSpace()
+{
+	return mStream->sizeOfSpace();
+}
+
+void StreamBufferWriter::setEndOfStream()
+{
+	// Set EOS flag in stream.
+	mStream->setEndOfStream();
+
+	// Both sides may be waiting, EOS breaks reading and writing.
+	mStream->wakeReader();
+	mStream->wakeWriter();
+}
+#else
 size_t StreamBufferWriter::write(unsigned char *buf, size_t size, bool sync)
 {
 	medvdbg("size %lu sync %c\n", size, sync ? 'Y' : 'N');
@@ -82,6 +167,39 @@ size_t StreamBufferWriter::sizeOfSpace()
 	return mStream->sizeOfSpace();
 }
 
+size_t StreamBufferWriter::getWriteRegion(unsigned char **region, bool sync)
+{
+	std::unique_lock<std::mutex> lock(mStream->getMutex());
+
+	size_t len = 0;
+
+	while (!mStream->isEndOfStream()) {
+		len = mStream->writeRegion(region);
+		if (len > 0 || !sync) {
+			break;
+		}
+
+		// Notify observer, shouldn't be blocked.
+		mStream->notifyObserver(StreamBuffer::State::OVERRUN);
+		// Reader may be waiting for more data, so it's necessary to notify before waiting.
+		mStream->getCondv().notify_one();
+		// Then wait notification from reader.
+		mStream->getCondv().wait(lock);
+	}
+
+	return len;
+}
+
+size_t StreamBufferWriter::commitWrite(size_t size)
+{
+	std::lock_guard<std::mutex> lock(mStream->getMutex());
+	size_t len = mStream->commitWrite(size);
+	mStream->notifyObserver(StreamBuffer::State::UPDATED, (ssize_t) len);
+	// Reader may be waiting for more data, so it's necessary to notify after writing.
+	mStream->getCondv().notify_one();
+	return len;
+}
+
 void StreamBufferWriter::setEndOfStream()
 {
 	std::lock_guard<std::mutex> lock(mStream->getMutex());
@@ -92,6 +210,7 @@ void StreamBufferWriter::setEndOfStream()
 	// Reader may be waiting for more data, so it's necessary to notify.
 	mStream->getCondv().notify_one();
 }
+#endif
 
 } // namespace stream
 } // namespace media
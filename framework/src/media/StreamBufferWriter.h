@@ -33,6 +33,13 @@ public:
 public:
 	virtual size_t write(unsigned char *buf, size_t size, bool sync = true);
 	virtual size_t sizeOfSpace();
+	/**
+	 * Get contiguous space in stream buffer, to fill it in place without copy.
+	 * In sync mode, wait until there's space, 0 is returned only at end-of-stream.
+	 * The data filled must be published by commitWrite() before the next write.
+	 */
+	virtual size_t getWriteRegion(unsigned char **region, bool sync = true);
+	virtual size_t commitWrite(size_t size);
 
 public:
 	void setEndOfStream();
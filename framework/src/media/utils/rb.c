@@ -27,6 +27,10 @@
 #define IS_EMPTY(rbp) (rbp->rd_idx == rbp->wr_idx)
 #define IS_FULL(rbp) ((rbp->rd_idx & IDX_MASK) == (rbp->wr_idx & IDX_MASK) && (rbp->rd_idx & MSB_MASK) != (rbp->wr_idx & MSB_MASK))
 
+// Index accesses shared between producer and consumer, see rb.h
+#define LOAD_IDX(p_idx) __atomic_load_n((p_idx), __ATOMIC_ACQUIRE)
+#define STORE_IDX(p_idx, v) __atomic_store_n((p_idx), (v), __ATOMIC_RELEASE)
+
 /**
  * @brief  Increase the buffer index while writing or reading the ring-buffer.
  *         This is implemented according to the 'mirroring' solution:
@@ -38,6 +42,13 @@
  */
 static void _incr(rb_p rbp, volatile size_t *p_idx, size_t len);
 
+/**
+ * @brief  Get data bytes between the given read and write indexes.
+ *         Each index is loaded only once by the caller, so that the result
+ *         stays consistent while the other side keeps updating its index.
+ */
+static size_t _used(rb_p rbp, size_t rd_idx, size_t wr_idx);
+
 bool rb_init(rb_p rbp, size_t size)
 {
 	RETURN_VAL_IF_FAIL(rbp != NULL, false);
@@ -64,18 +75,7 @@ size_t rb_used(rb_p rbp)
 {
 	RETURN_VAL_IF_FAIL(rbp != NULL, SIZE_ZERO);
 
-	if (IS_EMPTY(rbp)) {
-		return SIZE_ZERO;
-	}
-
-	size_t wr_idx = (rbp->wr_idx & IDX_MASK);
-	size_t rd_idx = (rbp->rd_idx & IDX_MASK);
-
-	if (wr_idx > rd_idx) {
-		return (wr_idx - rd_idx);
-	}
-
-	return (rbp->depth - (rd_idx - wr_idx));
+	return _used(rbp, LOAD_IDX(&rbp->rd_idx), LOAD_IDX(&rbp->wr_idx));
 }
 
 size_t rb_avail(rb_p rbp)
@@ -155,12 +155,50 @@ size_t rb_read_ext(rb_p rbp, void *ptr, size_t len, size_t offset)
 	return len;
 }
 
+size_t rb_write_region(rb_p rbp, void **ptr)
+{
+	RETURN_VAL_IF_FAIL(rbp != NULL, SIZE_ZERO);
+	RETURN_VAL_IF_FAIL(ptr != NULL, SIZE_ZERO);
+
+	size_t avail = rb_avail(rbp);
+	size_t wr_idx = (rbp->wr_idx & IDX_MASK);
+
+	*ptr = (void *)((uint8_t *)rbp->buf + wr_idx);
+	return MINIMUM(avail, (rbp->depth - wr_idx));
+}
+
+size_t rb_write_commit(rb_p rbp, size_t len)
+{
+	RETURN_VAL_IF_FAIL(rbp != NULL, SIZE_ZERO);
+
+	len = MINIMUM(len, rb_avail(rbp));
+	_incr(rbp, &rbp->wr_idx, len);
+	return len;
+}
+
+size_t rb_read_region(rb_p rbp, const void **ptr)
+{
+	RETURN_VAL_IF_FAIL(rbp != NULL, SIZE_ZERO);
+	RETURN_VAL_IF_FAIL(ptr != NULL, SIZE_ZERO);
+
+	size_t used = rb_used(rbp);
+	size_t rd_idx = (rbp->rd_idx & IDX_MASK);
+
+	*ptr = (const void *)((const uint8_t *)rbp->buf + rd_idx);
+	return MINIMUM(used, (rbp->depth - rd_idx));
+}
+
+size_t rb_read_commit(rb_p rbp, size_t len)
+{
+	return rb_read(rbp, NULL, len);
+}
+
 bool rb_reset(rb_p rbp)
 {
 	RETURN_VAL_IF_FAIL(rbp != NULL, false);
 
-	rbp->rd_idx = 0;
-	rbp->wr_idx = 0;
+	STORE_IDX(&rbp->rd_idx, 0);
+	STORE_IDX(&rbp->wr_idx, 0);
 
 	return true;
 }
@@ -176,5 +214,22 @@ static void _incr(rb_p rbp, volatile size_t *p_idx, size_t len)
 		idx -= rbp->depth;
 	}
 
-	*p_idx = msb | idx;
+	// Publish the index only after the data access it covers is done
+	STORE_IDX(p_idx, (msb | idx));
+}
+
+static size_t _used(rb_p rbp, size_t rd_idx, size_t wr_idx)
+{
+	if (rd_idx == wr_idx) {
+		return SIZE_ZERO;
+	}
+
+	wr_idx &= IDX_MASK;
+	rd_idx &= IDX_MASK;
+
+	if (wr_idx > rd_idx) {
+		return (wr_idx - rd_idx);
+	}
+
+	return (rbp->depth - (rd_idx - wr_idx));
 }
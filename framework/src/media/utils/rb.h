@@ -38,6 +38,12 @@ struct rb_s {
 	volatile size_t wr_idx;     /* MSB is used for the 'mirror' flag */
 };
 
+/* With a single producer and a single consumer, the ring-buffer needs no lock:
+ * wr_idx is only changed by the producer and rd_idx only by the consumer.
+ * Each index is published with release semantics after the data access it
+ * covers, and read with acquire semantics by the other side.
+ */
+
 typedef struct rb_s  rb_t;
 typedef struct rb_s *rb_p;
 
@@ -102,6 +108,44 @@ size_t rb_read(rb_p rbp, void *ptr, size_t len);
  */
 size_t rb_read_ext(rb_p rbp, void *ptr, size_t len, size_t offset);
 
+/**
+ * @brief  Get the contiguous free space at the write position, so that the
+ *         producer can fill the ring-buffer in place.
+ *         The space is published to the consumer by rb_write_commit().
+ * @param  rbp: Pointer to the ring-buffer object
+ * @param  ptr: Pointer to save the start address of the free space
+ * @return size of contiguous free space in bytes. It is less than rb_avail()
+ *         when the free space wraps around the end of the buffer.
+ */
+size_t rb_write_region(rb_p rbp, void **ptr);
+
+/**
+ * @brief  Publish data filled in the region got by rb_write_region().
+ * @param  rbp: Pointer to the ring-buffer object
+ * @param  len: length of the data filled
+ * @return size of data published, range[0, len]
+ */
+size_t rb_write_commit(rb_p rbp, size_t len);
+
+/**
+ * @brief  Get the contiguous data at the read position, so that the consumer
+ *         can use the data in place. rd_idx will not be increased.
+ * @param  rbp: Pointer to the ring-buffer object
+ * @param  ptr: Pointer to save the start address of the data
+ * @return size of contiguous data in bytes. It is less than rb_used()
+ *         when the data wraps around the end of the buffer.
+ */
+size_t rb_read_region(rb_p rbp, const void **ptr);
+
+/**
+ * @brief  Release data used in the region got by rb_read_region().
+ *         Same as rb_read() with 'ptr' NULL.
+ * @param  rbp: Pointer to the ring-buffer object
+ * @param  len: length of the data used
+ * @return size rd_idx increased, range[0, len]
+ */
+size_t rb_read_commit(rb_p rbp, size_t len);
+
 /**
  * @brief  Reset ring-buffer, data in ring-buffer will be dropped.
  * @param  rbp: Pointer to the ring-buffer object
@@ -34,6 +34,7 @@ EPDInferenceHandler::EPDInferenceHandler(InferenceResultListener listener) :
 EPDInferenceHandler::~EPDInferenceHandler()
 {
 	medvdbg("EPDInferenceHandler destructor");
+	stop();
 }
 
 AIFW_RESULT EPDInferenceHandler::prepare(void)
@@ -23,11 +23,14 @@
 #ifndef CONFIG_SPEECH_DETECTOR_LISTENER_STACKSIZE
 #define CONFIG_SPEECH_DETECTOR_LISTENER_STACKSIZE 4096
 #endif
+#ifndef CONFIG_SPEECH_DETECTOR_LISTENER_QUEUE_SIZE
+#define CONFIG_SPEECH_DETECTOR_LISTENER_QUEUE_SIZE 16
+#endif
 
 namespace media {
 namespace voice {
 
-SpeechDetectorListenerWorker::SpeechDetectorListenerWorker()
+SpeechDetectorListenerWorker::SpeechDetectorListenerWorker() : MediaWorker(CONFIG_SPEECH_DETECTOR_LISTENER_QUEUE_SIZE)
 {
 	medvdbg("SpeechDetectorListenerWorker::SpeechDetectorListenerWorker()\n");
 	mThreadName = "SpeechDetectorListenerWorker";
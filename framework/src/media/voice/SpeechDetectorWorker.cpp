@@ -23,11 +23,14 @@
 #ifndef CONFIG_SPEECH_DETECTOR_STACKSIZE
 #define CONFIG_SPEECH_DETECTOR_STACKSIZE 4096
 #endif
+#ifndef CONFIG_SPEECH_DETECTOR_QUEUE_SIZE
+#define CONFIG_SPEECH_DETECTOR_QUEUE_SIZE 8
+#endif
 
 namespace media {
 namespace voice {
 
-SpeechDetectorWorker::SpeechDetectorWorker()
+SpeechDetectorWorker::SpeechDetectorWorker() : MediaWorker(CONFIG_SPEECH_DETECTOR_QUEUE_SIZE)
 {
 	medvdbg("SpeechDetectorWorker::SpeechDetectorWorker()\n");
 	mThreadName = "SpeechDetectorWorker";
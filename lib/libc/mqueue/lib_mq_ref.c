@@ -0,0 +1,212 @@
+/****************************************************************************
+ *
+ * Copyright 2025 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <tinyara/config.h>
+
+#include <sys/types.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <semaphore.h>
+#include <mqueue.h>
+#include <errno.h>
+#include <assert.h>
+
+#include "lib_internal.h"
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define MQREF_BUFSIZE \
+	((CONFIG_MQ_REFERENCE_BUFSIZE + sizeof(uintptr_t) - 1) & ~(sizeof(uintptr_t) - 1))
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+/* The shared pool.  Free buffers are linked through their first word. */
+
+static uintptr_t g_mqref_pool[CONFIG_MQ_REFERENCE_NBUFFERS * MQREF_BUFSIZE / sizeof(uintptr_t)];
+static FAR void *g_mqref_free;
+static bool g_mqref_initialized;
+static sem_t g_mqref_sem = SEM_INITIALIZER(1);
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+static void mq_ref_lock(void)
+{
+	while (sem_wait(&g_mqref_sem) != 0) {
+		/* The only case that an error should occur here is if the wait
+		 * was awakened by a signal.
+		 */
+
+		ASSERT(get_errno() == EINTR);
+	}
+}
+
+static void mq_ref_unlock(void)
+{
+	sem_post(&g_mqref_sem);
+}
+
+static bool mq_ref_inpool(FAR void *buffer)
+{
+	return (FAR uint8_t *)buffer >= (FAR uint8_t *)g_mqref_pool &&
+		   (FAR uint8_t *)buffer < (FAR uint8_t *)g_mqref_pool + sizeof(g_mqref_pool);
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: mq_refalloc
+ *
+ * Description:
+ *   Get a buffer for a message that will be sent with mq_sendref().  It is
+ *   taken from the shared pool if it fits and a pooled buffer is free,
+ *   otherwise from the heap.
+ *
+ ****************************************************************************/
+
+FAR void *mq_refalloc(size_t size)
+{
+	FAR void *buffer = NULL;
+	int i;
+
+	if (size <= CONFIG_MQ_REFERENCE_BUFSIZE) {
+		mq_ref_lock();
+		if (!g_mqref_initialized) {
+			for (i = CONFIG_MQ_REFERENCE_NBUFFERS - 1; i >= 0; i--) {
+				buffer = (FAR uint8_t *)g_mqref_pool + i * MQREF_BUFSIZE;
+				*(FAR void **)buffer = g_mqref_free;
+				g_mqref_free = buffer;
+			}
+
+			g_mqref_initialized = true;
+		}
+
+		buffer = g_mqref_free;
+		if (buffer) {
+			g_mqref_free = *(FAR void **)buffer;
+		}
+		mq_ref_unlock();
+	}
+
+	if (!buffer) {
+		buffer = lib_malloc(size);
+		if (!buffer) {
+			set_errno(ENOMEM);
+		}
+	}
+
+	return buffer;
+}
+
+/****************************************************************************
+ * Name: mq_reffree
+ *
+ * Description:
+ *   Release a buffer obtained with mq_refalloc() or mq_receiveref().
+ *
+ ****************************************************************************/
+
+void mq_reffree(FAR void *buffer)
+{
+	if (!buffer) {
+		return;
+	}
+
+	if (mq_ref_inpool(buffer)) {
+		DEBUGASSERT(((FAR uint8_t *)buffer - (FAR uint8_t *)g_mqref_pool) % MQREF_BUFSIZE == 0);
+
+		mq_ref_lock();
+		*(FAR void **)buffer = g_mqref_free;
+		g_mqref_free = buffer;
+		mq_ref_unlock();
+	} else {
+		lib_free(buffer);
+	}
+}
+
+/****************************************************************************
+ * Name: mq_sendref
+ *
+ * Description:
+ *   Queue a reference to buffer instead of its contents.  On success the
+ *   buffer belongs to the receiver.
+ *
+ ****************************************************************************/
+
+int mq_sendref(mqd_t mqdes, FAR void *buffer, size_t buflen, int prio)
+{
+	struct mq_ref_s ref;
+
+	if (!buffer) {
+		set_errno(EINVAL);
+		return ERROR;
+	}
+
+	ref.buffer = buffer;
+	ref.buflen = buflen;
+	return mq_send(mqdes, (FAR const char *)&ref, sizeof(ref), prio);
+}
+
+/****************************************************************************
+ * Name: mq_receiveref
+ *
+ * Description:
+ *   Receive a reference queued by mq_sendref().  The message is received
+ *   into a buffer of CONFIG_MQ_MAXMSGSIZE bytes so that mq_receive()
+ *   accepts it whatever mq_msgsize the queue was opened with.
+ *
+ ****************************************************************************/
+
+ssize_t mq_receiveref(mqd_t mqdes, FAR void **buffer, FAR int *prio)
+{
+	union {
+		struct mq_ref_s ref;
+		char msg[CONFIG_MQ_MAXMSGSIZE];
+	} u;
+	ssize_t ret;
+
+	if (!buffer) {
+		set_errno(EINVAL);
+		return ERROR;
+	}
+
+	ret = mq_receive(mqdes, u.msg, sizeof(u), prio);
+	if (ret < 0) {
+		return ERROR;
+	}
+
+	if (ret != sizeof(struct mq_ref_s)) {
+		set_errno(EBADMSG);
+		return ERROR;
+	}
+
+	*buffer = u.ref.buffer;
+	return u.ref.buflen;
+}
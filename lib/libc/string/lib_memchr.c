@@ -58,6 +58,8 @@
 
 #include <string.h>
 
+#include "lib_word.h"
+
 /****************************************************************************
  * Global Functions
  ****************************************************************************/
@@ -79,8 +81,33 @@
 FAR void *memchr(FAR const void *s, int c, size_t n)
 {
 	FAR const unsigned char *p = (FAR const unsigned char *)s;
+#ifdef CONFIG_MEMCHR_OPTSPEED
+	FAR const lib_word_t *w;
+	lib_word_t pattern;
+#endif
 
 	if (s) {
+#ifdef CONFIG_MEMCHR_OPTSPEED
+		while (n > 0 && !LIB_ALIGNED(p)) {
+			if (*p == (unsigned char)c) {
+				return (FAR void *)p;
+			}
+
+			p++;
+			n--;
+		}
+
+		/* Skip the words which do not contain 'c' */
+
+		pattern = LIB_ONES * (unsigned char)c;
+		w = (FAR const lib_word_t *)p;
+		while (n >= LIB_WORDSIZE && !LIB_HASZERO(*w ^ pattern)) {
+			w++;
+			n -= LIB_WORDSIZE;
+		}
+
+		p = (FAR const unsigned char *)w;
+#endif
 		while (n--) {
 			if (*p == (unsigned char)c) {
 				return (FAR void *)p;
@@ -62,6 +62,8 @@
 #include <sys/types.h>
 #include <string.h>
 
+#include "lib_word.h"
+
 /************************************************************
  * Global Functions
  ************************************************************/
@@ -71,6 +73,35 @@ int memcmp(FAR const void *s1, FAR const void *s2, size_t n)
 {
 	unsigned char *p1 = (unsigned char *)s1;
 	unsigned char *p2 = (unsigned char *)s2;
+#ifdef CONFIG_MEMCMP_OPTSPEED
+	const lib_word_t *w1;
+	const lib_word_t *w2;
+
+	if (n >= LIB_WORDSIZE && LIB_SAMEALIGN(p1, p2)) {
+		while (!LIB_ALIGNED(p1)) {
+			if (*p1 != *p2) {
+				return (*p1 < *p2) ? -1 : 1;
+			}
+
+			p1++;
+			p2++;
+			n--;
+		}
+
+		/* Skip the equal words, the loop below locates the first difference */
+
+		w1 = (const lib_word_t *)p1;
+		w2 = (const lib_word_t *)p2;
+		while (n >= LIB_WORDSIZE && *w1 == *w2) {
+			w1++;
+			w2++;
+			n -= LIB_WORDSIZE;
+		}
+
+		p1 = (unsigned char *)w1;
+		p2 = (unsigned char *)w2;
+	}
+#endif
 
 	while (n-- > 0) {
 		if (*p1 < *p2) {
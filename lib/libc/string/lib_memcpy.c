@@ -62,6 +62,8 @@
 #include <sys/types.h>
 #include <string.h>
 
+#include "lib_word.h"
+
 /****************************************************************************
  * Global Functions
  ****************************************************************************/
@@ -75,6 +77,45 @@ FAR void *memcpy(FAR void *dest, FAR const void *src, size_t n)
 {
 	FAR unsigned char *pout = (FAR unsigned char *)dest;
 	FAR unsigned char *pin = (FAR unsigned char *)src;
+#ifdef CONFIG_MEMCPY_OPTSPEED
+	FAR lib_word_t *wout;
+	FAR const lib_word_t *win;
+
+	/* Words can only be copied if both buffers get aligned together */
+
+	if (n >= LIB_WORDSIZE && LIB_SAMEALIGN(pout, pin)) {
+		while (!LIB_ALIGNED(pout)) {
+			*pout++ = *pin++;
+			n--;
+		}
+
+		wout = (FAR lib_word_t *)pout;
+		win = (FAR const lib_word_t *)pin;
+
+		/* Unrolled so that load/store multiple instructions can be used */
+
+		while (n >= 4 * LIB_WORDSIZE) {
+			wout[0] = win[0];
+			wout[1] = win[1];
+			wout[2] = win[2];
+			wout[3] = win[3];
+			wout += 4;
+			win += 4;
+			n -= 4 * LIB_WORDSIZE;
+		}
+
+		while (n >= LIB_WORDSIZE) {
+			*wout++ = *win++;
+			n -= LIB_WORDSIZE;
+		}
+
+		pout = (FAR unsigned char *)wout;
+		pin = (FAR unsigned char *)win;
+	}
+#endif
+
+	/* Unaligned buffers and the remaining tail */
+
 	while (n-- > 0) {
 		*pout++ = *pin++;
 	}
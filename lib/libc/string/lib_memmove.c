@@ -62,6 +62,8 @@
 #include <sys/types.h>
 #include <string.h>
 
+#include "lib_word.h"
+
 /************************************************************
  * Global Functions
  ************************************************************/
@@ -70,15 +72,79 @@
 FAR void *memmove(FAR void *dest, FAR const void *src, size_t count)
 {
 	char *tmp, *s;
+#ifdef CONFIG_MEMMOVE_OPTSPEED
+	lib_word_t *wtmp;
+	const lib_word_t *ws;
+#endif
 	if (dest <= src) {
 		tmp = (char *)dest;
 		s = (char *)src;
+#ifdef CONFIG_MEMMOVE_OPTSPEED
+		/* Copying forward, each word is read before it can be overwritten */
+
+		if (count >= LIB_WORDSIZE && LIB_SAMEALIGN(tmp, s)) {
+			while (!LIB_ALIGNED(tmp)) {
+				*tmp++ = *s++;
+				count--;
+			}
+
+			wtmp = (lib_word_t *)tmp;
+			ws = (const lib_word_t *)s;
+			while (count >= 4 * LIB_WORDSIZE) {
+				wtmp[0] = ws[0];
+				wtmp[1] = ws[1];
+				wtmp[2] = ws[2];
+				wtmp[3] = ws[3];
+				wtmp += 4;
+				ws += 4;
+				count -= 4 * LIB_WORDSIZE;
+			}
+
+			while (count >= LIB_WORDSIZE) {
+				*wtmp++ = *ws++;
+				count -= LIB_WORDSIZE;
+			}
+
+			tmp = (char *)wtmp;
+			s = (char *)ws;
+		}
+#endif
 		while (count--) {
 			*tmp++ = *s++;
 		}
 	} else {
 		tmp = (char *)dest + count;
 		s = (char *)src + count;
+#ifdef CONFIG_MEMMOVE_OPTSPEED
+		/* Copying backward, from the highest word down */
+
+		if (count >= LIB_WORDSIZE && LIB_SAMEALIGN(tmp, s)) {
+			while (!LIB_ALIGNED(tmp)) {
+				*--tmp = *--s;
+				count--;
+			}
+
+			wtmp = (lib_word_t *)tmp;
+			ws = (const lib_word_t *)s;
+			while (count >= 4 * LIB_WORDSIZE) {
+				wtmp -= 4;
+				ws -= 4;
+				wtmp[3] = ws[3];
+				wtmp[2] = ws[2];
+				wtmp[1] = ws[1];
+				wtmp[0] = ws[0];
+				count -= 4 * LIB_WORDSIZE;
+			}
+
+			while (count >= LIB_WORDSIZE) {
+				*--wtmp = *--ws;
+				count -= LIB_WORDSIZE;
+			}
+
+			tmp = (char *)wtmp;
+			s = (char *)ws;
+		}
+#endif
 		while (count--) {
 			*--tmp = *--s;
 		}
@@ -89,7 +89,8 @@ void *memset(void *s, int c, size_t n)
 	 */
 
 	uintptr_t addr = (uintptr_t)s;
-	uint16_t val16 = ((uint16_t)c << 8) | (uint16_t)c;
+	uint8_t val8 = (uint8_t)c;
+	uint16_t val16 = ((uint16_t)val8 << 8) | (uint16_t)val8;
 	uint32_t val32 = ((uint32_t)val16 << 16) | (uint32_t)val16;
 #ifdef CONFIG_MEMSET_64BIT
 	uint64_t val64 = ((uint64_t)val32 << 32) | (uint64_t)val32;
@@ -101,7 +102,7 @@ void *memset(void *s, int c, size_t n)
 		/* Align to a 16-bit boundary */
 
 		if ((addr & 1) != 0) {
-			*(uint8_t *)addr = (uint8_t)c;
+			*(uint8_t *)addr = val8;
 			addr += 1;
 			n -= 1;
 		}
@@ -177,7 +178,7 @@ void *memset(void *s, int c, size_t n)
 		}
 
 		if (n >= 1) {
-			*(uint8_t *)addr = (uint8_t)c;
+			*(uint8_t *)addr = val8;
 		}
 	}
 #else
@@ -58,6 +58,8 @@
 #include <sys/types.h>
 #include <string.h>
 
+#include "lib_word.h"
+
 /****************************************************************************
  * Global Functions
  ****************************************************************************/
@@ -66,10 +68,29 @@
 size_t strlen(const char *s)
 {
 	const char *sc;
+#ifdef CONFIG_STRLEN_OPTSPEED
+	const lib_word_t *w;
+#endif
 	if (s == NULL) {
 		return 0;
 	}
-	for (sc = s; *sc != '\0'; ++sc);
+#ifdef CONFIG_STRLEN_OPTSPEED
+	for (sc = s; !LIB_ALIGNED(sc); ++sc) {
+		if (*sc == '\0') {
+			return sc - s;
+		}
+	}
+
+	/* An aligned word never crosses a page or region boundary, so reading
+	 * the whole word holding the terminator is safe.
+	 */
+
+	for (w = (const lib_word_t *)sc; !LIB_HASZERO(*w); ++w);
+	sc = (const char *)w;
+#else
+	sc = s;
+#endif
+	for (; *sc != '\0'; ++sc);
 	return sc - s;
 }
 #endif
@@ -0,0 +1,64 @@
+/****************************************************************************
+ *
+ * Copyright 2025 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+#ifndef __LIB_LIBC_STRING_LIB_WORD_H
+#define __LIB_LIBC_STRING_LIB_WORD_H
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <stdint.h>
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Helpers of the word-at-a-time string and memory functions */
+
+#define LIB_WORDSIZE           sizeof(lib_word_t)
+#define LIB_WORDMASK           (LIB_WORDSIZE - 1)
+
+/* True if 'p' is aligned to a word boundary */
+
+#define LIB_ALIGNED(p)         (((uintptr_t)(p) & LIB_WORDMASK) == 0)
+
+/* True if 'p1' and 'p2' become word aligned after the same number of bytes */
+
+#define LIB_SAMEALIGN(p1, p2)  ((((uintptr_t)(p1) ^ (uintptr_t)(p2)) & LIB_WORDMASK) == 0)
+
+/* 0x01 and 0x80 repeated in every byte of a word */
+
+#define LIB_ONES               ((lib_word_t)-1 / 0xff)
+#define LIB_HIGHS              (LIB_ONES * 0x80)
+
+/* Non-zero if any byte of word 'w' is zero */
+
+#define LIB_HASZERO(w)         (((w) - LIB_ONES) & ~(w) & LIB_HIGHS)
+
+/****************************************************************************
+ * Public Types
+ ****************************************************************************/
+
+/* A machine word which may alias any other type, so that byte buffers can
+ * be accessed through it.
+ */
+
+typedef uintptr_t lib_word_t __attribute__((__may_alias__));
+
+#endif							/* __LIB_LIBC_STRING_LIB_WORD_H */
@@ -61,11 +61,13 @@
 #include <errno.h>
 #include <assert.h>
 #include <debug.h>
+#include <semaphore.h>
 
 #include <tinyara/elf.h>
 #include <tinyara/binfmt/elf.h>
 #include <tinyara/binfmt/symtab.h>
 #include <tinyara/kmalloc.h>
+#include <tinyara/wqueue.h>
 
 #include "libelf.h"
 
@@ -79,10 +81,55 @@
 #define elf_dumpbuffer(m, b, n)
 #endif
 
+/* Number of relocation entries read from the file at once */
+
+#ifdef CONFIG_ELF_RELOCATION_BUFFERCOUNT
+#define ELF_RELOC_BUFCOUNT CONFIG_ELF_RELOCATION_BUFFERCOUNT
+#else
+#define ELF_RELOC_BUFCOUNT 128
+#endif
+
+/* Number of resolved symbols kept when the symbol table is not in memory */
+
+#ifdef CONFIG_ELF_SYMBOL_CACHECOUNT
+#define ELF_SYMCACHE_COUNT CONFIG_ELF_SYMBOL_CACHECOUNT
+#else
+#define ELF_SYMCACHE_COUNT 64
+#endif
+
+#if defined(CONFIG_ELF_RELOCATE_PARALLEL) && defined(CONFIG_SMP) && \
+	defined(CONFIG_SCHED_LPWORK) && CONFIG_SCHED_LPNTHREADS > 1
+#define ELF_RELOC_PARALLEL
+#endif
+
+#ifndef MIN
+#define MIN(a, b) ((a) < (b) ? (a) : (b))
+#endif
+
 /****************************************************************************
  * Private Types
  ****************************************************************************/
 
+/* A resolved symbol, direct mapped by its symbol table index */
+
+struct elf_symcache_s {
+	int idx;					/* Symbol table index, -1 if unused */
+	Elf32_Sym sym;				/* Symbol with st_value resolved */
+};
+
+#ifdef ELF_RELOC_PARALLEL
+/* The relocations of one section, applied by a low priority worker */
+
+struct elf_reljob_s {
+	struct work_s work;
+	FAR sem_t *done;
+	FAR struct elf_loadinfo_s *loadinfo;
+	FAR Elf32_Rel *rels;		/* The whole relocation table */
+	int relidx;					/* Index of the relocation section */
+	int ret;
+};
+#endif
+
 /****************************************************************************
  * Private Data
  ****************************************************************************/
@@ -97,51 +144,127 @@ static int g_num_lib_syms;
  ****************************************************************************/
 
 /****************************************************************************
- * Name: elf_readreltab
+ * Name: elf_relsection
  *
  * Description:
- *   Read the relocation table into memory.
+ *   Return the type (SHT_REL or SHT_RELA) of section 'relidx' if it holds
+ *   relocations for a section which was loaded into memory, 0 otherwise.
  *
  ****************************************************************************/
-static inline void elf_readreltab(FAR struct elf_loadinfo_s *loadinfo, FAR const Elf32_Shdr *relsec)
+
+static int elf_relsection(FAR struct elf_loadinfo_s *loadinfo, int relidx)
 {
-	loadinfo->reltab = (uintptr_t)kmm_malloc(relsec->sh_size);
+	int infosec = loadinfo->shdr[relidx].sh_info;
 
-	if (!loadinfo->reltab) {
-		berr("ERROR: Failed to allocate space for relocation table. Size = %u\n", relsec->sh_size);
-		return;
+	if (infosec >= loadinfo->ehdr.e_shnum) {
+		return 0;
 	}
 
-	if (elf_read(loadinfo, (FAR uint8_t *)loadinfo->reltab, relsec->sh_size, relsec->sh_offset) < 0) {
-		berr("ERROR: Failed to read relocation table into memory\n");
+	/* Make sure that the section is allocated.  We can't relocated
+	 * sections that were not loaded into memory.
+	 */
+
+	if ((loadinfo->shdr[infosec].sh_flags & SHF_ALLOC) == 0) {
+		return 0;
 	}
-}
 
+	if (loadinfo->shdr[relidx].sh_type == SHT_REL || loadinfo->shdr[relidx].sh_type == SHT_RELA) {
+		return loadinfo->shdr[relidx].sh_type;
+	}
+
+	return 0;
+}
 
 /****************************************************************************
- * Name: elf_readrel
+ * Name: elf_getsym
  *
  * Description:
- *   Read the ELF32_Rel structure into memory.
+ *   Get the symbol 'symidx' with its value resolved.  Each distinct symbol
+ *   is looked up only once per load: the entries of an in-memory symbol
+ *   table are turned into SHN_ABS in place by elf_symvalue(), otherwise the
+ *   resolved copy is kept in 'cache' when there is one.  'sym' is only used
+ *   when neither is available.
+ *
+ * Returned Value:
+ *   0 (OK) is returned on success and a negated errno is returned on
+ *   failure.  -ESRCH is returned for a nameless symbol, as by
+ *   elf_symvalue().
  *
  ****************************************************************************/
 
-static inline int elf_readrel(FAR struct elf_loadinfo_s *loadinfo, FAR const Elf32_Shdr *relsec, int index, FAR Elf32_Rel *rel)
+static int elf_getsym(FAR struct elf_loadinfo_s *loadinfo, int symidx, FAR Elf32_Sym *sym, FAR struct elf_symcache_s *cache, FAR Elf32_Sym **psym, FAR const struct symtab_s *exports, int nexports)
 {
-	off_t offset;
+#if ELF_SYMCACHE_COUNT > 0
+	FAR struct elf_symcache_s *entry;
+#endif
+	int ret;
 
 	/* Verify that the symbol table index lies within symbol table */
 
-	if (index < 0 || index > (relsec->sh_size / sizeof(Elf32_Rel))) {
-		berr("Bad relocation symbol index: %d\n", index);
+	if (symidx < 0 || symidx >= (loadinfo->shdr[loadinfo->symtabidx].sh_size / sizeof(Elf32_Sym))) {
+		berr("Bad relocation symbol index: %d\n", symidx);
 		return -EINVAL;
 	}
 
-	/* Get the file offset to the symbol table entry */
-	offset = relsec->sh_offset + sizeof(Elf32_Rel) * index;
+	if (loadinfo->symtab) {
+		*psym = (FAR Elf32_Sym *)(loadinfo->symtab + sizeof(Elf32_Sym) * symidx);
+#if ELF_SYMCACHE_COUNT > 0
+	} else if (cache) {
+		entry = &cache[symidx % ELF_SYMCACHE_COUNT];
+		if (entry->idx != symidx) {
+			ret = elf_readsym(loadinfo, symidx, &entry->sym);
+			if (ret < 0) {
+				entry->idx = -1;
+				return ret;
+			}
+			entry->idx = symidx;
+		}
+		*psym = &entry->sym;
+#endif
+	} else {
+		ret = elf_readsym(loadinfo, symidx, sym);
+		if (ret < 0) {
+			return ret;
+		}
+		*psym = sym;
+	}
+
+	/* Get the value of the symbol (in st_value).  This returns at once for
+	 * a symbol which was already resolved.
+	 */
 
-	/* And, finally, read the symbol table entry into memory */
-	return elf_read(loadinfo, (FAR uint8_t *)rel, sizeof(Elf32_Rel), offset);
+	return elf_symvalue(loadinfo, *psym, exports, nexports);
+}
+
+/****************************************************************************
+ * Name: elf_relocone
+ *
+ * Description:
+ *   Apply one relocation entry of section 'relidx' using the resolved
+ *   symbol 'psym' (NULL for a nameless symbol).
+ *
+ ****************************************************************************/
+
+static int elf_relocone(FAR struct elf_loadinfo_s *loadinfo, int relidx, int i, FAR const Elf32_Rel *rel, FAR const Elf32_Sym *psym)
+{
+	FAR Elf32_Shdr *dstsec = &loadinfo->shdr[loadinfo->shdr[relidx].sh_info];
+	int ret;
+
+	/* Calculate the relocation address. */
+
+	if (rel->r_offset > dstsec->sh_size - sizeof(uint32_t)) {
+		berr("Section %d reloc %d: Relocation address out of range, offset %d size %d\n", relidx, i, rel->r_offset, dstsec->sh_size);
+		return -EINVAL;
+	}
+
+	/* Now perform the architecture-specific relocation */
+
+	ret = up_relocate(rel, psym, dstsec->sh_addr + rel->r_offset);
+	if (ret < 0) {
+		berr("ERROR: Section %d reloc %d: Relocation failed: %d\n", relidx, i, ret);
+	}
+
+	return ret;
 }
 
 /****************************************************************************
@@ -156,125 +279,262 @@ static inline int elf_readrel(FAR struct elf_loadinfo_s *loadinfo, FAR const Elf
  *
  ****************************************************************************/
 
-static int elf_relocate(FAR struct elf_loadinfo_s *loadinfo, int relidx, FAR const struct symtab_s *exports, int nexports)
+static int elf_relocate(FAR struct elf_loadinfo_s *loadinfo, int relidx, FAR struct elf_symcache_s *cache, FAR const struct symtab_s *exports, int nexports)
 {
 	FAR Elf32_Shdr *relsec = &loadinfo->shdr[relidx];
-	FAR Elf32_Shdr *dstsec = &loadinfo->shdr[relsec->sh_info];
+	FAR Elf32_Rel *rels;
+	FAR Elf32_Sym *psym;
 	Elf32_Rel rel;
 	Elf32_Sym sym;
-	FAR Elf32_Sym *psym;
-	Elf32_Rel *prel;
-	uintptr_t addr;
+	int nrels = relsec->sh_size / sizeof(Elf32_Rel);
+	int bufcount;
+	int count;
 	int symidx;
 	int ret = OK;
 	int i;
+	int j;
+
+	/* Stream the relocation table through a buffer of ELF_RELOC_BUFCOUNT
+	 * entries, or entry by entry if that can not be allocated.
+	 */
+
+	bufcount = MIN(nrels, ELF_RELOC_BUFCOUNT);
+	if (bufcount > 1) {
+		loadinfo->reltab = (uintptr_t)kmm_malloc(bufcount * sizeof(Elf32_Rel));
+	}
 
-	/* Read the relocation table into memory */
-	elf_readreltab(loadinfo, relsec);
+	if (loadinfo->reltab) {
+		rels = (FAR Elf32_Rel *)loadinfo->reltab;
+	} else {
+		rels = &rel;
+		bufcount = 1;
+	}
 
 	/* Examine each relocation in the section.  'relsec' is the section
 	 * containing the relations.  'dstsec' is the section containing the data
 	 * to be relocated.
 	 */
 
-	for (i = 0; i < relsec->sh_size / sizeof(Elf32_Rel); i++) {
-		psym = &sym;
-		prel = &rel;
+	for (i = 0; i < nrels; i += count) {
+		count = MIN(bufcount, nrels - i);
+		ret = elf_read(loadinfo, (FAR uint8_t *)rels, count * sizeof(Elf32_Rel), relsec->sh_offset + i * sizeof(Elf32_Rel));
+		if (ret < 0) {
+			berr("Section %d reloc %d: Failed to read relocation entries: %d\n", relidx, i, ret);
+			goto ret_err;
+		}
+
+		for (j = 0; j < count; j++) {
+			/* Get the symbol table index for the relocation.  This is
+			 * contained in a bit-field within the r_info element.
+			 */
 
+			symidx = ELF32_R_SYM(rels[j].r_info);
 
-		/* Read the relocation entry into memory */
-		if (loadinfo->reltab) {
-			/* Verify that the relocation table index lies within relocation table */
-			if (i < 0 || i > (relsec->sh_size / sizeof(Elf32_Rel))) {
-				berr("Bad relocation symbol index: %d\n", i);
-				ret = -EINVAL;
-				goto ret_err;
+			ret = elf_getsym(loadinfo, symidx, &sym, cache, &psym, exports, nexports);
+			if (ret < 0) {
+				/* The special error -ESRCH is returned only in one condition:
+				 * The symbol has no name.
+				 *
+				 * There are a few relocations for a few architectures that do
+				 * no depend upon a named symbol.  We don't know if that is the
+				 * case here, but we will use a NULL symbol pointer to indicate
+				 * that case to up_relocate().  That function can then do what
+				 * is best.
+				 */
+
+				if (ret == -ESRCH) {
+					berr("Section %d reloc %d: Undefined symbol[%d] has no name: %d\n", relidx, i + j, symidx, ret);
+					psym = NULL;
+				} else {
+					berr("Section %d reloc %d: Failed to get value of symbol[%d]: %d\n", relidx, i + j, symidx, ret);
+					goto ret_err;
+				}
 			}
-			prel = (Elf32_Rel *)(loadinfo->reltab + sizeof(Elf32_Rel) * i);
-		} else {
-			ret = elf_readrel(loadinfo, relsec, i, &rel);
+
+			ret = elf_relocone(loadinfo, relidx, i + j, &rels[j], psym);
 			if (ret < 0) {
-				berr("Section %d reloc %d: Failed to read relocation entry: %d\n", relidx, i, ret);
 				goto ret_err;
 			}
 		}
+	}
 
-		/* Get the symbol table index for the relocation.  This is contained
-		 * in a bit-field within the r_info element.
-		 */
+ret_err:
+	if (loadinfo->reltab) {
+		kmm_free((void *)loadinfo->reltab);
+		loadinfo->reltab = (uintptr_t)NULL;
+	}
+	return ret;
+}
 
-		symidx = ELF32_R_SYM(prel->r_info);
+static int elf_relocateadd(FAR struct elf_loadinfo_s *loadinfo, int relidx, FAR const struct symtab_s *exports, int nexports)
+{
+	berr("Not implemented\n");
+	return -ENOSYS;
+}
 
-		/* Read the symbol table entry into memory */
-		if (loadinfo->symtab) {
-			/* Verify that the symbol table index lies within symbol table */
-			if (symidx < 0 || symidx > (loadinfo->shdr[loadinfo->symtabidx].sh_size / sizeof(Elf32_Sym))) {
-				berr("Bad relocation symbol index: %d\n", symidx);
-				ret = -EINVAL;
-				goto ret_err;
-			}
-			psym = (FAR Elf32_Sym *)(loadinfo->symtab + sizeof(Elf32_Sym) * symidx);
-		} else {
-			ret = elf_readsym(loadinfo, symidx, &sym);
-			if (ret < 0) {
-				berr("Section %d reloc %d: Failed to read symbol[%d]: %d\n", relidx, i, symidx, ret);
-				goto ret_err;
-			}
+#ifdef ELF_RELOC_PARALLEL
+/****************************************************************************
+ * Name: elf_relocate_job
+ *
+ * Description:
+ *   Apply the relocations of one section.  All symbols were resolved in
+ *   the in-memory symbol table beforehand, so this only reads it and can
+ *   run for several sections at the same time.
+ *
+ ****************************************************************************/
+
+static void elf_relocate_job(FAR struct elf_reljob_s *job)
+{
+	FAR struct elf_loadinfo_s *loadinfo = job->loadinfo;
+	FAR Elf32_Sym *psym;
+	int nrels = loadinfo->shdr[job->relidx].sh_size / sizeof(Elf32_Rel);
+	int i;
+
+	for (i = 0; i < nrels; i++) {
+		psym = (FAR Elf32_Sym *)(loadinfo->symtab + sizeof(Elf32_Sym) * ELF32_R_SYM(job->rels[i].r_info));
+
+		/* Only nameless symbols are left undefined */
+
+		if (psym->st_shndx == SHN_UNDEF) {
+			psym = NULL;
+		}
+
+		job->ret = elf_relocone(loadinfo, job->relidx, i, &job->rels[i], psym);
+		if (job->ret < 0) {
+			return;
 		}
-		/* Get the value of the symbol (in sym.st_value) */
+	}
+}
+
+static void elf_relocate_worker(FAR void *arg)
+{
+	FAR struct elf_reljob_s *job = (FAR struct elf_reljob_s *)arg;
+
+	elf_relocate_job(job);
+	sem_post(job->done);
+}
+
+/****************************************************************************
+ * Name: elf_relocate_parallel
+ *
+ * Description:
+ *   Read the relocation tables of all sections and resolve their symbols,
+ *   then hand all but the first section to the low priority worker threads
+ *   so that they are relocated on the other CPUs.  Needs the symbol table
+ *   in memory.
+ *
+ * Returned Value:
+ *   0 (OK) is returned on success and a negated errno is returned on
+ *   failure.  -ENOMEM is only returned before anything was relocated, the
+ *   caller can then fall back to elf_relocate().
+ *
+ ****************************************************************************/
+
+static int elf_relocate_parallel(FAR struct elf_loadinfo_s *loadinfo, FAR const struct symtab_s *exports, int nexports)
+{
+	FAR struct elf_reljob_s *jobs;
+	FAR Elf32_Shdr *relsec;
+	FAR Elf32_Sym *psym;
+	sem_t done;
+	int queued = 0;
+	int njobs = 0;
+	int nrels;
+	int symidx;
+	int ret = OK;
+	int i;
+	int j;
+
+	for (i = 1; i < loadinfo->ehdr.e_shnum; i++) {
+		if (elf_relsection(loadinfo, i) == SHT_RELA) {
+			return elf_relocateadd(loadinfo, i, exports, nexports);
+		} else if (elf_relsection(loadinfo, i) == SHT_REL && loadinfo->shdr[i].sh_size >= sizeof(Elf32_Rel)) {
+			njobs++;
+		}
+	}
+
+	if (njobs == 0) {
+		return OK;
+	}
+
+	jobs = (FAR struct elf_reljob_s *)kmm_zalloc(njobs * sizeof(struct elf_reljob_s));
+	if (!jobs) {
+		return -ENOMEM;
+	}
 
-		ret = elf_symvalue(loadinfo, psym, exports, nexports);
+	/* Resolve every referenced symbol once, in place */
+
+	for (i = 1, njobs = 0; i < loadinfo->ehdr.e_shnum; i++) {
+		relsec = &loadinfo->shdr[i];
+		nrels = relsec->sh_size / sizeof(Elf32_Rel);
+		if (elf_relsection(loadinfo, i) != SHT_REL || nrels == 0) {
+			continue;
+		}
+
+		jobs[njobs].loadinfo = loadinfo;
+		jobs[njobs].relidx = i;
+		jobs[njobs].rels = (FAR Elf32_Rel *)kmm_malloc(nrels * sizeof(Elf32_Rel));
+		if (!jobs[njobs].rels) {
+			ret = -ENOMEM;
+			goto errout;
+		}
+		njobs++;
+
+		ret = elf_read(loadinfo, (FAR uint8_t *)jobs[njobs - 1].rels, nrels * sizeof(Elf32_Rel), relsec->sh_offset);
 		if (ret < 0) {
-			/* The special error -ESRCH is returned only in one condition:  The
-			 * symbol has no name.
-			 *
-			 * There are a few relocations for a few architectures that do
-			 * no depend upon a named symbol.  We don't know if that is the
-			 * case here, but we will use a NULL symbol pointer to indicate
-			 * that case to up_relocate().  That function can then do what
-			 * is best.
-			 */
+			berr("Section %d: Failed to read relocation table: %d\n", i, ret);
+			goto errout;
+		}
 
+		for (j = 0; j < nrels; j++) {
+			symidx = ELF32_R_SYM(jobs[njobs - 1].rels[j].r_info);
+			ret = elf_getsym(loadinfo, symidx, NULL, NULL, &psym, exports, nexports);
 			if (ret == -ESRCH) {
-				berr("Section %d reloc %d: Undefined symbol[%d] has no name: %d\n", relidx, i, symidx, ret);
-				psym = NULL;
-			} else {
-				berr("Section %d reloc %d: Failed to get value of symbol[%d]: %d\n", relidx, i, symidx, ret);
-				goto ret_err;
+				berr("Section %d reloc %d: Undefined symbol[%d] has no name: %d\n", i, j, symidx, ret);
+			} else if (ret < 0) {
+				berr("Section %d reloc %d: Failed to get value of symbol[%d]: %d\n", i, j, symidx, ret);
+				goto errout;
 			}
 		}
+	}
 
-		/* Calculate the relocation address. */
+	/* Then apply the relocations of all sections at the same time */
 
-		if (prel->r_offset > dstsec->sh_size - sizeof(uint32_t)) {
-			berr("Section %d reloc %d: Relocation address out of range, offset %d size %d\n", relidx, i, prel->r_offset, dstsec->sh_size);
-			goto ret_err;
+	sem_init(&done, 0, 0);
+	sem_setprotocol(&done, SEM_PRIO_NONE);
+
+	for (i = 1; i < njobs; i++) {
+		jobs[i].done = &done;
+		if (work_queue(LPWORK, &jobs[i].work, elf_relocate_worker, &jobs[i], 0) == OK) {
+			queued++;
+		} else {
+			elf_relocate_job(&jobs[i]);
 		}
+	}
 
-		addr = dstsec->sh_addr + prel->r_offset;
+	elf_relocate_job(&jobs[0]);
 
-		/* Now perform the architecture-specific relocation */
+	while (queued-- > 0) {
+		while (sem_wait(&done) < 0) {
+			DEBUGASSERT(get_errno() == EINTR);
+		}
+	}
+	sem_destroy(&done);
 
-		ret = up_relocate(prel, psym, addr);
-		if (ret < 0) {
-			berr("ERROR: Section %d reloc %d: Relocation failed: %d\n", relidx, i, ret);
-			goto ret_err;
+	for (i = 0; i < njobs; i++) {
+		if (jobs[i].ret < 0) {
+			ret = jobs[i].ret;
+			break;
 		}
 	}
 
-ret_err:
-	if (loadinfo->reltab) {
-		kmm_free((void *)loadinfo->reltab);
-		loadinfo->reltab = (uintptr_t)NULL;
+errout:
+	for (i = 0; i < njobs; i++) {
+		kmm_free(jobs[i].rels);
 	}
+	kmm_free(jobs);
 	return ret;
 }
-
-static int elf_relocateadd(FAR struct elf_loadinfo_s *loadinfo, int relidx, FAR const struct symtab_s *exports, int nexports)
-{
-	berr("Not implemented\n");
-	return -ENOSYS;
-}
+#endif
 
 #ifdef CONFIG_SUPPORT_COMMON_BINARY
 static int export_library_symtab(FAR struct elf_loadinfo_s *loadinfo)
@@ -367,6 +627,7 @@ ret_err:
 
 int elf_bind(FAR struct elf_loadinfo_s *loadinfo, FAR const struct symtab_s *exports, int nexports)
 {
+	FAR struct elf_symcache_s *cache = NULL;
 	int ret;
 	int i;
 
@@ -396,28 +657,41 @@ int elf_bind(FAR struct elf_loadinfo_s *loadinfo, FAR const struct symtab_s *exp
 
 	/* Process relocations in every allocated section */
 
-	for (i = 1; i < loadinfo->ehdr.e_shnum; i++) {
-		/* Get the index to the relocation section */
-
-		int infosec = loadinfo->shdr[i].sh_info;
-		if (infosec >= loadinfo->ehdr.e_shnum) {
-			continue;
+#ifdef ELF_RELOC_PARALLEL
+	if (loadinfo->symtab) {
+		ret = elf_relocate_parallel(loadinfo, exports, nexports);
+		if (ret != -ENOMEM) {
+			goto relocated;
 		}
+	}
+#endif
 
-		/* Make sure that the section is allocated.  We can't relocated
-		 * sections that were not loaded into memory.
-		 */
+	/* Without the symbol table in memory, keep the symbols resolved so far */
 
-		if ((loadinfo->shdr[infosec].sh_flags & SHF_ALLOC) == 0) {
-			continue;
+#if ELF_SYMCACHE_COUNT > 0
+	if (!loadinfo->symtab) {
+		cache = (FAR struct elf_symcache_s *)kmm_malloc(ELF_SYMCACHE_COUNT * sizeof(struct elf_symcache_s));
+		if (cache) {
+			for (i = 0; i < ELF_SYMCACHE_COUNT; i++) {
+				cache[i].idx = -1;
+			}
 		}
+	}
+#endif
 
+	ret = OK;
+	for (i = 1; i < loadinfo->ehdr.e_shnum; i++) {
 		/* Process the relocations by type */
 
-		if (loadinfo->shdr[i].sh_type == SHT_REL) {
-			ret = elf_relocate(loadinfo, i, exports, nexports);
-		} else if (loadinfo->shdr[i].sh_type == SHT_RELA) {
+		switch (elf_relsection(loadinfo, i)) {
+		case SHT_REL:
+			ret = elf_relocate(loadinfo, i, cache, exports, nexports);
+			break;
+		case SHT_RELA:
 			ret = elf_relocateadd(loadinfo, i, exports, nexports);
+			break;
+		default:
+			break;
 		}
 
 		if (ret < 0) {
@@ -425,6 +699,14 @@ int elf_bind(FAR struct elf_loadinfo_s *loadinfo, FAR const struct symtab_s *exp
 		}
 	}
 
+	if (cache) {
+		kmm_free(cache);
+	}
+
+#ifdef ELF_RELOC_PARALLEL
+relocated:
+#endif
+
 #if defined(CONFIG_ARCH_HAVE_COHERENT_DCACHE)
 	/* Ensure that the I and D caches are coherent before starting the newly
 	 * loaded module by cleaning the D cache (i.e., flushing the D cache
@@ -225,7 +225,11 @@ void elf_readsymtab(FAR struct elf_loadinfo_s *loadinfo)
 	}
 
 	if (elf_read(loadinfo, (FAR uint8_t *)loadinfo->symtab, symtab->sh_size, symtab->sh_offset) < 0) {
+		/* Fall back to reading the symbols one by one */
+
 		berr("ERROR: Failed to load symbol table into memory\n");
+		kmm_free((void *)loadinfo->symtab);
+		loadinfo->symtab = (uintptr_t)NULL;
 	}
 }
 
@@ -253,7 +257,7 @@ int elf_readsym(FAR struct elf_loadinfo_s *loadinfo, int index, FAR Elf32_Sym *s
 
 	/* Verify that the symbol table index lies within symbol table */
 
-	if (index < 0 || index > (symtab->sh_size / sizeof(Elf32_Sym))) {
+	if (index < 0 || index >= (symtab->sh_size / sizeof(Elf32_Sym))) {
 		berr("Bad relocation symbol index: %d\n", index);
 		return -EINVAL;
 	}
@@ -27,8 +27,11 @@
 #include <string.h>
 #include <debug.h>
 #include <errno.h>
+#include <semaphore.h>
 
 #include <tinyara/fs/fs.h>
+#include <tinyara/clock.h>
+#include <tinyara/wqueue.h>
 #include <tinyara/binfmt/compression/compress_read.h>
 
 #if CONFIG_COMPRESSION_TYPE == LZMA
@@ -37,6 +40,62 @@
 #include <miniz/miniz.h>
 #endif
 
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#ifdef CONFIG_COMPRESSED_BINARY_CACHE_BLOCKS
+#define COMPRESS_CACHE_BLOCKS CONFIG_COMPRESSED_BINARY_CACHE_BLOCKS
+#else
+#define COMPRESS_CACHE_BLOCKS 1
+#endif
+
+/* Number of blocks of one read which are decompressed at the same time */
+
+#if defined(CONFIG_COMPRESSED_BINARY_PARALLEL) && defined(CONFIG_SMP) && \
+	defined(CONFIG_SCHED_LPWORK) && CONFIG_SCHED_LPNTHREADS > 1
+#define COMPRESS_PARALLEL
+#define COMPRESS_NJOBS        CONFIG_SMP_NCPUS
+#else
+#define COMPRESS_NJOBS        1
+#endif
+
+#ifndef MIN
+#define MIN(a, b)             ((a) < (b) ? (a) : (b))
+#endif
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* A decompressed block kept in the cache */
+
+struct compress_cache_s {
+	int block;					/* Block number, -1 if empty */
+	unsigned int stamp;			/* Time of last use, for LRU replacement */
+	bool busy;					/* Being filled by the current read */
+	FAR unsigned char *data;	/* blocksize bytes in buffers.out_buffer */
+};
+
+/* A block to be decompressed by the current read */
+
+struct compress_job_s {
+#ifdef COMPRESS_PARALLEL
+	struct work_s work;
+	FAR sem_t *done;
+#endif
+	int block;
+	int ret;
+	FAR unsigned char *in;		/* Compressed data */
+	long unsigned int insize;
+	FAR unsigned char *out;		/* Caller's buffer or data of 'slot' */
+	long unsigned int outsize;	/* Uncompressed size of the block */
+	FAR struct compress_cache_s *slot;
+	int from;					/* Offset in the block to copy from */
+	int len;					/* Bytes to copy */
+	int pos;					/* Offset in the caller's buffer */
+};
+
 /****************************************************************************
  * Private Declarations
  ****************************************************************************/
@@ -45,6 +104,22 @@ static struct s_header *compression_header;
 static struct s_buffer buffers;
 static int active_filefd = -1;
 
+/* Size of the compressed data buffer of each job in buffers.read_buffer */
+
+static size_t read_buffer_size;
+
+static struct compress_cache_s block_cache[COMPRESS_CACHE_BLOCKS];
+static unsigned int cache_stamp;
+
+#ifdef CONFIG_DEBUG_BINARY_COMPRESSION_INFO
+/* Statistics of the current file, reported by compress_uninit */
+
+static unsigned int stat_hits;
+static unsigned int stat_cached;
+static unsigned int stat_direct;
+static clock_t stat_ticks;
+#endif
+
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
@@ -231,6 +306,156 @@ static off_t compress_read_block(int filfd, uint16_t binary_header_size, FAR uin
 	return nbytes;
 }
 
+/****************************************************************************
+ * Name: compress_cache_find
+ *
+ * Description:
+ *   Return the cache entry holding 'block_number' decompressed, or NULL.
+ *
+ ****************************************************************************/
+static FAR struct compress_cache_s *compress_cache_find(int block_number)
+{
+	int i;
+
+	for (i = 0; i < COMPRESS_CACHE_BLOCKS; i++) {
+		if (block_cache[i].block == block_number && !block_cache[i].busy) {
+			block_cache[i].stamp = ++cache_stamp;
+			return &block_cache[i];
+		}
+	}
+
+	return NULL;
+}
+
+/****************************************************************************
+ * Name: compress_cache_victim
+ *
+ * Description:
+ *   Pick the least recently used cache entry which is not already being
+ *   filled by the current read, and claim it for 'block_number'.
+ *
+ * Returned Value:
+ *   The entry, or NULL if all of them are in use by the current read.
+ ****************************************************************************/
+static FAR struct compress_cache_s *compress_cache_victim(int block_number)
+{
+	FAR struct compress_cache_s *victim = NULL;
+	int i;
+
+	for (i = 0; i < COMPRESS_CACHE_BLOCKS; i++) {
+		if (block_cache[i].busy) {
+			continue;
+		}
+
+		if (block_cache[i].block < 0) {
+			victim = &block_cache[i];
+			break;
+		}
+
+		if (victim == NULL || (int)(block_cache[i].stamp - victim->stamp) < 0) {
+			victim = &block_cache[i];
+		}
+	}
+
+	if (victim) {
+		victim->block = block_number;
+		victim->busy = true;
+		victim->stamp = ++cache_stamp;
+	}
+
+	return victim;
+}
+
+/****************************************************************************
+ * Name: compress_decode
+ *
+ * Description:
+ *   Decompress the block of one job into its output buffer.
+ *
+ ****************************************************************************/
+static void compress_decode(FAR struct compress_job_s *job)
+{
+	long unsigned int writesize = job->outsize;
+	long unsigned int size = job->insize;
+
+	job->ret = decompress_block(job->out, &writesize, job->in, &size);
+	if (job->ret < 0) {
+		bcmpdbg("Failed to decompress %d block of this binary\n", job->block);
+	} else if (writesize != job->outsize) {
+		bcmpdbg("Block %d decompressed to %lu bytes instead of %lu\n", job->block, writesize, job->outsize);
+		job->ret = -EIO;
+	}
+}
+
+#ifdef COMPRESS_PARALLEL
+static void compress_worker(FAR void *arg)
+{
+	FAR struct compress_job_s *job = (FAR struct compress_job_s *)arg;
+
+	compress_decode(job);
+	sem_post(job->done);
+}
+#endif
+
+/****************************************************************************
+ * Name: compress_decode_jobs
+ *
+ * Description:
+ *   Decompress the blocks of the current read.  With COMPRESS_PARALLEL, all
+ *   but the first one are handed to the low priority worker threads so that
+ *   they run on the other CPUs while the caller decompresses the first one.
+ *
+ * Returned Value:
+ *   OK (0) on Success
+ *   Negative value on Failure
+ ****************************************************************************/
+static int compress_decode_jobs(FAR struct compress_job_s *jobs, int njobs)
+{
+	int i;
+#ifdef COMPRESS_PARALLEL
+	sem_t done;
+	int queued = 0;
+
+	if (njobs > 1) {
+		sem_init(&done, 0, 0);
+		sem_setprotocol(&done, SEM_PRIO_NONE);
+
+		for (i = 1; i < njobs; i++) {
+			memset(&jobs[i].work, 0, sizeof(jobs[i].work));
+			jobs[i].done = &done;
+			if (work_queue(LPWORK, &jobs[i].work, compress_worker, &jobs[i], 0) == OK) {
+				queued++;
+			} else {
+				compress_decode(&jobs[i]);
+			}
+		}
+	}
+
+	compress_decode(&jobs[0]);
+
+	if (njobs > 1) {
+		while (queued-- > 0) {
+			while (sem_wait(&done) < 0) {
+				DEBUGASSERT(get_errno() == EINTR);
+			}
+		}
+		sem_destroy(&done);
+	}
+#else
+	for (i = 0; i < njobs; i++) {
+		compress_decode(&jobs[i]);
+	}
+#endif
+
+	for (i = 0; i < njobs; i++) {
+		if (jobs[i].ret < 0) {
+			return jobs[i].ret;
+		}
+	}
+
+	return OK;
+}
+
 /****************************************************************************
  * Name: compress_read
  *
@@ -246,24 +471,35 @@ static off_t compress_read_block(int filfd, uint16_t binary_header_size, FAR uin
  ****************************************************************************/
 int compress_read(int filfd, uint16_t binary_header_size, FAR uint8_t *buffer, size_t readsize, off_t offset)
 {
+	struct compress_job_s jobs[COMPRESS_NJOBS];
+	FAR struct compress_job_s *job;
+	FAR struct compress_cache_s *slot;
 	int first_block;
 	int last_block;
 	int no_blocks;
 	int index;
+	int njobs;
 	int ret;
-	int actual_offset;			/* Offset from start of uncompressed file */
-	int block_size_to_write;	/* Size to write into buffer from decompressed block */
+	int i;
 	int buffer_index;
 	int blocksize;
+	int blockstart;
+	int blocklen;
 	int block_readsize;
-#if CONFIG_COMPRESSION_TYPE == LZMA
-	unsigned int writesize;
-	unsigned int size;
-#elif CONFIG_COMPRESSION_TYPE == MINIZ
-	long unsigned int writesize;
-	long unsigned int size;
+	int from;
+	int len;
+#ifdef CONFIG_DEBUG_BINARY_COMPRESSION_INFO
+	clock_t start = clock_systimer();
 #endif
 
+	if (offset >= compression_header->binary_size) {
+		return 0;
+	}
+
+	if (offset + readsize > compression_header->binary_size) {
+		readsize = compression_header->binary_size - offset;
+	}
+
 	/* Setting first block, end block and number of blocks to read and decompressed */
 	blocksize = compression_header->blocksize;
 	compress_blocks_to_read(&first_block, &last_block, &no_blocks, offset, readsize);
@@ -275,64 +511,101 @@ int compress_read(int filfd, uint16_t binary_header_size, FAR uint8_t *buffer, s
 
 	index = first_block;
 	buffer_index = 0;
-	/* Actual Offset in uncompressed file is same as Offset passed to this function */
-	actual_offset = offset;
-
-	/* Reading and decompressing blocks from first_block to last_block. Then writing to buffer. */
-	for (; index < first_block + no_blocks; index++) {
-		/* Read compressed 'index' block into read_buffer */
-		block_readsize = compress_read_block(filfd, binary_header_size, buffers.read_buffer, index);
-		if (block_readsize < 0) {
-			bcmpdbg("Read for compressed block %d failed\n", index);
-			buffer_index = block_readsize;
-			goto error_compress_read;
-		}
 
-#if CONFIG_COMPRESSION_TYPE == LZMA
-		size = (unsigned int)block_readsize;
-#elif CONFIG_COMPRESSION_TYPE == MINIZ
-		size = (long unsigned int)block_readsize;
+	while (index <= last_block) {
+		/* Collect up to COMPRESS_NJOBS blocks which are not in the cache.
+		 * A block which is read entirely is decompressed right into the
+		 * caller's buffer, a partially read one into a cache entry.
+		 */
+		njobs = 0;
+		for (; index <= last_block && njobs < COMPRESS_NJOBS; index++) {
+			blockstart = index * blocksize;
+			blocklen = MIN(blocksize, compression_header->binary_size - blockstart);
+			from = offset > blockstart ? offset - blockstart : 0;
+			len = MIN(offset + readsize, blockstart + blocklen) - (blockstart + from);
+
+			slot = compress_cache_find(index);
+			if (slot) {
+				memcpy(&buffer[blockstart + from - offset], &slot->data[from], len);
+				buffer_index += len;
+#ifdef CONFIG_DEBUG_BINARY_COMPRESSION_INFO
+				stat_hits++;
 #endif
-		writesize = compression_header->blocksize; 
-		/* Decompress block in read_buffer to out_buffer */
-		ret = decompress_block(buffers.out_buffer, &writesize, buffers.read_buffer, &size);
-		if (ret == ERROR) {
-			bcmpdbg("Failed to decompress %d block of this binary\n", index);
+				continue;
+			}
+
+			job = &jobs[njobs];
+			if (from == 0 && len == blocklen) {
+				job->slot = NULL;
+				job->out = &buffer[blockstart - offset];
+			} else {
+				job->slot = compress_cache_victim(index);
+				if (job->slot == NULL) {
+					/* All entries are taken by this read, next round */
+					break;
+				}
+				job->out = job->slot->data;
+			}
+
+			job->block = index;
+			job->outsize = blocklen;
+			job->from = from;
+			job->len = len;
+			job->pos = blockstart + from - offset;
+			job->in = &buffers.read_buffer[njobs * read_buffer_size];
+			njobs++;
+
+			/* Read compressed 'index' block into this job's read buffer */
+			block_readsize = compress_read_block(filfd, binary_header_size, job->in, index);
+			if (block_readsize < 0) {
+				bcmpdbg("Read for compressed block %d failed\n", index);
+				buffer_index = block_readsize;
+				goto error_release;
+			}
+			job->insize = block_readsize;
+		}
+
+		if (njobs == 0) {
+			continue;
+		}
+
+		ret = compress_decode_jobs(jobs, njobs);
+		if (ret < 0) {
 			buffer_index = ret;
-			goto error_compress_read;
+			goto error_release;
 		}
 
-		if (index == first_block) {
-			/*
-			 * Read appropriate number of bytes to buffer from this block using readsize and offset info.
-			 * If start_offset + readsize < end_offset, write from start_offset to start_offset + readsize.
-			 * Otherwise, write from start_offset to end_offset into buffer.
-			 */
-			block_size_to_write = ((index + 1) * blocksize - 1 > actual_offset + readsize - 1 ? readsize : (index + 1) * blocksize - actual_offset);
-			memcpy(&buffer[buffer_index], &buffers.out_buffer[actual_offset - (index * blocksize)], block_size_to_write);
-			buffer_index += block_size_to_write;
-		} else if (index == last_block) {
-			/*
-			 * Read appropriate number of bytes to buffer from this block using readsize and offset info.
-			 * Calculate end_offset (Offset of last byte to write from this block).
-			 * Write from start_offset to end_offset from this block into buffer.
-			 */
-			block_size_to_write = actual_offset + readsize - (index * blocksize);
-			memcpy(&buffer[buffer_index], &buffers.out_buffer[0], block_size_to_write);
-			buffer_index += block_size_to_write;
-		} else {
-			/*
-			 * This is not the first or last block. This is intermediary block.
-			 * So, write entire block into buffer.
-			 */
-			block_size_to_write = blocksize;
-			memcpy(&buffer[buffer_index], &buffers.out_buffer[0], block_size_to_write);
-			buffer_index += block_size_to_write;
+		for (i = 0; i < njobs; i++) {
+			if (jobs[i].slot) {
+				memcpy(&buffer[jobs[i].pos], &jobs[i].slot->data[jobs[i].from], jobs[i].len);
+				jobs[i].slot->busy = false;
+#ifdef CONFIG_DEBUG_BINARY_COMPRESSION_INFO
+				stat_cached++;
+			} else {
+				stat_direct++;
+#endif
+			}
+			buffer_index += jobs[i].len;
 		}
 	}
 
+#ifdef CONFIG_DEBUG_BINARY_COMPRESSION_INFO
+	stat_ticks += clock_systimer() - start;
+#endif
+
 error_compress_read:
 	return buffer_index;
+
+error_release:
+	/* Drop the entries which were being filled */
+	for (i = 0; i < njobs; i++) {
+		if (jobs[i].slot) {
+			jobs[i].slot->block = -1;
+			jobs[i].slot->busy = false;
+		}
+	}
+
+	return buffer_index;
 }
 
 /****************************************************************************
@@ -348,6 +621,7 @@ error_compress_read:
 int compress_init(int filfd, uint16_t offset, off_t *filelen)
 {
 	int ret;
+	int i;
 
 	if (active_filefd != -1 && active_filefd != filfd) {
 		bcmpdbg("Another file decompression is in process\n");
@@ -363,33 +637,50 @@ int compress_init(int filfd, uint16_t offset, off_t *filelen)
 
 	/* Assign file length as that of uncompressed file */
 	*filelen = compression_header->binary_size;
+	read_buffer_size = 0;
 
 #if CONFIG_COMPRESSION_TYPE == LZMA
 	/* Allocating memory for read and out buffer to be used for LZMA decompression */
 	if (compression_header->compression_format == COMPRESSION_TYPE_LZMA) {
-		buffers.read_buffer = (unsigned char *)kmm_malloc(compression_header->blocksize + LZMA_PROPS_SIZE);
-		if (buffers.read_buffer == NULL) {
-			return -ENOMEM;
-		}
-		buffers.out_buffer = (unsigned char *)kmm_malloc(compression_header->blocksize);
-		if (buffers.out_buffer == NULL) {
-			kmm_free(buffers.read_buffer);
-			return -ENOMEM;
-		}
+		read_buffer_size = compression_header->blocksize + LZMA_PROPS_SIZE;
 	}
 #elif CONFIG_COMPRESSION_TYPE == MINIZ
 	/* Allocating memory for read and out buffer to be used for Miniz decompression */
 	if (compression_header->compression_format == COMPRESSION_TYPE_MINIZ) {
-		buffers.read_buffer = (unsigned char *)kmm_malloc(compressBound(compression_header->blocksize));
+		read_buffer_size = compressBound(compression_header->blocksize);
+	}
+#endif
+
+	if (read_buffer_size > 0) {
+		/* One compressed block for each block decompressed at the same
+		 * time, and the decompressed blocks of the cache.
+		 */
+		read_buffer_size = (read_buffer_size + 3) & ~3;
+		buffers.read_buffer = (unsigned char *)kmm_malloc(read_buffer_size * COMPRESS_NJOBS);
 		if (buffers.read_buffer == NULL) {
 			return -ENOMEM;
 		}
-		buffers.out_buffer = (unsigned char *)kmm_malloc(compression_header->blocksize);
+		buffers.out_buffer = (unsigned char *)kmm_malloc(compression_header->blocksize * COMPRESS_CACHE_BLOCKS);
 		if (buffers.out_buffer == NULL) {
 			kmm_free(buffers.read_buffer);
+			buffers.read_buffer = NULL;
 			return -ENOMEM;
 		}
 	}
+
+	for (i = 0; i < COMPRESS_CACHE_BLOCKS; i++) {
+		block_cache[i].block = -1;
+		block_cache[i].stamp = 0;
+		block_cache[i].busy = false;
+		block_cache[i].data = buffers.out_buffer ? &buffers.out_buffer[i * compression_header->blocksize] : NULL;
+	}
+	cache_stamp = 0;
+
+#ifdef CONFIG_DEBUG_BINARY_COMPRESSION_INFO
+	stat_hits = 0;
+	stat_cached = 0;
+	stat_direct = 0;
+	stat_ticks = 0;
 #endif
 
 error_compress_init:
@@ -407,6 +698,17 @@ error_compress_init:
  ****************************************************************************/
 void compress_uninit(void)
 {
+	int i;
+
+#ifdef CONFIG_DEBUG_BINARY_COMPRESSION_INFO
+	bcmpvdbg("Decompressed %u blocks into the cache and %u in place, %u cache hits, %d ms reading\n", stat_cached, stat_direct, stat_hits, (int)TICK2MSEC(stat_ticks));
+#endif
+
+	for (i = 0; i < COMPRESS_CACHE_BLOCKS; i++) {
+		block_cache[i].block = -1;
+		block_cache[i].data = NULL;
+	}
+
 #if CONFIG_COMPRESSION_TYPE == LZMA || CONFIG_COMPRESSION_TYPE == MINIZ
 	/* Freeing memory allocated to read_buffer and out_buffer for file decompression */
 	if (compression_header->compression_format == COMPRESSION_TYPE_LZMA || compression_header->compression_format == COMPRESSION_TYPE_MINIZ) {
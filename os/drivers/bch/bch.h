@@ -72,17 +72,28 @@
 /****************************************************************************
  * Public Types
  ****************************************************************************/
+struct bch_cachesect_s {
+	size_t sector;				/* Sector held by this entry, (size_t)-1 if none */
+	uint32_t stamp;				/* Time of last access, for LRU replacement */
+	bool dirty;					/* true: Data has been written to the buffer */
+	FAR uint8_t *buffer;		/* One sector buffer */
+};
+
 struct bchlib_s {
 	FAR struct inode *inode;	/* I-node of the block driver */
 	uint32_t sectsize;			/* The size of one sector on the device */
 	size_t nsectors;			/* Number of sectors supported by the device */
-	size_t sector;				/* The current sector in the buffer */
 	sem_t sem;					/* For atomic accesses to this structure */
 	uint8_t refs;				/* Number of references */
-	bool dirty;					/* true: Data has been written to the buffer */
 	bool readonly;				/* true: Only read operations are supported */
 	bool unlinked;				/* true: The driver has been unlinked */
-	FAR uint8_t *buffer;		/* One sector buffer */
+	bool writeback;				/* true: Do not flush at the end of each write */
+	uint16_t ncache;			/* Number of entries in cache[] */
+	uint16_t readahead;			/* Sectors to read ahead on a sequential miss */
+	uint32_t stamp;				/* LRU clock */
+	size_t nextsector;			/* Sector following the last one read in */
+	FAR struct bch_cachesect_s *cache;	/* Sector cache entries */
+	FAR uint8_t *buffer;		/* ncache sector buffers, back to back */
 
 #if defined(CONFIG_BCH_ENCRYPTION)
 	uint8_t key[CONFIG_BCH_ENCRYPTION_KEY_SIZE];	/* Encryption key */
@@ -106,8 +117,12 @@ EXTERN const struct file_operations bch_fops;
  * Public Function Prototypes
  ****************************************************************************/
 EXTERN void bchlib_semtake(FAR struct bchlib_s *bch);
+EXTERN int  bchlib_setcache(FAR struct bchlib_s *bch, FAR const struct bch_cacheconfig_s *config);
+EXTERN void bchlib_freecache(FAR struct bchlib_s *bch);
 EXTERN int  bchlib_flushsector(FAR struct bchlib_s *bch);
-EXTERN int  bchlib_readsector(FAR struct bchlib_s *bch, size_t sector);
+EXTERN int  bchlib_readsector(FAR struct bchlib_s *bch, size_t sector, FAR struct bch_cachesect_s **entry);
+EXTERN void bchlib_invalidate(FAR struct bchlib_s *bch, size_t sector, size_t nsectors);
+EXTERN void bchlib_copydirty(FAR struct bchlib_s *bch, FAR uint8_t *buffer, size_t sector, size_t nsectors);
 
 #undef EXTERN
 #if defined(__cplusplus)
@@ -338,6 +338,18 @@ static int bch_ioctl(FAR struct file *filep, int cmd, unsigned long arg)
 			ret = OK;
 	}
 #endif
+	/* Is this a request to resize or retune the sector cache? */
+	else if (cmd == DIOC_SETCACHE) {
+		FAR const struct bch_cacheconfig_s *config = (FAR const struct bch_cacheconfig_s *)((uintptr_t)arg);
+
+		if (!config) {
+			ret = -EINVAL;
+		} else {
+			bchlib_semtake(bch);
+			ret = bchlib_setcache(bch, config);
+			bchlib_semgive(bch);
+		}
+	}
 	/* Otherwise, pass the IOCTL command on to the contained block driver */
 	else {
 		FAR struct inode *bchinode = bch->inode;
@@ -57,10 +57,13 @@
 
 #include <sys/types.h>
 #include <stdbool.h>
+#include <string.h>
 #include <errno.h>
 #include <assert.h>
 #include <debug.h>
 
+#include <tinyara/kmalloc.h>
+
 #include "bch.h"
 
 #if defined(CONFIG_BCH_ENCRYPTION)
@@ -88,16 +91,16 @@ static void bch_xor(uint32_t *R, uint32_t *A, uint32_t *B)
  * Name: bch_cypher
  ****************************************************************************/
 #if defined(CONFIG_BCH_ENCRYPTION)
-static int bch_cypher(FAR struct bchlib_s *bch, int encrypt)
+static int bch_cypher(FAR struct bchlib_s *bch, FAR uint8_t *data, size_t sector, int encrypt)
 {
 	int blocks = bch->sectsize / 16;
-	FAR uint32_t *buffer = (FAR uint32_t *)bch->buffer;
+	FAR uint32_t *buffer = (FAR uint32_t *)data;
 	int i;
 
 	for (i = 0; i < blocks; i++, buffer += 16 / sizeof(uint32_t)) {
 		uint32_t T[4];
 		uint32_t X[4] = {
-			bch->sector, 0, 0, i
+			sector, 0, 0, i
 		};
 
 		aes_cypher(X, X, 16, NULL, bch->key, CONFIG_BCH_ENCRYPTION_KEY_SIZE,
@@ -114,87 +117,376 @@ static int bch_cypher(FAR struct bchlib_s *bch, int encrypt)
 }
 #endif
 
+/****************************************************************************
+ * Name: bch_findsector
+ *
+ * Description:
+ *   Return the cache entry holding 'sector' or NULL
+ *
+ ****************************************************************************/
+static FAR struct bch_cachesect_s *bch_findsector(FAR struct bchlib_s *bch, size_t sector)
+{
+	int i;
+
+	for (i = 0; i < bch->ncache; i++) {
+		if (bch->cache[i].sector == sector) {
+			return &bch->cache[i];
+		}
+	}
+
+	return NULL;
+}
+
+/****************************************************************************
+ * Name: bch_writeentries
+ *
+ * Description:
+ *   Write 'count' adjacent cache entries holding consecutive sectors to the
+ *   media with a single block driver request.
+ *
+ ****************************************************************************/
+static int bch_writeentries(FAR struct bchlib_s *bch, FAR struct bch_cachesect_s *entry, int count)
+{
+	FAR struct inode *inode = bch->inode;
+	ssize_t ret;
+	int i;
+
+#if defined(CONFIG_BCH_ENCRYPTION)
+	/* Encrypt data as necessary */
+	for (i = 0; i < count; i++) {
+		bch_cypher(bch, entry[i].buffer, entry[i].sector, CYPHER_ENCRYPT);
+	}
+#endif
+
+	/* Write the sectors to the media */
+	ret = inode->u.i_bops->write(inode, entry->buffer, entry->sector, count);
+	if (ret < 0) {
+		fdbg("Write failed: %d\n", ret);
+	}
+
+#if defined(CONFIG_BCH_ENCRYPTION)
+	/*
+	 * Computation overhead to save memory for extra sector buffer
+	 * TODO: Add configuration switch for extra sector buffer
+	 */
+	for (i = 0; i < count; i++) {
+		bch_cypher(bch, entry[i].buffer, entry[i].sector, CYPHER_DECRYPT);
+	}
+#endif
+
+	/* The sectors are now in sync with the media, unless the write failed:
+	 * then they stay dirty, to be written again by the next flush.
+	 */
+	if (ret >= 0) {
+		for (i = 0; i < count; i++) {
+			entry[i].dirty = false;
+		}
+	}
+
+	return (int)ret;
+}
+
+/****************************************************************************
+ * Name: bch_flushrange
+ *
+ * Description:
+ *   Write back the dirty entries among cache[first .. first + count - 1] in
+ *   ascending sector order.  Entries that sit next to each other in the
+ *   cache and hold consecutive sectors are written with one request.
+ *   Entries that fail to write stay dirty; the first error is returned
+ *   after trying all of them.
+ *
+ ****************************************************************************/
+static int bch_flushrange(FAR struct bchlib_s *bch, int first, int count)
+{
+	FAR struct bch_cachesect_s *entry;
+	size_t next = 0;
+	int ret = OK;
+	int tmp;
+	int end = first + count;
+	int n;
+	int i;
+
+	for (;;) {
+		/* Find the dirty entry with the lowest sector number not tried yet */
+		entry = NULL;
+		for (i = first; i < end; i++) {
+			if (bch->cache[i].dirty && bch->cache[i].sector >= next &&
+				(!entry || bch->cache[i].sector < entry->sector)) {
+				entry = &bch->cache[i];
+			}
+		}
+
+		if (!entry) {
+			return ret;
+		}
+
+		/* Extend it with the neighbours that continue the same sector run */
+		i = entry - bch->cache;
+		for (n = 1; i + n < end && bch->cache[i + n].dirty && bch->cache[i + n].sector == entry->sector + n; n++) ;
+
+		next = entry->sector + n;
+		tmp = bch_writeentries(bch, entry, n);
+		if (tmp < 0 && ret == OK) {
+			ret = tmp;
+		}
+	}
+}
+
+/****************************************************************************
+ * Name: bch_victim
+ *
+ * Description:
+ *   Select the least recently used cache entry
+ *
+ ****************************************************************************/
+static int bch_victim(FAR struct bchlib_s *bch)
+{
+	int victim = 0;
+	int i;
+
+	for (i = 0; i < bch->ncache; i++) {
+		if (bch->cache[i].sector == (size_t)-1) {
+			return i;
+		}
+
+		if ((int32_t)(bch->cache[i].stamp - bch->cache[victim].stamp) < 0) {
+			victim = i;
+		}
+	}
+
+	return victim;
+}
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
+/****************************************************************************
+ * Name: bchlib_setcache
+ *
+ * Description:
+ *   (Re-)allocate the sector cache.  Any dirty sector is flushed first.
+ *
+ * Assumptions:
+ *   Caller must assume mutual exclusion
+ *
+ ****************************************************************************/
+int bchlib_setcache(FAR struct bchlib_s *bch, FAR const struct bch_cacheconfig_s *config)
+{
+	FAR struct bch_cachesect_s *cache;
+	FAR uint8_t *buffer;
+	int ret;
+	int i;
+
+	if (config->nsectors < 1 || config->readahead >= config->nsectors) {
+		return -EINVAL;
+	}
+
+	cache = (FAR struct bch_cachesect_s *)kmm_malloc(config->nsectors * sizeof(struct bch_cachesect_s));
+	buffer = (FAR uint8_t *)kmm_malloc(config->nsectors * bch->sectsize);
+	if (!cache || !buffer) {
+		fdbg("ERROR: Failed to allocate sector cache\n");
+		if (cache) {
+			kmm_free(cache);
+		}
+		if (buffer) {
+			kmm_free(buffer);
+		}
+		return -ENOMEM;
+	}
+
+	for (i = 0; i < config->nsectors; i++) {
+		cache[i].sector = (size_t)-1;
+		cache[i].stamp  = 0;
+		cache[i].dirty  = false;
+		cache[i].buffer = &buffer[i * bch->sectsize];
+	}
+
+	/* Keep the old cache, and its dirty sectors, if they can't be written */
+	ret = bchlib_flushsector(bch);
+	if (ret < 0) {
+		kmm_free(cache);
+		kmm_free(buffer);
+		return ret;
+	}
+
+	bchlib_freecache(bch);
+
+	bch->cache      = cache;
+	bch->buffer     = buffer;
+	bch->ncache     = config->nsectors;
+	bch->readahead  = config->readahead;
+	bch->writeback  = config->writeback;
+	bch->nextsector = (size_t)-1;
+	return OK;
+}
+
+/****************************************************************************
+ * Name: bchlib_freecache
+ *
+ * Description:
+ *   Release the sector cache without flushing it
+ *
+ ****************************************************************************/
+void bchlib_freecache(FAR struct bchlib_s *bch)
+{
+	if (bch->cache) {
+		kmm_free(bch->cache);
+		bch->cache = NULL;
+	}
+
+	if (bch->buffer) {
+		kmm_free(bch->buffer);
+		bch->buffer = NULL;
+	}
+
+	bch->ncache = 0;
+}
+
 /****************************************************************************
  * Name: bchlib_flushsector
  *
  * Description:
- *   Flush the current contents of the sector buffer (if dirty)
+ *   Flush every dirty sector in the cache, coalescing writes of adjacent
+ *   sectors
  *
  * Assumptions:
  *   Caller must assume mutual exclusion
  *
  ****************************************************************************/
 int bchlib_flushsector(FAR struct bchlib_s *bch)
+{
+	return bch_flushrange(bch, 0, bch->ncache);
+}
+
+/****************************************************************************
+ * Name: bchlib_readsector
+ *
+ * Description:
+ *   Return the cache entry holding 'sector', reading it in (and, on a
+ *   sequential access, the sectors that follow it) if necessary.  The
+ *   least recently used entries are written back and reused.  If they can
+ *   not be written back, or the read fails, the error is returned and
+ *   *entry is not set.
+ *
+ * Assumptions:
+ *   Caller must assume mutual exclusion
+ *
+ ****************************************************************************/
+int bchlib_readsector(FAR struct bchlib_s *bch, size_t sector, FAR struct bch_cachesect_s **entry)
 {
 	FAR struct inode *inode;
+	FAR struct bch_cachesect_s *found;
 	ssize_t ret = OK;
+	int count = 1;
+	int first;
+	int i;
 
-	/*
-	 * Check if the sector has been modified and is out of sync with the
-	 * media.
-	 */
-	if (bch->dirty) {
+	found = bch_findsector(bch, sector);
+	if (!found) {
 		inode = bch->inode;
 
-#if defined(CONFIG_BCH_ENCRYPTION)
-		/* Encrypt data as necessary */
-		bch_cypher(bch, CYPHER_ENCRYPT);
-#endif
+		/* Read ahead only when this miss continues the previous one, and
+		 * never over a sector that is already cached.
+		 */
+		if (bch->readahead > 0 && sector == bch->nextsector) {
+			count += bch->readahead;
+			if (sector + count > bch->nsectors) {
+				count = bch->nsectors - sector;
+			}
 
-		/* Write the sector to the media */
-		ret = inode->u.i_bops->write(inode, bch->buffer, bch->sector, 1);
+			for (i = 1; i < count; i++) {
+				if (bch_findsector(bch, sector + i)) {
+					count = i;
+					break;
+				}
+			}
+		}
+
+		/* Reuse 'count' adjacent entries starting from the LRU one */
+		first = bch_victim(bch);
+		if (first + count > bch->ncache) {
+			first = bch->ncache - count;
+		}
+
+		/* Dirty entries that fail to write back must not be overwritten */
+		ret = bch_flushrange(bch, first, count);
 		if (ret < 0) {
-			fdbg("Write failed: %d\n");
+			fdbg("Flush failed: %d\n", ret);
+			return (int)ret;
+		}
+
+		for (i = 0; i < count; i++) {
+			bch->cache[first + i].sector = (size_t)-1;
 		}
 
+		found = &bch->cache[first];
+		ret = inode->u.i_bops->read(inode, found->buffer, sector, count);
+		if (ret < 0) {
+			fdbg("Read failed: %d\n", ret);
+			bch->nextsector = (size_t)-1;
+			return (int)ret;
+		}
+
+		for (i = 0; i < count; i++) {
+			found[i].sector = sector + i;
+			found[i].stamp  = bch->stamp;
 #if defined(CONFIG_BCH_ENCRYPTION)
-		/*
-		 * Computation overhead to save memory for extra sector buffer
-		 * TODO: Add configuration switch for extra sector buffer
-		 */
-		bch_cypher(bch, CYPHER_DECRYPT);
+			bch_cypher(bch, found[i].buffer, found[i].sector, CYPHER_DECRYPT);
 #endif
+		}
 
-		/* The sector is now in sync with the media */
-		bch->dirty = false;
+		bch->nextsector = sector + count;
 	}
 
-	return (int)ret;
+	found->stamp = ++bch->stamp;
+	*entry = found;
+	return OK;
 }
 
 /****************************************************************************
- * Name: bchlib_readsector
+ * Name: bchlib_invalidate
  *
  * Description:
- *   Flush the current contents of the sector buffer (if dirty)
+ *   Drop the cached copies of sectors that are about to be overwritten on
+ *   the media directly.
  *
  * Assumptions:
  *   Caller must assume mutual exclusion
  *
  ****************************************************************************/
-int bchlib_readsector(FAR struct bchlib_s *bch, size_t sector)
+void bchlib_invalidate(FAR struct bchlib_s *bch, size_t sector, size_t nsectors)
 {
-	FAR struct inode *inode;
-	ssize_t ret = OK;
+	int i;
 
-	if (bch->sector != sector) {
-		inode = bch->inode;
+	for (i = 0; i < bch->ncache; i++) {
+		if (bch->cache[i].sector != (size_t)-1 && bch->cache[i].sector - sector < nsectors) {
+			bch->cache[i].sector = (size_t)-1;
+			bch->cache[i].dirty  = false;
+		}
+	}
+}
 
-		(void)bchlib_flushsector(bch);
-		bch->sector = (size_t)-1;
+/****************************************************************************
+ * Name: bchlib_copydirty
+ *
+ * Description:
+ *   Overlay the dirty cached sectors on data just read from the media
+ *   directly, so that the caller sees its own pending writes.
+ *
+ * Assumptions:
+ *   Caller must assume mutual exclusion
+ *
+ ****************************************************************************/
+void bchlib_copydirty(FAR struct bchlib_s *bch, FAR uint8_t *buffer, size_t sector, size_t nsectors)
+{
+	FAR struct bch_cachesect_s *entry;
+	int i;
 
-		ret = inode->u.i_bops->read(inode, bch->buffer, sector, 1);
-		if (ret < 0) {
-			fdbg("Read failed: %d\n");
+	for (i = 0; i < bch->ncache; i++) {
+		entry = &bch->cache[i];
+		if (entry->dirty && entry->sector - sector < nsectors) {
+			memcpy(&buffer[(entry->sector - sector) * bch->sectsize], entry->buffer, bch->sectsize);
 		}
-		bch->sector = sector;
-#if defined(CONFIG_BCH_ENCRYPTION)
-		bch_cypher(bch, CYPHER_DECRYPT);
-#endif
 	}
-	return (int)ret;
 }
-
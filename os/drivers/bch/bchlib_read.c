@@ -95,6 +95,7 @@
 ssize_t bchlib_read(FAR void *handle, FAR char *buffer, size_t offset, size_t len)
 {
 	FAR struct bchlib_s *bch = (FAR struct bchlib_s *)handle;
+	FAR struct bch_cachesect_s *entry;
 	size_t		nsectors;
 	size_t		sector;
 	uint16_t	sectoffset;
@@ -125,8 +126,11 @@ ssize_t bchlib_read(FAR void *handle, FAR char *buffer, size_t offset, size_t le
 
 	bytesread = 0;
 	if (sectoffset > 0) {
-		/* Read the sector into the sector buffer */
-		bchlib_readsector(bch, sector);
+		/* Read the sector into the sector cache */
+		ret = bchlib_readsector(bch, sector, &entry);
+		if (ret < 0) {
+			return ret;
+		}
 
 		/* Copy the tail end of the sector to the user buffer */
 		if (sectoffset + len > bch->sectsize) {
@@ -135,7 +139,7 @@ ssize_t bchlib_read(FAR void *handle, FAR char *buffer, size_t offset, size_t le
 			nbytes = len;
 		}
 
-		memcpy(buffer, &bch->buffer[sectoffset], nbytes);
+		memcpy(buffer, &entry->buffer[sectoffset], nbytes);
 
 		/* Adjust pointers and counts */
 		sector++;
@@ -166,6 +170,9 @@ ssize_t bchlib_read(FAR void *handle, FAR char *buffer, size_t offset, size_t le
 			return ret;
 		}
 
+		/* Sectors written to the cache but not yet to the media win */
+		bchlib_copydirty(bch, (FAR uint8_t *)buffer, sector, nsectors);
+
 		/* Adjust pointers and counts */
 		sector    += nsectors;
 		nbytes     = nsectors * bch->sectsize;
@@ -181,11 +188,14 @@ ssize_t bchlib_read(FAR void *handle, FAR char *buffer, size_t offset, size_t le
 
 	/* Then read any partial final sector */
 	if (len > 0) {
-		/* Read the sector into the sector buffer */
-		bchlib_readsector(bch, sector);
+		/* Read the sector into the sector cache */
+		ret = bchlib_readsector(bch, sector, &entry);
+		if (ret < 0) {
+			return bytesread > 0 ? bytesread : ret;
+		}
 
 		/* Copy the head end of the sector to the user buffer */
-		memcpy(buffer, bch->buffer, len);
+		memcpy(buffer, entry->buffer, len);
 
 		/* Adjust counts */
 		bytesread += len;
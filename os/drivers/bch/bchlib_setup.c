@@ -86,6 +86,7 @@ int bchlib_setup(const char *blkdev, bool readonly, FAR void **handle)
 {
 	FAR struct bchlib_s *bch;
 	struct geometry geo;
+	struct bch_cacheconfig_s cache;
 	int ret;
 
 	DEBUGASSERT(blkdev);
@@ -125,20 +126,25 @@ int bchlib_setup(const char *blkdev, bool readonly, FAR void **handle)
 	}
 
 	/* Save the geometry info and complete initialization of the structure */
-	sem_init(&bch->sem, 0, 1);
 	bch->nsectors = geo.geo_nsectors;
 	bch->sectsize = geo.geo_sectorsize;
-	bch->sector   = (size_t)-1;
 	bch->readonly = readonly;
 
-	/* Allocate the sector I/O buffer */
-	bch->buffer = (FAR uint8_t *)kmm_malloc(bch->sectsize);
-	if (!bch->buffer) {
-		fdbg("ERROR: Failed to allocate sector buffer\n");
-		ret = -ENOMEM;
+	/* Allocate the sector cache */
+	cache.nsectors  = CONFIG_BCH_CACHE_NSECTORS;
+	cache.readahead = CONFIG_BCH_CACHE_READAHEAD < CONFIG_BCH_CACHE_NSECTORS ? CONFIG_BCH_CACHE_READAHEAD : CONFIG_BCH_CACHE_NSECTORS - 1;
+#ifdef CONFIG_BCH_CACHE_WRITEBACK
+	cache.writeback = true;
+#else
+	cache.writeback = false;
+#endif
+	ret = bchlib_setcache(bch, &cache);
+	if (ret < 0) {
 		goto errout_with_bch;
 	}
 
+	sem_init(&bch->sem, 0, 1);
+
 	*handle = bch;
 	return OK;
 
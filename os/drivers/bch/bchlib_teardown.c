@@ -94,9 +94,7 @@ int bchlib_teardown(FAR void *handle)
 	(void)close_blockdriver(bch->inode);
 
 	/* Free the BCH state structure */
-	if (bch->buffer) {
-		kmm_free(bch->buffer);
-	}
+	bchlib_freecache(bch);
 
 	sem_destroy(&bch->sem);
 	kmm_free(bch);
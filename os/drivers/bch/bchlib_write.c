@@ -82,6 +82,7 @@
 ssize_t bchlib_write(FAR void *handle, FAR const char *buffer, size_t offset, size_t len)
 {
 	FAR struct bchlib_s *bch = (FAR struct bchlib_s *)handle;
+	FAR struct bch_cachesect_s *entry;
 	size_t   nsectors;
 	size_t   sector;
 	uint16_t sectoffset;
@@ -111,8 +112,11 @@ ssize_t bchlib_write(FAR void *handle, FAR const char *buffer, size_t offset, si
 
 	byteswritten = 0;
 	if (sectoffset > 0) {
-		/* Read the full sector into the sector buffer */
-		bchlib_readsector(bch, sector);
+		/* Read the full sector into the sector cache */
+		ret = bchlib_readsector(bch, sector, &entry);
+		if (ret < 0) {
+			return ret;
+		}
 
 		/* Copy the tail end of the sector from the user buffer */
 		if (sectoffset + len > bch->sectsize) {
@@ -121,17 +125,17 @@ ssize_t bchlib_write(FAR void *handle, FAR const char *buffer, size_t offset, si
 			nbytes = len;
 		}
 
-		memcpy(&bch->buffer[sectoffset], buffer, nbytes);
-		bch->dirty = true;
+		memcpy(&entry->buffer[sectoffset], buffer, nbytes);
+		entry->dirty = true;
 
 		/* Adjust pointers and counts */
 		sector++;
 
+		byteswritten  = nbytes;
 		if (sector >= bch->nsectors) {
-			return nbytes;
+			goto flush;
 		}
 
-		byteswritten  = nbytes;
 		buffer       += nbytes;
 		len          -= nbytes;
 	}
@@ -146,6 +150,9 @@ ssize_t bchlib_write(FAR void *handle, FAR const char *buffer, size_t offset, si
 			nsectors = bch->nsectors - sector;
 		}
 
+		/* Cached copies of these sectors are superseded */
+		bchlib_invalidate(bch, sector, nsectors);
+
 		/* Write the contiguous sectors */
 		ret = bch->inode->u.i_bops->write(bch->inode, (FAR uint8_t *)buffer,
 				sector, nsectors);
@@ -160,7 +167,7 @@ ssize_t bchlib_write(FAR void *handle, FAR const char *buffer, size_t offset, si
 		byteswritten += nbytes;
 
 		if (sector >= bch->nsectors) {
-			return byteswritten;
+			goto flush;
 		}
 
 		buffer    += nbytes;
@@ -169,22 +176,35 @@ ssize_t bchlib_write(FAR void *handle, FAR const char *buffer, size_t offset, si
 
 	/* Then write any partial final sector */
 	if (len > 0) {
-		/* Read the sector into the sector buffer */
-		bchlib_readsector(bch, sector);
+		/* Read the sector into the sector cache */
+		ret = bchlib_readsector(bch, sector, &entry);
+		if (ret < 0) {
+			if (byteswritten == 0) {
+				return ret;
+			}
+
+			/* Still flush what was written so far */
+			goto flush;
+		}
 
 		/* Copy the head end of the sector from the user buffer */
-		memcpy(bch->buffer, buffer, len);
-		bch->dirty = true;
+		memcpy(entry->buffer, buffer, len);
+		entry->dirty = true;
 
 		/* Adjust counts */
 		byteswritten += len;
 	}
 
-	/* Finally, flush any cached writes to the device as well */
-	ret = bchlib_flushsector(bch);
-	if (ret < 0) {
-		fdbg("ERROR: Flush failed: %d\n", ret);
-		return ret;
+flush:
+	/* Finally, flush any cached writes to the device as well unless the
+	 * cache is in write-back mode.
+	 */
+	if (!bch->writeback) {
+		ret = bchlib_flushsector(bch);
+		if (ret < 0) {
+			fdbg("ERROR: Flush failed: %d\n", ret);
+			return ret;
+		}
 	}
 
 	return byteswritten;
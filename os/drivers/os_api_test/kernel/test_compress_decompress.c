@@ -42,6 +42,45 @@
  * Private Function
  ****************************************************************************/
 
+static int test_compress_read_block(int filefd, int blocksize)
+{
+	uint8_t *block;
+	uint8_t *chunk;
+	int offset;
+	int size;
+	int ret = OK;
+
+	block = (uint8_t *)kmm_malloc(blocksize);
+	chunk = (uint8_t *)kmm_malloc(READSIZE);
+	if (block == NULL || chunk == NULL) {
+		berr("Allocation of memory failed\n");
+		kmm_free(block);
+		kmm_free(chunk);
+		return ERROR;
+	}
+
+	size = compress_read(filefd, 0, block, blocksize, 0);
+	if (size != blocksize) {
+		berr("Read for whole block failed\n");
+		ret = ERROR;
+		goto errout;
+	}
+
+	for (offset = 0; offset + READSIZE / 2 <= blocksize; offset += READSIZE / 2) {
+		size = compress_read(filefd, 0, chunk, READSIZE / 2, offset);
+		if (size != READSIZE / 2 || memcmp(chunk, &block[offset], size) != 0) {
+			berr("Partial read at offset %d does not match\n", offset);
+			ret = ERROR;
+			goto errout;
+		}
+	}
+
+errout:
+	kmm_free(block);
+	kmm_free(chunk);
+	return ret;
+}
+
 static int test_compress_decompress_function(unsigned long arg)
 {
 	int i;
@@ -90,10 +129,20 @@ static int test_compress_decompress_function(unsigned long arg)
 		}
 	}
 
-	compress_uninit();
 	kmm_free(dst_buffer);
 
-	return OK;
+	/* A whole block is decompressed in place, partial reads go through the
+	 * block cache.  Both have to return the same data.
+	 */
+	if (compression_header->binary_size < compression_header->blocksize) {
+		ret = test_compress_read_block(filefd, compression_header->binary_size);
+	} else {
+		ret = test_compress_read_block(filefd, compression_header->blocksize);
+	}
+
+	compress_uninit();
+
+	return ret;
 }
 
 /****************************************************************************
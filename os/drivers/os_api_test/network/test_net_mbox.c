@@ -0,0 +1,136 @@
+/****************************************************************************
+ *
+ * Copyright 2025 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <tinyara/config.h>
+#include <debug.h>
+#include <errno.h>
+#include <semaphore.h>
+#include <stdint.h>
+#include <time.h>
+#include <sched.h>
+#include <tinyara/kthread.h>
+#include <tinyara/os_api_test_drv.h>
+#include <lwip/sys.h>
+
+typedef struct sys_mbox_perf_args mbox_perf_args_t;
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define MBOX_PERF_STACKSIZE 2048
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static sys_mbox_t g_perf_mbox;
+static sem_t g_perf_done;
+static int g_perf_messages;
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+static int mbox_perf_producer(int argc, char *argv[])
+{
+	int i;
+
+	for (i = 1; i <= g_perf_messages; i++) {
+		sys_mbox_post(&g_perf_mbox, (void *)(uintptr_t)i);
+	}
+
+	sem_post(&g_perf_done);
+	return 0;
+}
+
+static int test_mbox_perf(unsigned long arg)
+{
+	mbox_perf_args_t *args = (mbox_perf_args_t *)arg;
+	struct timespec start;
+	struct timespec end;
+	void *msg;
+	long total;
+	int started;
+	int ret = OK;
+
+	if (args == NULL || args->producers <= 0 || args->messages <= 0) {
+		return -EINVAL;
+	}
+
+	if (sys_mbox_new(&g_perf_mbox, args->queue_size) != ERR_OK) {
+		return -ENOMEM;
+	}
+
+	sem_init(&g_perf_done, 0, 0);
+	sem_setprotocol(&g_perf_done, SEM_PRIO_NONE);
+	g_perf_messages = args->messages;
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+
+	for (started = 0; started < args->producers; started++) {
+		if (kernel_thread("mbox_perf", SCHED_PRIORITY_DEFAULT, MBOX_PERF_STACKSIZE, mbox_perf_producer, NULL) < 0) {
+			ret = -ENOMEM;
+			break;
+		}
+	}
+
+	/* Drain everything the started producers post */
+
+	for (total = (long)started * args->messages; total > 0; total--) {
+		sys_arch_mbox_fetch(&g_perf_mbox, &msg, 0);
+	}
+
+	clock_gettime(CLOCK_MONOTONIC, &end);
+
+	/* The producers may still be returning from their last post */
+
+	while (started-- > 0) {
+		while (sem_wait(&g_perf_done) < 0) {
+			DEBUGASSERT(get_errno() == EINTR);
+		}
+	}
+
+	args->queue_size = g_perf_mbox.queue_size;
+	args->elapsed_us = (end.tv_sec - start.tv_sec) * 1000000 + (end.tv_nsec - start.tv_nsec) / 1000;
+
+	sys_mbox_free(&g_perf_mbox);
+	sem_destroy(&g_perf_done);
+	return ret;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+int test_net_mbox(int cmd, unsigned long arg)
+{
+	int ret = -EINVAL;
+
+	switch (cmd) {
+	case TESTIOC_NET_MBOX_PERF:
+		ret = test_mbox_perf(arg);
+		break;
+	}
+
+	return ret;
+}
@@ -191,6 +191,12 @@ static int os_api_test_drv_ioctl(FAR struct file *filep, int cmd, unsigned long
 		ret = test_net_pbuf(cmd, arg);
 		break;
 #endif
+#ifdef CONFIG_EXAMPLES_LWIP_MBOX_PERFORMANCE
+	/* Measure the throughput of the lwIP mailbox */
+	case TESTIOC_NET_MBOX_PERF:
+		ret = test_net_mbox(cmd, arg);
+		break;
+#endif
 #if defined(CONFIG_AUTOMOUNT_USERFS) && defined(CONFIG_EXAMPLES_TESTCASE_FILESYSTEM)
 	case TESTIOC_GET_FS_PARTNO:
 		ret = test_fs_get_devname();
@@ -155,8 +155,58 @@ static inline void rwb_resetwrbuffer(struct rwbuffer_s *rwb)
 	/* We assume that the caller holds the wrsem */
 
 	rwb->wrnblocks = 0;
-	rwb->wrblockstart = (off_t)-1;
-	rwb->wrexpectedblock = (off_t)-1;
+}
+#endif
+
+/****************************************************************************
+ * Name: rwb_wrfind
+ *
+ * Description:
+ *   Return the write buffer slot holding 'block', or -1
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_DRVR_WRITEBUFFER
+static int rwb_wrfind(FAR struct rwbuffer_s *rwb, off_t block)
+{
+	int slot;
+
+	for (slot = 0; slot < rwb->wrnblocks; slot++) {
+		if (rwb->wrblocks[slot] == block) {
+			return slot;
+		}
+	}
+
+	return -1;
+}
+#endif
+
+/****************************************************************************
+ * Name: rwb_wrswap
+ *
+ * Description:
+ *   Exchange two write buffer slots
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_DRVR_WRITEBUFFER
+static void rwb_wrswap(FAR struct rwbuffer_s *rwb, int slot1, int slot2)
+{
+	FAR uint8_t *p1 = &rwb->wrbuffer[slot1 * rwb->blocksize];
+	FAR uint8_t *p2 = &rwb->wrbuffer[slot2 * rwb->blocksize];
+	off_t block;
+	uint8_t tmp;
+	int i;
+
+	for (i = 0; i < rwb->blocksize; i++) {
+		tmp = p1[i];
+		p1[i] = p2[i];
+		p2[i] = tmp;
+	}
+
+	block = rwb->wrblocks[slot1];
+	rwb->wrblocks[slot1] = rwb->wrblocks[slot2];
+	rwb->wrblocks[slot2] = block;
 }
 #endif
 
@@ -169,28 +219,55 @@ static inline void rwb_resetwrbuffer(struct rwbuffer_s *rwb)
  ****************************************************************************/
 
 #ifdef CONFIG_DRVR_WRITEBUFFER
-static void rwb_wrflush(struct rwbuffer_s *rwb)
+static int rwb_wrflush(struct rwbuffer_s *rwb)
 {
-	int ret;
-
-	fvdbg("Timeout!\n");
+	int ret = OK;
+	int tmp;
+	int first;
+	int last;
+	int min;
+	int i;
 
 	if (rwb->wrnblocks > 0) {
-		fvdbg("Flushing: blockstart=0x%08lx nblocks=%d from buffer=%p\n", (long)rwb->wrblockstart, rwb->wrnblocks, rwb->wrbuffer);
+		fvdbg("Flushing: nblocks=%d from buffer=%p\n", rwb->wrnblocks, rwb->wrbuffer);
 
-		/* Flush cache.  On success, the flush method will return the number
-		 * of blocks written.  Anything other than the number requested is
-		 * an error.
+		/* Sort the slots by block number (selection sort: at most one block
+		 * copy per slot) so that every run of consecutive blocks is also
+		 * contiguous in the buffer.
 		 */
 
-		ret = rwb->wrflush(rwb->dev, rwb->wrbuffer, rwb->wrblockstart, rwb->wrnblocks);
-		if (ret != rwb->wrnblocks) {
-			fdbg("ERROR: Error flushing write buffer: %d\n", ret);
+		for (first = 0; first < rwb->wrnblocks - 1; first++) {
+			min = first;
+			for (i = first + 1; i < rwb->wrnblocks; i++) {
+				if (rwb->wrblocks[i] < rwb->wrblocks[min]) {
+					min = i;
+				}
+			}
+
+			if (min != first) {
+				rwb_wrswap(rwb, first, min);
+			}
+		}
+
+		/* Then write each run with one request.  On success, the flush
+		 * method will return the number of blocks written.  Anything other
+		 * than the number requested is an error.
+		 */
+
+		for (first = 0; first < rwb->wrnblocks; first = last) {
+			for (last = first + 1; last < rwb->wrnblocks && rwb->wrblocks[last] == rwb->wrblocks[last - 1] + 1; last++) ;
+
+			tmp = rwb->wrflush(rwb->dev, &rwb->wrbuffer[first * rwb->blocksize], rwb->wrblocks[first], last - first);
+			if (tmp != last - first) {
+				fdbg("ERROR: Error flushing write buffer: %d\n", tmp);
+				ret = tmp < 0 ? tmp : -EIO;
+			}
 		}
 
 		rwb_resetwrbuffer(rwb);
 	}
 
+	return ret;
 }
 #endif
 
@@ -198,6 +275,7 @@ static void rwb_wrflush(struct rwbuffer_s *rwb)
  * Name: rwb_wrtimeout
  ****************************************************************************/
 
+#ifdef CONFIG_DRVR_WRITEBUFFER
 static void rwb_wrtimeout(FAR void *arg)
 {
 	/* The following assumes that the size of a pointer is 4-bytes or less */
@@ -210,8 +288,10 @@ static void rwb_wrtimeout(FAR void *arg)
 	 * worker thread.
 	 */
 
+	fvdbg("Timeout!\n");
+
 	rwb_semtake(&rwb->wrsem);
-	rwb_wrflush(rwb);
+	(void)rwb_wrflush(rwb);
 	rwb_semgive(&rwb->wrsem);
 }
 
@@ -237,6 +317,7 @@ static inline void rwb_wrcanceltimeout(struct rwbuffer_s *rwb)
 {
 	(void)work_cancel(LPWORK, &rwb->work);
 }
+#endif
 
 /****************************************************************************
  * Name: rwb_writebuffer
@@ -245,50 +326,76 @@ static inline void rwb_wrcanceltimeout(struct rwbuffer_s *rwb)
 #ifdef CONFIG_DRVR_WRITEBUFFER
 static ssize_t rwb_writebuffer(FAR struct rwbuffer_s *rwb, off_t startblock, uint32_t nblocks, FAR const uint8_t *wrbuffer)
 {
+	uint32_t nnew = 0;
+	uint32_t i;
+	int slot;
 	int ret;
 
-	/* Write writebuffer Logic */
+	/* We assume that the caller holds the wrsem */
 
 	rwb_wrcanceltimeout(rwb);
 
-	/* First: Should we flush out our cache? We would do that if (1) we already
-	 * buffering blocks and the next block writing is not in the same sequence,
-	 * or (2) the number of blocks would exceed our allocated buffer capacity
+	/* Blocks that are already buffered are simply overwritten.  Flush the
+	 * buffer first only if the others would not fit in the free slots.
 	 */
 
-	if (((startblock != rwb->wrexpectedblock) && (rwb->wrnblocks)) || ((rwb->wrnblocks + nblocks) > rwb->wrmaxblocks)) {
-		fvdbg("writebuffer miss, expected: %08x, given: %08x\n", rwb->wrexpectedblock, startblock);
+	for (i = 0; i < nblocks; i++) {
+		if (rwb_wrfind(rwb, startblock + i) < 0) {
+			nnew++;
+		}
+	}
 
-		/* Flush the write buffer */
+	if (rwb->wrnblocks + nnew > rwb->wrmaxblocks) {
+		fvdbg("writebuffer full, flushing %d blocks\n", rwb->wrnblocks);
 
-		ret = rwb->wrflush(rwb, rwb->wrbuffer, rwb->wrblockstart, rwb->wrnblocks);
+		ret = rwb_wrflush(rwb);
 		if (ret < 0) {
 			fdbg("ERROR: Error writing multiple from cache: %d\n", -ret);
 			return ret;
 		}
-
-		rwb_resetwrbuffer(rwb);
-	}
-
-	/* writebuffer is empty? Then initialize it */
-
-	if (rwb->wrnblocks == 0) {
-		fvdbg("Fresh cache starting at block: 0x%08x\n", startblock);
-		rwb->wrblockstart = startblock;
 	}
 
 	/* Add data to cache */
 
-	fvdbg("writebuffer: copying %d bytes from %p to %p\n", nblocks * rwb->blocksize, wrbuffer, &rwb->wrbuffer[rwb->wrnblocks * rwb->blocksize]);
-	memcpy(&rwb->wrbuffer[rwb->wrnblocks * rwb->blocksize], wrbuffer, nblocks * rwb->blocksize);
+	for (i = 0; i < nblocks; i++, wrbuffer += rwb->blocksize) {
+		slot = rwb_wrfind(rwb, startblock + i);
+		if (slot < 0) {
+			slot = rwb->wrnblocks++;
+			rwb->wrblocks[slot] = startblock + i;
+		}
+
+		memcpy(&rwb->wrbuffer[slot * rwb->blocksize], wrbuffer, rwb->blocksize);
+	}
 
-	rwb->wrnblocks += nblocks;
-	rwb->wrexpectedblock = rwb->wrblockstart + rwb->wrnblocks;
 	rwb_wrstarttimeout(rwb);
 	return nblocks;
 }
 #endif
 
+/****************************************************************************
+ * Name: rwb_wroverlay
+ *
+ * Description:
+ *   Copy the buffered (newer) contents of any block in the range over data
+ *   just read from the media or the read-ahead buffer.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_DRVR_WRITEBUFFER
+static void rwb_wroverlay(FAR struct rwbuffer_s *rwb, off_t startblock, size_t nblocks, FAR uint8_t *rdbuffer)
+{
+	int slot;
+
+	/* We assume that the caller holds the wrsem */
+
+	for (slot = 0; slot < rwb->wrnblocks; slot++) {
+		if (rwb->wrblocks[slot] >= startblock && rwb->wrblocks[slot] < startblock + (off_t)nblocks) {
+			memcpy(&rdbuffer[(rwb->wrblocks[slot] - startblock) * rwb->blocksize], &rwb->wrbuffer[slot * rwb->blocksize], rwb->blocksize);
+		}
+	}
+}
+#endif
+
 /****************************************************************************
  * Name: rwb_resetrhbuffer
  ****************************************************************************/
@@ -340,10 +447,9 @@ static inline void rwb_bufferread(struct rwbuffer_s *rwb, off_t startblock, size
  ****************************************************************************/
 
 #ifdef CONFIG_DRVR_READAHEAD
-static int rwb_rhreload(struct rwbuffer_s *rwb, off_t startblock)
+static int rwb_rhreload(struct rwbuffer_s *rwb, off_t startblock, size_t nblocks)
 {
 	off_t endblock;
-	size_t nblocks;
 	int ret;
 
 	/* Check for attempts to read beyond the end of the media */
@@ -356,7 +462,11 @@ static int rwb_rhreload(struct rwbuffer_s *rwb, off_t startblock)
 	 * read-ahead buffer
 	 */
 
-	endblock = startblock + rwb->rhmaxblocks;
+	if (nblocks > rwb->rhmaxblocks) {
+		nblocks = rwb->rhmaxblocks;
+	}
+
+	endblock = startblock + nblocks;
 
 	/* Make sure that we don't read past the end of the device */
 
@@ -388,6 +498,49 @@ static int rwb_rhreload(struct rwbuffer_s *rwb, off_t startblock)
 }
 #endif
 
+/****************************************************************************
+ * Name: rwb_rhstream
+ *
+ * Description:
+ *   Find the read stream that a request starting at 'startblock' continues
+ *   and grow its read-ahead window.  A request that continues no stream
+ *   replaces the oldest one and gets a window covering the request only,
+ *   so random reads do not pay for a full read-ahead buffer reload.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_DRVR_READAHEAD
+static FAR struct rwb_rhstream_s *rwb_rhstream(FAR struct rwbuffer_s *rwb, off_t startblock, size_t nblocks)
+{
+	FAR struct rwb_rhstream_s *stream;
+	int i;
+
+	for (i = 0; i < CONFIG_DRVR_RHSTREAMS; i++) {
+		stream = &rwb->rhstreams[i];
+		if (stream->next == startblock) {
+			if (stream->window < rwb->rhmaxblocks) {
+				stream->window <<= 1;
+				if (stream->window > rwb->rhmaxblocks) {
+					stream->window = rwb->rhmaxblocks;
+				}
+			}
+
+			return stream;
+		}
+	}
+
+	stream = &rwb->rhstreams[rwb->rhnextstream];
+	rwb->rhnextstream = (rwb->rhnextstream + 1) % CONFIG_DRVR_RHSTREAMS;
+
+	stream->window = nblocks < rwb->rhmaxblocks ? nblocks : rwb->rhmaxblocks;
+	if (stream->window == 0) {
+		stream->window = 1;
+	}
+
+	return stream;
+}
+#endif
+
 /****************************************************************************
  * Name: rwb_invalidate_writebuffer
  *
@@ -399,120 +552,34 @@ static int rwb_rhreload(struct rwbuffer_s *rwb, off_t startblock)
 #if defined(CONFIG_DRVR_WRITEBUFFER) && defined(CONFIG_DRVR_INVALIDATE)
 int rwb_invalidate_writebuffer(FAR struct rwbuffer_s *rwb, off_t startblock, size_t blockcount)
 {
-	int ret;
+	int slot;
+	int last;
 
 	if (rwb->wrmaxblocks > 0 && rwb->wrnblocks > 0) {
-		off_t wrbend;
-		off_t invend;
-
 		fvdbg("startblock=%d blockcount=%p\n", startblock, blockcount);
 
 		rwb_semtake(&rwb->wrsem);
 
-		/* Now there are five cases:
-		 *
-		 * 1. We invalidate nothing
+		/* Drop every buffered block in the region, filling the hole with
+		 * the last slot in use.
 		 */
 
-		wrbend = rwb->wrblockstart + rwb->wrnblocks;
-		invend = startblock + blockcount;
-
-		if (rwb->wrblockstart > invend || wrbend < startblock) {
-			ret = OK;
-		}
-
-		/* 2. We invalidate the entire write buffer. */
-
-		else if (rwb->wrblockstart >= startblock && wrbend <= invend) {
-			rwb->wrnblocks = 0;
-			ret = OK;
-		}
-
-		/* We are going to invalidate a subset of the write buffer.  Three
-		 * more cases to consider:
-		 *
-		 * 2. We invalidate a portion in the middle of the write buffer
-		 */
-
-		else if (rwb->wrblockstart < startblock && wrbend > invend) {
-			uint8_t *src;
-			off_t block;
-			off_t offset;
-			size_t nblocks;
-
-			/* Write the blocks at the end of the media to hardware */
-
-			nblocks = wrbend - invend;
-			block = invend;
-			offset = block - rwb->wrblockstart;
-			src = rwb->wrbuffer + offset * rwb->blocksize;
-
-			ret = rwb->wrflush(rwb->dev, src, block, nblocks);
-			if (ret < 0) {
-				fdbg("ERROR: wrflush failed: %d\n", ret);
-			}
-
-			/* Keep the blocks at the beginning of the buffer up the
-			 * start of the invalidated region.
-			 */
-			else {
-				rwb->wrnblocks = startblock - rwb->wrblockstart;
-				ret = OK;
+		for (slot = 0; slot < rwb->wrnblocks;) {
+			if (rwb->wrblocks[slot] >= startblock && rwb->wrblocks[slot] < startblock + (off_t)blockcount) {
+				last = --rwb->wrnblocks;
+				if (slot != last) {
+					memcpy(&rwb->wrbuffer[slot * rwb->blocksize], &rwb->wrbuffer[last * rwb->blocksize], rwb->blocksize);
+					rwb->wrblocks[slot] = rwb->wrblocks[last];
+				}
+			} else {
+				slot++;
 			}
 		}
 
-		/* 3. We invalidate a portion at the end of the write buffer */
-
-		else if (wrbend > startblock && wrbend <= invend) {
-			rwb->wrnblocks = wrbend - startblock;
-			ret = OK;
-		}
-
-		/* 4. We invalidate a portion at the beginning of the write buffer */
-
-		else {					/* if (rwb->wrblockstart >= startblock && wrbend > invend) */
-
-			uint8_t *src;
-			size_t ninval;
-			size_t nkeep;
-
-			DEBUGASSERT(rwb->wrblockstart >= startblock && wrbend > invend);
-
-			/* Copy the data from the uninvalidated region to the beginning
-			 * of the write buffer.
-			 *
-			 * First calculate the source and destination of the transfer.
-			 */
-
-			ninval = invend - rwb->wrblockstart;
-			src = rwb->wrbuffer + ninval * rwb->blocksize;
-
-			/* Calculate the number of blocks we are keeping.  We keep
-			 * the ones that we don't invalidate.
-			 */
-
-			nkeep = rwb->wrnblocks - ninval;
-
-			/* Then move the data that we are keeping to the beginning
-			 * the write buffer.
-			 */
-
-			memcpy(rwb->wrbuffer, src, nkeep * rwb->blocksize);
-
-			/* Update the block info.  The first block is now the one just
-			 * after the invalidation region and the number buffered blocks
-			 * is the number that we kept.
-			 */
-
-			rwb->wrblockstart = invend;
-			rwb->wrnblocks = nkeep;
-			ret = OK;
-		}
-
 		rwb_semgive(&rwb->wrsem);
 	}
 
-	return ret;
+	return OK;
 }
 #endif
 
@@ -622,6 +689,7 @@ int rwb_initialize(FAR struct rwbuffer_s *rwb)
 #ifdef CONFIG_DRVR_WRITEBUFFER
 	DEBUGASSERT(rwb->wrflush != NULL);
 	rwb->wrbuffer = NULL;
+	rwb->wrblocks = NULL;
 #endif
 #ifdef CONFIG_DRVR_READAHEAD
 	DEBUGASSERT(rwb->rhreload != NULL);
@@ -650,6 +718,12 @@ int rwb_initialize(FAR struct rwbuffer_s *rwb)
 				fdbg("Write buffer kmm_malloc(%d) failed\n", allocsize);
 				return -ENOMEM;
 			}
+
+			rwb->wrblocks = (FAR off_t *)kmm_malloc(rwb->wrmaxblocks * sizeof(off_t));
+			if (!rwb->wrblocks) {
+				fdbg("Write buffer block list allocation failed\n");
+				return -ENOMEM;
+			}
 		}
 
 		fvdbg("Write buffer size: %d bytes\n", allocsize);
@@ -667,6 +741,12 @@ int rwb_initialize(FAR struct rwbuffer_s *rwb)
 		/* Initialize read-ahead buffer parameters */
 
 		rwb_resetrhbuffer(rwb);
+		for (allocsize = 0; allocsize < CONFIG_DRVR_RHSTREAMS; allocsize++) {
+			rwb->rhstreams[allocsize].next = (off_t)-1;
+			rwb->rhstreams[allocsize].window = 0;
+		}
+
+		rwb->rhnextstream = 0;
 
 		/* Allocate the read-ahead buffer */
 
@@ -700,6 +780,10 @@ void rwb_uninitialize(FAR struct rwbuffer_s *rwb)
 		if (rwb->wrbuffer) {
 			kmm_free(rwb->wrbuffer);
 		}
+
+		if (rwb->wrblocks) {
+			kmm_free(rwb->wrblocks);
+		}
 	}
 #endif
 
@@ -720,6 +804,9 @@ void rwb_uninitialize(FAR struct rwbuffer_s *rwb)
 int rwb_read(FAR struct rwbuffer_s *rwb, off_t startblock, uint32_t nblocks, FAR uint8_t *rdbuffer)
 {
 #ifdef CONFIG_DRVR_READAHEAD
+	FAR struct rwb_rhstream_s *stream;
+	FAR uint8_t *dest = rdbuffer;
+	off_t block = startblock;
 	uint32_t remaining;
 #endif
 	int ret = OK;
@@ -727,23 +814,13 @@ int rwb_read(FAR struct rwbuffer_s *rwb, off_t startblock, uint32_t nblocks, FAR
 	fvdbg("startblock=%ld nblocks=%ld rdbuffer=%p\n", (long)startblock, (long)nblocks, rdbuffer);
 
 #ifdef CONFIG_DRVR_WRITEBUFFER
-	/* If the new read data overlaps any part of the write buffer, then
-	 * flush the write data onto the physical media before reading.  We
-	 * could attempt some more exotic handling -- but this simple logic
-	 * is well-suited for simple streaming applications.
+	/* Blocks still in the write buffer are newer than the media.  Hold the
+	 * write buffer while reading so that none of them can be flushed and
+	 * dropped before they are copied over the data read below.
 	 */
 
 	if (rwb->wrmaxblocks > 0) {
-		/* If the write buffer overlaps the block(s) requested, then flush the
-		 * write buffer.
-		 */
-
 		rwb_semtake(&rwb->wrsem);
-		if (rwb_overlap(rwb->wrblockstart, rwb->wrnblocks, startblock, nblocks)) {
-			rwb_wrflush(rwb);
-		}
-
-		rwb_semgive(&rwb->wrsem);
 	}
 #endif
 
@@ -752,6 +829,7 @@ int rwb_read(FAR struct rwbuffer_s *rwb, off_t startblock, uint32_t nblocks, FAR
 		/* Loop until we have read all of the requested blocks */
 
 		rwb_semtake(&rwb->rhsem);
+		stream = rwb_rhstream(rwb, startblock, nblocks);
 		for (remaining = nblocks; remaining > 0;) {
 			/* Is there anything in the read-ahead buffer? */
 
@@ -761,40 +839,68 @@ int rwb_read(FAR struct rwbuffer_s *rwb, off_t startblock, uint32_t nblocks, FAR
 				/* How many blocks are available in this buffer? */
 
 				bufferend = rwb->rhblockstart + rwb->rhnblocks;
-				if (startblock >= rwb->rhblockstart && startblock < bufferend) {
-					size_t rdblocks = bufferend - startblock;
+				if (block >= rwb->rhblockstart && block < bufferend) {
+					size_t rdblocks = bufferend - block;
 					if (rdblocks > remaining) {
 						rdblocks = remaining;
 					}
 
 					/* Then read the data from the read-ahead buffer */
 
-					rwb_bufferread(rwb, startblock, rdblocks, &rdbuffer);
-					startblock += rdblocks;
+					rwb_bufferread(rwb, block, rdblocks, &dest);
+					block += rdblocks;
 					remaining -= rdblocks;
 				}
 			}
 
-			/* If we did not get all of the data from the buffer, then we have
-			 * to refill the buffer and try again.
-			 */
+			if (remaining >= rwb->rhmaxblocks) {
+				/* Too big for the read-ahead buffer.  Read the rest directly
+				 * into the caller's buffer.
+				 */
+
+				ret = rwb->rhreload(rwb->dev, dest, block, remaining);
+				if (ret != remaining) {
+					fdbg("ERROR: Failed to read %d blocks: %d\n", remaining, ret);
+					ret = ret < 0 ? ret : -EIO;
+					break;
+				}
+
+				block += remaining;
+				remaining = 0;
+			} else if (remaining > 0) {
+				/* If we did not get all of the data from the buffer, then we
+				 * have to refill the buffer and try again.
+				 */
 
-			if (remaining > 0) {
-				ret = rwb_rhreload(rwb, startblock);
+				ret = rwb_rhreload(rwb, block, remaining > stream->window ? remaining : stream->window);
 				if (ret < 0) {
 					fdbg("ERROR: Failed to fill the read-ahead buffer: %d\n", ret);
-					return ret;
+					break;
+				}
+
+#ifdef CONFIG_DRVR_WRITEBUFFER
+				/* Keep the read-ahead buffer coherent with the blocks that
+				 * have not reached the media yet.
+				 */
+
+				if (rwb->wrmaxblocks > 0) {
+					rwb_wroverlay(rwb, rwb->rhblockstart, rwb->rhnblocks, rwb->rhbuffer);
 				}
+#endif
 			}
 		}
 
+		stream->next = block;
+		rwb_semgive(&rwb->rhsem);
+
 		/* On success, return the number of blocks that we were requested to
 		 * read. This is for compatibility with the normal return of a block
 		 * driver read method
 		 */
 
-		rwb_semgive(&rwb->rhsem);
-		ret = nblocks;
+		if (remaining == 0) {
+			ret = nblocks;
+		}
 	} else
 #endif
 	{
@@ -805,6 +911,16 @@ int rwb_read(FAR struct rwbuffer_s *rwb, off_t startblock, uint32_t nblocks, FAR
 		ret = rwb->rhreload(rwb->dev, rdbuffer, startblock, nblocks);
 	}
 
+#ifdef CONFIG_DRVR_WRITEBUFFER
+	if (rwb->wrmaxblocks > 0) {
+		if (ret > 0) {
+			rwb_wroverlay(rwb, startblock, ret, rdbuffer);
+		}
+
+		rwb_semgive(&rwb->wrsem);
+	}
+#endif
+
 	return ret;
 }
 
@@ -825,7 +941,7 @@ int rwb_write(FAR struct rwbuffer_s *rwb, off_t startblock, size_t nblocks, FAR
 		 */
 
 		rwb_semtake(&rwb->rhsem);
-		if (rwb_overlap(rwb->rhblockstart, rwb->rhnblocks, startblock, nblocks)) {
+		if (rwb->rhnblocks > 0 && rwb_overlap(rwb->rhblockstart, rwb->rhnblocks, startblock, nblocks)) {
 			rwb_resetrhbuffer(rwb);
 		}
 
@@ -837,14 +953,15 @@ int rwb_write(FAR struct rwbuffer_s *rwb, off_t startblock, size_t nblocks, FAR
 	if (rwb->wrmaxblocks > 0) {
 		fvdbg("startblock=%d wrbuffer=%p\n", startblock, wrbuffer);
 
+		rwb_semtake(&rwb->wrsem);
+
 		/* Use the block cache unless the buffer size is bigger than block cache */
 
 		if (nblocks > rwb->wrmaxblocks) {
 			/* First flush the cache */
 
-			rwb_semtake(&rwb->wrsem);
-			rwb_wrflush(rwb);
-			rwb_semgive(&rwb->wrsem);
+			rwb_wrcanceltimeout(rwb);
+			(void)rwb_wrflush(rwb);
 
 			/* Then transfer the data directly to the media */
 
@@ -855,6 +972,8 @@ int rwb_write(FAR struct rwbuffer_s *rwb, off_t startblock, size_t nblocks, FAR
 			ret = rwb_writebuffer(rwb, startblock, nblocks, wrbuffer);
 		}
 
+		rwb_semgive(&rwb->wrsem);
+
 		/* On success, return the number of blocks that we were requested to
 		 * write.  This is for compatibility with the normal return of a block
 		 * driver write method
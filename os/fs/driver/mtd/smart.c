@@ -199,6 +199,11 @@
 
 #define SET_TO_TRUE(v, n) v[n/8] |= (1<<(7-(n%8)))
 #define GET_VAL(v, n) (v[n/8] & 1<<(7-(n%8)))
+
+/* A packed sector map holds 12-bit entries, all ones meaning unmapped. */
+
+#define SMART_PACKEDMAP_UNMAPPED    0x0FFF
+#define SMART_PACKEDMAP_SIZE(n)     (((n) * 3 + 1) >> 1)
 /* Bit mapping for wear level bits */
 /* These are defined to allow updating the wear leveling with the minimum
  * number of sector relocations / maximum use of 1 --> 0 transitions when
@@ -305,6 +310,9 @@ struct smart_struct_s {
 #endif
 #ifndef CONFIG_MTD_SMART_MINIMIZE_RAM
 	FAR uint16_t *sMap;		/* Virtual to physical sector map */
+#ifdef CONFIG_MTD_SMART_PACKED_MAP
+	bool packedmap;			/* sMap holds 12-bit entries */
+#endif
 #else
 	FAR uint8_t *sBitMap;			/* Virtual sector used bit-map */
 	FAR struct smart_cache_s *sCache;	/* Sector cache */
@@ -313,6 +321,15 @@ struct smart_struct_s {
 	uint16_t cache_lastphys;		/* Keep the physical sector number also */
 	uint16_t cache_nextbirth;		/* Sector cache aging value */
 #endif
+#ifdef CONFIG_MTD_SMART_FREE_BITMAP
+	FAR uint32_t *freemap;		/* One bit per erased, unallocated sector */
+#endif
+#ifdef CONFIG_MTD_SMART_ALLOC_STATS
+	uint32_t allocsearches;		/* Number of free sector searches */
+	uint32_t allocreads;		/* Sector headers read by those searches */
+	uint16_t allocmaxreads;		/* Most headers read by a single search */
+	uint32_t allocfallbacks;	/* Searches that had to scan a whole block */
+#endif
 #ifdef CONFIG_MTD_SMART_SECTOR_ERASE_DEBUG
 	FAR uint8_t *erasecounts;	/* Number of erases for each erase block */
 #endif
@@ -522,6 +539,62 @@ static const struct block_operations g_bops = {
  * Public Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: smart_map_get / smart_map_set
+ *
+ * Description: Read or update the physical sector mapped to a logical
+ *              sector.  0xFFFF means the logical sector is not mapped.
+ *
+ ****************************************************************************/
+
+#ifndef CONFIG_MTD_SMART_MINIMIZE_RAM
+#ifdef CONFIG_MTD_SMART_PACKED_MAP
+static uint16_t smart_map_get(FAR struct smart_struct_s *dev, uint16_t logical)
+{
+	FAR const uint8_t *entry;
+	uint16_t physical;
+
+	if (!dev->packedmap) {
+		return dev->sMap[logical];
+	}
+
+	/* Two entries share three bytes. */
+
+	entry = (FAR const uint8_t *)dev->sMap + logical + (logical >> 1);
+	if (logical & 0x01) {
+		physical = (entry[0] >> 4) | (entry[1] << 4);
+	} else {
+		physical = entry[0] | ((entry[1] & 0x0F) << 8);
+	}
+
+	return physical == SMART_PACKEDMAP_UNMAPPED ? 0xFFFF : physical;
+}
+
+static void smart_map_set(FAR struct smart_struct_s *dev, uint16_t logical, uint16_t physical)
+{
+	FAR uint8_t *entry;
+
+	if (!dev->packedmap) {
+		dev->sMap[logical] = physical;
+		return;
+	}
+
+	physical &= SMART_PACKEDMAP_UNMAPPED;
+	entry = (FAR uint8_t *)dev->sMap + logical + (logical >> 1);
+	if (logical & 0x01) {
+		entry[0] = (entry[0] & 0x0F) | ((physical & 0x0F) << 4);
+		entry[1] = physical >> 4;
+	} else {
+		entry[0] = physical & 0xFF;
+		entry[1] = (entry[1] & 0xF0) | (physical >> 8);
+	}
+}
+#else
+#define smart_map_get(dev, logical)           ((dev)->sMap[logical])
+#define smart_map_set(dev, logical, physical) ((dev)->sMap[logical] = (uint16_t)(physical))
+#endif
+#endif
+
 /****************************************************************************
  * Name: smart_dumpsector
  *
@@ -539,12 +612,12 @@ static int smart_dumpsector(FAR struct smart_struct_s *dev, uint16_t sector, uin
 
 	if (command == SMART_DEBUG_CMD_DUMP_LSECTOR) {
 		lsector = sector;
-		psector = dev->sMap[sector];
+		psector = smart_map_get(dev, sector);
 	} else {
 		psector = sector;
 		lsector = (uint16_t)-1;
 		for (int i = 0; i < dev->totalsectors; i++) {
-			if (dev->sMap[i] == psector) {
+			if (smart_map_get(dev, i) == psector) {
 				lsector = i;
 				break;
 			}
@@ -756,6 +829,73 @@ static void smart_add_count(struct smart_struct_s *dev, uint8_t *pCount, uint16_
 }
 #endif
 
+/****************************************************************************
+ * Name: smart_freemap_set / smart_freemap_clear / smart_freemap_setblock
+ *
+ * Description: Maintain the free sector bitmap.  A set bit is only a hint
+ *              that the sector is erased and unallocated; the sector header
+ *              is always checked before the sector is handed out.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_MTD_SMART_FREE_BITMAP
+static inline void smart_freemap_set(FAR struct smart_struct_s *dev, uint16_t sector)
+{
+	dev->freemap[sector >> 5] |= 1u << (sector & 31);
+}
+
+static inline void smart_freemap_clear(FAR struct smart_struct_s *dev, uint16_t sector)
+{
+	dev->freemap[sector >> 5] &= ~(1u << (sector & 31));
+}
+
+static void smart_freemap_setblock(FAR struct smart_struct_s *dev, uint16_t block)
+{
+	uint32_t sector = (uint32_t)block * dev->sectorsPerBlk;
+	uint32_t end = sector + dev->availSectPerBlk;
+
+	if (end > dev->totalsectors) {
+		end = dev->totalsectors;
+	}
+
+	for (; sector < end; sector++) {
+		smart_freemap_set(dev, sector);
+	}
+}
+
+/****************************************************************************
+ * Name: smart_freemap_next
+ *
+ * Description: Return the lowest sector in [start, end) whose free bit is
+ *              set, or 0xFFFF if there is none.
+ *
+ ****************************************************************************/
+
+static uint16_t smart_freemap_next(FAR struct smart_struct_s *dev, uint32_t start, uint32_t end)
+{
+	uint32_t word = start >> 5;
+	uint32_t last = (end - 1) >> 5;
+	uint32_t bits;
+	uint32_t sector;
+
+	if (start >= end) {
+		return 0xFFFF;
+	}
+
+	bits = dev->freemap[word] & (~0u << (start & 31));
+	while (bits == 0) {
+		if (++word > last) {
+			return 0xFFFF;
+		}
+
+		bits = dev->freemap[word];
+	}
+
+	sector = (word << 5) + __builtin_ctz(bits);
+	return sector < end ? sector : 0xFFFF;
+}
+#endif
+
 /****************************************************************************
  * Name: smart_checkfree
  *
@@ -1074,6 +1214,9 @@ static int smart_setsectorsize(FAR struct smart_struct_s *dev, uint16_t size)
 	uint32_t erasesize;
 	uint32_t totalsectors;
 	uint32_t allocsize;
+#ifndef CONFIG_MTD_SMART_MINIMIZE_RAM
+	uint32_t mapsize;
+#endif
 
 	/* Validate the size isn't zero so we don't divide by zero below. */
 
@@ -1185,6 +1328,12 @@ static int smart_setsectorsize(FAR struct smart_struct_s *dev, uint16_t size)
 		smart_free(dev, dev->bytebuffer);
 		dev->bytebuffer = NULL;
 	}
+#ifdef CONFIG_MTD_SMART_FREE_BITMAP
+	if (dev->freemap != NULL) {
+		smart_free(dev, dev->freemap);
+		dev->freemap = NULL;
+	}
+#endif
 #ifdef CONFIG_MTD_SMART_WEAR_LEVEL
 	if (dev->wearstatus != NULL) {
 		smart_free(dev, dev->wearstatus);
@@ -1222,13 +1371,21 @@ static int smart_setsectorsize(FAR struct smart_struct_s *dev, uint16_t size)
 
 #ifndef CONFIG_MTD_SMART_MINIMIZE_RAM
 	allocsize = dev->neraseblocks << 1;
-	dev->sMap = (FAR uint16_t *)smart_malloc(dev, totalsectors * sizeof(uint16_t) + allocsize, "Sector map");
+#ifdef CONFIG_MTD_SMART_PACKED_MAP
+	/* Physical sector numbers must leave the all ones entry free. */
+
+	dev->packedmap = totalsectors < SMART_PACKEDMAP_UNMAPPED;
+	mapsize = dev->packedmap ? SMART_PACKEDMAP_SIZE(totalsectors) : totalsectors * sizeof(uint16_t);
+#else
+	mapsize = totalsectors * sizeof(uint16_t);
+#endif
+	dev->sMap = (FAR uint16_t *)smart_malloc(dev, mapsize + allocsize, "Sector map");
 	if (!dev->sMap) {
 		fdbg("Error allocating SMART virtual map buffer\n");
 		goto errexit;
 	}
 
-	dev->releasecount = (FAR uint8_t *)dev->sMap + (totalsectors * sizeof(uint16_t));
+	dev->releasecount = (FAR uint8_t *)dev->sMap + mapsize;
 	dev->freecount = dev->releasecount + dev->neraseblocks;
 #else
 	dev->sBitMap = (FAR uint8_t *)smart_malloc(dev, (totalsectors + 7) >> 3, "Sector Bitmap");
@@ -1280,6 +1437,18 @@ static int smart_setsectorsize(FAR struct smart_struct_s *dev, uint16_t size)
 
 #endif							/* CONFIG_MTD_SMART_MINIMIZE_RAM */
 
+#ifdef CONFIG_MTD_SMART_FREE_BITMAP
+	/* Allocate the free sector bitmap.  It is filled by smart_scan(). */
+
+	dev->freemap = (FAR uint32_t *)smart_malloc(dev, ((totalsectors + 31) >> 5) * sizeof(uint32_t), "Free bitmap");
+	if (!dev->freemap) {
+		fdbg("Error allocating SMART free sector bitmap\n");
+		goto errexit;
+	}
+
+	memset(dev->freemap, 0, ((totalsectors + 31) >> 5) * sizeof(uint32_t));
+#endif
+
 #ifdef CONFIG_MTD_SMART_SECTOR_ERASE_DEBUG
 	/* Allocate a buffer to hold the erase counts. */
 
@@ -1345,6 +1514,12 @@ errexit:
 	}
 #endif
 
+#ifdef CONFIG_MTD_SMART_FREE_BITMAP
+	if (dev->freemap) {
+		smart_free(dev, dev->freemap);
+	}
+#endif
+
 #ifdef CONFIG_MTD_SMART_WEAR_LEVEL
 	if (dev->wearstatus) {
 		smart_free(dev, dev->wearstatus);
@@ -1905,7 +2080,7 @@ static int smart_scan(FAR struct smart_struct_s *dev)
 
 #ifndef CONFIG_MTD_SMART_MINIMIZE_RAM
 	for (sector = 0; sector < totalsectors; sector++) {
-		dev->sMap[sector] = -1;
+		smart_map_set(dev, sector, -1);
 	}
 #else
 	/* Clear all logical sector used bits. */
@@ -1913,6 +2088,10 @@ static int smart_scan(FAR struct smart_struct_s *dev)
 	memset(dev->sBitMap, 0, (dev->totalsectors + 7) >> 3);
 #endif
 
+#ifdef CONFIG_MTD_SMART_FREE_BITMAP
+	memset(dev->freemap, 0, ((totalsectors + 31) >> 5) * sizeof(uint32_t));
+#endif
+
 	/* Now scan the MTD device. */
 
 	for (sector = 0; sector < totalsectors; sector++) {
@@ -1957,6 +2136,13 @@ static int smart_scan(FAR struct smart_struct_s *dev)
 #endif
 			dev->freesectors--;
 		}
+#ifdef CONFIG_MTD_SMART_FREE_BITMAP
+		else {
+			/* Not committed, so a candidate for allocation. */
+
+			smart_freemap_set(dev, sector);
+		}
+#endif
 
 		/* Test if this sector has been release and if it has,
 		 * update the erase block's releasecount.
@@ -2073,7 +2259,7 @@ static int smart_scan(FAR struct smart_struct_s *dev)
 		/* Test for duplicate logical sectors on the device. */
 
 #ifndef CONFIG_MTD_SMART_MINIMIZE_RAM
-		if (dev->sMap[logicalsector] != 0xFFFF)
+		if (smart_map_get(dev, logicalsector) != 0xFFFF)
 #else
 		if (dev->sBitMap[logicalsector >> 3] & (1 << (logicalsector & 0x07)))
 #endif
@@ -2082,7 +2268,7 @@ static int smart_scan(FAR struct smart_struct_s *dev)
 			 * the same logical sector.  Use the sequence number information
 			 * to resolve who wins.
 			 */
-			fvdbg("Duplication occurs!!\n, Popular Physical Sector = %d\n", dev->sMap[logicalsector]);
+			fvdbg("Duplication occurs!!\n, Popular Physical Sector = %d\n", smart_map_get(dev, logicalsector));
 #if SMART_STATUS_VERSION == 1
 			if (header.status & SMART_STATUS_CRC) {
 				seq2 = header.seq;
@@ -2097,7 +2283,7 @@ static int smart_scan(FAR struct smart_struct_s *dev)
 			/* We must re-read the 1st physical sector to get it's seq number. */
 
 #ifndef CONFIG_MTD_SMART_MINIMIZE_RAM
-			readaddress = dev->sMap[logicalsector] * dev->mtdBlksPerSector * dev->geo.blocksize;
+			readaddress = smart_map_get(dev, logicalsector) * dev->mtdBlksPerSector * dev->geo.blocksize;
 #else
 			/* For minimize RAM, we have to rescan to find the 1st sector claiming to
 			 * be this logical sector.
@@ -2171,8 +2357,8 @@ static int smart_scan(FAR struct smart_struct_s *dev)
 				/* Seq 2 is the winner ... bigger or it wrapped. */
 
 #ifndef CONFIG_MTD_SMART_MINIMIZE_RAM
-				loser = dev->sMap[logicalsector];
-				dev->sMap[logicalsector] = sector;
+				loser = smart_map_get(dev, logicalsector);
+				smart_map_set(dev, logicalsector, sector);
 #else
 				loser = dupsector;
 #endif
@@ -2182,7 +2368,7 @@ static int smart_scan(FAR struct smart_struct_s *dev)
 
 				loser = sector;
 #ifndef CONFIG_MTD_SMART_MINIMIZE_RAM
-				winner = dev->sMap[logicalsector];
+				winner = smart_map_get(dev, logicalsector);
 #else
 				winner = smart_cache_lookup(dev, logicalsector);
 #endif
@@ -2246,7 +2432,7 @@ static int smart_scan(FAR struct smart_struct_s *dev)
 #ifndef CONFIG_MTD_SMART_MINIMIZE_RAM
 		/* Update the logical to physical sector map. */
 
-		dev->sMap[logicalsector] = winner;
+		smart_map_set(dev, logicalsector, winner);
 #else
 		/* Mark the logical sector as used in the bitmap */
 		dev->sBitMap[logicalsector >> 3] |= 1 << (logicalsector & 0x07);
@@ -2267,7 +2453,7 @@ static int smart_scan(FAR struct smart_struct_s *dev)
 	 */
 
 #ifndef CONFIG_MTD_SMART_MINIMIZE_RAM
-	sector = dev->sMap[0];
+	sector = smart_map_get(dev, 0);
 #else
 	sector = smart_cache_lookup(dev, 0);
 #endif
@@ -2307,7 +2493,7 @@ static int smart_scan(FAR struct smart_struct_s *dev)
 			dev->releasesectors++;
 
 #ifndef CONFIG_MTD_SMART_MINIMIZE_RAM
-			dev->sMap[0] = newsector;
+			smart_map_set(dev, 0, newsector);
 			dev->freecount[newsector / dev->sectorsPerBlk]--;
 			dev->releasecount[sector / dev->sectorsPerBlk]++;
 #else
@@ -2491,6 +2677,10 @@ static void smart_erase_block_if_empty(FAR struct smart_struct_s *dev, uint16_t
 		dev->freecount[block] = dev->availSectPerBlk - prerelease;
 #endif							/* CONFIG_MTD_SMART_PACK_COUNTS */
 
+#ifdef CONFIG_MTD_SMART_FREE_BITMAP
+		smart_freemap_setblock(dev, block);
+#endif
+
 		/* Now that we have erased this block and updated the release / free counts,
 		 * if we are in WEAR LEVELING enabled mode, we must check if this erase block's
 		 * wear level has reached the threshold to warrant moving a minimum wear level
@@ -2684,7 +2874,7 @@ static int smart_relocate_static_data(FAR struct smart_struct_s *dev, uint16_t b
 			}
 
 #ifndef CONFIG_MTD_SMART_MINIMIZE_RAM
-			dev->sMap[UINT8TOUINT16(header->logicalsector)] = newsector;
+			smart_map_set(dev, UINT8TOUINT16(header->logicalsector), newsector);
 #else
 			smart_update_cache(dev, *((FAR uint16_t *)header->logicalsector), newsector);
 #endif
@@ -2976,14 +3166,22 @@ static inline int smart_llformat(FAR struct smart_struct_s *dev, unsigned long a
 	dev->freecount[0]--;
 #endif
 
+#ifdef CONFIG_MTD_SMART_FREE_BITMAP
+	for (x = 0; x < dev->neraseblocks; x++) {
+		smart_freemap_setblock(dev, x);
+	}
+
+	smart_freemap_clear(dev, 0);
+#endif
+
 	/* Now initialize the logical to physical sector map. */
 
 #ifndef CONFIG_MTD_SMART_MINIMIZE_RAM
-	dev->sMap[0] = 0;			/* Logical sector zero = physical sector 0 */
+	smart_map_set(dev, 0, 0);			/* Logical sector zero = physical sector 0 */
 	for (x = 1; x < dev->totalsectors; x++) {
 		/* Mark all other logical sectors as non-existent. */
 
-		dev->sMap[x] = -1;
+		smart_map_set(dev, x, -1);
 	}
 #endif
 
@@ -3280,7 +3478,7 @@ static int smart_relocate_block(FAR struct smart_struct_s *dev, uint16_t block)
 		/* Update the variables. */
 
 #ifndef CONFIG_MTD_SMART_MINIMIZE_RAM
-		dev->sMap[UINT8TOUINT16(header->logicalsector)] = newsector;
+		smart_map_set(dev, UINT8TOUINT16(header->logicalsector), newsector);
 #else
 		smart_update_cache(dev, *((FAR uint16_t *)header->logicalsector), newsector);
 #endif
@@ -3348,6 +3546,10 @@ static int smart_relocate_block(FAR struct smart_struct_s *dev, uint16_t block)
 	dev->releasecount[block] = prerelease;
 #endif
 
+#ifdef CONFIG_MTD_SMART_FREE_BITMAP
+	smart_freemap_setblock(dev, block);
+#endif
+
 #ifdef CONFIG_SMART_LOCAL_CHECKFREE
 	if (smart_checkfree(dev, __LINE__) != OK) {
 		fdbg("   ...while relocating block %d, free=%d, release=%d, oldrelease=%d\n", block, freecount, releasecount, oldrelease);
@@ -3375,6 +3577,57 @@ errout:
 	return ret;
 }
 
+/****************************************************************************
+ * Name: smart_isfreephyssector
+ *
+ * Description:  Check whether a physical sector is erased and has no
+ *               temporary allocation.  Returns 1 if it is free, 0 if it is
+ *               not and a negated errno if its header cannot be read.
+ *
+ ****************************************************************************/
+
+static int smart_isfreephyssector(FAR struct smart_struct_s *dev, uint16_t physical)
+{
+	struct smart_sect_header_s header;
+	uint32_t readaddr;
+	int ret;
+#ifdef CONFIG_MTD_SMART_ENABLE_CRC
+	FAR struct smart_allocsector_s *allocsect;
+
+	/* First check if there is a temporary alloc in place. */
+
+	for (allocsect = dev->allocsector; allocsect; allocsect = allocsect->next) {
+		if (allocsect->physical == physical) {
+			return 0;
+		}
+	}
+#endif
+
+	/* Now check on the physical media. */
+
+#ifdef CONFIG_MTD_SMART_ALLOC_STATS
+	dev->allocreads++;
+#endif
+	readaddr = physical * dev->mtdBlksPerSector * dev->geo.blocksize;
+	ret = MTD_READ(dev->mtd, readaddr, sizeof(struct smart_sect_header_s), (FAR uint8_t *)&header);
+	if (ret != sizeof(struct smart_sect_header_s)) {
+		fdbg("Error reading phys sector %d\n", physical);
+		return -EIO;
+	}
+
+	if ((UINT8TOUINT16(header.logicalsector) == 0xFFFF) &&
+#if SMART_STATUS_VERSION == 1
+		((header.seq == 0xFF) && (header.crc8 == 0xFF)) &&
+#else
+		(header.seq == CONFIG_SMARTFS_ERASEDSTATE) &&
+#endif
+		(!(SECTOR_IS_COMMITTED(header)))) {
+		return 1;
+	}
+
+	return 0;
+}
+
 /****************************************************************************
  * Name: smart_findfreephyssector
  *
@@ -3393,8 +3646,10 @@ static uint16_t smart_findfreephyssector(FAR struct smart_struct_s *dev, uint8_t
 #endif
 	uint16_t physicalsector;
 	uint16_t x, block;
-	uint32_t readaddr;
-	struct smart_sect_header_s header;
+	uint32_t start, end;
+#ifdef CONFIG_MTD_SMART_ALLOC_STATS
+	uint32_t reads;
+#endif
 	int ret;
 	/* Determine which erase block we should allocate the new
 	 * sector from. This is based on the number of free sectors
@@ -3522,53 +3777,71 @@ retry:
 	/* Now find a free physical sector within this selected
 	 * erase block to allocate. */
 
-	for (x = allocblock * dev->sectorsPerBlk; x < allocblock * dev->sectorsPerBlk + dev->availSectPerBlk; x++) {
-		/* Check if this physical sector is available. */
+#ifdef CONFIG_MTD_SMART_ALLOC_STATS
+	reads = dev->allocreads;
+#endif
+	start = allocblock * dev->sectorsPerBlk;
+	end = start + dev->availSectPerBlk;
 
-#ifdef CONFIG_MTD_SMART_ENABLE_CRC
-		/* First check if there is a temporary alloc in place. */
+#ifdef CONFIG_MTD_SMART_FREE_BITMAP
+	/* Only visit sectors the bitmap believes are free.  A bit is dropped
+	 * once its sector is handed out or found to be in use.
+	 */
 
-		FAR struct smart_allocsector_s *allocsect;
-		allocsect = dev->allocsector;
+	for (x = smart_freemap_next(dev, start, end); x != 0xFFFF; x = smart_freemap_next(dev, x + 1, end)) {
+		smart_freemap_clear(dev, x);
+		ret = smart_isfreephyssector(dev, x);
+		if (ret < 0) {
+			return -1;
+		}
 
-		while (allocsect) {
-			if (allocsect->physical == x) {
-				break;
-			}
-			allocsect = allocsect->next;
+		if (ret > 0) {
+			physicalsector = x;
+			dev->lastallocblock = allocblock;
+			break;
 		}
+	}
 
-		/* If we found this physical sector above, then continue on
-		 * to the next physical sector in this block ... this one has
-		 * a temporary allocation assigned.
-		 */
+	/* The block has free sectors but none of them has its bit set, e.g.
+	 * after an erase the bitmap did not see.  Fall back to a full scan.
+	 */
 
-		if (allocsect) {
-			continue;
-		}
+	if (physicalsector != 0xFFFF) {
+		end = start;
+	}
+#ifdef CONFIG_MTD_SMART_ALLOC_STATS
+	else {
+		dev->allocfallbacks++;
+	}
+#endif
 #endif
 
-		/* Now check on the physical media. */
+	for (x = start; x < end; x++) {
+		/* Check if this physical sector is available. */
 
-		readaddr = x * dev->mtdBlksPerSector * dev->geo.blocksize;
-		ret = MTD_READ(dev->mtd, readaddr, sizeof(struct smart_sect_header_s), (FAR uint8_t *)&header);
-		if (ret != sizeof(struct smart_sect_header_s)) {
-			fdbg("Error reading phys sector %d\n", physicalsector);
+		ret = smart_isfreephyssector(dev, x);
+		if (ret < 0) {
 			return -1;
 		}
-		if ((UINT8TOUINT16(header.logicalsector) == 0xFFFF) &&
-#if SMART_STATUS_VERSION == 1
-			((header.seq == 0xFF) && (header.crc8 == 0xFF)) &&
-#else
-			(header.seq == CONFIG_SMARTFS_ERASEDSTATE) &&
+
+		if (ret > 0) {
+			physicalsector = x;
+			dev->lastallocblock = allocblock;
+#ifdef CONFIG_MTD_SMART_FREE_BITMAP
+			smart_freemap_clear(dev, x);
 #endif
-			(!(SECTOR_IS_COMMITTED(header)))) {
-				physicalsector = x;
-				dev->lastallocblock = allocblock;
-				break;
+			break;
 		}
 	}
 
+#ifdef CONFIG_MTD_SMART_ALLOC_STATS
+	dev->allocsearches++;
+	reads = dev->allocreads - reads;
+	if (reads > dev->allocmaxreads) {
+		dev->allocmaxreads = reads > 0xFFFF ? 0xFFFF : reads;
+	}
+#endif
+
 	if (physicalsector == 0xFFFF) {
 		fdbg("Program bug!  Expected a free sector %d\n", allocblock);
 	}
@@ -3871,7 +4144,7 @@ static inline int smart_read_wearstatus(FAR struct smart_struct_s *dev)
 
 		/* Validate wear status sector has been allocated */
 #ifndef CONFIG_MTD_SMART_MINIMIZE_RAM
-		physsector = dev->sMap[req.logsector];
+		physsector = smart_map_get(dev, req.logsector);
 #else
 		physsector = smart_cache_lookup(dev, req.logsector);
 #endif
@@ -4099,7 +4372,7 @@ static int smart_writesector(FAR struct smart_struct_s *dev, unsigned long arg)
 #endif
 
 #ifndef CONFIG_MTD_SMART_MINIMIZE_RAM
-	physsector = dev->sMap[req->logsector];
+	physsector = smart_map_get(dev, req->logsector);
 #else
 	physsector = smart_cache_lookup(dev, req->logsector);
 #endif
@@ -4344,7 +4617,7 @@ static int smart_writesector(FAR struct smart_struct_s *dev, unsigned long arg)
 		/* Update the sector map. */
 
 #ifndef CONFIG_MTD_SMART_MINIMIZE_RAM
-		dev->sMap[req->logsector] = physsector;
+		smart_map_set(dev, req->logsector, physsector);
 #else
 		smart_update_cache(dev, req->logsector, physsector);
 #endif
@@ -4436,7 +4709,7 @@ static int smart_readsector(FAR struct smart_struct_s *dev, unsigned long arg)
 		return -EINVAL;
 	}
 #ifndef CONFIG_MTD_SMART_MINIMIZE_RAM
-	physsector = dev->sMap[req->logsector];
+	physsector = smart_map_get(dev, req->logsector);
 #else
 	physsector = smart_cache_lookup(dev, req->logsector);
 #endif
@@ -4572,7 +4845,7 @@ static int smart_allocsector(FAR struct smart_struct_s *dev, unsigned long reque
 		/* Validate the sector is not already allocated. */
 
 #ifndef CONFIG_MTD_SMART_MINIMIZE_RAM
-		if (dev->sMap[requested] == (uint16_t)-1)
+		if (smart_map_get(dev, requested) == (uint16_t)-1)
 #else
 		if (!(dev->sBitMap[requested >> 3] & (1 << (requested & 0x07))))
 #endif
@@ -4603,7 +4876,7 @@ static int smart_allocsector(FAR struct smart_struct_s *dev, unsigned long reque
 		/* Loop through all sectors and find one to allocate. */
 		for (x = SMART_FIRST_ALLOC_SECTOR; x < dev->totalsectors; x++) {
 #ifndef CONFIG_MTD_SMART_MINIMIZE_RAM
-			if (dev->sMap[x] == (uint16_t)-1)
+			if (smart_map_get(dev, x) == (uint16_t)-1)
 #else
 			if (!(dev->sBitMap[x >> 3] & (1 << (x & 0x07))))
 #endif
@@ -4707,7 +4980,7 @@ static int smart_allocsector(FAR struct smart_struct_s *dev, unsigned long reque
 	/* Map the sector and update the free sector counts. */
 
 #ifndef CONFIG_MTD_SMART_MINIMIZE_RAM
-	dev->sMap[logsector] = physicalsector;
+	smart_map_set(dev, logsector, physicalsector);
 #else
 	dev->sBitMap[logsector >> 3] |= (1 << (logsector & 0x07));
 	smart_add_sector_to_cache(dev, logsector, physicalsector, __LINE__);
@@ -4751,7 +5024,7 @@ static inline int smart_freesector(FAR struct smart_struct_s *dev, unsigned long
 		/* Validate the sector is actually allocated. */
 
 #ifndef CONFIG_MTD_SMART_MINIMIZE_RAM
-		if (dev->sMap[logicalsector] == (uint16_t)-1)
+		if (smart_map_get(dev, logicalsector) == (uint16_t)-1)
 #else
 		if (!(dev->sBitMap[logicalsector >> 3] & (1 << (logicalsector & 0x07))))
 #endif
@@ -4764,7 +5037,7 @@ static inline int smart_freesector(FAR struct smart_struct_s *dev, unsigned long
 	/* Okay to release the sector.  Read the sector header info. */
 
 #ifndef CONFIG_MTD_SMART_MINIMIZE_RAM
-	physsector = dev->sMap[logicalsector];
+	physsector = smart_map_get(dev, logicalsector);
 #else
 	physsector = smart_cache_lookup(dev, logicalsector);
 #endif
@@ -4813,7 +5086,7 @@ static inline int smart_freesector(FAR struct smart_struct_s *dev, unsigned long
 	/* Unmap this logical sector. */
 
 #ifndef CONFIG_MTD_SMART_MINIMIZE_RAM
-	dev->sMap[logicalsector] = (uint16_t)-1;
+	smart_map_set(dev, logicalsector, (uint16_t)-1);
 #else
 	dev->sBitMap[logicalsector >> 3] &= ~(1 << (logicalsector & 0x07));
 	smart_update_cache(dev, logicalsector, 0xFFFF);
@@ -4944,7 +5217,7 @@ static int smart_ioctl(FAR struct inode *inode, int cmd, unsigned long arg)
 #ifndef NXFUSE_HOST_BUILD
 		irqstate_t saved_state = enter_critical_section();
 #endif
-		uint16_t psector = dev->sMap[0];
+		uint16_t psector = smart_map_get(dev, 0);
 		fvdbg("psector : %d\n", psector);
 		header = (FAR struct smart_sect_header_s *)dev->rwbuffer;
 		ret = MTD_BREAD(dev->mtd, psector * dev->mtdBlksPerSector, dev->mtdBlksPerSector, (FAR uint8_t *)dev->rwbuffer);
@@ -4975,7 +5248,7 @@ static int smart_ioctl(FAR struct inode *inode, int cmd, unsigned long arg)
 #endif
 		goto ok_out;
 	case BIOC_CORRUPTION :
-		sector = dev->sMap[SMART_FIRST_DIR_SECTOR];
+		sector = smart_map_get(dev, SMART_FIRST_DIR_SECTOR);
 		header = (FAR struct smart_sect_header_s *)dev->rwbuffer;
 		ret = MTD_BREAD(dev->mtd, sector * dev->mtdBlksPerSector, dev->mtdBlksPerSector, (FAR uint8_t *)dev->rwbuffer);
 		if (ret != dev->mtdBlksPerSector) {
@@ -5010,7 +5283,7 @@ static int smart_ioctl(FAR struct inode *inode, int cmd, unsigned long arg)
 		}
 
 #ifndef CONFIG_MTD_SMART_MINIMIZE_RAM
-		ret = (int)dev->sMap[sector];
+		ret = (int)smart_map_get(dev, sector);
 #else
 		ret = (int)smart_cache_lookup(dev, sector);
 #endif
@@ -5033,8 +5306,8 @@ static int smart_ioctl(FAR struct inode *inode, int cmd, unsigned long arg)
 		procfs_data->sectorsperblk = dev->sectorsPerBlk;
 
 #ifndef CONFIG_MTD_SMART_MINIMIZE_RAM
-		procfs_data->formatsector = dev->sMap[0];
-		procfs_data->dirsector = dev->sMap[3];
+		procfs_data->formatsector = smart_map_get(dev, 0);
+		procfs_data->dirsector = smart_map_get(dev, 3);
 #else
 		procfs_data->formatsector = smart_cache_lookup(dev, 0);
 		procfs_data->dirsector = smart_cache_lookup(dev, 3);
@@ -5050,6 +5323,12 @@ static int smart_ioctl(FAR struct inode *inode, int cmd, unsigned long arg)
 #endif
 #ifdef CONFIG_MTD_SMART_WEAR_LEVEL
 		procfs_data->uneven_wearcount = dev->uneven_wearcount;
+#endif
+#ifdef CONFIG_MTD_SMART_ALLOC_STATS
+		procfs_data->allocsearches = dev->allocsearches;
+		procfs_data->allocreads = dev->allocreads;
+		procfs_data->allocmaxreads = dev->allocmaxreads;
+		procfs_data->allocfallbacks = dev->allocfallbacks;
 #endif
 		ret = OK;
 		goto ok_out;
@@ -6044,6 +6323,15 @@ int smart_initialize(int minor, FAR struct mtd_dev_s *mtd, FAR const char *partn
 #endif
 		dev->rwbuffer = NULL;
 		dev->bytebuffer = NULL;
+#ifdef CONFIG_MTD_SMART_FREE_BITMAP
+		dev->freemap = NULL;
+#endif
+#ifdef CONFIG_MTD_SMART_ALLOC_STATS
+		dev->allocsearches = 0;
+		dev->allocreads = 0;
+		dev->allocmaxreads = 0;
+		dev->allocfallbacks = 0;
+#endif
 #ifdef CONFIG_MTD_SMART_SECTOR_ERASE_DEBUG
 		dev->erasecounts = NULL;
 #endif
@@ -6170,6 +6458,11 @@ errout:
 	if (dev->bytebuffer != NULL) {
 		smart_free(dev, dev->bytebuffer);
 	}
+#ifdef CONFIG_MTD_SMART_FREE_BITMAP
+	if (dev->freemap != NULL) {
+		smart_free(dev, dev->freemap);
+	}
+#endif
 
 #ifdef CONFIG_MTD_SMART_WEAR_LEVEL
 	if (dev->wearstatus != NULL) {
@@ -130,6 +130,10 @@ static int _files_close(FAR struct file *filep)
 	/* Check if the struct file is open (i.e., assigned an inode) */
 
 	if (inode) {
+		/* Drop the epoll registrations while the driver is still open */
+
+		epoll_detach(filep, -1);
+
 		/* Close the file, driver, or mountpoint. */
 
 		if (inode->u.i_ops && inode->u.i_ops->close) {
@@ -147,6 +151,7 @@ static int _files_close(FAR struct file *filep)
 		filep->f_oflags = 0;
 		filep->f_pos = 0;
 		filep->f_inode = NULL;
+		filep->f_priv = NULL;
 	}
 
 	return ret;
@@ -240,7 +245,7 @@ int file_dup(FAR struct file *filep, int minfd)
 
 	/* Then allocate a new file descriptor for the inode */
 
-	fd2 = files_allocate(filep->f_inode, filep->f_oflags, filep->f_pos, minfd);
+	fd2 = files_allocate(filep->f_inode, filep->f_oflags & ~__FS_O_NOINHERIT, filep->f_pos, minfd);
 	if (fd2 < 0) {
 		goto errout_with_inode;
 	}
@@ -252,6 +257,10 @@ int file_dup(FAR struct file *filep, int minfd)
 
 	DEBUGASSERT(filep->f_inode == filep2->f_inode);
 
+	/* Share f_priv unless the open method sets up its own, as file_dup2() */
+
+	filep2->f_priv = filep->f_priv;
+
 	if (filep->f_inode->u.i_ops && filep->f_inode->u.i_ops->open) {
 #ifndef CONFIG_DISABLE_MOUNTPOINT
 		if (INODE_IS_MOUNTPT(filep->f_inode)) {
@@ -321,11 +330,14 @@ int file_dup2(FAR struct file *filep1, FAR struct file *filep2)
 	inode = filep1->f_inode;
 	inode_addref(inode);
 
-	/* Then clone the file structure */
+	/* Then clone the file structure.  Drivers which keep per-open state
+	 * replace f_priv in their open method, the others share it.
+	 */
 
-	filep2->f_oflags = filep1->f_oflags;
+	filep2->f_oflags = filep1->f_oflags & ~__FS_O_NOINHERIT;
 	filep2->f_pos = filep1->f_pos;
 	filep2->f_inode = inode;
+	filep2->f_priv = filep1->f_priv;
 
 	/* Call the open method on the file, driver, mountpoint so that it
 	 * can maintain the correct open counts.
@@ -362,6 +374,7 @@ errout_with_inode:
 	filep2->f_oflags = 0;
 	filep2->f_pos = 0;
 	filep2->f_inode = NULL;
+	filep2->f_priv = NULL;
 
 errout_with_ret:
 	err = -ret;
@@ -461,6 +474,7 @@ void files_release(int fd)
 		list->fl_files[fd].f_oflags = 0;
 		list->fl_files[fd].f_pos = 0;
 		list->fl_files[fd].f_inode = NULL;
+		list->fl_files[fd].f_priv = NULL;
 		_files_semgive(list);
 	}
 }
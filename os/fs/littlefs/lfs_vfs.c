@@ -43,6 +43,9 @@
 
 #include <errno.h>
 #include <fcntl.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
 #include <string.h>
 
 #include <tinyara/fs/dirent.h>
@@ -58,10 +61,58 @@
 #include "littlefs/lfs.h"
 #include "littlefs/lfs_util.h"
 
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#ifndef CONFIG_FS_LITTLEFS_CACHE_SIZE
+#define CONFIG_FS_LITTLEFS_CACHE_SIZE 0
+#endif
+
+#ifndef CONFIG_FS_LITTLEFS_LOOKAHEAD_SIZE
+#define CONFIG_FS_LITTLEFS_LOOKAHEAD_SIZE 0
+#endif
+
+#ifndef CONFIG_FS_LITTLEFS_BLOCK_CYCLES
+#define CONFIG_FS_LITTLEFS_BLOCK_CYCLES 500
+#endif
+
+/* littlefs asserts on block_cycles == 0, -1 is the value disabling eviction */
+
+#if CONFIG_FS_LITTLEFS_BLOCK_CYCLES == 0
+#error "CONFIG_FS_LITTLEFS_BLOCK_CYCLES must be -1 or positive"
+#endif
+
+#ifndef CONFIG_FS_LITTLEFS_BLOCK_CACHE_NBLOCKS
+#define CONFIG_FS_LITTLEFS_BLOCK_CACHE_NBLOCKS 0
+#endif
+
 /****************************************************************************
  * Private Types
  ****************************************************************************/
 
+/* Mount options parsed from the data argument of mount(), for example
+ * "autoformat,cache=1024,lookahead=64,blkcache=16".
+ */
+
+struct littlefs_options_s {
+	bool forceformat;
+	bool autoformat;
+	lfs_size_t cache_size;
+	lfs_size_t lookahead_size;
+	int32_t block_cycles;
+	int blkcache;
+};
+
+#ifdef CONFIG_FS_LITTLEFS_BLOCK_CACHE
+/* One slot of the shared block cache. Each slot holds one MTD block. */
+
+struct littlefs_bcache_slot_s {
+	off_t block;				/* MTD block held by the slot, -1 if empty */
+	uint32_t stamp;				/* Last use, for LRU replacement */
+};
+#endif
+
 struct littlefs_file_s {
 	struct lfs_file file;
 	int refs;
@@ -79,6 +130,14 @@ struct littlefs_mountpt_s {
 	struct mtd_geometry_s geo;
 	struct lfs_config cfg;
 	struct lfs lfs;
+#ifdef CONFIG_FS_LITTLEFS_BLOCK_CACHE
+	FAR struct littlefs_bcache_slot_s *bc_slots;
+	FAR uint8_t *bc_data;		/* bc_nslots * geo.blocksize bytes */
+	int bc_nslots;				/* 0 if the cache is disabled */
+	uint32_t bc_clock;
+	uint32_t bc_hits;
+	uint32_t bc_misses;
+#endif
 };
 
 /****************************************************************************
@@ -730,6 +789,251 @@ static int littlefs_rewinddir(FAR struct inode *mountpt, FAR struct fs_dirent_s
 	return ret;
 }
 
+/****************************************************************************
+ * Name: littlefs_option_match
+ ****************************************************************************/
+
+static bool littlefs_option_match(FAR const char *opt, size_t len, FAR const char *key)
+{
+	return strlen(key) == len && strncmp(opt, key, len) == 0;
+}
+
+/****************************************************************************
+ * Name: littlefs_parse_options
+ *
+ * Description: Parse the comma separated mount options passed as the data
+ *  argument of mount(). "forceformat" and "autoformat" keep their old
+ *  meaning; "cache=", "lookahead=", "block_cycles=" and "blkcache="
+ *  override the Kconfig defaults for this mount.
+ *
+ ****************************************************************************/
+
+static int littlefs_parse_options(FAR const char *data, FAR struct littlefs_options_s *opts)
+{
+	FAR const char *opt = data;
+	FAR const char *end;
+	FAR const char *eq;
+	FAR char *vend;
+	size_t keylen;
+	long value = 0;
+
+	opts->forceformat = false;
+	opts->autoformat = false;
+	opts->cache_size = CONFIG_FS_LITTLEFS_CACHE_SIZE;
+	opts->lookahead_size = CONFIG_FS_LITTLEFS_LOOKAHEAD_SIZE;
+	opts->block_cycles = CONFIG_FS_LITTLEFS_BLOCK_CYCLES;
+	opts->blkcache = CONFIG_FS_LITTLEFS_BLOCK_CACHE_NBLOCKS;
+
+	if (!opt) {
+		return OK;
+	}
+
+	while (*opt != '\0') {
+		end = strchr(opt, ',');
+		if (!end) {
+			end = opt + strlen(opt);
+		}
+
+		eq = memchr(opt, '=', end - opt);
+		keylen = (eq ? eq : end) - opt;
+		if (eq) {
+			value = strtol(eq + 1, &vend, 0);
+			if (vend == eq + 1 || vend != end) {
+				goto errout;
+			}
+		}
+
+		if (!eq && littlefs_option_match(opt, keylen, "forceformat")) {
+			opts->forceformat = true;
+		} else if (!eq && littlefs_option_match(opt, keylen, "autoformat")) {
+			opts->autoformat = true;
+		} else if (eq && value >= 0 && littlefs_option_match(opt, keylen, "cache")) {
+			opts->cache_size = value;
+		} else if (eq && value >= 0 && littlefs_option_match(opt, keylen, "lookahead")) {
+			opts->lookahead_size = value;
+		} else if (eq && value >= -1 && value != 0 && littlefs_option_match(opt, keylen, "block_cycles")) {
+			opts->block_cycles = value;
+		} else if (eq && value >= 0 && littlefs_option_match(opt, keylen, "blkcache")) {
+			opts->blkcache = value;
+		} else if (eq || keylen != 0) {
+			goto errout;
+		}
+
+		opt = (*end != '\0') ? end + 1 : end;
+	}
+
+	return OK;
+
+errout:
+	fdbg("ERROR: bad littlefs mount option: %s\n", opt);
+	return -EINVAL;
+}
+
+#ifdef CONFIG_FS_LITTLEFS_BLOCK_CACHE
+/****************************************************************************
+ * Name: littlefs_bcache_setup
+ *
+ * Description: Allocate a shared block cache of nslots MTD blocks.
+ *
+ ****************************************************************************/
+
+static int littlefs_bcache_setup(FAR struct littlefs_mountpt_s *fs, int nslots)
+{
+	int i;
+
+	if (nslots <= 0) {
+		return OK;
+	}
+
+	fs->bc_slots = (FAR struct littlefs_bcache_slot_s *)kmm_malloc(nslots * sizeof(struct littlefs_bcache_slot_s));
+	fs->bc_data = (FAR uint8_t *)kmm_malloc(nslots * fs->geo.blocksize);
+	if (!fs->bc_slots || !fs->bc_data) {
+		if (fs->bc_slots) {
+			kmm_free(fs->bc_slots);
+			fs->bc_slots = NULL;
+		}
+		if (fs->bc_data) {
+			kmm_free(fs->bc_data);
+			fs->bc_data = NULL;
+		}
+		return -ENOMEM;
+	}
+
+	for (i = 0; i < nslots; i++) {
+		fs->bc_slots[i].block = -1;
+		fs->bc_slots[i].stamp = 0;
+	}
+
+	fs->bc_nslots = nslots;
+	return OK;
+}
+
+/****************************************************************************
+ * Name: littlefs_bcache_release
+ ****************************************************************************/
+
+static void littlefs_bcache_release(FAR struct littlefs_mountpt_s *fs)
+{
+	if (fs->bc_nslots > 0) {
+		fvdbg("block cache: %u hits, %u misses\n", fs->bc_hits, fs->bc_misses);
+		kmm_free(fs->bc_slots);
+		kmm_free(fs->bc_data);
+		fs->bc_slots = NULL;
+		fs->bc_data = NULL;
+		fs->bc_nslots = 0;
+	}
+}
+
+/****************************************************************************
+ * Name: littlefs_bcache_find
+ ****************************************************************************/
+
+static int littlefs_bcache_find(FAR struct littlefs_mountpt_s *fs, off_t block)
+{
+	int i;
+
+	for (i = 0; i < fs->bc_nslots; i++) {
+		if (fs->bc_slots[i].block == block) {
+			return i;
+		}
+	}
+
+	return -1;
+}
+
+/****************************************************************************
+ * Name: littlefs_bcache_read
+ *
+ * Description: Copy nblocks MTD blocks from the cache. Returns false as
+ *  soon as one of them is missing; the caller then reads the whole range
+ *  from the device.
+ *
+ ****************************************************************************/
+
+static bool littlefs_bcache_read(FAR struct littlefs_mountpt_s *fs, off_t block, size_t nblocks, FAR uint8_t *buffer)
+{
+	size_t blocksize = fs->geo.blocksize;
+	size_t i;
+	int slot;
+
+	for (i = 0; i < nblocks; i++) {
+		slot = littlefs_bcache_find(fs, block + i);
+		if (slot < 0) {
+			fs->bc_misses++;
+			return false;
+		}
+
+		memcpy(buffer + i * blocksize, fs->bc_data + slot * blocksize, blocksize);
+		fs->bc_slots[slot].stamp = ++fs->bc_clock;
+	}
+
+	fs->bc_hits++;
+	return true;
+}
+
+/****************************************************************************
+ * Name: littlefs_bcache_insert
+ *
+ * Description: Store nblocks MTD blocks just read from the device,
+ *  replacing the least recently used slots.
+ *
+ ****************************************************************************/
+
+static void littlefs_bcache_insert(FAR struct littlefs_mountpt_s *fs, off_t block, size_t nblocks, FAR const uint8_t *buffer)
+{
+	FAR struct littlefs_bcache_slot_s *slots = fs->bc_slots;
+	size_t blocksize = fs->geo.blocksize;
+	size_t i;
+	int slot;
+	int j;
+
+	for (i = 0; i < nblocks; i++) {
+		slot = littlefs_bcache_find(fs, block + i);
+		if (slot < 0) {
+			slot = 0;
+			for (j = 1; j < fs->bc_nslots && slots[slot].block >= 0; j++) {
+				if (slots[j].block < 0 || slots[j].stamp < slots[slot].stamp) {
+					slot = j;
+				}
+			}
+			slots[slot].block = block + i;
+		}
+
+		memcpy(fs->bc_data + slot * blocksize, buffer + i * blocksize, blocksize);
+		slots[slot].stamp = ++fs->bc_clock;
+	}
+}
+
+/****************************************************************************
+ * Name: littlefs_bcache_update
+ *
+ * Description: Keep the cache coherent with a program or an erase of
+ *  nblocks MTD blocks. Cached copies are refreshed from buffer, or
+ *  dropped if buffer is NULL.
+ *
+ ****************************************************************************/
+
+static void littlefs_bcache_update(FAR struct littlefs_mountpt_s *fs, off_t block, size_t nblocks, FAR const uint8_t *buffer)
+{
+	size_t blocksize = fs->geo.blocksize;
+	off_t slotblock;
+	int i;
+
+	for (i = 0; i < fs->bc_nslots; i++) {
+		slotblock = fs->bc_slots[i].block;
+		if (slotblock < block || slotblock >= block + (off_t)nblocks) {
+			continue;
+		}
+
+		if (buffer) {
+			memcpy(fs->bc_data + i * blocksize, buffer + (slotblock - block) * blocksize, blocksize);
+		} else {
+			fs->bc_slots[i].block = -1;
+		}
+	}
+}
+#endif
+
 /****************************************************************************
  * Name: littlefs_bind
  *
@@ -748,13 +1052,36 @@ static int littlefs_read_block(FAR const struct lfs_config *c, lfs_block_t block
 	FAR struct inode *drv = fs->drv;
 	FAR struct little_dev_s	*dev = (struct little_dev_s *)drv->i_private;
 	int ret;
+#ifdef CONFIG_FS_LITTLEFS_BLOCK_CACHE
+	bool cacheable;
+#endif
+
+	DEBUGASSERT(drv && drv->i_private);
+
+#ifdef CONFIG_FS_LITTLEFS_BLOCK_CACHE
+	/* Reads that fit in the littlefs cache are cache fills, mostly of
+	 * metadata. Larger reads are file data and bypass the block cache.
+	 */
+
+	cacheable = fs->bc_nslots > 0 && size <= c->cache_size && size / geo->blocksize <= fs->bc_nslots;
+#endif
 
 	block = (block * c->block_size + off) / geo->blocksize;
 	size = size / geo->blocksize;
 
-	DEBUGASSERT(drv && drv->i_private);
+#ifdef CONFIG_FS_LITTLEFS_BLOCK_CACHE
+	if (cacheable && littlefs_bcache_read(fs, block, size, buffer)) {
+		return OK;
+	}
+#endif
+
 	ret = MTD_BREAD((struct mtd_dev_s *)dev->mtd, block, size, buffer);
 	if (ret >= 0) {
+#ifdef CONFIG_FS_LITTLEFS_BLOCK_CACHE
+		if (cacheable) {
+			littlefs_bcache_insert(fs, block, size, buffer);
+		}
+#endif
 		return OK;
 	}
 	/* TODO Mapping table between errno.h & lfs is required */
@@ -781,6 +1108,11 @@ static int littlefs_write_block(FAR const struct lfs_config *c, lfs_block_t bloc
 
 	DEBUGASSERT(drv && drv->i_private);
 	ret = MTD_BWRITE((struct mtd_dev_s *)dev->mtd, block, size, buffer);
+#ifdef CONFIG_FS_LITTLEFS_BLOCK_CACHE
+	/* Write through; drop the cached copies if the program failed */
+
+	littlefs_bcache_update(fs, block, size, ret >= 0 ? buffer : NULL);
+#endif
 	if (ret >= 0) {
 		return OK;
 	}
@@ -805,6 +1137,9 @@ static int littlefs_erase_block(FAR const struct lfs_config *c, lfs_block_t bloc
 	DEBUGASSERT(drv && drv->i_private);
 	FAR struct mtd_geometry_s *geo = &fs->geo;
 	size_t size = c->block_size / geo->erasesize;
+#ifdef CONFIG_FS_LITTLEFS_BLOCK_CACHE
+	littlefs_bcache_update(fs, (off_t)block * c->block_size / geo->blocksize, c->block_size / geo->blocksize, NULL);
+#endif
 	block = block * c->block_size / geo->erasesize;
 	ret = MTD_ERASE((struct mtd_dev_s *)dev->mtd, block, size);
 
@@ -866,9 +1201,16 @@ static int littlefs_unlock(const struct lfs_config *c)
 static int littlefs_bind(FAR struct inode *driver, FAR const void *data, FAR void **handle)
 {
 	FAR struct littlefs_mountpt_s *fs;
+	struct littlefs_options_s opts;
+	lfs_size_t lookahead_max;
 	int ret;
 	struct little_dev_s *dev;
 
+	ret = littlefs_parse_options(data, &opts);
+	if (ret < 0) {
+		return ret;
+	}
+
 	/* Open the block driver */
 
 	if (INODE_IS_BLOCK(driver) && driver->u.i_bops->open) {
@@ -882,7 +1224,7 @@ static int littlefs_bind(FAR struct inode *driver, FAR const void *data, FAR voi
 	fs = kmm_zalloc(sizeof(*fs));
 	if (!fs) {
 		/* We do not close block driver to recovery by format command from app */
-		return ENOMEM;
+		return -ENOMEM;
 	}
 
 	/* Initialize the allocated mountpt state structure. The filesystem is
@@ -921,9 +1263,37 @@ static int littlefs_bind(FAR struct inode *driver, FAR const void *data, FAR voi
 	fs->cfg.prog_size = fs->geo.blocksize;
 	fs->cfg.block_size = fs->geo.erasesize;
 	fs->cfg.block_count = fs->geo.neraseblocks;
-	fs->cfg.block_cycles = 500;
-	fs->cfg.cache_size = fs->geo.blocksize;
-	fs->cfg.lookahead_size = lfs_min(lfs_alignup(fs->cfg.block_count, 64) / 8, fs->cfg.read_size);
+	fs->cfg.block_cycles = opts.block_cycles;
+
+	/* The read and program caches and the cache of each open file all have
+	 * cache_size bytes. It must be a multiple of the MTD block size and
+	 * divide the erase block.
+	 */
+
+	fs->cfg.cache_size = opts.cache_size ? lfs_alignup(opts.cache_size, fs->geo.blocksize) : fs->geo.blocksize;
+	if (fs->cfg.cache_size > fs->cfg.block_size || fs->cfg.block_size % fs->cfg.cache_size != 0) {
+		fdbg("ERROR: cache size %u does not divide the erase block size %u\n", fs->cfg.cache_size, fs->cfg.block_size);
+		ret = -EINVAL;
+		goto errout_with_fs;
+	}
+
+	/* Each lookahead byte tracks 8 blocks; more than the whole partition
+	 * is never useful.
+	 */
+
+	lookahead_max = lfs_alignup(fs->cfg.block_count, 64) / 8;
+	if (opts.lookahead_size) {
+		fs->cfg.lookahead_size = lfs_min(lfs_alignup(opts.lookahead_size, 8), lookahead_max);
+	} else {
+		fs->cfg.lookahead_size = lfs_min(lookahead_max, fs->cfg.read_size);
+	}
+
+#ifdef CONFIG_FS_LITTLEFS_BLOCK_CACHE
+	ret = littlefs_bcache_setup(fs, opts.blkcache);
+	if (ret < 0) {
+		goto errout_with_fs;
+	}
+#endif
 
 	/* Then get information about the littlefs filesystem on the devices
 	 * managed by this driver.
@@ -931,7 +1301,7 @@ static int littlefs_bind(FAR struct inode *driver, FAR const void *data, FAR voi
 
 	/* Force format the device if -o forceformat */
 
-	if (data && strcmp(data, "forceformat") == 0) {
+	if (opts.forceformat) {
 		ret = lfs_format(&fs->lfs, &fs->cfg);
 		if (ret < 0) {
 			goto errout_with_fs;
@@ -949,7 +1319,7 @@ static int littlefs_bind(FAR struct inode *driver, FAR const void *data, FAR voi
 	if (ret < 0 && ret != LFS_ERR_CORRUPT) {
 		/* Auto format the device if -o autoformat */
 		fdbg("mount failed ret : %d\n", ret);
-		if (!data || strcmp(data, "autoformat")) {
+		if (!opts.autoformat) {
 			goto errout_with_fs;
 		}
 
@@ -975,6 +1345,9 @@ static int littlefs_bind(FAR struct inode *driver, FAR const void *data, FAR voi
 	return ret;
 
 errout_with_fs:
+#ifdef CONFIG_FS_LITTLEFS_BLOCK_CACHE
+	littlefs_bcache_release(fs);
+#endif
 	sem_destroy(&fs->sem);
 	kmm_free(fs);
 	return ret;
@@ -1020,6 +1393,9 @@ static int littlefs_unbind(FAR void *handle, FAR struct inode **driver, unsigned
 
 		/* Release the mountpoint private data */
 
+#ifdef CONFIG_FS_LITTLEFS_BLOCK_CACHE
+		littlefs_bcache_release(fs);
+#endif
 		sem_destroy(&fs->sem);
 		kmm_free(fs);
 	}
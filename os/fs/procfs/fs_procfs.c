@@ -96,6 +96,7 @@ extern const struct procfs_operations proc_operations;
 extern const struct procfs_operations cpuload_operations;
 extern const struct procfs_operations uptime_operations;
 extern const struct procfs_operations version_operations;
+extern const struct procfs_operations wqueue_operations;
 #if defined(CONFIG_LOG_DUMP)
 extern const struct procfs_operations logsave_operations;
 #endif
@@ -165,6 +166,10 @@ static const struct procfs_entry_s g_procfsentries[] = {
 	{"version", &version_operations},
 #endif
 
+#if defined(CONFIG_SCHED_WORKQUEUE_STATS) && !defined(CONFIG_FS_PROCFS_EXCLUDE_WQUEUE)
+	{"wqueue", &wqueue_operations},
+#endif
+
 #if defined(CONFIG_CM) && !defined(CONFIG_FS_PROCFS_EXCLUDE_CONNECTIVITY)
 	{"connectivity**", &cm_operations},
 #endif
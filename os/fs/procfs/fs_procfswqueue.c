@@ -0,0 +1,309 @@
+/****************************************************************************
+ *
+ * Copyright 2025 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <tinyara/config.h>
+
+#include <sys/types.h>
+#include <sys/stat.h>
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+#include <fcntl.h>
+#include <assert.h>
+#include <errno.h>
+#include <debug.h>
+
+#include <tinyara/kmalloc.h>
+#include <tinyara/wqueue.h>
+#include <tinyara/fs/fs.h>
+#include <tinyara/fs/procfs.h>
+
+#if !defined(CONFIG_DISABLE_MOUNTPOINT) && defined(CONFIG_FS_PROCFS)
+#if defined(CONFIG_SCHED_WORKQUEUE_STATS) && !defined(CONFIG_FS_PROCFS_EXCLUDE_WQUEUE)
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+/* Determines the size of an intermediate buffer that must be large enough
+ * to hold the header and one line per kernel work queue.
+ */
+
+#define WQUEUE_LINELEN 320
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* This structure describes one open "file" */
+
+struct wqueue_file_s {
+	struct procfs_file_s base;	/* Base open file structure */
+	unsigned int linesize;		/* Number of valid characters in line[] */
+	char line[WQUEUE_LINELEN];	/* Pre-allocated buffer for formatted lines */
+};
+
+/****************************************************************************
+ * Private Function Prototypes
+ ****************************************************************************/
+
+/* File system methods */
+
+static int wqueue_open(FAR struct file *filep, FAR const char *relpath, int oflags, mode_t mode);
+static int wqueue_close(FAR struct file *filep);
+static ssize_t wqueue_read(FAR struct file *filep, FAR char *buffer, size_t buflen);
+
+static int wqueue_dup(FAR const struct file *oldp, FAR struct file *newp);
+
+static int wqueue_stat(FAR const char *relpath, FAR struct stat *buf);
+
+/****************************************************************************
+ * Public Variables
+ ****************************************************************************/
+
+/* See fs_mount.c -- this structure is explicitly externed there.
+ * We use the old-fashioned kind of initializers so that this will compile
+ * with any compiler.
+ */
+
+const struct procfs_operations wqueue_operations = {
+	wqueue_open,				/* open */
+	wqueue_close,				/* close */
+	wqueue_read,				/* read */
+	NULL,						/* write */
+
+	wqueue_dup,					/* dup */
+
+	NULL,						/* opendir */
+	NULL,						/* closedir */
+	NULL,						/* readdir */
+	NULL,						/* rewinddir */
+
+	wqueue_stat					/* stat */
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: wqueue_format
+ *
+ * Description:
+ *   Append the counters of one work queue to the line buffer.  Times are
+ *   in clock ticks.
+ *
+ ****************************************************************************/
+
+static size_t wqueue_format(FAR char *buffer, size_t buflen, FAR const char *name, int qid)
+{
+	struct work_stats_s stats;
+	unsigned long avglat;
+	unsigned long avgrun;
+	int nthreads;
+
+	if (work_getstats(qid, &stats, &nthreads) < 0) {
+		return 0;
+	}
+
+	avglat = stats.completed > 0 ? (unsigned long)(stats.totlatency / stats.completed) : 0;
+	avgrun = stats.completed > 0 ? (unsigned long)(stats.totruntime / stats.completed) : 0;
+
+	return snprintf(buffer, buflen, "%-6s %3d %8lu %8lu %6lu %4u %4u %6lu %6lu %6lu %6lu\n", name, nthreads, (unsigned long)stats.queued, (unsigned long)stats.completed, (unsigned long)stats.cancelled, stats.pending, stats.maxpending, avglat, (unsigned long)stats.maxlatency, avgrun, (unsigned long)stats.maxruntime);
+}
+
+/****************************************************************************
+ * Name: wqueue_open
+ ****************************************************************************/
+
+static int wqueue_open(FAR struct file *filep, FAR const char *relpath, int oflags, mode_t mode)
+{
+	FAR struct wqueue_file_s *attr;
+
+	fvdbg("Open '%s'\n", relpath);
+
+	/* PROCFS is read-only.  Any attempt to open with any kind of write
+	 * access is not permitted.
+	 */
+
+	if ((oflags & O_WRONLY) != 0 || (oflags & O_RDONLY) == 0) {
+		fdbg("ERROR: Only O_RDONLY supported\n");
+		return -EACCES;
+	}
+
+	/* "wqueue" is the only acceptable value for the relpath */
+
+	if (strcmp(relpath, "wqueue") != 0) {
+		fdbg("ERROR: relpath is '%s'\n", relpath);
+		return -ENOENT;
+	}
+
+	/* Allocate a container to hold the file attributes */
+
+	attr = (FAR struct wqueue_file_s *)kmm_zalloc(sizeof(struct wqueue_file_s));
+	if (!attr) {
+		fdbg("ERROR: Failed to allocate file attributes\n");
+		return -ENOMEM;
+	}
+
+	/* Save the attributes as the open-specific state in filep->f_priv */
+
+	filep->f_priv = (FAR void *)attr;
+	return OK;
+}
+
+/****************************************************************************
+ * Name: wqueue_close
+ ****************************************************************************/
+
+static int wqueue_close(FAR struct file *filep)
+{
+	FAR struct wqueue_file_s *attr;
+
+	/* Recover our private data from the struct file instance */
+
+	attr = (FAR struct wqueue_file_s *)filep->f_priv;
+	DEBUGASSERT(attr);
+
+	/* Release the file attributes structure */
+
+	kmm_free(attr);
+	filep->f_priv = NULL;
+	return OK;
+}
+
+/****************************************************************************
+ * Name: wqueue_read
+ ****************************************************************************/
+
+static ssize_t wqueue_read(FAR struct file *filep, FAR char *buffer, size_t buflen)
+{
+	FAR struct wqueue_file_s *attr;
+	size_t linesize;
+	off_t offset;
+	ssize_t ret;
+
+	fvdbg("buffer=%p buflen=%d\n", buffer, (int)buflen);
+
+	/* Recover our private data from the struct file instance */
+
+	attr = (FAR struct wqueue_file_s *)filep->f_priv;
+	DEBUGASSERT(attr);
+
+	/* Sample the counters when f_pos is zero and keep them stable for the
+	 * following reads of the same open file.
+	 */
+
+	if (filep->f_pos == 0) {
+		linesize = snprintf(attr->line, WQUEUE_LINELEN, "%-6s %3s %8s %8s %6s %4s %4s %6s %6s %6s %6s\n", "QUEUE", "THR", "QUEUED", "DONE", "CANCEL", "PEND", "MAX", "AVGLAT", "MAXLAT", "AVGRUN", "MAXRUN");
+#ifdef CONFIG_SCHED_HPWORK
+		linesize += wqueue_format(&attr->line[linesize], WQUEUE_LINELEN - linesize, "hpwork", HPWORK);
+#endif
+#ifdef CONFIG_SCHED_LPWORK
+		linesize += wqueue_format(&attr->line[linesize], WQUEUE_LINELEN - linesize, "lpwork", LPWORK);
+#endif
+
+		/* Save the linesize in case we are re-entered with f_pos > 0 */
+
+		attr->linesize = linesize;
+	}
+
+	/* Transfer the counters to user receive buffer */
+
+	offset = filep->f_pos;
+	ret = procfs_memcpy(attr->line, attr->linesize, buffer, buflen, &offset);
+
+	/* Update the file offset */
+
+	if (ret > 0) {
+		filep->f_pos += ret;
+	}
+
+	return ret;
+}
+
+/****************************************************************************
+ * Name: wqueue_dup
+ *
+ * Description:
+ *   Duplicate open file data in the new file structure.
+ *
+ ****************************************************************************/
+
+static int wqueue_dup(FAR const struct file *oldp, FAR struct file *newp)
+{
+	FAR struct wqueue_file_s *oldattr;
+	FAR struct wqueue_file_s *newattr;
+
+	fvdbg("Dup %p->%p\n", oldp, newp);
+
+	/* Recover our private data from the old struct file instance */
+
+	oldattr = (FAR struct wqueue_file_s *)oldp->f_priv;
+	DEBUGASSERT(oldattr);
+
+	/* Allocate a new container to hold the task and attribute selection */
+
+	newattr = (FAR struct wqueue_file_s *)kmm_malloc(sizeof(struct wqueue_file_s));
+	if (!newattr) {
+		fdbg("ERROR: Failed to allocate file attributes\n");
+		return -ENOMEM;
+	}
+
+	/* The copy the file attributes from the old attributes to the new */
+
+	memcpy(newattr, oldattr, sizeof(struct wqueue_file_s));
+
+	/* Save the new attributes in the new file structure */
+
+	newp->f_priv = (FAR void *)newattr;
+	return OK;
+}
+
+/****************************************************************************
+ * Name: wqueue_stat
+ *
+ * Description: Return information about a file or directory
+ *
+ ****************************************************************************/
+
+static int wqueue_stat(const char *relpath, struct stat *buf)
+{
+	/* "wqueue" is the only acceptable value for the relpath */
+
+	if (strcmp(relpath, "wqueue") != 0) {
+		fdbg("ERROR: relpath is '%s'\n", relpath);
+		return -ENOENT;
+	}
+
+	/* "wqueue" is the name for a read-only file */
+
+	buf->st_mode = S_IFREG | S_IROTH | S_IRGRP | S_IRUSR;
+	buf->st_size = 0;
+	buf->st_blksize = 0;
+	buf->st_blocks = 0;
+	return OK;
+}
+
+#endif							/* CONFIG_SCHED_WORKQUEUE_STATS && !CONFIG_FS_PROCFS_EXCLUDE_WQUEUE */
+#endif							/* !CONFIG_DISABLE_MOUNTPOINT && CONFIG_FS_PROCFS */
@@ -329,6 +329,25 @@ struct smartfs_ofile_s {
 								 * causes the sector to change. */
 };
 
+#ifdef CONFIG_SMARTFS_DENTRY_CACHE
+/* This structure describes one cached path component lookup: the entry
+ * called 'name' in the directory starting at sector 'parent'.
+ */
+
+#define SMARTFS_DCACHE_NEGATIVE 0xFFFF	/* dsector of a "not found" entry */
+
+struct smartfs_dcache_entry_s {
+	uint32_t hash;				/* Hash of parent and name, 0 = unused */
+	uint16_t parent;			/* First sector of the parent directory */
+	uint16_t firstsector;		/* First sector of the entry */
+	uint16_t dsector;			/* Sector holding the directory entry */
+	uint16_t doffset;			/* Offset of the entry in dsector */
+	uint16_t flags;				/* Entry flags */
+	uint16_t stamp;				/* LRU stamp */
+	FAR char *name;				/* Name, namesize bytes, not terminated */
+};
+#endif
+
 /* This structure represents the overall mountpoint state.  An instance of this
  * structure is retained as inode private data on each mountpoint that is
  * mounted with a smartfs filesystem.
@@ -353,6 +372,12 @@ struct smartfs_mountpt_s {
 #ifdef CONFIG_SMARTFS_ENTRY_TIMESTAMP
 	uint32_t entry_seq;
 #endif
+#ifdef CONFIG_SMARTFS_DENTRY_CACHE
+	FAR struct smartfs_dcache_entry_s *fs_dcache;	/* Path component lookup cache */
+	uint16_t fs_dcache_stamp;	/* LRU clock of the cache */
+	uint32_t fs_dcache_hits;	/* Lookups answered by the cache */
+	uint32_t fs_dcache_misses;	/* Lookups that read the directory */
+#endif
 };
 
 
@@ -419,6 +444,28 @@ uint32_t smartfs_rdle32(FAR const void *val);
 
 void smartfs_wrle32(uint8_t *dest, uint32_t val);
 
+/* Directory entry lookup cache */
+
+#ifdef CONFIG_SMARTFS_DENTRY_CACHE
+int smartfs_dcache_initialize(struct smartfs_mountpt_s *fs);
+
+void smartfs_dcache_release(struct smartfs_mountpt_s *fs);
+
+FAR struct smartfs_dcache_entry_s *smartfs_dcache_lookup(struct smartfs_mountpt_s *fs, uint16_t parent, const char *name);
+
+void smartfs_dcache_add(struct smartfs_mountpt_s *fs, uint16_t parent, const char *name, uint16_t firstsector, uint16_t flags, uint16_t dsector, uint16_t doffset);
+
+void smartfs_dcache_remove(struct smartfs_mountpt_s *fs, uint16_t dsector, uint16_t doffset);
+
+void smartfs_dcache_forget(struct smartfs_mountpt_s *fs, const char *name);
+#else
+#define smartfs_dcache_initialize(fs)                   (OK)
+#define smartfs_dcache_release(fs)
+#define smartfs_dcache_add(fs, parent, name, firstsector, flags, dsector, doffset)
+#define smartfs_dcache_remove(fs, dsector, doffset)
+#define smartfs_dcache_forget(fs, name)
+#endif
+
 #if defined(CONFIG_FS_PROCFS) && !defined(CONFIG_FS_PROCFS_EXCLUDE_SMARTFS)
 struct smartfs_mountpt_s *smartfs_get_first_mount(void);
 #endif
@@ -0,0 +1,254 @@
+/****************************************************************************
+ *
+ * Copyright 2025 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <tinyara/config.h>
+
+#include <sys/types.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <errno.h>
+#include <debug.h>
+
+#include <tinyara/kmalloc.h>
+#include <tinyara/fs/fs.h>
+
+#include "smartfs.h"
+
+#ifdef CONFIG_SMARTFS_DENTRY_CACHE
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Entries are grouped in sets of SMARTFS_DCACHE_WAYS.  A (parent, name)
+ * pair can only live in the set selected by its hash, and the least
+ * recently used entry of that set is replaced on a miss.
+ */
+
+#define SMARTFS_DCACHE_WAYS    4
+#define SMARTFS_DCACHE_NSETS   ((CONFIG_SMARTFS_DENTRY_CACHE_SIZE + SMARTFS_DCACHE_WAYS - 1) / SMARTFS_DCACHE_WAYS)
+#define SMARTFS_DCACHE_NENTRIES (SMARTFS_DCACHE_NSETS * SMARTFS_DCACHE_WAYS)
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: smartfs_dcache_hash
+ *
+ * Description: FNV-1a hash of the parent sector and of the part of the name
+ *   that is stored on the volume.  Zero is reserved for unused entries.
+ *
+ ****************************************************************************/
+
+static uint32_t smartfs_dcache_hash(struct smartfs_mountpt_s *fs, uint16_t parent, const char *name)
+{
+	uint32_t hash = 2166136261u;
+	uint16_t len;
+
+	hash = (hash ^ (parent & 0xFF)) * 16777619u;
+	hash = (hash ^ (parent >> 8)) * 16777619u;
+	for (len = 0; len < fs->fs_llformat.namesize && name[len] != '\0'; len++) {
+		hash = (hash ^ (uint8_t)name[len]) * 16777619u;
+	}
+
+	return hash != 0 ? hash : 1;
+}
+
+static inline bool smartfs_dcache_match(struct smartfs_mountpt_s *fs, FAR struct smartfs_dcache_entry_s *dentry, uint32_t hash, uint16_t parent, const char *name)
+{
+	return dentry->hash == hash && dentry->parent == parent && strncmp(dentry->name, name, fs->fs_llformat.namesize) == 0;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: smartfs_dcache_initialize
+ *
+ * Description: Allocate the dentry cache of a mountpoint.  A mount without
+ *   a cache still works; every lookup simply goes to the volume.
+ *
+ ****************************************************************************/
+
+int smartfs_dcache_initialize(struct smartfs_mountpt_s *fs)
+{
+	FAR char *names;
+	int x;
+
+	fs->fs_dcache_hits = 0;
+	fs->fs_dcache_misses = 0;
+	fs->fs_dcache_stamp = 0;
+	fs->fs_dcache = (FAR struct smartfs_dcache_entry_s *)kmm_zalloc(SMARTFS_DCACHE_NENTRIES * (sizeof(struct smartfs_dcache_entry_s) + fs->fs_llformat.namesize));
+	if (fs->fs_dcache == NULL) {
+		fdbg("Unable to allocate the dentry cache\n");
+		return -ENOMEM;
+	}
+
+	names = (FAR char *)&fs->fs_dcache[SMARTFS_DCACHE_NENTRIES];
+	for (x = 0; x < SMARTFS_DCACHE_NENTRIES; x++) {
+		fs->fs_dcache[x].name = &names[x * fs->fs_llformat.namesize];
+	}
+
+	return OK;
+}
+
+/****************************************************************************
+ * Name: smartfs_dcache_release
+ ****************************************************************************/
+
+void smartfs_dcache_release(struct smartfs_mountpt_s *fs)
+{
+	if (fs->fs_dcache != NULL) {
+		kmm_free(fs->fs_dcache);
+		fs->fs_dcache = NULL;
+	}
+}
+
+/****************************************************************************
+ * Name: smartfs_dcache_lookup
+ *
+ * Description: Find the cached result of looking up 'name' in the directory
+ *   starting at sector 'parent'.  A returned entry whose dsector is
+ *   SMARTFS_DCACHE_NEGATIVE records that the name does not exist there.
+ *
+ ****************************************************************************/
+
+FAR struct smartfs_dcache_entry_s *smartfs_dcache_lookup(struct smartfs_mountpt_s *fs, uint16_t parent, const char *name)
+{
+	FAR struct smartfs_dcache_entry_s *dentry;
+	uint32_t hash;
+	int way;
+
+	if (fs->fs_dcache == NULL) {
+		return NULL;
+	}
+
+	hash = smartfs_dcache_hash(fs, parent, name);
+	dentry = &fs->fs_dcache[(hash % SMARTFS_DCACHE_NSETS) * SMARTFS_DCACHE_WAYS];
+	for (way = 0; way < SMARTFS_DCACHE_WAYS; way++, dentry++) {
+		if (smartfs_dcache_match(fs, dentry, hash, parent, name)) {
+			dentry->stamp = ++fs->fs_dcache_stamp;
+			return dentry;
+		}
+	}
+
+	return NULL;
+}
+
+/****************************************************************************
+ * Name: smartfs_dcache_add
+ *
+ * Description: Record the result of looking up 'name' in the directory
+ *   starting at sector 'parent'.  Pass dsector = SMARTFS_DCACHE_NEGATIVE
+ *   to record that the name does not exist.
+ *
+ ****************************************************************************/
+
+void smartfs_dcache_add(struct smartfs_mountpt_s *fs, uint16_t parent, const char *name, uint16_t firstsector, uint16_t flags, uint16_t dsector, uint16_t doffset)
+{
+	FAR struct smartfs_dcache_entry_s *dentry;
+	FAR struct smartfs_dcache_entry_s *victim;
+	uint32_t hash;
+	int way;
+
+	if (fs->fs_dcache == NULL) {
+		return;
+	}
+
+	hash = smartfs_dcache_hash(fs, parent, name);
+	dentry = &fs->fs_dcache[(hash % SMARTFS_DCACHE_NSETS) * SMARTFS_DCACHE_WAYS];
+	victim = dentry;
+	for (way = 0; way < SMARTFS_DCACHE_WAYS; way++, dentry++) {
+		if (dentry->hash == 0 || smartfs_dcache_match(fs, dentry, hash, parent, name)) {
+			victim = dentry;
+			break;
+		}
+
+		/* Unsigned distance from the current stamp survives wrap around */
+
+		if ((uint16_t)(fs->fs_dcache_stamp - dentry->stamp) > (uint16_t)(fs->fs_dcache_stamp - victim->stamp)) {
+			victim = dentry;
+		}
+	}
+
+	victim->hash = hash;
+	victim->parent = parent;
+	victim->firstsector = firstsector;
+	victim->flags = flags;
+	victim->dsector = dsector;
+	victim->doffset = doffset;
+	victim->stamp = ++fs->fs_dcache_stamp;
+	strncpy(victim->name, name, fs->fs_llformat.namesize);
+}
+
+/****************************************************************************
+ * Name: smartfs_dcache_remove
+ *
+ * Description: Drop the entry cached for the directory entry stored at
+ *   'offset' in sector 'dsector'.  Called before that entry is deleted,
+ *   invalidated or renamed in place.
+ *
+ ****************************************************************************/
+
+void smartfs_dcache_remove(struct smartfs_mountpt_s *fs, uint16_t dsector, uint16_t doffset)
+{
+	int x;
+
+	if (fs->fs_dcache == NULL) {
+		return;
+	}
+
+	for (x = 0; x < SMARTFS_DCACHE_NENTRIES; x++) {
+		if (fs->fs_dcache[x].hash != 0 && fs->fs_dcache[x].dsector == dsector && fs->fs_dcache[x].doffset == doffset) {
+			fs->fs_dcache[x].hash = 0;
+		}
+	}
+}
+
+/****************************************************************************
+ * Name: smartfs_dcache_forget
+ *
+ * Description: Drop every entry, positive or negative, for 'name'.  Called
+ *   when an entry with that name is written.  The parent sector is not
+ *   known at that point, so the name is dropped from every directory.
+ *
+ ****************************************************************************/
+
+void smartfs_dcache_forget(struct smartfs_mountpt_s *fs, const char *name)
+{
+	int x;
+
+	if (fs->fs_dcache == NULL) {
+		return;
+	}
+
+	for (x = 0; x < SMARTFS_DCACHE_NENTRIES; x++) {
+		if (fs->fs_dcache[x].hash != 0 && strncmp(fs->fs_dcache[x].name, name, fs->fs_llformat.namesize) == 0) {
+			fs->fs_dcache[x].hash = 0;
+		}
+	}
+}
+
+#endif							/* CONFIG_SMARTFS_DENTRY_CACHE */
@@ -761,6 +761,16 @@ static size_t smartfs_status_read(FAR struct file *filep, FAR char *buffer, size
 		if (ret == OK) {
 			/* Format and return data in the buffer */
 			len = snprintf(buffer, buflen, "Total Sectors    %d\nFree Sectors     %d\n" "Released Sectors %d\n", procfs_data.totalsectors, procfs_data.freesectors, procfs_data.releasesectors);
+#ifdef CONFIG_MTD_SMART_ALLOC_STATS
+			/* Report the sector header reads spent per allocation */
+
+			len += snprintf(&buffer[len], buflen - len, "Allocations      %u\nAlloc Reads      %u\n" "Max Alloc Reads  %u\nAlloc Fallbacks  %u\n", procfs_data.allocsearches, procfs_data.allocreads, procfs_data.allocmaxreads, procfs_data.allocfallbacks);
+#endif
+#ifdef CONFIG_SMARTFS_DENTRY_CACHE
+			/* Report how many path lookups the dentry cache answered */
+
+			len += snprintf(&buffer[len], buflen - len, "Dentry Hits      %u\nDentry Misses    %u\n", priv->level1.mount->fs_dcache_hits, priv->level1.mount->fs_dcache_misses);
+#endif
 #ifdef CONFIG_DEBUG_FS
 			/* Calculate the sector utilization percentage */
 			if (procfs_data.blockerases == 0) {
@@ -1642,6 +1642,8 @@ int smartfs_rename(struct inode *mountpt, const char *oldrelpath, const char *ne
 #ifdef CONFIG_SMARTFS_USE_SECTOR_BUFFER
 		if (oldentry.dfirst == newentry.dsector) {
 			/* We will not use any new entry found, we will overwrite the existing entry but with a new name */
+			smartfs_dcache_remove(fs, oldentry.dsector, oldentry.doffset);
+			smartfs_dcache_forget(fs, newentry.name);
 			smartfs_setbuffer(&readwrite, oldentry.dsector, oldentry.doffset + offsetof(struct smartfs_entry_header_s, name), fs->fs_llformat.namesize, (uint8_t *)newentry.name);
 			ret = FS_IOCTL(fs, BIOC_WRITESECT, (unsigned long)&readwrite);
 			if (ret != OK) {
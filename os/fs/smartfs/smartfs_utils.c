@@ -186,6 +186,43 @@ struct sector_recover_info_s {
  * Private Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: smartfs_fill_direntry
+ *
+ * Description: Report the on-volume entry found at 'offset' in sector
+ *   'dsector' of the directory starting at sector 'parent'.
+ *
+ ****************************************************************************/
+
+static void smartfs_fill_direntry(struct smartfs_mountpt_s *fs, struct smartfs_entry_s *direntry, struct smartfs_entry_header_s *entry, uint16_t dsector, uint16_t offset, uint16_t parent)
+{
+#ifdef CONFIG_SMARTFS_ALIGNED_ACCESS
+	direntry->firstsector = smartfs_rdle16(&entry->firstsector);
+	direntry->flags = smartfs_rdle16(&entry->flags);
+	direntry->utc = smartfs_rdle32(&entry->utc);
+#else
+	direntry->firstsector = entry->firstsector;
+	direntry->flags = entry->flags;
+	direntry->utc = entry->utc;
+#endif
+	direntry->dsector = dsector;
+	direntry->doffset = offset;
+	direntry->dfirst = parent;
+
+	strncpy(direntry->name, entry->name, fs->fs_llformat.namesize);
+	direntry->datalen = 0;
+
+	/* Mark the file's length as unknown, smartfs_get_datalen will scan
+	 * through the file's sectors to calculate it later if required.
+	 */
+
+	if ((direntry->flags & SMARTFS_DIRENT_TYPE) == SMARTFS_DIRENT_TYPE_FILE) {
+		direntry->datalen = SMARTFS_DIRENT_LEN_UNKWN;
+	}
+
+	direntry->prev_parent = parent;
+}
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -897,6 +934,10 @@ int smartfs_mount(struct smartfs_mountpt_s *fs, bool writeable)
 	fs->fs_workbuffer = (char *)kmm_malloc(256);
 	fs->fs_rootsector = SMARTFS_ROOT_DIR_SECTOR;
 
+	/* The lookup cache is optional, a mount without it still works */
+
+	(void)smartfs_dcache_initialize(fs);
+
 	/* We did it! */
 
 	fs->fs_mounted = TRUE;
@@ -1043,6 +1084,8 @@ int smartfs_unmount(struct smartfs_mountpt_s *fs)
 	kmm_free(fs->fs_workbuffer);
 #endif
 
+	smartfs_dcache_release(fs);
+
 	return ret;
 }
 
@@ -1137,6 +1180,9 @@ int smartfs_finddirentry(struct smartfs_mountpt_s *fs, struct smartfs_entry_s *d
 #ifdef CONFIG_SMARTFS_DYNAMIC_HEADER
 	int used_value;
 #endif
+#ifdef CONFIG_SMARTFS_DENTRY_CACHE
+	FAR struct smartfs_dcache_entry_s *dentry;
+#endif
 
 	/* Initialize directory level zero as the root sector */
 	direntry->dsector = 0xFFFF;
@@ -1216,6 +1262,59 @@ int smartfs_finddirentry(struct smartfs_mountpt_s *fs, struct smartfs_entry_s *d
 			segment = ptr;
 			continue;
 		} else {
+#ifdef CONFIG_SMARTFS_DENTRY_CACHE
+			/* Try the lookup cache before reading the directory */
+
+			dentry = smartfs_dcache_lookup(fs, dirstack[depth], fs->fs_workbuffer);
+			if (dentry != NULL && dentry->dsector == SMARTFS_DCACHE_NEGATIVE) {
+				fs->fs_dcache_hits++;
+				goto notfound;
+			} else if (dentry != NULL && *ptr != '\0') {
+				/* An intermediate segment only needs the directory's first
+				 * sector, which does not change while the entry exists.
+				 */
+
+				fs->fs_dcache_hits++;
+				if ((dentry->flags & SMARTFS_DIRENT_TYPE) != SMARTFS_DIRENT_TYPE_DIR) {
+					ret = -ENOTDIR;
+					goto errout;
+				}
+
+				if (depth >= CONFIG_SMARTFS_DIRDEPTH - 1) {
+					ret = -ENAMETOOLONG;
+					goto errout;
+				}
+
+				dirstack[++depth] = dentry->firstsector;
+				segment = ptr + 1;
+				continue;
+			} else if (dentry != NULL) {
+				/* The last segment is reported from the volume, so only the
+				 * sector holding the entry is read.
+				 */
+
+				smartfs_setbuffer(&readwrite, dentry->dsector, 0, fs->fs_llformat.availbytes, (uint8_t *)fs->fs_rwbuffer);
+				ret = FS_IOCTL(fs, BIOC_READSECT, (unsigned long)&readwrite);
+				if (ret < 0) {
+					goto errout;
+				}
+
+				entry = (struct smartfs_entry_header_s *)&fs->fs_rwbuffer[dentry->doffset];
+				if (dentry->doffset + entrysize <= readwrite.count && ENTRY_VALID(entry) && strncmp(entry->name, fs->fs_workbuffer, fs->fs_llformat.namesize) == 0) {
+					fs->fs_dcache_hits++;
+					smartfs_fill_direntry(fs, direntry, entry, dentry->dsector, dentry->doffset, dirstack[depth]);
+					ret = OK;
+					goto errout;
+				}
+
+				/* Stale entry, drop it and search the directory */
+
+				dentry->hash = 0;
+			}
+
+			fs->fs_dcache_misses++;
+#endif
+
 			/* Search for the entry in the current directory */
 
 			dirsector = dirstack[depth];
@@ -1272,39 +1371,8 @@ int smartfs_finddirentry(struct smartfs_mountpt_s *fs, struct smartfs_entry_s *d
 						if (*ptr == '\0') {
 							/* We are at the last segment.  Report the entry */
 
-							/* Fill in the entry */
-
-#ifdef CONFIG_SMARTFS_ALIGNED_ACCESS
-							direntry->firstsector = smartfs_rdle16(&entry->firstsector);
-							direntry->flags = smartfs_rdle16(&entry->flags);
-							direntry->utc = smartfs_rdle32(&entry->utc);
-#else
-							direntry->firstsector = entry->firstsector;
-							direntry->flags = entry->flags;
-							direntry->utc = entry->utc;
-#endif
-							direntry->dsector = readwrite.logsector;
-							direntry->doffset = offset;
-							direntry->dfirst = dirstack[depth];
-
-							strncpy(direntry->name, entry->name, fs->fs_llformat.namesize);
-							direntry->datalen = 0;
-
-							/* Invoke smartfs_get_datalen to scan through the file's sectors to calculate
-							 * its length and perform a rudimentary check.
-							 */
-#ifdef CONFIG_SMARTFS_ALIGNED_ACCESS
-							if ((smartfs_rdle16(&entry->flags) & SMARTFS_DIRENT_TYPE) == SMARTFS_DIRENT_TYPE_FILE) {
-								dirsector = smartfs_rdle16(&entry->firstsector);
-#else
-							if ((entry->flags & SMARTFS_DIRENT_TYPE) == SMARTFS_DIRENT_TYPE_FILE) {
-								dirsector = entry->firstsector;
-#endif
-								/* Mark the file's length as unknown, it will be calculated later if required */
-								direntry->datalen = SMARTFS_DIRENT_LEN_UNKWN;
-							}
-
-							direntry->prev_parent = dirstack[depth];
+							smartfs_fill_direntry(fs, direntry, entry, readwrite.logsector, offset, dirstack[depth]);
+							smartfs_dcache_add(fs, dirstack[depth], fs->fs_workbuffer, direntry->firstsector, direntry->flags, readwrite.logsector, offset);
 							ret = OK;
 							goto errout;
 						} else {
@@ -1331,8 +1399,10 @@ int smartfs_finddirentry(struct smartfs_mountpt_s *fs, struct smartfs_entry_s *d
 								goto errout;
 							}
 #ifdef CONFIG_SMARTFS_ALIGNED_ACCESS
+							smartfs_dcache_add(fs, dirstack[depth], fs->fs_workbuffer, smartfs_rdle16(&entry->firstsector), smartfs_rdle16(&entry->flags), readwrite.logsector, offset);
 							dirstack[++depth] = smartfs_rdle16(&entry->firstsector);
 #else
+							smartfs_dcache_add(fs, dirstack[depth], fs->fs_workbuffer, entry->firstsector, entry->flags, readwrite.logsector, offset);
 							dirstack[++depth] = entry->firstsector;
 #endif
 							segment = ptr + 1;
@@ -1367,10 +1437,16 @@ int smartfs_finddirentry(struct smartfs_mountpt_s *fs, struct smartfs_entry_s *d
 				continue;
 			}
 
-			/* Entry not found!  Report the error.  Also, if this is the last
-			 * segment, then report the parent directory sector.
+			/* Entry not found!  Remember that, report the error.  Also, if
+			 * this is the last segment, then report the parent directory
+			 * sector.
 			 */
 
+			smartfs_dcache_add(fs, dirstack[depth], fs->fs_workbuffer, 0, 0, SMARTFS_DCACHE_NEGATIVE, 0);
+#ifdef CONFIG_SMARTFS_DENTRY_CACHE
+notfound:
+#endif
+
 			if (*ptr == '\0') {
 				direntry->dsector = dirstack[depth];
 				strncpy(direntry->name, segment, seglen);
@@ -1593,6 +1669,11 @@ int smartfs_writeentry(struct smartfs_mountpt_s *fs, struct smartfs_entry_s new_
 
 	memset(entry->name, 0, fs->fs_llformat.namesize);
 	strncpy(entry->name, new_entry.name, fs->fs_llformat.namesize);
+
+	/* Cached lookups of this name, including "not found", are now stale */
+
+	smartfs_dcache_forget(fs, new_entry.name);
+
 	/* Now write the new entry to the parent directory sector */
 	if (new_entry.prev_parent != new_entry.dsector) {
 		/* If this is a newly chained sector, write new entry and chain header both */
@@ -1719,6 +1800,8 @@ int smartfs_invalidateentry(struct smartfs_mountpt_s *fs, uint16_t parentdirsect
 	struct smart_read_write_s readwrite;
 	uint8_t *entry_flags;
 
+	smartfs_dcache_remove(fs, parentdirsector, offset);
+
 	smartfs_setbuffer(&readwrite, parentdirsector, offset, sizeof(uint16_t), (uint8_t *)fs->fs_rwbuffer);
 	ret = FS_IOCTL(fs, BIOC_READSECT, (unsigned long)&readwrite);
 	if (ret < 0) {
@@ -1780,6 +1863,8 @@ int smartfs_deleteentry(struct smartfs_mountpt_s *fs, struct smartfs_entry_s *en
 	 * So We will always process regarding entry & chain first when delete entry.
 	 */
 
+	smartfs_dcache_remove(fs, entry->dsector, entry->doffset);
+
 	/* First Find current directory has only one item which is target entry */
 	ret = OK;
 	header = (struct smartfs_chain_header_s *)fs->fs_rwbuffer;
@@ -72,6 +72,10 @@
 #include <tinyara/fs/fs.h>
 #include <tinyara/fs/dirent.h>
 #include <tinyara/fs/ioctl.h>
+#ifdef CONFIG_FS_TMPFS_PAGE_POOL
+#include <tinyara/mm/gran.h>
+#include <arch/irq.h>
+#endif
 
 #include "fs_tmpfs.h"
 
@@ -83,10 +87,15 @@
 #  warning CONFIG_FS_TMPFS_DIRECTORY_FREEGUARD needs to be > ALLOCGUARD
 #endif
 
-#if CONFIG_FS_TMPFS_FILE_FREEGUARD <= CONFIG_FS_TMPFS_FILE_ALLOCGUARD
+#if !defined(CONFIG_FS_TMPFS_PAGED) && \
+	CONFIG_FS_TMPFS_FILE_FREEGUARD <= CONFIG_FS_TMPFS_FILE_ALLOCGUARD
 #  warning CONFIG_FS_TMPFS_FILE_FREEGUARD needs to be > ALLOCGUARD
 #endif
 
+/* Minimum number of page table entries allocated for a paged file */
+
+#define TMPFS_MIN_PAGETABLE 4
+
 #define tmpfs_lock_file(tfo) \
 	(tmpfs_lock_object((FAR struct tmpfs_object_s *)tfo))
 #define tmpfs_lock_directory(tdo) \
@@ -109,6 +118,14 @@ static void tmpfs_lock_object(FAR struct tmpfs_object_s *to);
 static void tmpfs_unlock_object(FAR struct tmpfs_object_s *to);
 static int tmpfs_realloc_directory(FAR struct tmpfs_directory_s **tdo, unsigned int nentries);
 static int tmpfs_realloc_file(FAR struct tmpfs_file_s **tfo, size_t newsize);
+#ifdef CONFIG_FS_TMPFS_PAGED
+static FAR uint8_t *tmpfs_alloc_page(void);
+static void tmpfs_free_page(FAR uint8_t *page);
+static void tmpfs_free_pages(FAR struct tmpfs_file_s *tfo);
+static void tmpfs_copy_pages(FAR struct tmpfs_file_s *tfo, size_t pos, FAR uint8_t *buffer, size_t len, bool write);
+#else
+#define tmpfs_free_pages(tfo)
+#endif
 static void tmpfs_release_lockedobject(FAR struct tmpfs_object_s *to);
 static void tmpfs_release_lockedfile(FAR struct tmpfs_file_s *tfo);
 static int tmpfs_find_dirent(FAR struct tmpfs_directory_s *tdo, FAR const char *name);
@@ -182,6 +199,24 @@ const struct mountpt_operations tmpfs_operations = {
 	tmpfs_stat,       /* stat */
 };
 
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+#ifdef CONFIG_FS_TMPFS_PAGE_POOL
+/* Page pool shared by all mounted tmpfs instances.  Mount and unmount are
+ * serialized by the inode semaphore.  A file which is still open after its
+ * instance is unmounted keeps its pages, so the pool lives until both the
+ * mount count and the count of pages in use drop to zero.  Both counts are
+ * changed in a critical section.
+ */
+
+static GRAN_HANDLE g_tmpfs_pool;
+static FAR uint8_t *g_tmpfs_poolmem;
+static unsigned int g_tmpfs_nmounts;
+static unsigned int g_tmpfs_npages;
+#endif
+
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
@@ -340,10 +375,243 @@ static int tmpfs_realloc_directory(FAR struct tmpfs_directory_s **tdo,
 	return ret;
 }
 
+/****************************************************************************
+ * Name: tmpfs_release_pool
+ *
+ * Description:
+ *   Release the page pool if no mount and no page of it is left.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_FS_TMPFS_PAGE_POOL
+static void tmpfs_release_pool(void)
+{
+	GRAN_HANDLE pool;
+	FAR uint8_t *poolmem;
+	irqstate_t flags;
+
+	flags = enter_critical_section();
+	if (g_tmpfs_nmounts != 0 || g_tmpfs_npages != 0) {
+		leave_critical_section(flags);
+		return;
+	}
+
+	pool            = g_tmpfs_pool;
+	poolmem         = g_tmpfs_poolmem;
+	g_tmpfs_pool    = NULL;
+	g_tmpfs_poolmem = NULL;
+	leave_critical_section(flags);
+
+	if (pool != NULL) {
+		gran_release(pool);
+		kmm_free(poolmem);
+	}
+}
+#endif
+
+/****************************************************************************
+ * Name: tmpfs_alloc_page
+ ****************************************************************************/
+
+#ifdef CONFIG_FS_TMPFS_PAGED
+static FAR uint8_t *tmpfs_alloc_page(void)
+{
+#ifdef CONFIG_FS_TMPFS_PAGE_POOL
+	FAR uint8_t *page;
+
+	if (g_tmpfs_pool != NULL) {
+		page = (FAR uint8_t *)gran_alloc(g_tmpfs_pool, TMPFS_PAGE_SIZE);
+		if (page != NULL) {
+			irqstate_t flags = enter_critical_section();
+			g_tmpfs_npages++;
+			leave_critical_section(flags);
+			return page;
+		}
+	}
+
+	/* The pool is exhausted (or could not be created), use the heap */
+#endif
+
+	return (FAR uint8_t *)kmm_malloc(TMPFS_PAGE_SIZE);
+}
+
+/****************************************************************************
+ * Name: tmpfs_free_page
+ ****************************************************************************/
+
+static void tmpfs_free_page(FAR uint8_t *page)
+{
+#ifdef CONFIG_FS_TMPFS_PAGE_POOL
+	if (g_tmpfs_poolmem != NULL && page >= g_tmpfs_poolmem &&
+		page < g_tmpfs_poolmem + CONFIG_FS_TMPFS_PAGE_POOL_SIZE) {
+		irqstate_t flags;
+		bool last;
+
+		gran_free(g_tmpfs_pool, page, TMPFS_PAGE_SIZE);
+
+		/* The last page of a pool whose mounts are all gone releases it */
+
+		flags = enter_critical_section();
+		last = (--g_tmpfs_npages == 0);
+		leave_critical_section(flags);
+		if (last) {
+			tmpfs_release_pool();
+		}
+		return;
+	}
+#endif
+
+	kmm_free(page);
+}
+
+/****************************************************************************
+ * Name: tmpfs_free_pages
+ *
+ * Description:
+ *   Free all data pages and the page table of a file that is about to be
+ *   freed.
+ *
+ ****************************************************************************/
+
+static void tmpfs_free_pages(FAR struct tmpfs_file_s *tfo)
+{
+	while (tfo->tfo_npages > 0) {
+		tmpfs_free_page(tfo->tfo_pages[--tfo->tfo_npages]);
+	}
+
+	if (tfo->tfo_pages != NULL) {
+		kmm_free(tfo->tfo_pages);
+		tfo->tfo_pages = NULL;
+	}
+
+	tfo->tfo_maxpages = 0;
+}
+
+/****************************************************************************
+ * Name: tmpfs_copy_pages
+ *
+ * Description:
+ *   Copy len bytes between buffer and the file data at pos, one page at a
+ *   time.  If write is true and buffer is NULL the range is zeroed.  The
+ *   pages covering the range must exist.
+ *
+ ****************************************************************************/
+
+static void tmpfs_copy_pages(FAR struct tmpfs_file_s *tfo, size_t pos,
+		FAR uint8_t *buffer, size_t len, bool write)
+{
+	FAR uint8_t *page;
+	size_t offset;
+	size_t nbytes;
+
+	while (len > 0) {
+		DEBUGASSERT(pos / TMPFS_PAGE_SIZE < tfo->tfo_npages);
+
+		page   = tfo->tfo_pages[pos / TMPFS_PAGE_SIZE];
+		offset = pos & (TMPFS_PAGE_SIZE - 1);
+		nbytes = TMPFS_PAGE_SIZE - offset;
+		if (nbytes > len) {
+			nbytes = len;
+		}
+
+		if (!write) {
+			memcpy(buffer, &page[offset], nbytes);
+		} else if (buffer != NULL) {
+			memcpy(&page[offset], buffer, nbytes);
+		} else {
+			memset(&page[offset], 0, nbytes);
+		}
+
+		if (buffer != NULL) {
+			buffer += nbytes;
+		}
+
+		pos += nbytes;
+		len -= nbytes;
+	}
+}
+
 /****************************************************************************
  * Name: tmpfs_realloc_file
+ *
+ * Description:
+ *   Resize a paged file.  Pages are appended or freed at the end of the
+ *   file only; the file object itself never moves and existing data is
+ *   never copied.  Bytes between the old and the new size are not
+ *   initialized.
+ *
  ****************************************************************************/
 
+static int tmpfs_realloc_file(FAR struct tmpfs_file_s **tfo,
+		size_t newsize)
+{
+	FAR struct tmpfs_file_s *file = *tfo;
+	FAR uint8_t **pages;
+	FAR uint8_t *page;
+	unsigned int oldpages;
+	unsigned int npages;
+	unsigned int maxpages;
+
+	oldpages = file->tfo_npages;
+	npages   = TMPFS_NPAGES(newsize);
+
+	/* Shrinking ... free the pages past the new end of file */
+
+	if (npages == 0) {
+		tmpfs_free_pages(file);
+	} else {
+		while (file->tfo_npages > npages) {
+			tmpfs_free_page(file->tfo_pages[--file->tfo_npages]);
+		}
+	}
+
+	/* Growing ... extend the page table geometrically so that appending
+	 * stays amortized constant time, then add the pages.
+	 */
+
+	if (npages > file->tfo_maxpages) {
+		maxpages = file->tfo_maxpages * 2;
+		if (maxpages < TMPFS_MIN_PAGETABLE) {
+			maxpages = TMPFS_MIN_PAGETABLE;
+		}
+
+		if (maxpages < npages) {
+			maxpages = npages;
+		}
+
+		pages = (FAR uint8_t **)kmm_realloc(file->tfo_pages, maxpages * sizeof(FAR uint8_t *));
+		if (pages == NULL) {
+			return -ENOMEM;
+		}
+
+		file->tfo_pages    = pages;
+		file->tfo_maxpages = maxpages;
+	}
+
+	while (file->tfo_npages < npages) {
+		page = tmpfs_alloc_page();
+		if (page == NULL) {
+			/* Back out the pages added by this call; the file keeps its
+			 * old size.
+			 */
+
+			while (file->tfo_npages > oldpages) {
+				tmpfs_free_page(file->tfo_pages[--file->tfo_npages]);
+			}
+
+			return -ENOMEM;
+		}
+
+		file->tfo_pages[file->tfo_npages++] = page;
+	}
+
+	file->tfo_size  = newsize;
+	file->tfo_alloc = sizeof(struct tmpfs_file_s) +
+					  file->tfo_maxpages * sizeof(FAR uint8_t *) +
+					  file->tfo_npages * TMPFS_PAGE_SIZE;
+	return OK;
+}
+#else
 static int tmpfs_realloc_file(FAR struct tmpfs_file_s **tfo,
 		size_t newsize)
 {
@@ -401,6 +669,7 @@ static int tmpfs_realloc_file(FAR struct tmpfs_file_s **tfo,
 	*tfo              = newtfo;
 	return OK;
 }
+#endif
 
 /****************************************************************************
  * Name: tmpfs_release_lockedobject
@@ -434,6 +703,7 @@ static void tmpfs_release_lockedfile(FAR struct tmpfs_file_s *tfo)
 
 	if (tfo->tfo_refs == 1 && (tfo->tfo_flags & TFO_FLAG_UNLINKED) != 0) {
 		sem_destroy(&tfo->tfo_exclsem.ts_sem);
+		tmpfs_free_pages(tfo);
 		kmm_free(tfo);
 	}
 
@@ -575,7 +845,11 @@ static FAR struct tmpfs_file_s *tmpfs_alloc_file(void)
 
 	/* Create a new zero length file object */
 
+#ifdef CONFIG_FS_TMPFS_PAGED
+	allocsize = SIZEOF_TMPFS_FILE(0);
+#else
 	allocsize = SIZEOF_TMPFS_FILE(CONFIG_FS_TMPFS_FILE_ALLOCGUARD);
+#endif
 	tfo = (FAR struct tmpfs_file_s *)kmm_malloc(allocsize);
 	if (tfo == NULL) {
 		return NULL;
@@ -589,6 +863,11 @@ static FAR struct tmpfs_file_s *tmpfs_alloc_file(void)
 	tfo->tfo_refs  = 1;
 	tfo->tfo_flags = 0;
 	tfo->tfo_size  = 0;
+#ifdef CONFIG_FS_TMPFS_PAGED
+	tfo->tfo_pages    = NULL;
+	tfo->tfo_npages   = 0;
+	tfo->tfo_maxpages = 0;
+#endif
 
 	tfo->tfo_exclsem.ts_holder = getpid();
 	tfo->tfo_exclsem.ts_count  = 1;
@@ -1176,6 +1455,11 @@ static int tmpfs_free_callout(FAR struct tmpfs_directory_s *tdo,
 	/* Free the object now */
 
 	sem_destroy(&to->to_exclsem.ts_sem);
+#ifdef CONFIG_FS_TMPFS_PAGED
+	if (to->to_type == TMPFS_REGULAR) {
+		tmpfs_free_pages((FAR struct tmpfs_file_s *)to);
+	}
+#endif
 	kmm_free(to);
 	return TMPFS_DELETED;
 }
@@ -1420,6 +1704,7 @@ static int tmpfs_close(FAR struct file *filep)
 		 * have any other references.
 		 */
 
+		tmpfs_free_pages(tfo);
 		kmm_free(tfo);
 		return OK;
 	}
@@ -1467,7 +1752,16 @@ static ssize_t tmpfs_read(FAR struct file *filep, FAR char *buffer,
 
 	/* Copy data from the memory object to the user buffer */
 
+#ifdef CONFIG_FS_TMPFS_PAGED
+	if (nread <= 0) {
+		tmpfs_unlock_file(tfo);
+		return 0;
+	}
+
+	tmpfs_copy_pages(tfo, (size_t)startpos, (FAR uint8_t *)buffer, nread, false);
+#else
 	memcpy(buffer, &tfo->tfo_data[startpos], nread);
+#endif
 	filep->f_pos += nread;
 
 	/* Release the lock on the file */
@@ -1508,6 +1802,8 @@ static ssize_t tmpfs_write(FAR struct file *filep, FAR const char *buffer,
 	endpos   = startpos + buflen;
 
 	if (endpos > tfo->tfo_size) {
+		size_t oldsize = tfo->tfo_size;
+
 		/* Reallocate the file to handle the write past the end of the file. */
 
 		ret = tmpfs_realloc_file(&tfo, (size_t)endpos);
@@ -1515,11 +1811,25 @@ static ssize_t tmpfs_write(FAR struct file *filep, FAR const char *buffer,
 			goto errout_with_lock;
 		}
 		filep->f_priv = tfo;
+
+		/* Zero the hole left by a seek past the old end of file */
+
+		if (startpos > oldsize) {
+#ifdef CONFIG_FS_TMPFS_PAGED
+			tmpfs_copy_pages(tfo, oldsize, NULL, startpos - oldsize, true);
+#else
+			memset(&tfo->tfo_data[oldsize], 0, startpos - oldsize);
+#endif
+		}
 	}
 
 	/* Copy data from the memory object to the user buffer */
 
+#ifdef CONFIG_FS_TMPFS_PAGED
+	tmpfs_copy_pages(tfo, (size_t)startpos, (FAR uint8_t *)buffer, nwritten, true);
+#else
 	memcpy(&tfo->tfo_data[startpos], buffer, nwritten);
+#endif
 	filep->f_pos += nwritten;
 
 	/* Release the lock on the file */
@@ -1615,7 +1925,18 @@ static int tmpfs_ioctl(FAR struct file *filep, int cmd, unsigned long arg)
 		 * the file.
 		 */
 
+#ifdef CONFIG_FS_TMPFS_PAGED
+		/* Only a file held in a single page is contiguous */
+
+		if (tfo->tfo_npages > 1) {
+			fdbg("ERROR: File spans %u pages, cannot map\n", tfo->tfo_npages);
+			return -ENOTTY;
+		}
+
+		*ppv = (FAR void *)(tfo->tfo_npages > 0 ? tfo->tfo_pages[0] : NULL);
+#else
 		*ppv = (FAR void *)tfo->tfo_data;
+#endif
 		return OK;
 	}
 
@@ -1730,7 +2051,11 @@ static int tmpfs_truncate(FAR struct file *filep, off_t length)
 		 */
 
 		if (length > oldsize) {
-		  memset(&tfo->tfo_data[oldsize], 0, length - oldsize);
+#ifdef CONFIG_FS_TMPFS_PAGED
+			tmpfs_copy_pages(tfo, oldsize, NULL, length - oldsize, true);
+#else
+			memset(&tfo->tfo_data[oldsize], 0, length - oldsize);
+#endif
 		}
 		ret = OK;
 	}
@@ -1906,6 +2231,10 @@ static int tmpfs_bind(FAR struct inode *blkdriver, FAR const void *data,
 {
 	FAR struct tmpfs_directory_s *tdo;
 	FAR struct tmpfs_s *fs;
+#ifdef CONFIG_FS_TMPFS_PAGE_POOL
+	irqstate_t flags;
+	bool create;
+#endif
 
 	fvdbg("blkdriver: %p data: %p handle: %p\n", blkdriver, data, handle);
 	DEBUGASSERT(blkdriver == NULL && handle != NULL);
@@ -1939,6 +2268,34 @@ static int tmpfs_bind(FAR struct inode *blkdriver, FAR const void *data,
 	fs->tfs_exclsem.ts_count  = 0;
 	sem_init(&fs->tfs_exclsem.ts_sem, 0, 1);
 
+#ifdef CONFIG_FS_TMPFS_PAGE_POOL
+	/* Create the page pool with the first mount, unless files of an
+	 * unmounted instance still hold pages of it.  Without a pool, pages
+	 * simply come from the heap.
+	 */
+
+	flags = enter_critical_section();
+	create = (g_tmpfs_nmounts++ == 0 && g_tmpfs_pool == NULL);
+	leave_critical_section(flags);
+
+	if (create) {
+		g_tmpfs_poolmem = (FAR uint8_t *)kmm_malloc(CONFIG_FS_TMPFS_PAGE_POOL_SIZE);
+		if (g_tmpfs_poolmem != NULL) {
+			uint8_t log2page = 0;
+
+			while ((1 << log2page) < TMPFS_PAGE_SIZE) {
+				log2page++;
+			}
+
+			g_tmpfs_pool = gran_initialize(g_tmpfs_poolmem, CONFIG_FS_TMPFS_PAGE_POOL_SIZE, log2page, 2);
+			if (g_tmpfs_pool == NULL) {
+				kmm_free(g_tmpfs_poolmem);
+				g_tmpfs_poolmem = NULL;
+			}
+		}
+	}
+#endif
+
 	/* Return the new file system handle */
 
 	*handle = (FAR void *)fs;
@@ -1952,6 +2309,9 @@ static int tmpfs_unbind(FAR void *handle, FAR struct inode **blkdriver)
 {
 	FAR struct tmpfs_s *fs = (FAR struct tmpfs_s *)handle;
 	FAR struct tmpfs_directory_s *tdo;
+#ifdef CONFIG_FS_TMPFS_PAGE_POOL
+	irqstate_t flags;
+#endif
 	int ret;
 
 	fvdbg("handle: %p blkdriver: %p\n", handle, blkdriver);
@@ -1973,6 +2333,18 @@ static int tmpfs_unbind(FAR void *handle, FAR struct inode **blkdriver)
 
 	sem_destroy(&fs->tfs_exclsem.ts_sem);
 	kmm_free(fs);
+
+#ifdef CONFIG_FS_TMPFS_PAGE_POOL
+	/* Files which are still open keep their pages, so the pool is dropped
+	 * with the last mount only when no page is in use.  Otherwise the last
+	 * tmpfs_free_page() drops it.
+	 */
+
+	flags = enter_critical_section();
+	g_tmpfs_nmounts--;
+	leave_critical_section(flags);
+	tmpfs_release_pool();
+#endif
 	return ret;
 }
 
@@ -2117,6 +2489,7 @@ static int tmpfs_unlink(FAR struct inode *mountpt, FAR const char *relpath)
 
 	else {
 		sem_destroy(&tfo->tfo_exclsem.ts_sem);
+		tmpfs_free_pages(tfo);
 		kmm_free(tfo);
 	}
 
@@ -75,6 +75,19 @@
 
 #define TFO_FLAG_UNLINKED (1 << 0)  /* Bit 0: File is unlinked */
 
+/* Paged file storage */
+
+#ifdef CONFIG_FS_TMPFS_PAGED
+#define TMPFS_PAGE_SIZE   CONFIG_FS_TMPFS_PAGE_SIZE
+#if (TMPFS_PAGE_SIZE & (TMPFS_PAGE_SIZE - 1)) != 0
+#  error CONFIG_FS_TMPFS_PAGE_SIZE must be a power of two
+#endif
+
+/* Number of pages needed to hold n bytes */
+
+#define TMPFS_NPAGES(n)   (((n) + TMPFS_PAGE_SIZE - 1) / TMPFS_PAGE_SIZE)
+#endif
+
 /* Redefine memory alloc function when using multi heap */
 
 #if CONFIG_KMM_NHEAPS > 1 && CONFIG_KMM_REGIONS > 1
@@ -174,10 +187,20 @@ struct tmpfs_file_s {
 
 	uint8_t  tfo_flags;    /* See TFO_FLAG_* definitions */
 	size_t   tfo_size;     /* Valid file size */
+#ifdef CONFIG_FS_TMPFS_PAGED
+	FAR uint8_t **tfo_pages;   /* Table of data pages */
+	unsigned int tfo_npages;   /* Pages in use, TMPFS_NPAGES(tfo_size) */
+	unsigned int tfo_maxpages; /* Allocated entries of tfo_pages */
+#else
 	uint8_t  tfo_data[1];  /* File data starts here */
+#endif
 };
 
+#ifdef CONFIG_FS_TMPFS_PAGED
+#define SIZEOF_TMPFS_FILE(n) sizeof(struct tmpfs_file_s)
+#else
 #define SIZEOF_TMPFS_FILE(n) (sizeof(struct tmpfs_file_s) + (n) - 1)
+#endif
 
 /* This structure represents one instance of a TMPFS file system */
 
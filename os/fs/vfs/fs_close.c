@@ -114,6 +114,7 @@ int close(int fd)
 
 #if defined(CONFIG_NET) && CONFIG_NSOCKET_DESCRIPTORS > 0
 		if ((unsigned int)fd < (CONFIG_NFILE_DESCRIPTORS + CONFIG_NSOCKET_DESCRIPTORS)) {
+			epoll_detach(NULL, fd);
 			ret = net_close(fd);
 			leave_cancellation_point();
 			return ret;
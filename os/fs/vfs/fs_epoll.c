@@ -0,0 +1,773 @@
+/****************************************************************************
+ *
+ * Copyright 2025 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+/****************************************************************************
+ * fs/vfs/fs_epoll.c
+ *
+ * Persistent event notification built on the driver poll() hooks.
+ *
+ * poll() and select() set up every descriptor in the set on entry and tear
+ * every one of them down again on exit, so each call costs two driver
+ * round trips per descriptor even when nothing is ready.  An epoll instance
+ * instead registers each descriptor once, in epoll_ctl(), with a pollfd
+ * that stays attached to the driver and shares the instance semaphore.
+ * Drivers (pipes, message queues, serial, sockets via net_poll()) post that
+ * semaphore and set revents exactly as they do for poll(); epoll_wait()
+ * only has to collect the non-zero revents and re-arm the descriptors that
+ * it reported.
+ *
+ * Level-triggered descriptors are re-armed at the start of the next
+ * epoll_wait() so that the driver re-evaluates the current state after the
+ * caller had a chance to drain it.  EPOLLET descriptors stay armed and are
+ * reported again on the next driver notification.  Socket poll setup only
+ * signals once per setup, so sockets are always re-armed and EPOLLET on a
+ * socket behaves level-triggered.  EPOLLONESHOT descriptors are torn down
+ * after being reported until re-enabled with EPOLL_CTL_MOD.
+ *
+ * The driver keeps a pointer to the registered pollfd until it is torn
+ * down, so closing a registered descriptor detaches it from every epoll
+ * instance first (epoll_detach(), called from the close paths).  Files are
+ * set up through the struct file recorded at EPOLL_CTL_ADD, never through
+ * a descriptor number that may have been reused since.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <tinyara/config.h>
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <queue.h>
+#include <errno.h>
+#include <assert.h>
+#include <debug.h>
+#include <sys/epoll.h>
+
+#include <tinyara/kmalloc.h>
+#include <tinyara/clock.h>
+#include <tinyara/cancelpt.h>
+#include <tinyara/semaphore.h>
+#include <tinyara/fs/fs.h>
+#include <arch/irq.h>
+
+#include "inode/inode.h"
+
+#if !defined(CONFIG_DISABLE_POLL) && CONFIG_NFILE_DESCRIPTORS > 0
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Events reported even if not requested */
+
+#define EPOLL_ALWAYS    (EPOLLERR | EPOLLHUP)
+
+/* Event modifiers, not passed to the drivers */
+
+#define EPOLL_MODIFIERS (EPOLLET | EPOLLONESHOT)
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* One entry of the interest list.  Entries are allocated individually
+ * because the driver holds a pointer to pfd while the entry is armed.
+ */
+
+struct epoll_entry_s {
+	dq_entry_t node;			/* Link in the interest list */
+	struct pollfd pfd;			/* Registered with the driver */
+	FAR struct file *filep;		/* File of pfd.fd, NULL for a socket */
+	epoll_data_t data;			/* User data returned with the events */
+	uint32_t events;			/* Requested events and modifiers */
+	bool armed;					/* pfd is set up with the driver */
+	bool rearm;					/* Reported, re-arm before the next scan */
+};
+
+struct epoll_head_s {
+	dq_entry_t node;			/* Link in g_epoll_heads */
+	FAR struct filelist *list;	/* Files of the task group that created it */
+	int crefs;					/* Descriptors referring to it, g_epoll_sem */
+	sem_t exclsem;				/* Protects the interest list */
+	sem_t sem;					/* Posted by the drivers on any event */
+	dq_queue_t entries;			/* Interest list */
+};
+
+/****************************************************************************
+ * Private Function Prototypes
+ ****************************************************************************/
+
+static int epoll_open(FAR struct file *filep);
+static int epoll_close(FAR struct file *filep);
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static const struct file_operations g_epoll_fops = {
+	epoll_open,					/* open */
+	epoll_close,				/* close */
+	NULL,						/* read */
+	NULL,						/* write */
+	NULL,						/* seek */
+	NULL,						/* ioctl */
+#ifndef CONFIG_DISABLE_POLL
+	NULL,						/* poll */
+#endif
+	NULL						/* unlink */
+};
+
+/* All epoll descriptors refer to this anonymous inode.  It is never linked
+ * into the pseudo-filesystem and holds one permanent reference, so the
+ * inode_release() done by close() never frees it.
+ */
+
+static struct inode g_epoll_inode = {
+	.i_crefs = 1,
+	.i_flags = FSNODEFLAG_TYPE_DRIVER,
+	.u = {
+		.i_ops = &g_epoll_fops,
+	},
+};
+
+/* All epoll instances, searched by epoll_detach() */
+
+static dq_queue_t g_epoll_heads;
+static sem_t g_epoll_sem = SEM_INITIALIZER(1);
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: epoll_semtake
+ ****************************************************************************/
+
+static void epoll_semtake(FAR sem_t *sem)
+{
+	while (sem_wait(sem) != 0) {
+		/* The only case that an error should occur here is if the wait was
+		 * awakened by a signal.
+		 */
+
+		ASSERT(get_errno() == EINTR);
+	}
+}
+
+#define epoll_semgive(sem) sem_post(sem)
+
+/****************************************************************************
+ * Name: epoll_gethead
+ *
+ * Description:
+ *   Return the epoll instance referred to by epfd, or NULL if epfd is not
+ *   an epoll descriptor.
+ *
+ ****************************************************************************/
+
+static FAR struct epoll_head_s *epoll_gethead(int epfd)
+{
+	FAR struct file *filep;
+
+	if (fs_getfilep(epfd, &filep) < 0 || filep->f_inode != &g_epoll_inode) {
+		return NULL;
+	}
+
+	return (FAR struct epoll_head_s *)filep->f_priv;
+}
+
+/****************************************************************************
+ * Name: epoll_setup
+ ****************************************************************************/
+
+static int epoll_setup(FAR struct epoll_entry_s *ep, bool setup)
+{
+	if (ep->filep != NULL) {
+		return file_poll(ep->filep, &ep->pfd, setup);
+	}
+
+	return poll_fdsetup(ep->pfd.fd, &ep->pfd, setup);
+}
+
+/****************************************************************************
+ * Name: epoll_arm
+ *
+ * Description:
+ *   Register one entry with its driver.  If the descriptor is already ready
+ *   the driver sets revents and posts the instance semaphore immediately.
+ *
+ ****************************************************************************/
+
+static int epoll_arm(FAR struct epoll_head_s *eph, FAR struct epoll_entry_s *ep)
+{
+	int ret;
+
+	ep->pfd.events = (pollevent_t)(ep->events & ~EPOLL_MODIFIERS);
+	ep->pfd.sem = &eph->sem;
+	ep->pfd.revents = 0;
+	ep->pfd.priv = NULL;
+	ep->pfd.filep = NULL;
+
+	ret = epoll_setup(ep, true);
+	ep->armed = (ret >= 0);
+	ep->rearm = false;
+	return ret;
+}
+
+/****************************************************************************
+ * Name: epoll_disarm
+ ****************************************************************************/
+
+static void epoll_disarm(FAR struct epoll_entry_s *ep)
+{
+	if (ep->armed) {
+		(void)epoll_setup(ep, false);
+		ep->armed = false;
+	}
+
+	ep->rearm = false;
+}
+
+/****************************************************************************
+ * Name: epoll_find
+ ****************************************************************************/
+
+static FAR struct epoll_entry_s *epoll_find(FAR struct epoll_head_s *eph, int fd)
+{
+	FAR struct epoll_entry_s *ep;
+
+	for (ep = (FAR struct epoll_entry_s *)dq_peek(&eph->entries); ep != NULL;
+		 ep = (FAR struct epoll_entry_s *)dq_next(&ep->node)) {
+		if (ep->pfd.fd == fd) {
+			return ep;
+		}
+	}
+
+	return NULL;
+}
+
+/****************************************************************************
+ * Name: epoll_collect
+ *
+ * Description:
+ *   Re-arm the entries reported by the previous call, then gather up to
+ *   maxevents pending events.  Only previously reported entries call into
+ *   their drivers; everything else is a check of revents.
+ *
+ ****************************************************************************/
+
+static int epoll_collect(FAR struct epoll_head_s *eph, FAR struct epoll_event *events, int maxevents)
+{
+	FAR struct epoll_entry_s *ep;
+	irqstate_t flags;
+	pollevent_t revents;
+	int count = 0;
+
+	for (ep = (FAR struct epoll_entry_s *)dq_peek(&eph->entries); ep != NULL;
+		 ep = (FAR struct epoll_entry_s *)dq_next(&ep->node)) {
+		if (ep->rearm) {
+			epoll_disarm(ep);
+			(void)epoll_arm(eph, ep);
+		}
+
+		if (!ep->armed || count >= maxevents) {
+			continue;
+		}
+
+		/* The driver may update revents from interrupt context */
+
+		flags = enter_critical_section();
+		revents = ep->pfd.revents & (pollevent_t)(ep->events | EPOLL_ALWAYS);
+		if (revents != 0) {
+			ep->pfd.revents = 0;
+		}
+		leave_critical_section(flags);
+
+		if (revents == 0) {
+			continue;
+		}
+
+		events[count].events = revents;
+		events[count].data = ep->data;
+		count++;
+
+		if ((ep->events & EPOLLONESHOT) != 0) {
+			epoll_disarm(ep);
+		} else if ((ep->events & EPOLLET) == 0 ||
+				   (unsigned int)ep->pfd.fd >= CONFIG_NFILE_DESCRIPTORS) {
+			ep->rearm = true;
+		}
+	}
+
+	return count;
+}
+
+/****************************************************************************
+ * Name: epoll_open
+ *
+ * Description:
+ *   open() method of the epoll descriptor, only reached through dup(),
+ *   dup2() and the descriptors inherited by a child task.  file_dup2()
+ *   copied f_priv, the new descriptor shares the instance.
+ *
+ ****************************************************************************/
+
+static int epoll_open(FAR struct file *filep)
+{
+	FAR struct epoll_head_s *eph = (FAR struct epoll_head_s *)filep->f_priv;
+
+	if (eph == NULL) {
+		return -EBADF;
+	}
+
+	epoll_semtake(&g_epoll_sem);
+	eph->crefs++;
+	epoll_semgive(&g_epoll_sem);
+	return OK;
+}
+
+/****************************************************************************
+ * Name: epoll_close
+ *
+ * Description:
+ *   close() method of the epoll descriptor.  The last descriptor referring
+ *   to the instance tears down every armed entry and frees it.
+ *
+ ****************************************************************************/
+
+static int epoll_close(FAR struct file *filep)
+{
+	FAR struct epoll_head_s *eph = (FAR struct epoll_head_s *)filep->f_priv;
+	FAR struct epoll_entry_s *ep;
+
+	if (eph == NULL) {
+		return OK;
+	}
+
+	filep->f_priv = NULL;
+
+	epoll_semtake(&g_epoll_sem);
+	if (--eph->crefs > 0) {
+		epoll_semgive(&g_epoll_sem);
+		return OK;
+	}
+	dq_rem(&eph->node, &g_epoll_heads);
+	epoll_semgive(&g_epoll_sem);
+
+	while ((ep = (FAR struct epoll_entry_s *)dq_remfirst(&eph->entries)) != NULL) {
+		epoll_disarm(ep);
+		kmm_free(ep);
+	}
+
+	sem_destroy(&eph->sem);
+	sem_destroy(&eph->exclsem);
+	kmm_free(eph);
+	return OK;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: epoll_detach
+ *
+ * Description:
+ *   Called by the close paths before a file or socket is closed.  Tears
+ *   down and frees every entry registered on it, in all epoll instances.
+ *
+ * Input Parameters:
+ *   filep - The file being closed, or NULL for a socket descriptor
+ *   fd    - The socket descriptor of the calling task when filep is NULL
+ *
+ ****************************************************************************/
+
+void epoll_detach(FAR struct file *filep, int fd)
+{
+	FAR struct epoll_head_s *eph;
+	FAR struct epoll_entry_s *ep;
+	FAR struct epoll_entry_s *next;
+	FAR struct filelist *list = NULL;
+
+	/* Nothing to do, and no lock to take, until epoll is used */
+
+	if (dq_peek(&g_epoll_heads) == NULL) {
+		return;
+	}
+
+	if (filep == NULL) {
+		list = sched_getfiles();
+	}
+
+	epoll_semtake(&g_epoll_sem);
+	for (eph = (FAR struct epoll_head_s *)dq_peek(&g_epoll_heads); eph != NULL;
+		 eph = (FAR struct epoll_head_s *)dq_next(&eph->node)) {
+		if (filep == NULL && eph->list != list) {
+			continue;
+		}
+
+		epoll_semtake(&eph->exclsem);
+		for (ep = (FAR struct epoll_entry_s *)dq_peek(&eph->entries); ep != NULL; ep = next) {
+			next = (FAR struct epoll_entry_s *)dq_next(&ep->node);
+			if (ep->filep != filep || (filep == NULL && ep->pfd.fd != fd)) {
+				continue;
+			}
+
+			epoll_disarm(ep);
+			dq_rem(&ep->node, &eph->entries);
+			kmm_free(ep);
+		}
+		epoll_semgive(&eph->exclsem);
+	}
+	epoll_semgive(&g_epoll_sem);
+}
+
+/****************************************************************************
+ * Name: epoll_create1
+ *
+ * Description:
+ *   Create an epoll instance and return a file descriptor referring to it.
+ *
+ * Input Parameters:
+ *   flags - Zero or EPOLL_CLOEXEC.  There is no exec(), EPOLL_CLOEXEC keeps
+ *           the descriptor from being inherited by child tasks.
+ *
+ * Returned Value:
+ *   A new file descriptor on success; ERROR with errno set on failure:
+ *
+ *   EINVAL - Invalid flags
+ *   EMFILE - No free file descriptor
+ *   ENOMEM - Out of memory
+ *
+ ****************************************************************************/
+
+int epoll_create1(int flags)
+{
+	FAR struct epoll_head_s *eph;
+	FAR struct file *filep;
+	int errcode;
+	int fd;
+
+	if ((flags & ~EPOLL_CLOEXEC) != 0) {
+		errcode = EINVAL;
+		goto errout;
+	}
+
+	eph = (FAR struct epoll_head_s *)kmm_zalloc(sizeof(struct epoll_head_s));
+	if (eph == NULL) {
+		errcode = ENOMEM;
+		goto errout;
+	}
+
+	/* The event semaphore is used for signaling and, hence, should not have
+	 * priority inheritance enabled.
+	 */
+
+	sem_init(&eph->exclsem, 0, 1);
+	sem_init(&eph->sem, 0, 0);
+	sem_setprotocol(&eph->sem, SEM_PRIO_NONE);
+	dq_init(&eph->entries);
+	eph->crefs = 1;
+
+	inode_addref(&g_epoll_inode);
+	fd = files_allocate(&g_epoll_inode, (flags & EPOLL_CLOEXEC) != 0 ? O_RDOK | __FS_O_NOINHERIT : O_RDOK, 0, 0);
+	if (fd < 0) {
+		inode_release(&g_epoll_inode);
+		errcode = EMFILE;
+		goto errout_with_eph;
+	}
+
+	DEBUGVERIFY(fs_getfilep(fd, &filep));
+	filep->f_priv = eph;
+	eph->list = sched_getfiles();
+
+	epoll_semtake(&g_epoll_sem);
+	dq_addlast(&eph->node, &g_epoll_heads);
+	epoll_semgive(&g_epoll_sem);
+	return fd;
+
+errout_with_eph:
+	sem_destroy(&eph->sem);
+	sem_destroy(&eph->exclsem);
+	kmm_free(eph);
+
+errout:
+	set_errno(errcode);
+	return ERROR;
+}
+
+/****************************************************************************
+ * Name: epoll_create
+ *
+ * Description:
+ *   Create an epoll instance.  size must be positive but is otherwise
+ *   ignored; the interest list grows on demand.
+ *
+ ****************************************************************************/
+
+int epoll_create(int size)
+{
+	if (size <= 0) {
+		set_errno(EINVAL);
+		return ERROR;
+	}
+
+	return epoll_create1(0);
+}
+
+/****************************************************************************
+ * Name: epoll_ctl
+ *
+ * Description:
+ *   Add, modify or remove a descriptor in the interest list of epfd.
+ *
+ * Input Parameters:
+ *   epfd - The epoll descriptor
+ *   op   - EPOLL_CTL_ADD, EPOLL_CTL_MOD or EPOLL_CTL_DEL
+ *   fd   - The target file or socket descriptor
+ *   ev   - The requested events and user data (ignored for EPOLL_CTL_DEL)
+ *
+ * Returned Value:
+ *   Zero (OK) on success; ERROR with errno set on failure:
+ *
+ *   EBADF  - epfd is not an epoll descriptor
+ *   EEXIST - EPOLL_CTL_ADD and fd is already registered
+ *   EINVAL - Invalid op, fd is epfd, or ev is NULL
+ *   ENOENT - EPOLL_CTL_MOD/DEL and fd is not registered
+ *   ENOMEM - Out of memory
+ *   Any error returned by the driver poll setup (e.g. EBADF, ENOSYS)
+ *
+ ****************************************************************************/
+
+int epoll_ctl(int epfd, int op, int fd, FAR struct epoll_event *ev)
+{
+	FAR struct epoll_head_s *eph;
+	FAR struct epoll_entry_s *ep;
+	int ret = OK;
+
+	eph = epoll_gethead(epfd);
+	if (eph == NULL) {
+		set_errno(EBADF);
+		return ERROR;
+	}
+
+	if (fd == epfd || fd < 0 || (op != EPOLL_CTL_DEL && ev == NULL)) {
+		set_errno(EINVAL);
+		return ERROR;
+	}
+
+	epoll_semtake(&eph->exclsem);
+	ep = epoll_find(eph, fd);
+
+	switch (op) {
+	case EPOLL_CTL_ADD:
+		if (ep != NULL) {
+			ret = -EEXIST;
+			break;
+		}
+
+		ep = (FAR struct epoll_entry_s *)kmm_zalloc(sizeof(struct epoll_entry_s));
+		if (ep == NULL) {
+			ret = -ENOMEM;
+			break;
+		}
+
+		ep->pfd.fd = fd;
+		ep->events = ev->events;
+		ep->data = ev->data;
+
+		if ((unsigned int)fd < CONFIG_NFILE_DESCRIPTORS) {
+			ret = fs_getfilep(fd, &ep->filep);
+			if (ret == OK && ep->filep->f_inode == NULL) {
+				ret = -EBADF;
+			}
+		}
+
+		if (ret == OK) {
+			ret = epoll_arm(eph, ep);
+		}
+
+		if (ret < 0) {
+			kmm_free(ep);
+			break;
+		}
+
+		dq_addlast(&ep->node, &eph->entries);
+		break;
+
+	case EPOLL_CTL_MOD:
+		if (ep == NULL) {
+			ret = -ENOENT;
+			break;
+		}
+
+		/* Re-arm with the new event mask; this also re-enables a disarmed
+		 * EPOLLONESHOT entry.
+		 */
+
+		epoll_disarm(ep);
+		ep->events = ev->events;
+		ep->data = ev->data;
+		ret = epoll_arm(eph, ep);
+		break;
+
+	case EPOLL_CTL_DEL:
+		if (ep == NULL) {
+			ret = -ENOENT;
+			break;
+		}
+
+		epoll_disarm(ep);
+		dq_rem(&ep->node, &eph->entries);
+		kmm_free(ep);
+		break;
+
+	default:
+		ret = -EINVAL;
+		break;
+	}
+
+	epoll_semgive(&eph->exclsem);
+
+	if (ret < 0) {
+		set_errno(-ret);
+		return ERROR;
+	}
+
+	return OK;
+}
+
+/****************************************************************************
+ * Name: epoll_wait
+ *
+ * Description:
+ *   Wait for events on the interest list of epfd.
+ *
+ * Input Parameters:
+ *   epfd      - The epoll descriptor
+ *   events    - Returned events, at most maxevents entries
+ *   maxevents - The capacity of events, must be positive
+ *   timeout   - Upper limit on the time to block in milliseconds.  Zero
+ *               returns immediately and a negative value waits forever.
+ *
+ * Returned Value:
+ *   The number of entries stored in events, zero if the call timed out, or
+ *   ERROR with errno set:
+ *
+ *   EBADF  - epfd is not an epoll descriptor
+ *   EINVAL - maxevents is not positive or events is NULL
+ *   EINTR  - A signal occurred before any requested event
+ *
+ ****************************************************************************/
+
+int epoll_wait(int epfd, FAR struct epoll_event *events, int maxevents, int timeout)
+{
+	FAR struct epoll_head_s *eph;
+	struct timespec abstime;
+	irqstate_t flags;
+	int count;
+	int ret = OK;
+
+	/* epoll_wait() is a cancellation point */
+
+	(void)enter_cancellation_point();
+
+	eph = epoll_gethead(epfd);
+	if (eph == NULL) {
+		ret = -EBADF;
+		goto errout;
+	}
+
+	if (events == NULL || maxevents <= 0) {
+		ret = -EINVAL;
+		goto errout;
+	}
+
+	if (timeout > 0) {
+		time_t sec = timeout / MSEC_PER_SEC;
+		uint32_t nsec = (timeout - MSEC_PER_SEC * sec) * NSEC_PER_MSEC;
+
+		(void)clock_gettime(CLOCK_REALTIME, &abstime);
+		abstime.tv_sec += sec;
+		abstime.tv_nsec += nsec;
+		if (abstime.tv_nsec >= NSEC_PER_SEC) {
+			abstime.tv_sec++;
+			abstime.tv_nsec -= NSEC_PER_SEC;
+		}
+	}
+
+	for (;;) {
+		/* Consume the notifications before scanning so that a post that
+		 * races with the scan leaves the semaphore signalled and the wait
+		 * below returns immediately.
+		 */
+
+		while (sem_trywait(&eph->sem) == OK) {
+		}
+
+		epoll_semtake(&eph->exclsem);
+		count = epoll_collect(eph, events, maxevents);
+		epoll_semgive(&eph->exclsem);
+
+		if (count > 0 || timeout == 0) {
+			break;
+		}
+
+		/* Nothing is ready: wait for a driver notification.  A notification
+		 * may be stale (already consumed by the previous scan), in which
+		 * case the loop simply scans and waits again.
+		 */
+
+		if (timeout > 0) {
+			flags = enter_critical_section();
+			ret = sem_timedwait(&eph->sem, &abstime);
+			leave_critical_section(flags);
+		} else {
+			ret = sem_wait(&eph->sem);
+		}
+
+		if (ret < 0) {
+			ret = -get_errno();
+			if (ret == -ETIMEDOUT) {
+				/* Report anything that arrived with the timeout */
+
+				epoll_semtake(&eph->exclsem);
+				count = epoll_collect(eph, events, maxevents);
+				epoll_semgive(&eph->exclsem);
+				break;
+			}
+
+			goto errout;
+		}
+	}
+
+	leave_cancellation_point();
+	return count;
+
+errout:
+	leave_cancellation_point();
+	set_errno(-ret);
+	return ERROR;
+}
+
+#endif							/* !CONFIG_DISABLE_POLL && CONFIG_NFILE_DESCRIPTORS > 0 */
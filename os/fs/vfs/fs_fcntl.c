@@ -148,7 +148,7 @@ int file_vfcntl(FAR struct file *filep, int cmd, va_list ap)
 		 */
 
 	{
-		ret = filep->f_oflags;
+		ret = filep->f_oflags & ~__FS_O_NOINHERIT;
 	}
 	break;
 
@@ -107,37 +107,6 @@ static int poll_semtake(FAR sem_t *sem)
 	return OK;
 }
 
-/****************************************************************************
- * Name: poll_fdsetup
- *
- * Description:
- *   Configure (or unconfigure) one file/socket descriptor for the poll
- *   operation.  If fds and sem are non-null, then the poll is being setup.
- *   if fds and sem are NULL, then the poll is being torn down.
- *
- ****************************************************************************/
-
-#if CONFIG_NFILE_DESCRIPTORS > 0
-static int poll_fdsetup(int fd, FAR struct pollfd *fds, bool setup)
-{
-	/* Check for a valid file descriptor */
-
-	if ((unsigned int)fd >= CONFIG_NFILE_DESCRIPTORS) {
-		/* Perform the socket ioctl */
-
-#if defined(CONFIG_NET) && CONFIG_NSOCKET_DESCRIPTORS > 0
-		if ((unsigned int)fd < (CONFIG_NFILE_DESCRIPTORS + CONFIG_NSOCKET_DESCRIPTORS)) {
-			return net_poll(fd, fds, setup);
-		} else
-#endif
-		{
-			return -EBADF;
-		}
-	}
-
-	return fdesc_poll(fd, fds, setup);
-}
-#endif
 
 /****************************************************************************
  * Name: poll_setup
@@ -249,6 +218,39 @@ static inline int poll_teardown(FAR struct pollfd *fds, nfds_t nfds, int *count,
  * Public Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: poll_fdsetup
+ *
+ * Description:
+ *   Configure (or unconfigure) one file/socket descriptor for the poll
+ *   operation.  Socket descriptors are routed to net_poll() and all other
+ *   descriptors to fdesc_poll().  Used by poll() and by epoll_ctl(), which
+ *   keeps descriptors set up across waits.
+ *
+ ****************************************************************************/
+
+#if CONFIG_NFILE_DESCRIPTORS > 0
+int poll_fdsetup(int fd, FAR struct pollfd *fds, bool setup)
+{
+	/* Check for a valid file descriptor */
+
+	if ((unsigned int)fd >= CONFIG_NFILE_DESCRIPTORS) {
+		/* Perform the socket ioctl */
+
+#if defined(CONFIG_NET) && CONFIG_NSOCKET_DESCRIPTORS > 0
+		if ((unsigned int)fd < (CONFIG_NFILE_DESCRIPTORS + CONFIG_NSOCKET_DESCRIPTORS)) {
+			return net_poll(fd, fds, setup);
+		} else
+#endif
+		{
+			return -EBADF;
+		}
+	}
+
+	return fdesc_poll(fd, fds, setup);
+}
+#endif
+
 /****************************************************************************
  * Name: file_poll
  *
@@ -16,7 +16,7 @@
  *
  ****************************************************************************/
 /************************************************************************
- * libc/misc/lib_sendfile.c
+ * fs/vfs/fs_sendfile.c
  *
  *   Copyright (C) 2007, 2009, 2011, 2013 Gregory Nutt. All rights reserved.
  *   Author: Gregory Nutt <gnutt@nuttx.org>
@@ -58,110 +58,45 @@
 
 #include <sys/sendfile.h>
 #include <stdbool.h>
-#include <stdlib.h>
 #include <unistd.h>
+#include <fcntl.h>
 #include <errno.h>
 #include <limits.h>
 
-#include "lib_internal.h"
+#include <tinyara/kmalloc.h>
+#include <tinyara/fs/fs.h>
+#ifdef CONFIG_NET_SENDFILE
+#include <tinyara/net/net.h>
+#endif
 
 #if CONFIG_NSOCKET_DESCRIPTORS > 0 || CONFIG_NFILE_DESCRIPTORS > 0
 
-/************************************************************************
- * Private types
- ************************************************************************/
-
-/************************************************************************
- * Private Variables
- ************************************************************************/
-
-/************************************************************************
- * Public Variables
- ************************************************************************/
-
 /************************************************************************
  * Private Functions
  ************************************************************************/
 
 /************************************************************************
- * Public Functions
- ************************************************************************/
-
-/************************************************************************
- * Name: sendfile / lib_sendfile
+ * Name: sendfile_copy
  *
  * Description:
- *   sendfile() copies data between one file descriptor and another.
- *   sendfile() basically just wraps a sequence of reads() and writes()
- *   to perform a copy.  It serves a purpose in systems where there is
- *   a penalty for copies to between user and kernal space, but really
- *   nothing in TinyAra but provide some Linux compatible (and adding
- *   another 'almost standard' interface).
- *
- *   NOTE: This interface is *not* specified in POSIX.1-2001, or other
- *   standards.  The implementation here is very similar to the Linux
- *   sendfile interface.  Other UNIX systems implement sendfile() with
- *   different semantics and prototypes.  sendfile() should not be used
- *   in portable programs.
- *
- * Input Parmeters:
- *   infd   - A file (or socket) descriptor opened for reading
- *   outfd  - A descriptor opened for writing.
- *   offset - If 'offset' is not NULL, then it points to a variable
- *            holding the file offset from which sendfile() will start
- *            reading data from 'infd'.  When sendfile() returns, this
- *            variable will be set to the offset of the byte following
- *            the last byte that was read.  If 'offset' is not NULL,
- *            then sendfile() does not modify the current file offset of
- *            'infd'; otherwise the current file offset is adjusted to
- *            reflect the number of bytes read from 'infd.'
- *
- *            If 'offset' is NULL, then data will be read from 'infd'
- *            starting at the current file offset, and the file offset
- *            will be updated by the call.
- *   count -  The number of bytes to copy between the file descriptors.
- *
- * Returned Value:
- *   If the transfer was successful, the number of bytes written to outfd is
- *   returned.  On error, -1 is returned, and errno is set appropriately.
- *   There error values are those returned by read() or write() plus:
- *
- *   EINVAL - Bad input parameters.
- *   ENOMEM - Could not allocated an I/O buffer
+ *   Copy 'count' bytes from infd to outfd through a bounce buffer.  This
+ *   works for any pair of descriptors.
  *
  ************************************************************************/
 
-ssize_t sendfile(int outfd, int infd, off_t *offset, size_t count)
+static ssize_t sendfile_copy(int outfd, int infd, size_t count)
 {
 	FAR uint8_t *iobuffer;
 	FAR uint8_t *wrbuffer;
-	off_t startpos = 0;
 	ssize_t nbytesread;
 	size_t read_buf_size;
 	ssize_t nbyteswritten;
 	ssize_t ntransferred;
 	bool endxfr;
 
-	/* Get the current file position. */
-
-	if (offset) {
-		/* Use lseek to get the current file position */
-
-		startpos = lseek(infd, 0, SEEK_CUR);
-		if (startpos == (off_t)-1) {
-			return ERROR;
-		}
-
-		/* Use lseek again to set the new file position */
-
-		if (lseek(infd, *offset, SEEK_SET) == (off_t)-1) {
-			return ERROR;
-		}
-	}
-
 	/* Allocate an I/O buffer */
 
-	iobuffer = (FAR void *)lib_malloc(CONFIG_LIB_SENDFILE_BUFSIZE);
+	iobuffer = (FAR void *)kmm_malloc(CONFIG_LIB_SENDFILE_BUFSIZE);
 	if (!iobuffer) {
 		set_errno(ENOMEM);
 		return ERROR;
@@ -281,7 +216,132 @@ ssize_t sendfile(int outfd, int infd, off_t *offset, size_t count)
 
 	/* Release the I/O buffer */
 
-	lib_free(iobuffer);
+	kmm_free(iobuffer);
+	return ntransferred;
+}
+
+/************************************************************************
+ * Name: sendfile_socket
+ *
+ * Description:
+ *   Let the network stack read the file straight into its send buffer
+ *   when outfd is a socket and infd a file.
+ *
+ * Returned Value:
+ *   The number of bytes sent, or -1 with errno set.  ENOSYS means that
+ *   the socket can not take the file directly and nothing was read.
+ *
+ ************************************************************************/
+
+#if defined(CONFIG_NET_SENDFILE) && CONFIG_NFILE_DESCRIPTORS > 0 && CONFIG_NSOCKET_DESCRIPTORS > 0
+static ssize_t sendfile_socket(int outfd, int infd, size_t count)
+{
+	FAR struct file *filep;
+	int ret;
+
+	if ((unsigned int)outfd < CONFIG_NFILE_DESCRIPTORS || (unsigned int)infd >= CONFIG_NFILE_DESCRIPTORS) {
+		set_errno(ENOSYS);
+		return ERROR;
+	}
+
+	ret = fs_getfilep(infd, &filep);
+	if (ret < 0) {
+		set_errno(-ret);
+		return ERROR;
+	}
+
+	if ((filep->f_oflags & O_RDOK) == 0) {
+		set_errno(EBADF);
+		return ERROR;
+	}
+
+	return net_sendfile(outfd, filep, count);
+}
+#endif
+
+/************************************************************************
+ * Public Functions
+ ************************************************************************/
+
+/************************************************************************
+ * Name: sendfile
+ *
+ * Description:
+ *   sendfile() copies data between one file descriptor and another.
+ *   When the output is a TCP socket and the input a file, the data is
+ *   read straight into the send buffer of the network stack (see
+ *   CONFIG_NET_SENDFILE).  Otherwise sendfile() wraps a sequence of
+ *   reads() and writes() with a kernel buffer, which still saves the
+ *   copy through a user buffer and the system calls per block.
+ *
+ *   NOTE: This interface is *not* specified in POSIX.1-2001, or other
+ *   standards.  The implementation here is very similar to the Linux
+ *   sendfile interface.  Other UNIX systems implement sendfile() with
+ *   different semantics and prototypes.  sendfile() should not be used
+ *   in portable programs.
+ *
+ * Input Parmeters:
+ *   infd   - A file (or socket) descriptor opened for reading
+ *   outfd  - A descriptor opened for writing.
+ *   offset - If 'offset' is not NULL, then it points to a variable
+ *            holding the file offset from which sendfile() will start
+ *            reading data from 'infd'.  When sendfile() returns, this
+ *            variable will be set to the offset of the byte following
+ *            the last byte that was read.  If 'offset' is not NULL,
+ *            then sendfile() does not modify the current file offset of
+ *            'infd'; otherwise the current file offset is adjusted to
+ *            reflect the number of bytes read from 'infd.'
+ *
+ *            If 'offset' is NULL, then data will be read from 'infd'
+ *            starting at the current file offset, and the file offset
+ *            will be updated by the call.
+ *   count -  The number of bytes to copy between the file descriptors.
+ *
+ * Returned Value:
+ *   If the transfer was successful, the number of bytes written to outfd is
+ *   returned.  On error, -1 is returned, and errno is set appropriately.
+ *   There error values are those returned by read() or write() plus:
+ *
+ *   EINVAL - Bad input parameters.
+ *   ENOMEM - Could not allocated an I/O buffer
+ *
+ ************************************************************************/
+
+ssize_t sendfile(int outfd, int infd, off_t *offset, size_t count)
+{
+	off_t startpos = 0;
+	ssize_t ntransferred;
+
+	/* Get the current file position. */
+
+	if (offset) {
+		/* Use lseek to get the current file position */
+
+		startpos = lseek(infd, 0, SEEK_CUR);
+		if (startpos == (off_t)-1) {
+			return ERROR;
+		}
+
+		/* Use lseek again to set the new file position */
+
+		if (lseek(infd, *offset, SEEK_SET) == (off_t)-1) {
+			return ERROR;
+		}
+	}
+
+#if defined(CONFIG_NET_SENDFILE) && CONFIG_NFILE_DESCRIPTORS > 0 && CONFIG_NSOCKET_DESCRIPTORS > 0
+	/* Try the path without a bounce buffer first.  Clear errno so that only
+	 * an ENOSYS reported by that path selects the copy, never one left over
+	 * from an earlier call.
+	 */
+
+	set_errno(OK);
+	ntransferred = sendfile_socket(outfd, infd, count);
+	if (ntransferred < 0 && get_errno() == ENOSYS)
+#endif
+	{
+		ntransferred = sendfile_copy(outfd, infd, count);
+	}
 
 	/* Return the current file position */
 
@@ -95,6 +95,21 @@ struct mq_attr {
 
 typedef FAR struct mq_des *mqd_t;
 
+#ifdef CONFIG_MQ_REFERENCE
+/* The message queued by mq_sendref(): a reference to a buffer obtained
+ * with mq_refalloc().  A queue used with mq_sendref() must be opened with
+ * mq_msgsize of at least MQ_REF_MSGSIZE.
+ */
+
+/** @brief reference to a message buffer passed by mq_sendref() */
+struct mq_ref_s {
+	FAR void *buffer;			/* Buffer from mq_refalloc() */
+	size_t buflen;				/* Number of valid bytes in the buffer */
+};
+
+#define MQ_REF_MSGSIZE sizeof(struct mq_ref_s)
+#endif
+
 /********************************************************************************
  * Public Data
  ********************************************************************************/
@@ -189,6 +204,48 @@ int mq_setattr(mqd_t mqdes, FAR const struct mq_attr *mq_stat, FAR struct mq_att
  */
 int mq_getattr(mqd_t mqdes, FAR struct mq_attr *mq_stat);
 
+#ifdef CONFIG_MQ_REFERENCE
+/**
+ * @brief allocate a buffer for mq_sendref()
+ * @details @b #include <mqueue.h> \n
+ * TizenRT API \n
+ * The buffer comes from a shared pool of CONFIG_MQ_REFERENCE_NBUFFERS
+ * buffers of CONFIG_MQ_REFERENCE_BUFSIZE bytes, or from the heap when the
+ * pool is exhausted or size is larger.  Returns NULL with errno ENOMEM on
+ * failure.
+ * @since TizenRT v4.1
+ */
+FAR void *mq_refalloc(size_t size);
+/**
+ * @brief release a buffer from mq_refalloc() or mq_receiveref()
+ * @details @b #include <mqueue.h> \n
+ * TizenRT API
+ * @since TizenRT v4.1
+ */
+void mq_reffree(FAR void *buffer);
+/**
+ * @brief send a message by reference
+ * @details @b #include <mqueue.h> \n
+ * TizenRT API \n
+ * Queues a struct mq_ref_s for buffer instead of copying buflen bytes.
+ * On success the buffer belongs to the receiver; on failure it still
+ * belongs to the caller.  Returns as mq_send().
+ * @since TizenRT v4.1
+ */
+int mq_sendref(mqd_t mqdes, FAR void *buffer, size_t buflen, int prio);
+/**
+ * @brief receive a message sent with mq_sendref()
+ * @details @b #include <mqueue.h> \n
+ * TizenRT API \n
+ * Stores the buffer in *buffer and returns its length, or -1 with errno
+ * set as by mq_receive().  A message that is not MQ_REF_MSGSIZE bytes
+ * long is discarded and fails with EBADMSG, so the queue should carry only
+ * references.  The caller must release the buffer with mq_reffree().
+ * @since TizenRT v4.1
+ */
+ssize_t mq_receiveref(mqd_t mqdes, FAR void **buffer, FAR int *prio);
+#endif
+
 #undef EXTERN
 #ifdef __cplusplus
 }
@@ -0,0 +1,154 @@
+/****************************************************************************
+ *
+ * Copyright 2025 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+/****************************************************************************
+ * include/sys/epoll.h
+ *
+ * Persistent, Linux-style event notification on top of the poll() driver
+ * hooks.  Descriptors are registered once with epoll_ctl() and stay armed
+ * across epoll_wait() calls, so the cost of a wait is proportional to the
+ * number of descriptors that became ready rather than to the size of the
+ * interest list.
+ *
+ ****************************************************************************/
+
+#ifndef __INCLUDE_SYS_EPOLL_H
+#define __INCLUDE_SYS_EPOLL_H
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <tinyara/config.h>
+
+#include <stdint.h>
+#include <poll.h>
+
+/****************************************************************************
+ * Pre-Processor Definitions
+ ****************************************************************************/
+
+/* Valid opcodes to issue to epoll_ctl() */
+
+#define EPOLL_CTL_ADD   1		/* Add a file descriptor to the interface */
+#define EPOLL_CTL_DEL   2		/* Remove a file descriptor from the interface */
+#define EPOLL_CTL_MOD   3		/* Change file descriptor epoll_event structure */
+
+/* Event types.  These share their values with the poll() event bits so that
+ * the driver poll methods can be used unchanged.
+ */
+
+#define EPOLLIN         POLLIN
+#define EPOLLPRI        POLLPRI
+#define EPOLLOUT        POLLOUT
+#define EPOLLRDNORM     POLLRDNORM
+#define EPOLLWRNORM     POLLWRNORM
+#define EPOLLERR        POLLERR
+#define EPOLLHUP        POLLHUP
+
+/* Event modifiers */
+
+#define EPOLLONESHOT    (1u << 30)	/* Disarm after the first reported event */
+#define EPOLLET         (1u << 31)	/* Report only new events (edge-triggered) */
+
+/* Flags for epoll_create1().  There is no exec(), an EPOLL_CLOEXEC
+ * descriptor is instead not inherited by child tasks.
+ */
+
+#define EPOLL_CLOEXEC   0x80000
+
+/****************************************************************************
+ * Public Type Definitions
+ ****************************************************************************/
+
+typedef union epoll_data {
+	FAR void *ptr;
+	int fd;
+	uint32_t u32;
+} epoll_data_t;
+
+struct epoll_event {
+	uint32_t events;			/* Epoll events (EPOLL*) */
+	epoll_data_t data;			/* User data returned with the event */
+};
+
+/****************************************************************************
+ * Public Function Prototypes
+ ****************************************************************************/
+
+#undef EXTERN
+#if defined(__cplusplus)
+#define EXTERN extern "C"
+extern "C" {
+#else
+#define EXTERN extern
+#endif
+
+/****************************************************************************
+ * Name: epoll_create
+ *
+ * Description:
+ *   Create an epoll instance and return a file descriptor referring to it.
+ *   The size argument is only a hint for the initial interest list capacity;
+ *   the list grows on demand.  The instance is released with close().
+ *
+ ****************************************************************************/
+
+int epoll_create(int size);
+
+/****************************************************************************
+ * Name: epoll_create1
+ *
+ * Description:
+ *   Same as epoll_create() without the size hint.  flags may be zero or
+ *   EPOLL_CLOEXEC, which keeps the descriptor from being inherited by
+ *   child tasks.
+ *
+ ****************************************************************************/
+
+int epoll_create1(int flags);
+
+/****************************************************************************
+ * Name: epoll_ctl
+ *
+ * Description:
+ *   Add, modify or remove a descriptor in the interest list of the epoll
+ *   instance epfd.  Closing a registered descriptor removes it from the
+ *   interest list.
+ *
+ ****************************************************************************/
+
+int epoll_ctl(int epfd, int op, int fd, FAR struct epoll_event *ev);
+
+/****************************************************************************
+ * Name: epoll_wait
+ *
+ * Description:
+ *   Wait up to timeout milliseconds (forever if negative) for an event on
+ *   any descriptor in the interest list of epfd.  Returns the number of
+ *   entries stored in events, zero on timeout, or ERROR with errno set.
+ *
+ ****************************************************************************/
+
+int epoll_wait(int epfd, FAR struct epoll_event *events, int maxevents, int timeout);
+
+#undef EXTERN
+#if defined(__cplusplus)
+}
+#endif
+
+#endif							/* __INCLUDE_SYS_EPOLL_H */
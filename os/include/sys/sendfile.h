@@ -91,11 +91,11 @@ extern "C" {
  *
  * Description:
  *   sendfile() copies data between one file descriptor and another.
- *   sendfile() basically just wraps a sequence of reads() and writes()
- *   to perform a copy.  It serves a purpose in systems where there is
- *   a penalty for copies to between user and kernal space, but really
- *   nothing in TinyAra but provide some Linux compatible (and adding
- *   another 'almost standard' interface).
+ *   When the output is a TCP socket and the input a file, the data is
+ *   read straight into the send buffer of the network stack (see
+ *   CONFIG_NET_SENDFILE).  Otherwise sendfile() wraps a sequence of
+ *   reads() and writes() with a kernel buffer, which still saves the
+ *   copy through a user buffer and the system calls per block.
  *
  *   NOTE: This interface is *not* specified in POSIX.1-2001, or other
  *   standards.  The implementation here is very similar to the Linux
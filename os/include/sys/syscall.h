@@ -256,7 +256,16 @@
 #define SYS_umount                     (__SYS_mountpoint + 5)
 #define SYS_unlink                     (__SYS_mountpoint + 6)
 #define SYS_ftruncate                  (__SYS_mountpoint + 7)
-#define __SYS_shm                      (__SYS_mountpoint + 8)
+#define SYS_sendfile                   (__SYS_mountpoint + 8)
+#define __SYS_epoll                    (__SYS_mountpoint + 9)
+
+/* Persistent poll interfaces */
+
+#define SYS_epoll_create               (__SYS_epoll + 0)
+#define SYS_epoll_create1              (__SYS_epoll + 1)
+#define SYS_epoll_ctl                  (__SYS_epoll + 2)
+#define SYS_epoll_wait                 (__SYS_epoll + 3)
+#define __SYS_shm                      (__SYS_epoll + 4)
 
 /* Shared memory interfaces */
 
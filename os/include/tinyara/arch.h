@@ -1833,6 +1833,33 @@ char up_romgetc(FAR const char *ptr);
 #define up_romgetc(ptr) (*ptr)
 #endif
 
+/****************************************************************************
+ * Name: up_crc32part
+ *
+ * Description:
+ *   If CONFIG_ARCH_CRC32 is defined, then the architecture logic must
+ *   export the function up_crc32part().  crc32part() passes buffers of at
+ *   least CONFIG_ARCH_CRC32_MINLEN bytes to the CRC accelerator through it.
+ *   The result must be identical to crc32part() (reflected polynomial
+ *   0xedb88320, initial and final inversion).
+ *
+ * Input Parameters:
+ *   src      - The data to checksum
+ *   len      - The number of bytes in 'src'
+ *   crc32val - The CRC of the preceding parts, 0 for the first part
+ *   result   - The location to return the updated CRC
+ *
+ * Returned Value:
+ *   OK on success.  A negated errno value if the accelerator cannot be used
+ *   right now (busy, unsuitable buffer, ...), crc32part() then falls back
+ *   to the software implementation.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_ARCH_CRC32
+int up_crc32part(FAR const uint8_t *src, size_t len, uint32_t crc32val, FAR uint32_t *result);
+#endif
+
 /****************************************************************************
  * Name: up_mdelay and up_udelay
  *
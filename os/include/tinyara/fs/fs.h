@@ -86,6 +86,14 @@
 #define __FS_FLAG_ERROR (1 << 1)	/* Error detected by any operation */
 #define __FS_FLAG_LBF   (1 << 2)       /* Line buffered */
 #define __FS_FLAG_UBF   (1 << 3)       /* Buffer allocated by caller of setvbuf */
+
+/* Internal flag in f_oflags, above the open() flags of <fcntl.h>: the
+ * descriptor is not duplicated into child tasks.  It is the counterpart of
+ * close-on-exec, e.g. EPOLL_CLOEXEC, and is cleared by dup() and dup2().
+ */
+
+#define __FS_O_NOINHERIT (1 << 9)	/* _O_MAXBIT + 1 */
+
 #ifndef CONFIG_MOUNT_POINT
 #define CONFIG_MOUNT_POINT "/mnt/"
 #endif
@@ -156,6 +164,15 @@ struct geometry {
 	char geo_model[NAME_MAX + 1];
 };
 
+/* Sector cache configuration of a BCH character device (DIOC_SETCACHE) */
+
+struct bch_cacheconfig_s {
+	uint16_t nsectors;			/* Number of cached sectors (>= 1) */
+	uint16_t readahead;			/* Extra sectors read on a sequential miss */
+	bool writeback;				/* true: Write dirty sectors only on eviction,
+								 * close or reconfiguration */
+};
+
 /* This structure is provided by block devices when they register with the
  * system.  It is used by file systems to perform filesystem transfers.  It
  * differs from the normal driver vtable in several ways -- most notably in
@@ -1028,6 +1045,46 @@ int file_poll(FAR struct file *filep, FAR struct pollfd *fds, bool setup);
 
 int fdesc_poll(int fd, FAR struct pollfd *fds, bool setup);
 
+/****************************************************************************
+ * Name: poll_fdsetup
+ *
+ * Description:
+ *   Set up or tear down the poll of one file or socket descriptor.  Socket
+ *   descriptors are routed to net_poll(), all others to fdesc_poll().
+ *
+ * Input Parameters:
+ *   fd    - The file or socket descriptor of interest
+ *   fds   - The structure describing the events to be monitored
+ *   setup - true: Setup up the poll; false: Teardown the poll
+ *
+ * Returned Value:
+ *  0: Success; Negated errno on failure
+ *
+ ****************************************************************************/
+
+#if CONFIG_NFILE_DESCRIPTORS > 0
+int poll_fdsetup(int fd, FAR struct pollfd *fds, bool setup);
+#endif
+
+/****************************************************************************
+ * Name: epoll_detach
+ *
+ * Description:
+ *   Tear down and remove the epoll entries registered on a descriptor that
+ *   is being closed, so that no driver keeps a pointer to a freed entry.
+ *
+ * Input Parameters:
+ *   filep - The file being closed, or NULL for a socket descriptor
+ *   fd    - The socket descriptor of the calling task when filep is NULL
+ *
+ ****************************************************************************/
+
+#if !defined(CONFIG_DISABLE_POLL) && CONFIG_NFILE_DESCRIPTORS > 0
+void epoll_detach(FAR struct file *filep, int fd);
+#else
+#define epoll_detach(filep, fd)
+#endif
+
 /* fs/driver/block/fs_blockproxy.c ******************************************/
 /****************************************************************************
  * Name: unique_chardev_initialize
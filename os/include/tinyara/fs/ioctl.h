@@ -189,6 +189,11 @@
 										 * OUT: None
 										 */
 
+#define DIOC_SETCACHE   _DIOC(0x0005)	/* IN:  Pointer to struct bch_cacheconfig_s
+										 * OUT: None. Dirty sectors are
+										 *      flushed before the change.
+										 */
+
 /* TinyAra block driver ioctl definitions *************************************/
 
 #define _BIOCVALID(c)   (_IOC_TYPE(c) == _BIOCBASE)
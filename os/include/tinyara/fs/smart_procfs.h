@@ -113,6 +113,12 @@ struct mtd_smart_procfs_data_s {
 #ifdef CONFIG_MTD_SMART_WEAR_LEVEL
 	uint32_t uneven_wearcount;	/* Number of uneven block erases */
 #endif
+#ifdef CONFIG_MTD_SMART_ALLOC_STATS
+	uint32_t allocsearches;		/* Number of free sector searches */
+	uint32_t allocreads;		/* Sector headers read by those searches */
+	uint16_t allocmaxreads;		/* Most headers read by a single search */
+	uint32_t allocfallbacks;	/* Searches that had to scan a whole block */
+#endif
 };
 
 /* The following defines debug command data passed from the procfs layer to
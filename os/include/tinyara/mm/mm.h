@@ -70,6 +70,9 @@
 #endif
 
 #include <tinyara/sched.h>
+#if defined(CONFIG_MM_PERCPU_CACHE) && defined(CONFIG_SMP)
+#include <tinyara/spinlock.h>
+#endif
 /****************************************************************************
  * Pre-Processor Definitions
  ****************************************************************************/
@@ -318,6 +321,29 @@ struct mm_delaynode_s
 	FAR struct mm_delaynode_s *flink;
 };
 
+#ifdef CONFIG_MM_PERCPU_CACHE
+/* Small chunks released by mm_free() are parked in a per-CPU cache, one
+ * singly linked list per chunk size class, so that the next mm_malloc() of
+ * the same size class can be served without the heap semaphore.  Cached
+ * chunks keep MM_ALLOC_BIT set and reuse the payload for the list link.
+ */
+
+#define MM_CACHE_MAXCHUNK  MM_ALIGN_UP(CONFIG_MM_PERCPU_CACHE_MAXSIZE + SIZEOF_MM_ALLOCNODE)
+#define MM_CACHE_NCLASSES  (MM_CACHE_MAXCHUNK >> MM_MIN_SHIFT)
+#define MM_CACHE_NDX(s)    (((s) >> MM_MIN_SHIFT) - 1)
+
+struct mm_cache_s {
+#ifdef CONFIG_SMP
+	volatile spinlock_t lock;
+#endif
+	FAR struct mm_delaynode_s *head[MM_CACHE_NCLASSES];
+	uint8_t count[MM_CACHE_NCLASSES];
+	uint32_t hits;
+	uint32_t misses;
+	uint32_t flushes;
+};
+#endif
+
 #ifdef CONFIG_DEBUG_MM_HEAPINFO
 struct heapinfo_tcb_info_s {
 	int pid;
@@ -401,6 +427,11 @@ struct mm_heap_s {
 
 	FAR struct mm_delaynode_s *mm_delaylist[CONFIG_SMP_NCPUS];
 
+#ifdef CONFIG_MM_PERCPU_CACHE
+	/* Per-CPU cache of small chunks, see mm_cache.c */
+
+	struct mm_cache_s mm_cache[CONFIG_SMP_NCPUS];
+#endif
 };
 
 /****************************************************************************
@@ -657,6 +688,21 @@ void mm_addfreechunk(FAR struct mm_heap_s *heap, FAR struct mm_freenode_s *node)
 
 int mm_size2ndx(size_t size);
 
+#ifdef CONFIG_MM_PERCPU_CACHE
+/* Functions contained in mm_cache.c ****************************************/
+
+void mm_cache_initialize(FAR struct mm_heap_s *heap);
+FAR void *mm_cache_alloc(FAR struct mm_heap_s *heap, size_t size, mmaddress_t caller_retaddr);
+bool mm_cache_free(FAR struct mm_heap_s *heap, FAR void *mem);
+void mm_cache_flush(FAR struct mm_heap_s *heap);
+void mm_cache_trim(FAR struct mm_heap_s *heap, size_t threshold);
+void mm_cache_flush_all(size_t threshold);
+#endif
+
+/* Functions contained in mm_free.c *****************************************/
+
+void mm_free_nocache(FAR struct mm_heap_s *heap, FAR void *mem);
+
 void mm_dump_node(struct mm_allocnode_s *node, char *node_type);
 void mm_dump_heap_region(uint32_t start, uint32_t end);
 void mm_dump_heap_free_node_list(struct mm_heap_s *heap);
@@ -701,6 +747,9 @@ void mm_remove_app_heap_list(struct mm_heap_s *heap);
 void mm_disable_app_heap_list(struct mm_heap_s *heap);
 struct mm_heap_s *mm_get_app_heap_with_name(char *app_name);
 char *mm_get_app_heap_name(void *address);
+#ifdef CONFIG_MM_PERCPU_CACHE
+void mm_cache_trim_app_heaps(size_t threshold);
+#endif
 #endif
 
 struct mm_heap_s *umm_get_heap(void *address);
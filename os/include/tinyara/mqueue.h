@@ -90,6 +90,10 @@ struct mqueue_inode_s {
 	int16_t nwaitnotfull;		/* Number tasks waiting for not full */
 	int16_t nwaitnotempty;		/* Number tasks waiting for not empty */
 	size_t maxmsgsize;			/* Max size of message in message queue */
+#ifdef CONFIG_MQ_QUEUE_PREALLOC
+	sq_queue_t msgfree;			/* Free messages preallocated for this queue */
+	FAR void *msgslab;			/* Memory of the preallocated messages */
+#endif
 #ifndef CONFIG_DISABLE_SIGNALS
 	FAR struct mq_des *ntmqdes;	/* Notification: Owning mqdes (NULL if none) */
 	pid_t ntpid;				/* Notification: Receiving Task's PID */
@@ -390,6 +390,30 @@ int net_dupsd2(int sockfd1, int sockfd2);
 
 int net_clone(FAR struct socket *psock1, FAR struct socket *psock2);
 
+/****************************************************************************
+ * Function: net_sendfile
+ *
+ * Description:
+ *   Send 'count' bytes of an open file through the socket without a user
+ *   buffer.  This is the socket half of sendfile().  The data is read from
+ *   the current position of the file.
+ *
+ * Parameters:
+ *   sockfd   Socket descriptor of a connected stream socket
+ *   filep    The file to read from
+ *   count    The number of bytes to send
+ *
+ * Returned Value:
+ *   The number of bytes sent; -1 on error with errno set appropriately.
+ *   ENOSYS means that the socket can not take the file directly and
+ *   nothing was read from it, the caller should copy instead.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_SENDFILE
+ssize_t net_sendfile(int sockfd, FAR struct file *filep, size_t count);
+#endif
+
 /****************************************************************************
  * Name: net_vfcntl
  *
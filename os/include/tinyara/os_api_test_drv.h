@@ -87,6 +87,9 @@
 #if defined(CONFIG_AUTOMOUNT_USERFS) && defined(CONFIG_EXAMPLES_TESTCASE_FILESYSTEM)
 #define TESTIOC_GET_FS_PARTNO			_TESTIOC(24)
 #endif
+#ifdef CONFIG_EXAMPLES_LWIP_MBOX_PERFORMANCE
+#define TESTIOC_NET_MBOX_PERF			_TESTIOC(25)
+#endif
 
 #define OS_API_TEST_DRVPATH	"/dev/os_api_test"
 
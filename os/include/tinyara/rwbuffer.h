@@ -69,6 +69,10 @@
  * Pre-processor Definitions
  **********************************************************************/
 
+#ifndef CONFIG_DRVR_RHSTREAMS
+#define CONFIG_DRVR_RHSTREAMS 2
+#endif
+
 /**********************************************************************
  * Public Types
  **********************************************************************/
@@ -81,6 +85,15 @@
 typedef ssize_t (*rwbreload_t)(FAR void *dev, FAR uint8_t *buffer, off_t startblock, size_t nblocks);
 typedef ssize_t (*rwbflush_t)(FAR void *dev, FAR const uint8_t *buffer, off_t startblock, size_t nblocks);
 
+/* A sequential read stream seen by the read-ahead logic */
+
+#ifdef CONFIG_DRVR_READAHEAD
+struct rwb_rhstream_s {
+	off_t next;					/* Block expected next in this stream */
+	uint16_t window;			/* Blocks to read ahead on the next miss */
+};
+#endif
+
 /* This structure holds the state of the buffers.  In typical usage,
  * an instance of this structure is declared within each block driver
  * status structure like:
@@ -151,10 +164,9 @@ struct rwbuffer_s {
 #ifdef CONFIG_DRVR_WRITEBUFFER
 	sem_t wrsem;				/* Enforces exclusive access to the write buffer */
 	struct work_s work;			/* Delayed work to flush buffer after a delay with no activity */
-	uint8_t *wrbuffer;			/* Allocated write buffer */
-	uint16_t wrnblocks;			/* Number of blocks in write buffer */
-	off_t wrblockstart;			/* First block in write buffer */
-	off_t wrexpectedblock;		/* Next block expected */
+	uint8_t *wrbuffer;			/* Allocated write buffer, wrmaxblocks slots */
+	off_t *wrblocks;			/* Block held in each slot of the write buffer */
+	uint16_t wrnblocks;			/* Number of slots in use */
 #endif
 
 	/* This is the state of the read-ahead buffering */
@@ -164,6 +176,8 @@ struct rwbuffer_s {
 	uint8_t *rhbuffer;			/* Allocated read-ahead buffer */
 	uint16_t rhnblocks;			/* Number of blocks in read-ahead buffer */
 	off_t rhblockstart;			/* First block in read-ahead buffer */
+	uint8_t rhnextstream;		/* Stream entry to replace next */
+	struct rwb_rhstream_s rhstreams[CONFIG_DRVR_RHSTREAMS];
 #endif
 };
 
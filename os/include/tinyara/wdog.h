@@ -160,6 +160,11 @@ struct wdog_s {
 	uint8_t flags;				/* See WDOGF_* definitions above */
 	uint8_t argc;				/* The number of parameters to pass */
 	uint32_t parm[CONFIG_MAX_WDOGPARMS];
+#ifdef CONFIG_WDOG_TIMING_WHEEL
+	FAR struct wdog_s *prev;	/* Back link in the timing wheel slot */
+	uint32_t expires;			/* Absolute expiration tick */
+	uint16_t wslot;				/* Timing wheel slot holding this watchdog */
+#endif
 };
 
 /* Watchdog 'handle' */
@@ -289,6 +289,25 @@ struct work_s {
 	clock_t delay;			/* Delay until work performed */
 };
 
+#ifdef CONFIG_SCHED_WORKQUEUE_STATS
+/* Counters of one work queue, see work_getstats().  Times are in clock
+ * ticks.  Latency is measured from the time the work became due (queued
+ * time plus delay) to the time its worker was called.
+ */
+
+struct work_stats_s {
+	uint32_t queued;			/* Work queued */
+	uint32_t completed;			/* Work performed */
+	uint32_t cancelled;			/* Work cancelled before it was performed */
+	uint16_t pending;			/* Work in the queue now */
+	uint16_t maxpending;		/* Most work in the queue at one time */
+	clock_t totlatency;			/* Sum of the latencies of performed work */
+	clock_t maxlatency;			/* Longest latency */
+	clock_t totruntime;			/* Sum of the worker execution times */
+	clock_t maxruntime;			/* Longest worker execution time */
+};
+#endif
+
 /****************************************************************************
  * Public Data
  ****************************************************************************/
@@ -449,6 +468,28 @@ int work_signal(int qid);
 
 #define work_available(work) ((work)->worker == NULL)
 
+/****************************************************************************
+ * Name: work_getstats
+ *
+ * Description:
+ *   Return the latency and throughput counters of a kernel work queue.
+ *
+ * Input parameters:
+ *   qid      - The work queue ID
+ *   stats    - Location to return the counters
+ *   nthreads - Location to return the number of worker threads, may be NULL
+ *
+ * Returned Value:
+ *   Zero on success, a negated errno on failure
+ *
+ *   -EINVAL - An invalid work queue was specified
+ *
+ ****************************************************************************/
+
+#if defined(CONFIG_SCHED_WORKQUEUE_STATS) && (defined(CONFIG_BUILD_FLAT) || defined(__KERNEL__))
+int work_getstats(int qid, FAR struct work_stats_s *stats, FAR int *nthreads);
+#endif
+
 /****************************************************************************
  * Name: lpwork_boostpriority
  *
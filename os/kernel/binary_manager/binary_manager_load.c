@@ -41,6 +41,7 @@
 #include <tinyara/sched.h>
 #include <tinyara/init.h>
 #include <tinyara/kthread.h>
+#include <tinyara/clock.h>
 #ifdef CONFIG_OPTIMIZE_APP_RELOAD_TIME
 #include <tinyara/binfmt/binfmt.h>
 #endif
@@ -115,11 +116,20 @@ static int binary_manager_load_binary(int bin_idx, char *path, load_attr_t *load
 {
 	int ret;
 	int retry_count;
+#ifdef CONFIG_DEBUG_BINMGR_INFO
+	clock_t start_time;
+#endif
 
 	retry_count = 0;
 	while (retry_count < BINMGR_LOADING_TRYCNT) {
+#ifdef CONFIG_DEBUG_BINMGR_INFO
+		start_time = clock_systimer();
+#endif
 		ret = load_binary(bin_idx, path, load_attr);
 		if (ret >= 0) {
+#ifdef CONFIG_DEBUG_BINMGR_INFO
+			bmvdbg("Load time of %s : %d ms\n", load_attr->bin_name, (int)TICK2MSEC(clock_systimer() - start_time));
+#endif
 			/* Set the data in table from header */
 			BIN_LOAD_ATTR(bin_idx) = *load_attr;
 			strncpy(BIN_NAME(bin_idx), load_attr->bin_name, BIN_NAME_MAX);
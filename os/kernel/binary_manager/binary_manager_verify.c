@@ -29,6 +29,7 @@
 #include <tinyara/signature.h>
 #endif
 #include <tinyara/mm/mm.h>
+#include <tinyara/clock.h>
 #include <tinyara/binary_manager.h>
 
 #include "binary_manager_internal.h"
@@ -111,6 +112,12 @@ int binary_manager_read_header(int type, char *devpath, void *header_data, bool
 	uint32_t crc_hash;
 	uint32_t crc_bufsize = 0;
 	int header_size = 0;
+#ifdef CONFIG_DEBUG_BINMGR_INFO
+	clock_t start_time;
+	clock_t crc_start;
+	clock_t crc_time = 0;
+	uint32_t total_size;
+#endif
 
 	if (type < BINARY_KERNEL || type >= BINARY_TYPE_MAX || !header_data) {
 		bmdbg("Invalid parameter, type %d\n", type);
@@ -189,6 +196,10 @@ int binary_manager_read_header(int type, char *devpath, void *header_data, bool
 			goto errout_with_fd;
 		}
 		/* Calculate checksum and Verify it */
+#ifdef CONFIG_DEBUG_BINMGR_INFO
+		start_time = clock_systimer();
+		total_size = bin_size;
+#endif
 		calculate_crc = crc32part((uint8_t *)header_data + CHECKSUM_SIZE, header_size - CHECKSUM_SIZE, calculate_crc);
 		while (bin_size > 0) {
 			read_size = bin_size < crc_bufsize ? bin_size : crc_bufsize;
@@ -198,9 +209,19 @@ int binary_manager_read_header(int type, char *devpath, void *header_data, bool
 				ret = BINMGR_OPERATION_FAIL;
 				goto errout_with_fd;
 			}
+#ifdef CONFIG_DEBUG_BINMGR_INFO
+			crc_start = clock_systimer();
+#endif
 			calculate_crc = crc32part(crc_buffer, read_size, calculate_crc);
+#ifdef CONFIG_DEBUG_BINMGR_INFO
+			crc_time += clock_systimer() - crc_start;
+#endif
 			bin_size -= read_size;
 		}
+#ifdef CONFIG_DEBUG_BINMGR_INFO
+		/* Read and CRC time of the whole image, to compare the crc32() implementations */
+		bmvdbg("CRC check of %s, %u bytes : total %d ms, crc %d ms\n", devpath, total_size, (int)TICK2MSEC(clock_systimer() - start_time), (int)TICK2MSEC(crc_time));
+#endif
 
 		if (calculate_crc != crc_hash) {
 			bmdbg("Fail to crc check : %u != %u\n", calculate_crc, crc_hash);
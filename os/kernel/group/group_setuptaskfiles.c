@@ -129,10 +129,11 @@ static inline void sched_dupfiles(FAR struct task_tcb_s *tcb)
 	for (i = 0; i < NFDS_TOCLONE; i++) {
 		/* Check if this file is opened by the parent.  We can tell if
 		 * if the file is open because it contain a reference to a non-NULL
-		 * i-node structure.
+		 * i-node structure.  Descriptors created close-on-exec are not
+		 * passed on.
 		 */
 
-		if (parent[i].f_inode) {
+		if (parent[i].f_inode && (parent[i].f_oflags & __FS_O_NOINHERIT) == 0) {
 			/* Yes... duplicate it for the child */
 
 			(void)file_dup2(&parent[i], &child[i]);
@@ -86,6 +86,46 @@
  * Private Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: mq_msgslaballoc
+ *
+ * Description:
+ *   Preallocate maxmsgs messages for the new message queue, each with room
+ *   for maxmsgsize bytes of payload.  If the allocation fails, the queue
+ *   works as without CONFIG_MQ_QUEUE_PREALLOC and takes its messages from
+ *   the global pool.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_MQ_QUEUE_PREALLOC
+static void mq_msgslaballoc(FAR struct mqueue_inode_s *msgq)
+{
+	FAR struct mqueue_msg_s *mqmsg;
+	FAR uint8_t *slab;
+	size_t msgsize;
+	int i;
+
+	sq_init(&msgq->msgfree);
+	if (msgq->maxmsgs == 0) {
+		return;
+	}
+
+	msgsize = MQ_MSG_SIZE(msgq->maxmsgsize);
+	slab = (FAR uint8_t *)kmm_malloc(msgsize * msgq->maxmsgs);
+	if (!slab) {
+		return;
+	}
+
+	for (i = 0; i < msgq->maxmsgs; i++) {
+		mqmsg = (FAR struct mqueue_msg_s *)(slab + i * msgsize);
+		mqmsg->type = MQ_ALLOC_QUEUE;
+		sq_addlast((FAR sq_entry_t *)mqmsg, &msgq->msgfree);
+	}
+
+	msgq->msgslab = slab;
+}
+#endif
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -141,6 +181,10 @@ FAR struct mqueue_inode_s *mq_msgqalloc(mode_t mode, FAR struct mq_attr *attr)
 #ifndef CONFIG_DISABLE_SIGNALS
 		msgq->ntpid = INVALID_PROCESS_ID;
 #endif
+
+#ifdef CONFIG_MQ_QUEUE_PREALLOC
+		mq_msgslaballoc(msgq);
+#endif
 	}
 
 	return msgq;
@@ -114,10 +114,18 @@ void mq_msgqfree(FAR struct mqueue_inode_s *msgq)
 		/* Deallocate the message structure. */
 
 		next = curr->next;
-		mq_msgfree(curr);
+		mq_msgfree(msgq, curr);
 		curr = next;
 	}
 
+#ifdef CONFIG_MQ_QUEUE_PREALLOC
+	/* Then the messages that were preallocated for this queue */
+
+	if (msgq->msgslab) {
+		sched_kfree(msgq->msgslab);
+	}
+#endif
+
 	/* Then deallocate the message queue itself */
 
 	sched_kfree(msgq);
@@ -153,8 +153,9 @@ int mq_verifysend(mqd_t mqdes, FAR const char *msg, size_t msglen, int prio)
  *
  * Description:
  *   The mq_msgalloc function will get a free message for use by the
- *   operating system.  The message will be allocated from the g_msgfree
- *   list.
+ *   operating system.  The message will be taken from the messages
+ *   preallocated for msgq if there are any left (CONFIG_MQ_QUEUE_PREALLOC),
+ *   otherwise it will be allocated from the g_msgfree list.
  *
  *   If the list is empty AND the message is NOT being allocated from the
  *   interrupt level, then the message will be allocated.  If a message
@@ -167,7 +168,7 @@ int mq_verifysend(mqd_t mqdes, FAR const char *msg, size_t msglen, int prio)
  *   handler will be notified.
  *
  * Inputs:
- *   None
+ *   msgq - The message queue that the message will be sent to
  *
  * Return Value:
  *   A reference to the allocated msg structure.
@@ -177,11 +178,24 @@ int mq_verifysend(mqd_t mqdes, FAR const char *msg, size_t msglen, int prio)
  *
  ****************************************************************************/
 
-FAR struct mqueue_msg_s *mq_msgalloc(void)
+FAR struct mqueue_msg_s *mq_msgalloc(FAR struct mqueue_inode_s *msgq)
 {
 	FAR struct mqueue_msg_s *mqmsg;
 	irqstate_t saved_state;
 
+#ifdef CONFIG_MQ_QUEUE_PREALLOC
+	/* The queue's own messages are enough unless an interrupt handler sends
+	 * to a full queue.
+	 */
+
+	saved_state = enter_critical_section();
+	mqmsg = (FAR struct mqueue_msg_s *)sq_remfirst(&msgq->msgfree);
+	leave_critical_section(saved_state);
+	if (mqmsg) {
+		return mqmsg;
+	}
+#endif
+
 	/* If we were called from an interrupt handler, then try to get the message
 	 * from generally available list of messages. If this fails, then try the
 	 * list of messages reserved for interrupt handlers
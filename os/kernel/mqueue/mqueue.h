@@ -61,6 +61,7 @@
 #include <tinyara/compiler.h>
 
 #include <sys/types.h>
+#include <stddef.h>
 #include <stdint.h>
 #include <stdbool.h>
 #include <limits.h>
@@ -99,7 +100,8 @@
 enum mqalloc_e {
 	MQ_ALLOC_FIXED = 0,			/* pre-allocated; never freed */
 	MQ_ALLOC_DYN,				/* dynamically allocated; free when unused */
-	MQ_ALLOC_IRQ				/* Preallocated, reserved for interrupt handling */
+	MQ_ALLOC_IRQ,				/* Preallocated, reserved for interrupt handling */
+	MQ_ALLOC_QUEUE				/* Preallocated for one message queue */
 };
 
 /* This structure describes one buffered POSIX message. */
@@ -112,6 +114,13 @@ struct mqueue_msg_s {
 	char mail[MQ_MAX_BYTES];		/* Message data */
 };
 
+/* Size of a message with room for 'n' bytes of payload.  Messages that are
+ * preallocated for one queue only have room for that queue's message size.
+ */
+
+#define MQ_MSG_SIZE(n) \
+	((offsetof(struct mqueue_msg_s, mail) + (n) + sizeof(uintptr_t) - 1) & ~(sizeof(uintptr_t) - 1))
+
 /****************************************************************************
  * Public Variables
  ****************************************************************************/
@@ -155,7 +164,7 @@ void weak_function mq_initialize(void);
 void mq_desblockalloc(void);
 
 FAR struct mqueue_inode_s *mq_findnamed(FAR const char *mq_name);
-void mq_msgfree(FAR struct mqueue_msg_s *mqmsg);
+void mq_msgfree(FAR struct mqueue_inode_s *msgq, FAR struct mqueue_msg_s *mqmsg);
 
 /* mq_waitirq.c ************************************************************/
 
@@ -170,7 +179,7 @@ ssize_t mq_doreceive(mqd_t mqdes, FAR struct mqueue_msg_s *mqmsg, FAR char *ubuf
 /* mq_sndinternal.c ********************************************************/
 
 int mq_verifysend(mqd_t mqdes, FAR const char *msg, size_t msglen, int prio);
-FAR struct mqueue_msg_s *mq_msgalloc(void);
+FAR struct mqueue_msg_s *mq_msgalloc(FAR struct mqueue_inode_s *msgq);
 int mq_waitsend(mqd_t mqdes);
 int mq_dosend(mqd_t mqdes, FAR struct mqueue_msg_s *mqmsg, FAR const char *msg, size_t msglen, int prio);
 
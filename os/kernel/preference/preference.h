@@ -38,4 +38,11 @@ int preference_register_callback(preference_callback_t *data);
 int preference_unregister_callback(const char *key, int type);
 int preference_get_private_keypath(const char *key, char **path);
 void preference_clear_callbacks(pid_t pid);
+#ifdef CONFIG_PREFERENCE_LOG
+int preference_log_write(char *path, preference_data_t *data);
+int preference_log_read(char *path, preference_data_t *data);
+int preference_log_remove(char *path);
+int preference_log_remove_all(const char *dir_path);
+int preference_log_check(char *path, bool *existing);
+#endif
 #endif							/* __KERNEL_PREFERENCE_PREFERENCE_H */
@@ -18,6 +18,7 @@
 /****************************************************************************
  * Included Files
  ****************************************************************************/
+#include <tinyara/config.h>
 #include <stdbool.h>
 #include <debug.h>
 #include <fcntl.h>
@@ -25,9 +26,12 @@
 #include <sys/stat.h>
 #include <tinyara/preference.h>
 
+#include "preference.h"
+
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
+#ifndef CONFIG_PREFERENCE_LOG
 static int preference_check_fs_key(char *path, bool *existing)
 {
 	int ret;
@@ -51,6 +55,7 @@ static int preference_check_fs_key(char *path, bool *existing)
 
 	return OK;
 }
+#endif							/* CONFIG_PREFERENCE_LOG */
 
 /****************************************************************************
  * Public Functions
@@ -79,5 +84,9 @@ int preference_check_key(int type, const char *key, bool *result)
 		}
 	}
 
+#ifdef CONFIG_PREFERENCE_LOG
+	return preference_log_check(path, result);
+#else
 	return preference_check_fs_key(path, result);
+#endif
 }
@@ -0,0 +1,843 @@
+/****************************************************************************
+ *
+ * Copyright 2025 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+#include <tinyara/config.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <limits.h>
+#include <fcntl.h>
+#include <errno.h>
+#include <debug.h>
+#include <assert.h>
+#include <semaphore.h>
+#include <crc32.h>
+#include <sys/stat.h>
+#include <tinyara/clock.h>
+#include <tinyara/fs/fs.h>
+#include <tinyara/hashmap.h>
+#include <tinyara/preference.h>
+#if defined(CONFIG_SCHED_HPWORK) || defined(CONFIG_SCHED_LPWORK)
+#include <tinyara/wqueue.h>
+#endif
+
+#include "preference.h"
+
+#ifdef CONFIG_PREFERENCE_LOG
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+/* All keys live in one append-only log.  Each record holds the full value
+ * of a key, or marks it as removed, so only the last record of a key is in
+ * use.  Records which are no longer in use are dropped by rewriting the log
+ * to PREF_LOG_NEWPATH, then renaming it.
+ */
+#define PREF_LOG_PATH          PREF_PATH"/pref.log"
+#define PREF_LOG_NEWPATH       PREF_PATH"/pref.log.new"
+
+#define PREF_LOG_MAGIC         0x31474c50	/* "PLG1" */
+#define PREF_LOG_OP_SET        1
+#define PREF_LOG_OP_REMOVE     2
+
+#define PREF_LOG_HASHSIZE      64
+#define PREF_LOG_COPYSIZE      256
+
+/* pref_log_scan() found a record cut short by a power loss or a bad CRC */
+#define PREF_LOG_TORN          1
+
+#define PREF_LOG_RECSIZE(e)    (sizeof(struct pref_log_hdr_s) + (e)->namelen + (e)->len)
+
+#if defined(CONFIG_SCHED_HPWORK) || defined(CONFIG_SCHED_LPWORK)
+#define PREF_LOG_WORK
+#endif
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+/* Header of a record, followed by the key name and the value */
+struct pref_log_hdr_s {
+	uint32_t crc;				/* Of the fields below, the name and the value */
+	uint8_t op;
+	uint8_t reserved;
+	uint16_t namelen;
+	int32_t type;
+	int32_t len;
+};
+
+/* In-RAM index entry of a key.  Removed keys are kept until the next
+ * compaction because the hashmap has no way to drop an entry.
+ */
+struct pref_log_entry_s {
+	struct pref_log_entry_s *flink;		/* All entries */
+	struct pref_log_entry_s *hnext;		/* Entries with the same hash value */
+	off_t offset;				/* Record of the current value, -1 if removed */
+	off_t newoffset;			/* Offset in the compacted log */
+	int type;
+	int len;
+	uint16_t namelen;
+	char name[1];
+};
+
+struct pref_log_s {
+	sem_t lock;
+	bool initialized;
+	struct file file;
+	struct hashmap_s *index;
+	struct pref_log_entry_s *entries;
+	off_t size;					/* End of the log */
+	off_t live;					/* Bytes of the records in use */
+	int unsynced;				/* Records appended since the last fsync */
+#ifdef PREF_LOG_WORK
+	struct work_s work;
+#endif
+};
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+static struct pref_log_s g_preflog = {
+	.lock = SEM_INITIALIZER(1),
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+static void pref_log_lock(void)
+{
+	while (sem_wait(&g_preflog.lock) != OK) {
+		ASSERT(get_errno() == EINTR);
+	}
+}
+
+static void pref_log_unlock(void)
+{
+	sem_post(&g_preflog.lock);
+}
+
+/* Keys are stored by their path relative to PREF_PATH */
+static const char *pref_log_name(const char *path)
+{
+	if (strncmp(path, PREF_PATH"/", sizeof(PREF_PATH)) == 0) {
+		return path + sizeof(PREF_PATH);
+	}
+	return path;
+}
+
+static uint32_t pref_log_crc(struct pref_log_hdr_s *hdr, const char *name, const void *value)
+{
+	uint32_t crc;
+
+	crc = crc32((uint8_t *)&hdr->op, sizeof(struct pref_log_hdr_s) - sizeof(uint32_t));
+	crc = crc32part((uint8_t *)name, hdr->namelen, crc);
+	if (hdr->len > 0) {
+		crc = crc32part((uint8_t *)value, hdr->len, crc);
+	}
+	return crc;
+}
+
+static struct pref_log_entry_s *pref_log_find(const char *name, size_t namelen)
+{
+	struct pref_log_entry_s *entry;
+
+	entry = (struct pref_log_entry_s *)hashmap_get(g_preflog.index, hashmap_get_hashval((unsigned char *)name));
+	while (entry) {
+		if (entry->namelen == namelen && memcmp(entry->name, name, namelen) == 0) {
+			break;
+		}
+		entry = entry->hnext;
+	}
+	return entry;
+}
+
+static void pref_log_hash(struct pref_log_entry_s *entry)
+{
+	unsigned long hashval = hashmap_get_hashval((unsigned char *)entry->name);
+
+	entry->hnext = (struct pref_log_entry_s *)hashmap_get(g_preflog.index, hashval);
+	hashmap_insert(g_preflog.index, entry, hashval);
+}
+
+static struct pref_log_entry_s *pref_log_add(const char *name, size_t namelen)
+{
+	struct pref_log_entry_s *entry;
+
+	entry = (struct pref_log_entry_s *)PREFERENCE_ALLOC(sizeof(struct pref_log_entry_s) + namelen);
+	if (entry == NULL) {
+		return NULL;
+	}
+	memcpy(entry->name, name, namelen);
+	entry->name[namelen] = '\0';
+	entry->namelen = namelen;
+	entry->offset = -1;
+
+	pref_log_hash(entry);
+	entry->flink = g_preflog.entries;
+	g_preflog.entries = entry;
+
+	return entry;
+}
+
+static void pref_log_free_entries(void)
+{
+	struct pref_log_entry_s *entry;
+
+	while (g_preflog.entries) {
+		entry = g_preflog.entries;
+		g_preflog.entries = entry->flink;
+		PREFERENCE_FREE(entry);
+	}
+	if (g_preflog.index) {
+		hashmap_delete(g_preflog.index);
+		g_preflog.index = NULL;
+	}
+}
+
+/* Point an entry at a new record (offset >= 0) or mark it removed (-1) */
+static void pref_log_update(struct pref_log_entry_s *entry, off_t offset, int type, int len)
+{
+	if (entry->offset >= 0) {
+		g_preflog.live -= PREF_LOG_RECSIZE(entry);
+	}
+	entry->offset = offset;
+	entry->type = type;
+	entry->len = len;
+	if (offset >= 0) {
+		g_preflog.live += PREF_LOG_RECSIZE(entry);
+	}
+}
+
+static int pref_log_read_exact(struct file *filep, void *buf, size_t len, off_t offset)
+{
+	ssize_t ret = file_pread(filep, buf, len, offset);
+
+	if (ret < 0) {
+		return (int)ret;
+	}
+	return (size_t)ret == len ? OK : -EIO;
+}
+
+static int pref_log_write_exact(struct file *filep, const void *buf, size_t len, off_t offset)
+{
+	ssize_t ret = file_pwrite(filep, buf, len, offset);
+
+	if (ret < 0) {
+		return (int)ret;
+	}
+	return (size_t)ret == len ? OK : -EIO;
+}
+
+/* Read a part of a record during the scan: a short read is a torn tail */
+static int pref_log_read_scan(struct file *filep, void *buf, size_t len, off_t offset)
+{
+	ssize_t ret = file_pread(filep, buf, len, offset);
+
+	if (ret < 0) {
+		prefdbg("Failed to read the log at %d, %d\n", (int)offset, (int)ret);
+		return PREFERENCE_IO_ERROR;
+	}
+	return (size_t)ret == len ? OK : PREF_LOG_TORN;
+}
+
+/****************************************************************************
+ * Name: pref_log_scan
+ *
+ * Description:
+ *   Build the index from the records of the log.  Stops at the first record
+ *   which is incomplete or fails the CRC check, which is what an update
+ *   interrupted by a power loss leaves behind.
+ *
+ * Returned Value:
+ *   OK if the whole log was valid, PREF_LOG_TORN if it ends with a broken
+ *   record, or a negative PREFERENCE_* error if the log could not be read
+ *   or indexed.  The records after the point of an error are not known,
+ *   so the log must not be compacted then.
+ *
+ ****************************************************************************/
+static int pref_log_scan(char *buf)
+{
+	struct pref_log_hdr_s hdr;
+	struct pref_log_entry_s *entry;
+	off_t offset = sizeof(uint32_t);
+	off_t end;
+	uint32_t crc;
+	int done;
+	int chunk;
+	int ret;
+
+	while ((ret = pref_log_read_scan(&g_preflog.file, &hdr, sizeof(hdr), offset)) == OK) {
+		if ((hdr.op != PREF_LOG_OP_SET && hdr.op != PREF_LOG_OP_REMOVE) || hdr.namelen == 0 || hdr.namelen > PATH_MAX || hdr.len < 0) {
+			ret = PREF_LOG_TORN;
+			break;
+		}
+
+		/* The name is at most PATH_MAX, 'buf' holds both the name and a
+		 * chunk of the value.
+		 */
+		ret = pref_log_read_scan(&g_preflog.file, buf, hdr.namelen, offset + sizeof(hdr));
+		if (ret != OK) {
+			break;
+		}
+		crc = crc32((uint8_t *)&hdr.op, sizeof(hdr) - sizeof(uint32_t));
+		crc = crc32part((uint8_t *)buf, hdr.namelen, crc);
+		for (done = 0; done < hdr.len; done += chunk) {
+			chunk = hdr.len - done < PREF_LOG_COPYSIZE ? hdr.len - done : PREF_LOG_COPYSIZE;
+			ret = pref_log_read_scan(&g_preflog.file, buf + hdr.namelen, chunk, offset + sizeof(hdr) + hdr.namelen + done);
+			if (ret != OK) {
+				break;
+			}
+			crc = crc32part((uint8_t *)buf + hdr.namelen, chunk, crc);
+		}
+		if (ret != OK) {
+			break;
+		}
+		if (crc != hdr.crc) {
+			ret = PREF_LOG_TORN;
+			break;
+		}
+
+		buf[hdr.namelen] = '\0';
+		entry = pref_log_find(buf, hdr.namelen);
+		if (entry == NULL) {
+			entry = pref_log_add(buf, hdr.namelen);
+			if (entry == NULL) {
+				ret = PREFERENCE_OUT_OF_MEMORY;
+				break;
+			}
+		}
+		if (hdr.op == PREF_LOG_OP_SET) {
+			pref_log_update(entry, offset, hdr.type, hdr.len);
+		} else {
+			pref_log_update(entry, -1, 0, 0);
+		}
+
+		offset += sizeof(hdr) + hdr.namelen + hdr.len;
+	}
+
+	g_preflog.size = offset;
+	if (ret < 0) {
+		return ret;
+	}
+
+	/* The loop also ends with PREF_LOG_TORN at the exact end of the log */
+	end = file_seek(&g_preflog.file, 0, SEEK_END);
+	if (end < 0) {
+		return PREFERENCE_IO_ERROR;
+	}
+	return end == offset ? OK : PREF_LOG_TORN;
+}
+
+static int pref_log_compact(void);
+
+/****************************************************************************
+ * Name: pref_log_init
+ *
+ * Description:
+ *   Open the log and build the index on first use.  The file system holding
+ *   PREF_PATH is not mounted yet when the kernel starts.
+ *
+ ****************************************************************************/
+static int pref_log_init(void)
+{
+	struct stat st;
+	uint32_t magic;
+	char *buf;
+	int ret;
+
+	if (g_preflog.initialized) {
+		return OK;
+	}
+
+	/* Finish a compaction interrupted after the old log was removed, or
+	 * drop one interrupted before.
+	 */
+	if (stat(PREF_LOG_NEWPATH, &st) == OK) {
+		if (stat(PREF_LOG_PATH, &st) == OK) {
+			unlink(PREF_LOG_NEWPATH);
+		} else if (rename(PREF_LOG_NEWPATH, PREF_LOG_PATH) < 0) {
+			prefdbg("Failed to recover %s, errno %d\n", PREF_LOG_NEWPATH, errno);
+			return PREFERENCE_IO_ERROR;
+		}
+	}
+
+	ret = file_open(&g_preflog.file, PREF_LOG_PATH, O_RDWR | O_CREAT, 0666);
+	if (ret < 0) {
+		prefdbg("Failed to open %s, %d\n", PREF_LOG_PATH, ret);
+		return PREFERENCE_IO_ERROR;
+	}
+
+	g_preflog.index = hashmap_create(PREF_LOG_HASHSIZE);
+	buf = (char *)PREFERENCE_ALLOC(PATH_MAX + PREF_LOG_COPYSIZE + 1);
+	if (g_preflog.index == NULL || buf == NULL) {
+		ret = PREFERENCE_OUT_OF_MEMORY;
+		goto errout;
+	}
+
+	g_preflog.live = 0;
+	g_preflog.unsynced = 0;
+	ret = pref_log_read_exact(&g_preflog.file, &magic, sizeof(magic), 0);
+	if (ret == OK && magic == PREF_LOG_MAGIC) {
+		ret = pref_log_scan(buf);
+		if (ret < 0) {
+			/* Compacting now would drop the keys which were not read */
+			goto errout;
+		}
+	} else if (file_seek(&g_preflog.file, 0, SEEK_END) == 0) {
+		/* New log */
+		magic = PREF_LOG_MAGIC;
+		if (pref_log_write_exact(&g_preflog.file, &magic, sizeof(magic), 0) != OK) {
+			ret = PREFERENCE_IO_ERROR;
+			goto errout;
+		}
+		g_preflog.size = sizeof(magic);
+		ret = OK;
+	} else {
+		prefdbg("%s is not a preference log\n", PREF_LOG_PATH);
+		ret = PREFERENCE_INVALID_DATA;
+		goto errout;
+	}
+	PREFERENCE_FREE(buf);
+	buf = NULL;
+
+	g_preflog.initialized = true;
+	prefvdbg("Preference log : %d bytes, %d in use\n", (int)g_preflog.size, (int)g_preflog.live);
+
+	if (ret == PREF_LOG_TORN) {
+		/* Rewrite the log without the broken tail, so that new records are
+		 * not hidden behind it on the next boot.
+		 */
+		prefdbg("Dropped a broken record at %d\n", (int)g_preflog.size);
+		ret = pref_log_compact();
+		if (ret < 0) {
+			return ret;
+		}
+	}
+
+	return OK;
+
+errout:
+	if (buf) {
+		PREFERENCE_FREE(buf);
+	}
+	pref_log_free_entries();
+	file_close(&g_preflog.file);
+	return ret;
+}
+
+/****************************************************************************
+ * Name: pref_log_compact
+ *
+ * Description:
+ *   Copy the records in use to a new log, then replace the old one with it.
+ *
+ ****************************************************************************/
+static int pref_log_compact(void)
+{
+	struct file newfile;
+	struct pref_log_entry_s *entry;
+	struct pref_log_entry_s **prev;
+	uint32_t magic = PREF_LOG_MAGIC;
+	off_t newsize = sizeof(magic);
+	char *buf;
+	int size;
+	int done;
+	int chunk;
+	int ret;
+
+	buf = (char *)PREFERENCE_ALLOC(PREF_LOG_COPYSIZE);
+	if (buf == NULL) {
+		return PREFERENCE_OUT_OF_MEMORY;
+	}
+
+	ret = file_open(&newfile, PREF_LOG_NEWPATH, O_WRONLY | O_CREAT | O_TRUNC, 0666);
+	if (ret < 0) {
+		PREFERENCE_FREE(buf);
+		prefdbg("Failed to open %s, %d\n", PREF_LOG_NEWPATH, ret);
+		return PREFERENCE_IO_ERROR;
+	}
+
+	ret = pref_log_write_exact(&newfile, &magic, sizeof(magic), 0);
+	for (entry = g_preflog.entries; entry && ret == OK; entry = entry->flink) {
+		if (entry->offset < 0) {
+			continue;
+		}
+		size = PREF_LOG_RECSIZE(entry);
+		for (done = 0; done < size && ret == OK; done += chunk) {
+			chunk = size - done < PREF_LOG_COPYSIZE ? size - done : PREF_LOG_COPYSIZE;
+			ret = pref_log_read_exact(&g_preflog.file, buf, chunk, entry->offset + done);
+			if (ret == OK) {
+				ret = pref_log_write_exact(&newfile, buf, chunk, newsize + done);
+			}
+		}
+		entry->newoffset = newsize;
+		newsize += size;
+	}
+	PREFERENCE_FREE(buf);
+
+	if (ret == OK) {
+		ret = file_fsync(&newfile);
+	}
+	file_close(&newfile);
+	if (ret < 0) {
+		prefdbg("Failed to write %s, %d\n", PREF_LOG_NEWPATH, ret);
+		unlink(PREF_LOG_NEWPATH);
+		return PREFERENCE_IO_ERROR;
+	}
+
+	/* From here on, pref_log_init() recovers from PREF_LOG_NEWPATH */
+	file_close(&g_preflog.file);
+	g_preflog.initialized = false;
+	if (unlink(PREF_LOG_PATH) < 0 || rename(PREF_LOG_NEWPATH, PREF_LOG_PATH) < 0 ||
+		file_open(&g_preflog.file, PREF_LOG_PATH, O_RDWR, 0666) < 0) {
+		prefdbg("Failed to replace %s, errno %d\n", PREF_LOG_PATH, errno);
+		pref_log_free_entries();
+		return PREFERENCE_IO_ERROR;
+	}
+
+	/* Drop the removed keys and rebuild the index without them */
+	hashmap_delete(g_preflog.index);
+	g_preflog.index = hashmap_create(PREF_LOG_HASHSIZE);
+	if (g_preflog.index == NULL) {
+		file_close(&g_preflog.file);
+		pref_log_free_entries();
+		return PREFERENCE_OUT_OF_MEMORY;
+	}
+
+	prev = &g_preflog.entries;
+	while ((entry = *prev) != NULL) {
+		if (entry->offset < 0) {
+			*prev = entry->flink;
+			PREFERENCE_FREE(entry);
+			continue;
+		}
+		entry->offset = entry->newoffset;
+		pref_log_hash(entry);
+		prev = &entry->flink;
+	}
+
+	prefvdbg("Compacted preference log : %d -> %d bytes\n", (int)g_preflog.size, (int)newsize);
+	g_preflog.size = newsize;
+	g_preflog.live = newsize - sizeof(magic);
+	g_preflog.unsynced = 0;
+	g_preflog.initialized = true;
+
+	return OK;
+}
+
+static bool pref_log_need_compact(void)
+{
+	off_t garbage = g_preflog.size - sizeof(uint32_t) - g_preflog.live;
+
+	return g_preflog.size >= CONFIG_PREFERENCE_LOG_COMPACT_MINSIZE && garbage * 100 >= g_preflog.size * CONFIG_PREFERENCE_LOG_COMPACT_PERCENT;
+}
+
+static void pref_log_sync(void)
+{
+	if (g_preflog.unsynced > 0) {
+		if (file_fsync(&g_preflog.file) < 0) {
+			prefdbg("Failed to sync %s\n", PREF_LOG_PATH);
+		}
+		g_preflog.unsynced = 0;
+	}
+}
+
+#ifdef PREF_LOG_WORK
+static void pref_log_worker(FAR void *arg)
+{
+	pref_log_lock();
+	if (g_preflog.initialized) {
+		pref_log_sync();
+		if (pref_log_need_compact()) {
+			(void)pref_log_compact();
+		}
+	}
+	pref_log_unlock();
+}
+#endif
+
+/****************************************************************************
+ * Name: pref_log_record
+ *
+ * Description:
+ *   Append one record and update the index.  The log is synced every
+ *   CONFIG_PREFERENCE_LOG_SYNC_RECORDS records.  This never compacts the
+ *   log, so 'entry' and the rest of the list stay valid.
+ *
+ ****************************************************************************/
+static int pref_log_record(struct pref_log_entry_s *entry, uint8_t op, int type, int len, const void *value)
+{
+	struct pref_log_hdr_s hdr;
+	off_t offset = g_preflog.size;
+	int ret;
+
+	memset(&hdr, 0, sizeof(hdr));
+	hdr.op = op;
+	hdr.namelen = entry->namelen;
+	hdr.type = type;
+	hdr.len = len;
+	hdr.crc = pref_log_crc(&hdr, entry->name, value);
+
+	/* A failed write leaves g_preflog.size as is, the next record
+	 * overwrites what was written.
+	 */
+	ret = pref_log_write_exact(&g_preflog.file, &hdr, sizeof(hdr), offset);
+	if (ret == OK) {
+		ret = pref_log_write_exact(&g_preflog.file, entry->name, entry->namelen, offset + sizeof(hdr));
+	}
+	if (ret == OK && len > 0) {
+		ret = pref_log_write_exact(&g_preflog.file, value, len, offset + sizeof(hdr) + entry->namelen);
+	}
+	if (ret < 0) {
+		prefdbg("Failed to append to %s, %d\n", PREF_LOG_PATH, ret);
+		return PREFERENCE_IO_ERROR;
+	}
+
+	g_preflog.size += sizeof(hdr) + entry->namelen + len;
+	if (op == PREF_LOG_OP_SET) {
+		pref_log_update(entry, offset, type, len);
+	} else {
+		pref_log_update(entry, -1, 0, 0);
+	}
+
+	if (++g_preflog.unsynced >= CONFIG_PREFERENCE_LOG_SYNC_RECORDS) {
+		pref_log_sync();
+	}
+
+	return OK;
+}
+
+/****************************************************************************
+ * Name: pref_log_schedule
+ *
+ * Description:
+ *   The work queue syncs the records left after CONFIG_PREFERENCE_LOG_SYNC_DELAY
+ *   and compacts the log once enough of it is no longer in use.  Without
+ *   the work queue, the log is compacted here, which frees the removed
+ *   entries: no entry pointer may be used after this.
+ *
+ ****************************************************************************/
+static void pref_log_schedule(void)
+{
+#ifdef PREF_LOG_WORK
+	if ((g_preflog.unsynced > 0 || pref_log_need_compact()) && work_available(&g_preflog.work)) {
+		work_queue(LPWORK, &g_preflog.work, pref_log_worker, NULL, MSEC2TICK(CONFIG_PREFERENCE_LOG_SYNC_DELAY));
+	}
+#else
+	if (pref_log_need_compact()) {
+		(void)pref_log_compact();
+	}
+#endif
+}
+
+static int pref_log_append(struct pref_log_entry_s *entry, uint8_t op, int type, int len, const void *value)
+{
+	int ret;
+
+	ret = pref_log_record(entry, op, type, len, value);
+	if (ret == OK) {
+		pref_log_schedule();
+	}
+	return ret;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+/* The functions below take the full key path as built by the callers for
+ * the file per key layout, and free it as the file versions do.
+ */
+int preference_log_write(char *path, preference_data_t *data)
+{
+	struct pref_log_entry_s *entry;
+	const char *name = pref_log_name(path);
+	uint32_t crc_value;
+	int ret;
+
+	pref_log_lock();
+	ret = pref_log_init();
+	if (ret < 0) {
+		goto errout;
+	}
+
+	entry = pref_log_find(name, strlen(name));
+	if (entry == NULL) {
+		entry = pref_log_add(name, strlen(name));
+		if (entry == NULL) {
+			ret = PREFERENCE_OUT_OF_MEMORY;
+			goto errout;
+		}
+	}
+
+	/* Same attributes as written by the file per key layout */
+	crc_value = crc32((uint8_t *)&data->attr.type, sizeof(value_attr_t) - sizeof(uint32_t));
+	data->attr.crc = crc32part((uint8_t *)data->value, data->attr.len, crc_value);
+
+	ret = pref_log_append(entry, PREF_LOG_OP_SET, data->attr.type, data->attr.len, data->value);
+	if (ret == OK) {
+		prefvdbg("Write Key Success : %s, len = %d\n", name, data->attr.len);
+	}
+
+errout:
+	pref_log_unlock();
+	PREFERENCE_FREE(path);
+	return ret;
+}
+
+int preference_log_read(char *path, preference_data_t *data)
+{
+	struct pref_log_entry_s *entry;
+	struct pref_log_hdr_s hdr;
+	const char *name = pref_log_name(path);
+	int ret;
+
+	pref_log_lock();
+	ret = pref_log_init();
+	if (ret < 0) {
+		goto errout;
+	}
+
+	entry = pref_log_find(name, strlen(name));
+	if (entry == NULL || entry->offset < 0) {
+		ret = PREFERENCE_KEY_NOT_EXIST;
+		goto errout;
+	}
+	if (entry->type != data->attr.type) {
+		prefdbg("Invalid type. request type:%d, read type:%d\n", data->attr.type, entry->type);
+		ret = PREFERENCE_INVALID_PARAMETER;
+		goto errout;
+	}
+
+	data->attr.len = entry->len;
+	data->value = PREFERENCE_ALLOC(data->attr.len);
+	if (data->value == NULL) {
+		ret = PREFERENCE_OUT_OF_MEMORY;
+		goto errout;
+	}
+
+	if (pref_log_read_exact(&g_preflog.file, &hdr, sizeof(hdr), entry->offset) != OK ||
+		pref_log_read_exact(&g_preflog.file, data->value, entry->len, entry->offset + sizeof(hdr) + entry->namelen) != OK) {
+		prefdbg("Failed to read key value %s\n", name);
+		ret = PREFERENCE_IO_ERROR;
+		goto errout_with_free;
+	}
+
+	/* The name is not read back, it has to match for the CRC to match */
+	if (hdr.len != entry->len || pref_log_crc(&hdr, entry->name, data->value) != hdr.crc) {
+		prefdbg("Invalid checksum of %s\n", name);
+		ret = PREFERENCE_INVALID_DATA;
+		goto errout_with_free;
+	}
+
+	prefvdbg("Read key Success!\n");
+	pref_log_unlock();
+	PREFERENCE_FREE(path);
+	return OK;
+
+errout_with_free:
+	PREFERENCE_FREE(data->value);
+errout:
+	pref_log_unlock();
+	PREFERENCE_FREE(path);
+	return ret;
+}
+
+int preference_log_remove(char *path)
+{
+	struct pref_log_entry_s *entry;
+	const char *name = pref_log_name(path);
+	int ret;
+
+	pref_log_lock();
+	ret = pref_log_init();
+	if (ret == OK) {
+		entry = pref_log_find(name, strlen(name));
+		if (entry == NULL || entry->offset < 0) {
+			prefdbg("key is not exist : %s\n", name);
+			ret = PREFERENCE_KEY_NOT_EXIST;
+		} else {
+			ret = pref_log_append(entry, PREF_LOG_OP_REMOVE, 0, 0, NULL);
+		}
+	}
+	pref_log_unlock();
+	PREFERENCE_FREE(path);
+
+	return ret;
+}
+
+/* Remove the keys directly under 'dir_path', which stays owned by the
+ * caller.  Removed keys still tell that the directory existed.
+ */
+int preference_log_remove_all(const char *dir_path)
+{
+	struct pref_log_entry_s *entry;
+	const char *name = pref_log_name(dir_path);
+	size_t len = strlen(name);
+	bool found = false;
+	bool removed = false;
+	int ret;
+
+	pref_log_lock();
+	ret = pref_log_init();
+
+	/* Compact once after the loop, compacting frees the removed entries */
+	for (entry = g_preflog.entries; entry && ret == OK; entry = entry->flink) {
+		if (entry->namelen <= len + 1 || strncmp(entry->name, name, len) != 0 ||
+			entry->name[len] != '/' || strchr(entry->name + len + 1, '/') != NULL) {
+			continue;
+		}
+		found = true;
+		if (entry->offset >= 0) {
+			prefvdbg("Remove key : %s\n", entry->name);
+			ret = pref_log_record(entry, PREF_LOG_OP_REMOVE, 0, 0, NULL);
+			removed |= (ret == OK);
+		}
+	}
+	if (removed) {
+		pref_log_schedule();
+	}
+	pref_log_unlock();
+
+	if (ret == OK && !found) {
+		ret = PREFERENCE_PATH_NOT_FOUND;
+	}
+	return ret;
+}
+
+int preference_log_check(char *path, bool *existing)
+{
+	struct pref_log_entry_s *entry;
+	int ret;
+
+	*existing = false;
+
+	pref_log_lock();
+	ret = pref_log_init();
+	if (ret == OK) {
+		entry = pref_log_find(pref_log_name(path), strlen(pref_log_name(path)));
+		*existing = (entry != NULL && entry->offset >= 0);
+	}
+	pref_log_unlock();
+	PREFERENCE_FREE(path);
+
+	return ret;
+}
+
+#endif							/* CONFIG_PREFERENCE_LOG */
@@ -18,6 +18,7 @@
 /****************************************************************************
  * Included Files
  ****************************************************************************/
+#include <tinyara/config.h>
 #include <unistd.h>
 #include <debug.h>
 #include <fcntl.h>
@@ -25,9 +26,12 @@
 #include <crc32.h>
 #include <tinyara/preference.h>
 
+#include "preference.h"
+
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
+#ifndef CONFIG_PREFERENCE_LOG
 static int preference_read_fs_key(char *path, preference_data_t *data)
 {
 	int fd;
@@ -95,6 +99,7 @@ errout:
 
 	return ret;
 }
+#endif							/* CONFIG_PREFERENCE_LOG */
 
 /****************************************************************************
  * Public Functions
@@ -123,5 +128,9 @@ int preference_read_key(preference_data_t *data)
 		}
 	}
 
+#ifdef CONFIG_PREFERENCE_LOG
+	return preference_log_read(path, data);
+#else
 	return preference_read_fs_key(path, data);
+#endif
 }
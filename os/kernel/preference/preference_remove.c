@@ -25,6 +25,8 @@
 #include <errno.h>
 #include <fcntl.h>
 #include <tinyara/preference.h>
+
+#include "preference.h"
 #if CONFIG_TASK_NAME_SIZE > 0
 #include <sys/types.h>
 #include <tinyara/sched.h>
@@ -35,6 +37,7 @@
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
+#ifndef CONFIG_PREFERENCE_LOG
 static int preference_remove_fs_key(char *path)
 {
 	int ret;
@@ -62,6 +65,7 @@ static int preference_remove_fs_key(char *path)
 
 	return ret;
 }
+#endif							/* CONFIG_PREFERENCE_LOG */
 
 /****************************************************************************
  * Public Functions
@@ -90,16 +94,22 @@ int preference_remove_key(int type, const char *key)
 		}
 	}
 
+#ifdef CONFIG_PREFERENCE_LOG
+	return preference_log_remove(path);
+#else
 	return preference_remove_fs_key(path);
+#endif
 }
 
 int preference_remove_all_key(int type, const char *path)
 {
 	int ret;
-	DIR *dir;
 	char *dir_path;
+#ifndef CONFIG_PREFERENCE_LOG
+	DIR *dir;
 	char *key_path;
 	struct dirent *entry;
+#endif
 #if CONFIG_TASK_NAME_SIZE > 0
 	struct tcb_s *tcb;
 #endif
@@ -134,6 +144,12 @@ int preference_remove_all_key(int type, const char *path)
 
 	prefvdbg("preference dir path = %s\n", dir_path);
 
+#ifdef CONFIG_PREFERENCE_LOG
+	ret = preference_log_remove_all(dir_path);
+	if (ret < 0) {
+		goto errout_with_free;
+	}
+#else
 	dir = (DIR *)opendir(dir_path);
 	if (!dir) {
 		prefdbg("Failed to open dir %s, %d\n", dir_path, errno);
@@ -168,6 +184,7 @@ int preference_remove_all_key(int type, const char *path)
 	if (ret < 0) {
 		goto errout_with_free;
 	}
+#endif
 
 	ret = OK;
 
@@ -349,6 +349,19 @@ extern volatile spinlock_t g_cpu_tasklistlock;
 
 #endif /* CONFIG_SMP */
 
+#ifdef CONFIG_SCHED_READYTORUN_INDEX
+/* Priority index of a ready-to-run list. Bit 'p' of map[] is set when
+ * last[p] holds the last TCB of priority 'p' in the list; bit 'w' of
+ * summary is set when map[w] is non-zero.
+ */
+
+struct sched_rtrindex_s {
+	uint32_t summary;
+	uint32_t map[(SCHED_PRIORITY_MAX >> 5) + 1];
+	FAR struct tcb_s *last[SCHED_PRIORITY_MAX + 1];
+};
+#endif
+
 /****************************************************************************
  * Public Function Prototypes
  ****************************************************************************/
@@ -361,6 +374,17 @@ void sched_addblocked(FAR struct tcb_s *btcb, tstate_t task_state);
 void sched_removeblocked(FAR struct tcb_s *btcb);
 int sched_setpriority(FAR struct tcb_s *tcb, int sched_priority);
 
+#ifdef CONFIG_SCHED_READYTORUN_INDEX
+FAR struct sched_rtrindex_s *sched_rtrindex(FAR dq_queue_t *list);
+FAR struct tcb_s *sched_rtrindex_search(FAR struct sched_rtrindex_s *index, FAR dq_queue_t *list, FAR struct tcb_s *tcb);
+void sched_rtrindex_add(FAR struct sched_rtrindex_s *index, FAR struct tcb_s *tcb);
+void sched_rtrindex_remove(FAR dq_queue_t *list, FAR struct tcb_s *tcb);
+void sched_rtrindex_release(FAR struct tcb_s *tcb);
+#else
+#define sched_rtrindex_remove(list, tcb)
+#define sched_rtrindex_release(tcb)
+#endif
+
 #ifdef CONFIG_SW_STACK_OVERFLOW_DETECTION
 void sched_checkstackoverflow(FAR struct tcb_s *rtcb);
 #endif
@@ -118,6 +118,9 @@ bool sched_addprioritized(FAR struct tcb_s *tcb, DSEG dq_queue_t *list)
 	FAR struct tcb_s *prev;
 	uint8_t sched_priority = tcb->sched_priority;
 	bool ret = false;
+#ifdef CONFIG_SCHED_READYTORUN_INDEX
+	FAR struct sched_rtrindex_s *index = sched_rtrindex(list);
+#endif
 
 	/* Lets do a sanity check before we get started. */
 
@@ -127,7 +130,14 @@ bool sched_addprioritized(FAR struct tcb_s *tcb, DSEG dq_queue_t *list)
 	 * Each is list is maintained in ascending sched_priority order.
 	 */
 
-	for (next = (FAR struct tcb_s *)list->head; (next && sched_priority <= next->sched_priority); next = next->flink) ;
+#ifdef CONFIG_SCHED_READYTORUN_INDEX
+	if (index) {
+		next = sched_rtrindex_search(index, list, tcb);
+	} else
+#endif
+	{
+		for (next = (FAR struct tcb_s *)list->head; (next && sched_priority <= next->sched_priority); next = next->flink) ;
+	}
 
 	/* Add the tcb to the spot found in the list.  Check if the tcb
 	 * goes at the end of the list. NOTE:  This could only happen if list
@@ -176,5 +186,13 @@ bool sched_addprioritized(FAR struct tcb_s *tcb, DSEG dq_queue_t *list)
 		}
 	}
 
+#ifdef CONFIG_SCHED_READYTORUN_INDEX
+	/* tcb now follows every other TCB of the same priority */
+
+	if (index) {
+		sched_rtrindex_add(index, tcb);
+	}
+#endif
+
 	return ret;
 }
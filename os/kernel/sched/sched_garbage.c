@@ -206,4 +206,13 @@ void sched_garbagecollection(void)
 	/* Handle deferred dealloctions for the user heap */
 
 	sched_kucleanup();
+
+#ifdef CONFIG_MM_PERCPU_CACHE
+	/* Give the cached small chunks back to the heaps whose caches grew
+	 * large, so that they can be merged with their free neighbours.  A
+	 * failed allocation flushes the cache of its heap by itself.
+	 */
+
+	mm_cache_flush_all(CONFIG_MM_PERCPU_CACHE_GC_THRESHOLD);
+#endif
 }
@@ -123,6 +123,9 @@ bool sched_mergepending(void)
 	FAR struct tcb_s *rtrtcb;
 	FAR struct tcb_s *rtrprev;
 	bool ret = false;
+#ifdef CONFIG_SCHED_READYTORUN_INDEX
+	FAR struct sched_rtrindex_s *index = sched_rtrindex((FAR dq_queue_t *)&g_readytorun);
+#endif
 
 	/* Initialize the inner search loop */
 
@@ -138,7 +141,11 @@ bool sched_mergepending(void)
 		 * order.
 		 */
 
+#ifdef CONFIG_SCHED_READYTORUN_INDEX
+		rtrtcb = sched_rtrindex_search(index, (FAR dq_queue_t *)&g_readytorun, pndtcb);
+#else
 		for (; (rtrtcb && pndtcb->sched_priority <= rtrtcb->sched_priority); rtrtcb = rtrtcb->flink) ;
+#endif
 
 		/* Add the pndtcb to the spot found in the list.  Check if the
 		 * pndtcb goes at the ends of the g_readytorun list. This would be
@@ -172,6 +179,10 @@ bool sched_mergepending(void)
 			pndtcb->task_state = TSTATE_TASK_READYTORUN;
 		}
 
+#ifdef CONFIG_SCHED_READYTORUN_INDEX
+		sched_rtrindex_add(index, pndtcb);
+#endif
+
 		/* Set up for the next time through */
 
 		rtrtcb = pndtcb;
@@ -207,6 +207,10 @@ int sched_releasetcb(FAR struct tcb_s *tcb, uint8_t ttype)
 		group_leave(tcb);
 #endif
 
+		/* Drop any ready-to-run index entry that still refers to the TCB */
+
+		sched_rtrindex_release(tcb);
+
 		/* And, finally, release the TCB itself */
 
 		sched_kfree(tcb);
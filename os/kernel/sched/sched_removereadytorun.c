@@ -138,6 +138,7 @@ bool sched_removereadytorun(FAR struct tcb_s *rtcb)
 
 	/* Remove the TCB from the ready-to-run list */
 
+	sched_rtrindex_remove(tasklist, rtcb);
 	dq_rem((FAR dq_entry_t *)rtcb, tasklist);
 
 	/* Since the TCB is not in any list, it is now invalid */
@@ -206,6 +207,7 @@ bool sched_removereadytorun(FAR struct tcb_s *rtcb)
 		 * or the g_assignedtasks[cpu] list.
 		 */
 
+		sched_rtrindex_remove(tasklist, rtcb);
 		dq_rem((FAR dq_entry_t *)rtcb, tasklist);
 
 		/* Which task will go at the head of the list? It will either be
@@ -242,6 +244,7 @@ bool sched_removereadytorun(FAR struct tcb_s *rtcb)
 			 * g_assignedtasks[cpu] list.
 			 */
 
+			sched_rtrindex_remove((FAR dq_queue_t *)&g_readytorun, rtrtcb);
 			dq_rem((FAR dq_entry_t *)rtrtcb, (FAR dq_queue_t *)&g_readytorun);
 			dq_addfirst((FAR dq_entry_t *)rtrtcb, tasklist);
 			rtrtcb->cpu = cpu;
@@ -286,6 +289,7 @@ bool sched_removereadytorun(FAR struct tcb_s *rtcb)
 		 * g_assignedtasks[cpu] list.
 		 */
 
+		sched_rtrindex_remove(tasklist, rtcb);
 		dq_rem((FAR dq_entry_t *)rtcb, tasklist);
 	}
 
@@ -0,0 +1,246 @@
+/****************************************************************************
+ *
+ * Copyright 2025 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <tinyara/config.h>
+#include <tinyara/sched.h>
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <queue.h>
+#include <assert.h>
+
+#include "sched/sched.h"
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#ifdef CONFIG_SMP
+#define RTRINDEX_NLISTS              (CONFIG_SMP_NCPUS + 1)
+#define RTRINDEX_LISTHEAD(t)         TLIST_HEAD((t)->task_state, (t)->cpu)
+#else
+#define RTRINDEX_NLISTS              1
+#define RTRINDEX_LISTHEAD(t)         TLIST_HEAD((t)->task_state)
+#endif
+
+/****************************************************************************
+ * Private Variables
+ ****************************************************************************/
+
+/* Index of g_readytorun followed, in the SMP case, by the index of each
+ * g_assignedtasks[] list.  All zero means "nothing indexed".
+ */
+
+static struct sched_rtrindex_s g_rtrindex[RTRINDEX_NLISTS];
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+static inline void sched_rtrindex_clear(FAR struct sched_rtrindex_s *index, int priority)
+{
+	int word = priority >> 5;
+
+	index->map[word] &= ~(1u << (priority & 31));
+	if (index->map[word] == 0) {
+		index->summary &= ~(1u << word);
+	}
+	index->last[priority] = NULL;
+}
+
+/* The index is only a hint.  Architecture and task management code moves
+ * TCBs with dq_rem() directly, so an entry is trusted only if that TCB is
+ * still linked into 'list' with the priority it was recorded under.
+ */
+
+static inline bool sched_rtrindex_valid(FAR dq_queue_t *list, FAR struct tcb_s *tcb, int priority)
+{
+	return tcb->sched_priority == priority &&
+		(tcb->blink != NULL || list->head == (FAR dq_entry_t *)tcb) &&
+		RTRINDEX_LISTHEAD(tcb) == list;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: sched_rtrindex
+ *
+ * Description:
+ *   Return the priority index kept for a ready-to-run list, or NULL if the
+ *   list is not indexed (e.g. g_pendingtasks or a blocked list).
+ *
+ ****************************************************************************/
+
+FAR struct sched_rtrindex_s *sched_rtrindex(FAR dq_queue_t *list)
+{
+	if (list == (FAR dq_queue_t *)&g_readytorun) {
+		return &g_rtrindex[0];
+	}
+#ifdef CONFIG_SMP
+	if (list >= (FAR dq_queue_t *)g_assignedtasks && list < (FAR dq_queue_t *)&g_assignedtasks[CONFIG_SMP_NCPUS]) {
+		return &g_rtrindex[1 + (list - (FAR dq_queue_t *)g_assignedtasks)];
+	}
+#endif
+	return NULL;
+}
+
+/****************************************************************************
+ * Name: sched_rtrindex_search
+ *
+ * Description:
+ *   Find the TCB before which 'tcb' must be inserted so that it follows
+ *   every TCB of equal or higher priority.  This is the same position the
+ *   linear search in sched_addprioritized() finds.
+ *
+ *   The lowest indexed priority at or above that of 'tcb' is located with
+ *   two count-trailing-zero operations and its last TCB is used as the
+ *   starting point.  Only TCBs added behind the index's back are walked.
+ *
+ * Return Value:
+ *   The TCB that will follow 'tcb', or NULL if 'tcb' goes at the tail.
+ *
+ ****************************************************************************/
+
+FAR struct tcb_s *sched_rtrindex_search(FAR struct sched_rtrindex_s *index, FAR dq_queue_t *list, FAR struct tcb_s *tcb)
+{
+	FAR struct tcb_s *prev;
+	FAR struct tcb_s *next;
+	uint8_t sched_priority = tcb->sched_priority;
+	uint32_t bits;
+	int word;
+	int priority;
+
+	word = sched_priority >> 5;
+	bits = index->map[word] & (~0u << (sched_priority & 31));
+
+	for (;;) {
+		while (bits == 0) {
+			uint32_t words = index->summary & ~((2u << word) - 1);
+
+			if (words == 0) {
+				/* No usable entry: search from the head of the list */
+
+				for (next = (FAR struct tcb_s *)list->head; next && sched_priority <= next->sched_priority; next = next->flink) ;
+				return next;
+			}
+
+			word = __builtin_ctz(words);
+			bits = index->map[word];
+		}
+
+		priority = (word << 5) + __builtin_ctz(bits);
+		prev = index->last[priority];
+		if (prev != tcb && sched_rtrindex_valid(list, prev, priority)) {
+			break;
+		}
+
+		/* Stale entry. Drop it and try the next indexed priority */
+
+		sched_rtrindex_clear(index, priority);
+		bits &= bits - 1;
+	}
+
+	/* 'prev' has a priority >= that of 'tcb'.  Step over anything that was
+	 * linked in after it without going through the index.
+	 */
+
+	for (next = prev->flink; next && sched_priority <= next->sched_priority; next = next->flink) ;
+	return next;
+}
+
+/****************************************************************************
+ * Name: sched_rtrindex_add
+ *
+ * Description:
+ *   Record 'tcb' as the last TCB of its priority.  Called after 'tcb' has
+ *   been linked behind all other TCBs of the same priority.
+ *
+ ****************************************************************************/
+
+void sched_rtrindex_add(FAR struct sched_rtrindex_s *index, FAR struct tcb_s *tcb)
+{
+	int priority = tcb->sched_priority;
+	int word = priority >> 5;
+
+	index->last[priority] = tcb;
+	index->map[word] |= 1u << (priority & 31);
+	index->summary |= 1u << word;
+}
+
+/****************************************************************************
+ * Name: sched_rtrindex_remove
+ *
+ * Description:
+ *   Update the index of 'list' before 'tcb' is unlinked from it.  Does
+ *   nothing if the list is not indexed.
+ *
+ ****************************************************************************/
+
+void sched_rtrindex_remove(FAR dq_queue_t *list, FAR struct tcb_s *tcb)
+{
+	FAR struct sched_rtrindex_s *index = sched_rtrindex(list);
+	FAR struct tcb_s *prev;
+	int priority = tcb->sched_priority;
+
+	if (index == NULL || index->last[priority] != tcb) {
+		return;
+	}
+
+	prev = tcb->blink;
+	if (prev != NULL && prev->sched_priority == priority) {
+		index->last[priority] = prev;
+	} else {
+		sched_rtrindex_clear(index, priority);
+	}
+}
+
+/****************************************************************************
+ * Name: sched_rtrindex_release
+ *
+ * Description:
+ *   Forget every reference to a TCB that is about to be freed so that a
+ *   later search never dereferences released memory.
+ *
+ ****************************************************************************/
+
+void sched_rtrindex_release(FAR struct tcb_s *tcb)
+{
+	FAR struct sched_rtrindex_s *index;
+	uint32_t words;
+	uint32_t bits;
+	int word;
+	int priority;
+
+	for (index = g_rtrindex; index < &g_rtrindex[RTRINDEX_NLISTS]; index++) {
+		for (words = index->summary; words != 0; words &= words - 1) {
+			word = __builtin_ctz(words);
+			for (bits = index->map[word]; bits != 0; bits &= bits - 1) {
+				priority = (word << 5) + __builtin_ctz(bits);
+				if (index->last[priority] == tcb) {
+					sched_rtrindex_clear(index, priority);
+				}
+			}
+		}
+	}
+}
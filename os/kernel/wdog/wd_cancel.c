@@ -124,6 +124,17 @@ int wd_cancel(WDOG_ID wdog)
 	 */
 
 	if (wdog && WDOG_ISACTIVE(wdog)) {
+#ifdef CONFIG_WDOG_TIMING_WHEEL
+		/* The watchdog knows its slot, so it is simply unlinked */
+
+		wd_wheel_remove(wdog);
+
+		/* Reassess the interval timer that will generate the next interval
+		 * event.
+		 */
+
+		sched_timer_reassess();
+#else
 		/* Search the g_wdactivelist for the target FCB.  We can't use sq_rem
 		 * to do this because there are additional operations that need to be
 		 * done.
@@ -168,6 +179,7 @@ int wd_cancel(WDOG_ID wdog)
 
 			sched_timer_reassess();
 		}
+#endif
 
 		/* Mark the watchdog inactive */
 
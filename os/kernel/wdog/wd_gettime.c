@@ -109,6 +109,16 @@ int wd_gettime(WDOG_ID wdog)
 	/* Verify the wdog */
 
 	flags = enter_critical_section();
+#ifdef CONFIG_WDOG_TIMING_WHEEL
+	if (wdog && WDOG_ISACTIVE(wdog)) {
+		/* The absolute expiration time is kept in the watchdog */
+
+		int32_t delay = (int32_t)(wdog->expires - g_wdwheel.now);
+
+		leave_critical_section(flags);
+		return delay > 0 ? delay : 0;
+	}
+#else
 	if (wdog && WDOG_ISACTIVE(wdog)) {
 		/* Traverse the watchdog list accumulating lag times until we find the wdog
 		 * that we are looking for
@@ -125,6 +135,7 @@ int wd_gettime(WDOG_ID wdog)
 			}
 		}
 	}
+#endif
 
 	leave_critical_section(flags);
 	return 0;
@@ -150,6 +161,10 @@ int wd_gettime(WDOG_ID wdog)
 
 int wd_getdelay(void)
 {
+#ifdef CONFIG_WDOG_TIMING_WHEEL
+	return wd_wheel_nextdelay();
+#else
 	return (g_wdactivelist.head) ? ((FAR struct wdog_s *)g_wdactivelist.head)->lag : 0;
+#endif
 }
 #endif
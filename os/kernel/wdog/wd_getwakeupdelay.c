@@ -70,8 +70,33 @@ clock_t wd_getwakeupdelay(void)
 	clock_t delay = 0;
 	struct wdog_s *curr;
 	irqstate_t flags;
+#ifdef CONFIG_WDOG_TIMING_WHEEL
+	int32_t best = INT32_MAX;
+	int32_t lag;
+	int index;
+#endif
 
 	flags = enter_critical_section();
+#ifdef CONFIG_WDOG_TIMING_WHEEL
+	/* The wheel is not ordered across slots, so look at every queued
+	 * watchdog and keep the one which expires soonest.
+	 */
+
+	for (index = 0; index <= WD_WHEEL_EXPIRED; index++) {
+		for (curr = g_wdwheel.slot[index].head; curr; curr = curr->next) {
+			if (WDOG_ISWAKEUP(curr)) {
+				lag = (int32_t)(curr->expires - g_wdwheel.now);
+				if (lag < best) {
+					best = lag;
+				}
+			}
+		}
+	}
+
+	if (best != INT32_MAX) {
+		delay = best > 0 ? best : 0;
+	}
+#else
 	for (curr = (FAR struct wdog_s *)g_wdactivelist.head; curr; curr = curr->next) {
 		delay += curr->lag;
 		if (WDOG_ISWAKEUP(curr)) {
@@ -80,6 +105,9 @@ clock_t wd_getwakeupdelay(void)
 		}
 	}
 
+	delay = 0;
+#endif
+
 	leave_critical_section(flags);
-	return 0;
+	return delay;
 }
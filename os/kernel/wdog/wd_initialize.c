@@ -168,6 +168,9 @@ void wd_initialize(void)
 
 	sq_init(&g_wdfreelist);
 	sq_init(&g_wdactivelist);
+#ifdef CONFIG_WDOG_TIMING_WHEEL
+	wd_wheel_initialize();
+#endif
 
 	/* The g_wdfreelist must be loaded at initialization time to hold the
 	 * configured number of watchdogs.
@@ -111,6 +111,62 @@ typedef void (*wdentry4_t)(int argc, uint32_t arg1, uint32_t arg2, uint32_t arg3
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
+/****************************************************************************
+ * Name: wd_execute
+ *
+ * Description:
+ *   Execute the function of an expired watchdog.
+ *
+ * Parameters:
+ *   wdog - The watchdog which already has been removed from the queue
+ *
+ * Return Value:
+ *   None
+ *
+ ****************************************************************************/
+
+static inline void wd_execute(FAR struct wdog_s *wdog)
+{
+	/* Indicate that the watchdog is no longer active. */
+
+	WDOG_CLRACTIVE(wdog);
+
+	/* Execute the watchdog function */
+
+	up_setpicbase(wdog->picbase);
+	switch (wdog->argc) {
+	default:
+		wd_corruption_dbg(wdog);
+		DEBUGPANIC();
+		break;
+
+	case 0:
+		(*((wdentry0_t)(wdog->func)))(0);
+		break;
+
+#if CONFIG_MAX_WDOGPARMS > 0
+	case 1:
+		(*((wdentry1_t)(wdog->func)))(1, wdog->parm[0]);
+		break;
+#endif
+#if CONFIG_MAX_WDOGPARMS > 1
+	case 2:
+		(*((wdentry2_t)(wdog->func)))(2, wdog->parm[0], wdog->parm[1]);
+		break;
+#endif
+#if CONFIG_MAX_WDOGPARMS > 2
+	case 3:
+		(*((wdentry3_t)(wdog->func)))(3, wdog->parm[0], wdog->parm[1], wdog->parm[2]);
+		break;
+#endif
+#if CONFIG_MAX_WDOGPARMS > 3
+	case 4:
+		(*((wdentry4_t)(wdog->func)))(4, wdog->parm[0], wdog->parm[1], wdog->parm[2], wdog->parm[3]);
+		break;
+#endif
+	}
+}
+
 /****************************************************************************
  * Name: wd_expiration
  *
@@ -128,6 +184,20 @@ typedef void (*wdentry4_t)(int argc, uint32_t arg1, uint32_t arg2, uint32_t arg3
  *
  ****************************************************************************/
 
+#ifdef CONFIG_WDOG_TIMING_WHEEL
+static inline void wd_expiration(void)
+{
+	FAR struct wdog_s *wdog;
+
+	/* Execute all watchdogs which wd_wheel_advance() found to be due.  A
+	 * watchdog function may start or cancel other watchdogs meanwhile.
+	 */
+
+	while ((wdog = wd_wheel_popexpired()) != NULL) {
+		wd_execute(wdog);
+	}
+}
+#else
 static inline void wd_expiration(void)
 {
 	FAR struct wdog_s *wdog;
@@ -152,47 +222,13 @@ static inline void wd_expiration(void)
 				((FAR struct wdog_s *)g_wdactivelist.head)->lag += wdog->lag;
 			}
 
-			/* Indicate that the watchdog is no longer active. */
-
-			WDOG_CLRACTIVE(wdog);
-
 			/* Execute the watchdog function */
 
-			up_setpicbase(wdog->picbase);
-			switch (wdog->argc) {
-			default:
-				wd_corruption_dbg(wdog);
-				DEBUGPANIC();
-				break;
-
-			case 0:
-				(*((wdentry0_t)(wdog->func)))(0);
-				break;
-
-#if CONFIG_MAX_WDOGPARMS > 0
-			case 1:
-				(*((wdentry1_t)(wdog->func)))(1, wdog->parm[0]);
-				break;
-#endif
-#if CONFIG_MAX_WDOGPARMS > 1
-			case 2:
-				(*((wdentry2_t)(wdog->func)))(2, wdog->parm[0], wdog->parm[1]);
-				break;
-#endif
-#if CONFIG_MAX_WDOGPARMS > 2
-			case 3:
-				(*((wdentry3_t)(wdog->func)))(3, wdog->parm[0], wdog->parm[1], wdog->parm[2]);
-				break;
-#endif
-#if CONFIG_MAX_WDOGPARMS > 3
-			case 4:
-				(*((wdentry4_t)(wdog->func)))(4, wdog->parm[0], wdog->parm[1], wdog->parm[2], wdog->parm[3]);
-				break;
-#endif
-			}
+			wd_execute(wdog);
 		}
 	}
 }
+#endif
 
 /****************************************************************************
  * Public Functions
@@ -298,6 +334,15 @@ int wd_start(WDOG_ID wdog, int delay, wdentry_t wdentry, int argc, ...)
 	(void)sched_timer_cancel();
 #endif
 
+#ifdef CONFIG_WDOG_TIMING_WHEEL
+	/* Hash the watchdog into the timing wheel by its absolute expiration
+	 * time, no list walk is needed.
+	 */
+
+	wdog->expires = g_wdwheel.now + delay;
+	wdog->lag = delay;
+	wd_wheel_insert(wdog);
+#else
 	/* Do the easy case first -- when the watchdog timer queue is empty. */
 
 	if (g_wdactivelist.head == NULL) {
@@ -369,9 +414,13 @@ int wd_start(WDOG_ID wdog, int delay, wdentry_t wdentry, int argc, ...)
 		}
 	}
 
-	/* Put the lag into the watchdog structure and mark it as active. */
+	/* Put the lag into the watchdog structure */
 
 	wdog->lag = delay;
+#endif
+
+	/* Mark the watchdog as active. */
+
 	WDOG_SETACTIVE(wdog);
 
 #ifdef CONFIG_SCHED_TICKLESS
@@ -412,8 +461,32 @@ int wd_start(WDOG_ID wdog, int delay, wdentry_t wdentry, int argc, ...)
  *
  ****************************************************************************/
 
+#ifdef CONFIG_WDOG_TIMING_WHEEL
 #ifdef CONFIG_SCHED_TICKLESS
 unsigned int wd_timer(int ticks)
+{
+	/* Move the wheel forward and execute what became due */
+
+	if (ticks > 0) {
+		wd_wheel_advance(ticks);
+	}
+
+	wd_expiration();
+
+	/* Return the delay for the next watchdog to expire */
+
+	return wd_wheel_nextdelay();
+}
+#else
+void wd_timer(void)
+{
+	wd_wheel_advance(1);
+	wd_expiration();
+}
+#endif							/* CONFIG_SCHED_TICKLESS */
+
+#elif defined(CONFIG_SCHED_TICKLESS)
+unsigned int wd_timer(int ticks)
 {
 	FAR struct wdog_s *wdog;
 	int decr;
@@ -471,6 +544,14 @@ void wd_timer(void)
 #endif							/* CONFIG_SCHED_TICKLESS */
 
 #ifdef CONFIG_SCHED_TICKSUPPRESS
+#ifdef CONFIG_WDOG_TIMING_WHEEL
+void wd_timer_nohz(clock_t ticks)
+{
+	/* Expires when the next wd_timer is called.*/
+
+	wd_wheel_advance(ticks);
+}
+#else
 void wd_timer_nohz(clock_t ticks)
 {
 	FAR struct wdog_s *wdog;
@@ -491,3 +572,4 @@ void wd_timer_nohz(clock_t ticks)
 	}
 }
 #endif
+#endif
@@ -0,0 +1,331 @@
+/****************************************************************************
+ *
+ * Copyright 2025 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <tinyara/config.h>
+
+#include <stdint.h>
+#include <string.h>
+#include <assert.h>
+
+#include <tinyara/wdog.h>
+
+#include "wdog/wdog.h"
+
+#ifdef CONFIG_WDOG_TIMING_WHEEL
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define WD_WHEEL_SHIFT(l)      ((l) * WD_WHEEL_BITS)
+#define WD_WHEEL_INDEX(t, l)   (((t) >> WD_WHEEL_SHIFT(l)) & WD_WHEEL_MASK)
+#define WD_WHEEL_SLOT(l, i)    ((l) * WD_WHEEL_SIZE + (i))
+
+/****************************************************************************
+ * Public Variables
+ ****************************************************************************/
+
+/* All active watchdogs, see wdog.h */
+
+struct wd_wheel_s g_wdwheel;
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: wd_wheel_link
+ *
+ * Description:
+ *   Append a watchdog to the tail of a slot so that watchdogs which expire
+ *   on the same tick run in the order they were started.
+ *
+ ****************************************************************************/
+
+static void wd_wheel_link(FAR struct wdog_s *wdog, int index)
+{
+	FAR struct wd_slot_s *slot = &g_wdwheel.slot[index];
+
+	wdog->next = NULL;
+	wdog->prev = slot->tail;
+	wdog->wslot = index;
+
+	if (slot->tail) {
+		slot->tail->next = wdog;
+	} else {
+		slot->head = wdog;
+	}
+	slot->tail = wdog;
+
+	if (index != WD_WHEEL_EXPIRED) {
+		g_wdwheel.bitmap[index / WD_WHEEL_SIZE] |= (uint64_t)1 << (index & WD_WHEEL_MASK);
+	}
+}
+
+/****************************************************************************
+ * Name: wd_wheel_detach
+ *
+ * Description:
+ *   Empty a slot and return the list of watchdogs it held.
+ *
+ ****************************************************************************/
+
+static FAR struct wdog_s *wd_wheel_detach(int index)
+{
+	FAR struct wd_slot_s *slot = &g_wdwheel.slot[index];
+	FAR struct wdog_s *list = slot->head;
+
+	slot->head = NULL;
+	slot->tail = NULL;
+	if (index != WD_WHEEL_EXPIRED) {
+		g_wdwheel.bitmap[index / WD_WHEEL_SIZE] &= ~((uint64_t)1 << (index & WD_WHEEL_MASK));
+	}
+
+	return list;
+}
+
+/****************************************************************************
+ * Name: wd_wheel_nextslot
+ *
+ * Description:
+ *   Return the distance (1..WD_WHEEL_SIZE) from slot 'index' to the next
+ *   non-empty slot of 'level', or 0 if the level is empty.
+ *
+ ****************************************************************************/
+
+static int wd_wheel_nextslot(int level, int index)
+{
+	uint64_t map = g_wdwheel.bitmap[level];
+	int start = (index + 1) & WD_WHEEL_MASK;
+
+	if (map == 0) {
+		return 0;
+	}
+
+	/* Rotate so that bit 0 is the slot right after 'index' */
+
+	if (start) {
+		map = (map >> start) | (map << (WD_WHEEL_SIZE - start));
+	}
+
+	return __builtin_ctzll(map) + 1;
+}
+
+/****************************************************************************
+ * Name: wd_wheel_cascade
+ *
+ * Description:
+ *   Called each time the level 0 index wraps.  Re-distribute the watchdogs
+ *   of the current slot of each upper level to the lower levels.
+ *
+ ****************************************************************************/
+
+static void wd_wheel_cascade(void)
+{
+	FAR struct wdog_s *wdog;
+	FAR struct wdog_s *next;
+	int level;
+	int index;
+
+	for (level = 1; level < WD_WHEEL_LEVELS; level++) {
+		index = WD_WHEEL_INDEX(g_wdwheel.now, level);
+
+		for (wdog = wd_wheel_detach(WD_WHEEL_SLOT(level, index)); wdog; wdog = next) {
+			next = wdog->next;
+			wd_wheel_insert(wdog);
+		}
+
+		/* Higher levels only move when this one wraps as well */
+
+		if (index != 0) {
+			break;
+		}
+	}
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+void wd_wheel_initialize(void)
+{
+	memset(&g_wdwheel, 0, sizeof(g_wdwheel));
+}
+
+void wd_wheel_insert(FAR struct wdog_s *wdog)
+{
+	int32_t delta = (int32_t)(wdog->expires - g_wdwheel.now);
+	uint32_t expires = wdog->expires;
+	int level;
+
+	if (delta < 0) {
+		/* Already due, can only happen when the wheel was advanced without
+		 * executing the watchdogs.
+		 */
+
+		wd_wheel_link(wdog, WD_WHEEL_EXPIRED);
+		return;
+	}
+
+	if (delta > WD_WHEEL_MAXDELAY) {
+		expires = g_wdwheel.now + WD_WHEEL_MAXDELAY;
+		delta = WD_WHEEL_MAXDELAY;
+	}
+
+	for (level = 0; level < WD_WHEEL_LEVELS - 1; level++) {
+		if (delta < (1 << WD_WHEEL_SHIFT(level + 1))) {
+			break;
+		}
+	}
+
+	wd_wheel_link(wdog, WD_WHEEL_SLOT(level, WD_WHEEL_INDEX(expires, level)));
+}
+
+void wd_wheel_remove(FAR struct wdog_s *wdog)
+{
+	FAR struct wd_slot_s *slot = &g_wdwheel.slot[wdog->wslot];
+
+	DEBUGASSERT(wdog->wslot <= WD_WHEEL_EXPIRED);
+
+	if (wdog->prev) {
+		wdog->prev->next = wdog->next;
+	} else {
+		slot->head = wdog->next;
+	}
+
+	if (wdog->next) {
+		wdog->next->prev = wdog->prev;
+	} else {
+		slot->tail = wdog->prev;
+	}
+
+	if (slot->head == NULL && wdog->wslot != WD_WHEEL_EXPIRED) {
+		g_wdwheel.bitmap[wdog->wslot / WD_WHEEL_SIZE] &= ~((uint64_t)1 << (wdog->wslot & WD_WHEEL_MASK));
+	}
+
+	wdog->next = NULL;
+	wdog->prev = NULL;
+}
+
+void wd_wheel_advance(clock_t ticks)
+{
+	FAR struct wdog_s *wdog;
+	FAR struct wdog_s *next;
+	clock_t step;
+	int index;
+	int dist;
+
+	while (ticks > 0) {
+		/* Skip over empty level 0 slots, but stop at the next wrap so that
+		 * the upper levels get cascaded in time.
+		 */
+
+		index = WD_WHEEL_INDEX(g_wdwheel.now, 0);
+		step = WD_WHEEL_SIZE - index;
+		dist = wd_wheel_nextslot(0, index);
+		if (dist > 0 && dist < step) {
+			step = dist;
+		}
+
+		if (step > ticks) {
+			step = ticks;
+		}
+
+		g_wdwheel.now += step;
+		ticks -= step;
+
+		index = WD_WHEEL_INDEX(g_wdwheel.now, 0);
+		if (index == 0) {
+			wd_wheel_cascade();
+		}
+
+		/* Everything in the current level 0 slot is due now */
+
+		if (g_wdwheel.bitmap[0] & ((uint64_t)1 << index)) {
+			for (wdog = wd_wheel_detach(WD_WHEEL_SLOT(0, index)); wdog; wdog = next) {
+				next = wdog->next;
+				wd_wheel_link(wdog, WD_WHEEL_EXPIRED);
+			}
+		}
+	}
+}
+
+FAR struct wdog_s *wd_wheel_popexpired(void)
+{
+	FAR struct wdog_s *wdog = g_wdwheel.slot[WD_WHEEL_EXPIRED].head;
+
+	if (wdog) {
+		wd_wheel_remove(wdog);
+	}
+
+	return wdog;
+}
+
+int wd_wheel_nextdelay(void)
+{
+	FAR struct wdog_s *wdog;
+	int32_t best = INT32_MAX;
+	int32_t delta;
+	int scanned;
+	int level;
+	int index;
+	int dist;
+
+	if (g_wdwheel.slot[WD_WHEEL_EXPIRED].head) {
+		return 0;
+	}
+
+	/* Within one level, the slots following the current index are ordered
+	 * by expiration, so only the first non-empty slot of each level has to
+	 * be looked at.  The last level also holds the delays beyond
+	 * WD_WHEEL_MAXDELAY which break that order, so all of its slots are
+	 * looked at.
+	 */
+
+	for (level = 0; level < WD_WHEEL_LEVELS; level++) {
+		index = WD_WHEEL_INDEX(g_wdwheel.now, level);
+		scanned = 0;
+		while ((dist = wd_wheel_nextslot(level, index)) != 0 && (scanned += dist) <= WD_WHEEL_SIZE) {
+			index = (index + dist) & WD_WHEEL_MASK;
+			for (wdog = g_wdwheel.slot[WD_WHEEL_SLOT(level, index)].head; wdog; wdog = wdog->next) {
+				delta = (int32_t)(wdog->expires - g_wdwheel.now);
+				if (delta < best) {
+					best = delta;
+				}
+
+				/* All watchdogs of a level 0 slot expire on the same tick */
+
+				if (level == 0) {
+					break;
+				}
+			}
+
+			if (level < WD_WHEEL_LEVELS - 1) {
+				break;
+			}
+		}
+	}
+
+	return best == INT32_MAX ? 0 : best;
+}
+
+#endif							/* CONFIG_WDOG_TIMING_WHEEL */
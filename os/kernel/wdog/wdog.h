@@ -69,10 +69,45 @@
  * Pre-processor Definitions
  ************************************************************************/
 
+#ifdef CONFIG_WDOG_TIMING_WHEEL
+/* The timing wheel has WD_WHEEL_LEVELS levels of WD_WHEEL_SIZE slots.  A
+ * slot of level n covers 2^(n * WD_WHEEL_BITS) ticks.  One more slot,
+ * WD_WHEEL_EXPIRED, holds the watchdogs whose time has come but which were
+ * not executed yet.
+ */
+
+#define WD_WHEEL_BITS      6
+#define WD_WHEEL_SIZE      (1 << WD_WHEEL_BITS)
+#define WD_WHEEL_MASK      (WD_WHEEL_SIZE - 1)
+#define WD_WHEEL_LEVELS    4
+#define WD_WHEEL_NSLOTS    (WD_WHEEL_LEVELS * WD_WHEEL_SIZE)
+#define WD_WHEEL_EXPIRED   WD_WHEEL_NSLOTS
+
+/* Longer delays are parked in the last level and re-evaluated when that
+ * slot is cascaded.
+ */
+
+#define WD_WHEEL_MAXDELAY  ((1 << (WD_WHEEL_BITS * WD_WHEEL_LEVELS)) - \
+							(1 << (WD_WHEEL_BITS * (WD_WHEEL_LEVELS - 1))))
+#endif
+
 /************************************************************************
  * Public Type Declarations
  ************************************************************************/
 
+#ifdef CONFIG_WDOG_TIMING_WHEEL
+struct wd_slot_s {
+	FAR struct wdog_s *head;
+	FAR struct wdog_s *tail;
+};
+
+struct wd_wheel_s {
+	uint32_t now;						/* Current tick of the wheel */
+	uint64_t bitmap[WD_WHEEL_LEVELS];	/* Non-empty slots per level */
+	struct wd_slot_s slot[WD_WHEEL_NSLOTS + 1];
+};
+#endif
+
 /************************************************************************
  * Public Variables
  ************************************************************************/
@@ -104,6 +139,14 @@ extern sq_queue_t g_wdactivelist;
 
 extern uint16_t g_wdnfree;
 
+#ifdef CONFIG_WDOG_TIMING_WHEEL
+/* With CONFIG_WDOG_TIMING_WHEEL, active watchdogs are kept in g_wdwheel
+ * instead of g_wdactivelist.
+ */
+
+extern struct wd_wheel_s g_wdwheel;
+#endif
+
 /************************************************************************
  * Public Function Prototypes
  ************************************************************************/
@@ -179,6 +222,31 @@ void wd_timer(void);
 #ifdef CONFIG_SCHED_TICKSUPPRESS
 void wd_timer_nohz(clock_t ticks);
 #endif
+#ifdef CONFIG_WDOG_TIMING_WHEEL
+/****************************************************************************
+ * Timing wheel primitives (wd_wheel.c)
+ *
+ *   wd_wheel_initialize - Empty the wheel
+ *   wd_wheel_insert     - Queue an active watchdog by wdog->expires
+ *   wd_wheel_remove     - Unlink a queued watchdog, O(1)
+ *   wd_wheel_advance    - Move the wheel forward by 'ticks' and collect
+ *                         the watchdogs which became due in the expired slot
+ *   wd_wheel_popexpired - Take the next due watchdog, NULL if none
+ *   wd_wheel_nextdelay  - Ticks until the next watchdog expires, 0 if none
+ *
+ * Assumptions:
+ *   Called with interrupts disabled.
+ *
+ ****************************************************************************/
+
+void wd_wheel_initialize(void);
+void wd_wheel_insert(FAR struct wdog_s *wdog);
+void wd_wheel_remove(FAR struct wdog_s *wdog);
+void wd_wheel_advance(clock_t ticks);
+FAR struct wdog_s *wd_wheel_popexpired(void);
+int wd_wheel_nextdelay(void);
+#endif
+
 #ifdef CONFIG_DEBUG
 void wd_corruption_dbg(struct wdog_s *wdog);
 #else
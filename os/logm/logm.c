@@ -83,14 +83,27 @@ int logm_internal(int flag, int indx, int priority, const char *fmt, va_list ap)
 #ifdef CONFIG_LOGM_TIMESTAMP
 	struct timespec ts;
 #endif
+#ifdef CONFIG_LOGM_TEST
+	struct timespec irqoff;
+#endif
 
 	if (LOGM_STATUS(LOGM_READY) && !LOGM_STATUS(LOGM_BUFFER_RESIZE_REQ) \
 		&& flag == LOGM_NORMAL && !up_interrupt_context()) {
 
+#ifdef CONFIG_LOGM_BINARY
+		/* Only the arguments are queued, the logm task formats them */
+		return logm_binary_put(priority, fmt, ap);
+#endif
 		flags = enter_critical_section();
+#ifdef CONFIG_LOGM_TEST
+		LOGM_IRQOFF_BEGIN(irqoff);
+#endif
 
 		if (LOGM_STATUS(LOGM_BUFFER_OVERFLOW)) {
 			g_logm_dropmsg_count++;
+#ifdef CONFIG_LOGM_TEST
+			LOGM_IRQOFF_END(irqoff);
+#endif
 			leave_critical_section(flags);
 			return 0;
 		}
@@ -113,6 +126,9 @@ int logm_internal(int flag, int indx, int priority, const char *fmt, va_list ap)
 			g_logm_dropmsg_count = 1;
 			g_logm_overflow_offset = g_logm_tail;
 		}
+#ifdef CONFIG_LOGM_TEST
+		LOGM_IRQOFF_END(irqoff);
+#endif
 		leave_critical_section(flags);
 	} else {
 		/* Low Output: Sytem is not yet completely ready or this is called from interrupt handler */
@@ -20,6 +20,10 @@
 
 #include <tinyara/config.h>
 #include <stdint.h>
+#include <stdarg.h>
+#ifdef CONFIG_LOGM_TEST
+#include <tinyara/clock.h>
+#endif
 
 /****************************************************************************
  * Preprocessor Definitions
@@ -51,6 +55,12 @@
 #define LOGM_STATUS_SET(a) (logm_status |= (a))
 #define LOGM_STATUS_CLEAR(a) (logm_status &= ~(a))
 
+#ifdef CONFIG_LOGM_TEST
+/* Account the time spent with interrupts disabled by a logging call */
+#define LOGM_IRQOFF_BEGIN(ts) (void)clock_systimespec(&(ts))
+#define LOGM_IRQOFF_END(ts) logmtest_irqoff(&(ts))
+#endif
+
 /****************************************************************************
  * Private Declarations
  ****************************************************************************/
@@ -80,6 +90,14 @@ EXTERN volatile int logm_print_interval;
  ************************************************************************************/
 int logm_task(int argc, char *argv[]);
 void logm_register_tashcmds(void);
+#ifdef CONFIG_LOGM_BINARY
+int logm_binary_initialize(void);
+int logm_binary_put(int priority, const char *fmt, va_list ap);
+void logm_binary_flush(void);
+#endif
+#ifdef CONFIG_LOGM_TEST
+void logmtest_irqoff(const struct timespec *start);
+#endif
 
 #undef EXTERN
 #if defined(__cplusplus)
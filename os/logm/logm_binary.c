@@ -0,0 +1,1065 @@
+/****************************************************************************
+ *
+ * Copyright 2025 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <tinyara/config.h>
+
+#include <sys/types.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <string.h>
+#include <unistd.h>
+#include <debug.h>
+
+#include <arch/irq.h>
+#include <tinyara/arch.h>
+#include <tinyara/clock.h>
+#include <tinyara/kmalloc.h>
+#include <tinyara/spinlock.h>
+#include <tinyara/streams.h>
+
+#include "logm.h"
+
+#ifdef CONFIG_LOGM_BINARY
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#if (CONFIG_LOGM_BINARY_BUFFER_SIZE & (CONFIG_LOGM_BINARY_BUFFER_SIZE - 1)) != 0
+#error "CONFIG_LOGM_BINARY_BUFFER_SIZE must be a power of two"
+#endif
+
+#define LOGM_BIN_SIZE        CONFIG_LOGM_BINARY_BUFFER_SIZE
+#define LOGM_BIN_MASK        (LOGM_BIN_SIZE - 1)
+#define LOGM_BIN_MAXREC      (LOGM_BIN_SIZE / 2)
+#define LOGM_BIN_ALIGN(n)    (((n) + 3) & ~3)
+#define LOGM_BIN_OUTBUF      256
+#define LOGM_BIN_SPECLEN     32
+
+/* A record starts with one header word which is 0 while the record is
+ * being written and is set with a single store once it is complete.  The
+ * header is followed by the 32 bit tick count, the format (a pointer with
+ * LOGM_BIN_FMTPTR, a NUL terminated copy otherwise) and the arguments.
+ */
+
+#define LOGM_BIN_HDR(size, flags, prio) \
+	((uint32_t)(size) | ((uint32_t)(flags) << 16) | ((uint32_t)(prio) << 24))
+#define LOGM_BIN_HDR_SIZE(h)  ((h) & 0xffff)
+#define LOGM_BIN_HDR_FLAGS(h) (((h) >> 16) & 0xff)
+#define LOGM_BIN_HDR_PRIO(h)  ((h) >> 24)
+
+#define LOGM_BIN_PAD         0x01	/* Filler up to the end of the ring */
+#define LOGM_BIN_FMTPTR      0x02	/* Format stored as a pointer */
+#define LOGM_BIN_INFO        0x04	/* Stream description, raw output only */
+
+/* Each argument is a tag byte followed by its value in native byte order.
+ * A string is a length byte followed by the characters, without NUL.
+ */
+
+#define LOGM_ARG_INT32       1
+#define LOGM_ARG_INT64       2
+#define LOGM_ARG_DOUBLE      3
+#define LOGM_ARG_STRING      4
+
+#define LOGM_BIN_VERSION     1
+
+/* Ring buffers are written by the tasks and interrupt-free sections of
+ * one CPU only, and read by the logm task which may run on another CPU.
+ */
+
+#ifdef CONFIG_SMP
+#define LOGM_BIN_WMB()       SP_DMB()
+#define LOGM_BIN_RMB()       SP_DSB()
+#else
+#define LOGM_BIN_WMB()       __asm__ __volatile__("" : : : "memory")
+#define LOGM_BIN_RMB()       __asm__ __volatile__("" : : : "memory")
+#endif
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+struct logm_bin_ring_s {
+	FAR uint8_t *buf;
+	volatile uint32_t head;		/* Free running, advanced by the logm task */
+	volatile uint32_t tail;		/* Free running, advanced by the loggers */
+	volatile uint32_t dropped;	/* Messages dropped because the ring was full */
+	uint32_t reported;			/* Drops already reported by the logm task */
+};
+
+enum logm_bin_len_e {
+	LOGM_LEN_NONE,
+	LOGM_LEN_HH,
+	LOGM_LEN_H,
+	LOGM_LEN_L,
+	LOGM_LEN_LL,
+	LOGM_LEN_Z,
+	LOGM_LEN_J,
+	LOGM_LEN_T,
+	LOGM_LEN_BIGL
+};
+
+struct logm_bin_spec_s {
+	uint8_t conv;				/* Conversion character */
+	uint8_t len;				/* enum logm_bin_len_e */
+	bool wstar;					/* Width given as an argument */
+	bool pstar;					/* Precision given as an argument */
+	int prec;					/* Precision, -1 if none */
+};
+
+/* Argument writer.  With dst == NULL it only counts the bytes. */
+
+struct logm_bin_out_s {
+	FAR uint8_t *dst;
+	size_t len;
+	size_t max;
+};
+
+/* Argument reader */
+
+struct logm_bin_in_s {
+	FAR const uint8_t *ptr;
+	FAR const uint8_t *end;
+};
+
+struct logm_bin_arg_s {
+	uint8_t tag;
+	int64_t ival;
+	double dval;
+	FAR const char *str;
+	int slen;
+};
+
+struct logm_bin_outstream_s {
+	struct lib_outstream_s public;
+	int len;
+};
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static struct logm_bin_ring_s g_logm_bin[CONFIG_SMP_NCPUS];
+
+/* Only used by the logm task */
+
+static char g_logm_bin_outbuf[LOGM_BIN_OUTBUF];
+static char g_logm_bin_str[CONFIG_LOGM_BINARY_STRMAX + 1];
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: logm_bin_parse
+ *
+ * Description:
+ *   Parse one conversion specification, 'fmt' points right after the '%'.
+ *   Returns a pointer to the character following the specification.
+ *
+ ****************************************************************************/
+
+static FAR const char *logm_bin_parse(FAR const char *fmt, FAR struct logm_bin_spec_s *spec)
+{
+	spec->len = LOGM_LEN_NONE;
+	spec->wstar = false;
+	spec->pstar = false;
+	spec->prec = -1;
+
+	while (*fmt == '-' || *fmt == '+' || *fmt == ' ' || *fmt == '#' || *fmt == '0') {
+		fmt++;
+	}
+
+	if (*fmt == '*') {
+		spec->wstar = true;
+		fmt++;
+	} else {
+		while (*fmt >= '0' && *fmt <= '9') {
+			fmt++;
+		}
+	}
+
+	if (*fmt == '.') {
+		fmt++;
+		if (*fmt == '*') {
+			spec->pstar = true;
+			fmt++;
+		} else {
+			spec->prec = 0;
+			while (*fmt >= '0' && *fmt <= '9') {
+				spec->prec = spec->prec * 10 + (*fmt++ - '0');
+			}
+		}
+	}
+
+	switch (*fmt) {
+	case 'h':
+		fmt++;
+		spec->len = LOGM_LEN_H;
+		if (*fmt == 'h') {
+			fmt++;
+			spec->len = LOGM_LEN_HH;
+		}
+		break;
+	case 'l':
+		fmt++;
+		spec->len = LOGM_LEN_L;
+		if (*fmt == 'l') {
+			fmt++;
+			spec->len = LOGM_LEN_LL;
+		}
+		break;
+	case 'z':
+		fmt++;
+		spec->len = LOGM_LEN_Z;
+		break;
+	case 'j':
+		fmt++;
+		spec->len = LOGM_LEN_J;
+		break;
+	case 't':
+		fmt++;
+		spec->len = LOGM_LEN_T;
+		break;
+	case 'L':
+		fmt++;
+		spec->len = LOGM_LEN_BIGL;
+		break;
+	default:
+		break;
+	}
+
+	spec->conv = *fmt;
+	if (*fmt != '\0') {
+		fmt++;
+	}
+
+	return fmt;
+}
+
+/****************************************************************************
+ * Name: logm_bin_emit
+ ****************************************************************************/
+
+static bool logm_bin_emit(FAR struct logm_bin_out_s *out, uint8_t tag, FAR const void *data, size_t size)
+{
+	if (out->len + 1 + size > out->max) {
+		return false;
+	}
+
+	if (out->dst) {
+		out->dst[out->len] = tag;
+		memcpy(&out->dst[out->len + 1], data, size);
+	}
+
+	out->len += 1 + size;
+	return true;
+}
+
+static bool logm_bin_emitint(FAR struct logm_bin_out_s *out, int64_t value, size_t size)
+{
+	int32_t value32;
+
+	if (size <= sizeof(int32_t)) {
+		value32 = (int32_t)value;
+		return logm_bin_emit(out, LOGM_ARG_INT32, &value32, sizeof(value32));
+	}
+
+	return logm_bin_emit(out, LOGM_ARG_INT64, &value, sizeof(value));
+}
+
+static bool logm_bin_emitstr(FAR struct logm_bin_out_s *out, FAR const char *str, int prec)
+{
+	size_t max = CONFIG_LOGM_BINARY_STRMAX;
+	size_t len;
+
+	if (str == NULL) {
+		str = "(null)";
+	}
+
+	/* Never read beyond the precision, the string may not be terminated */
+
+	if (prec >= 0 && (size_t)prec < max) {
+		max = prec;
+	}
+
+	len = strnlen(str, max);
+	if (out->len + 2 + len > out->max) {
+		return false;
+	}
+
+	if (out->dst) {
+		out->dst[out->len] = LOGM_ARG_STRING;
+		out->dst[out->len + 1] = (uint8_t)len;
+		memcpy(&out->dst[out->len + 2], str, len);
+	}
+
+	out->len += 2 + len;
+	return true;
+}
+
+/****************************************************************************
+ * Name: logm_bin_capture
+ *
+ * Description:
+ *   Walk the format and store the arguments it consumes.  A conversion
+ *   which is not known takes no argument, the same as on the decoding side.
+ *   Returns false if the arguments do not fit in out->max bytes.
+ *
+ ****************************************************************************/
+
+static bool logm_bin_capture(FAR struct logm_bin_out_s *out, FAR const char *fmt, va_list ap)
+{
+	struct logm_bin_spec_s spec;
+	FAR void *ptr;
+	bool ok = true;
+	double dval;
+	int prec;
+
+	while (ok && *fmt != '\0') {
+		if (*fmt++ != '%') {
+			continue;
+		}
+
+		if (*fmt == '%') {
+			fmt++;
+			continue;
+		}
+
+		fmt = logm_bin_parse(fmt, &spec);
+
+		if (spec.wstar) {
+			ok = logm_bin_emitint(out, va_arg(ap, int), sizeof(int));
+		}
+
+		if (ok && spec.pstar) {
+			prec = va_arg(ap, int);
+			spec.prec = prec >= 0 ? prec : -1;
+			ok = logm_bin_emitint(out, prec, sizeof(int));
+		}
+
+		if (!ok) {
+			break;
+		}
+
+		switch (spec.conv) {
+		case 'd':
+		case 'i':
+			switch (spec.len) {
+			case LOGM_LEN_L:
+				ok = logm_bin_emitint(out, va_arg(ap, long), sizeof(long));
+				break;
+			case LOGM_LEN_LL:
+				ok = logm_bin_emitint(out, va_arg(ap, long long), sizeof(long long));
+				break;
+			case LOGM_LEN_Z:
+				ok = logm_bin_emitint(out, va_arg(ap, ssize_t), sizeof(ssize_t));
+				break;
+			case LOGM_LEN_J:
+				ok = logm_bin_emitint(out, va_arg(ap, intmax_t), sizeof(intmax_t));
+				break;
+			case LOGM_LEN_T:
+				ok = logm_bin_emitint(out, va_arg(ap, ptrdiff_t), sizeof(ptrdiff_t));
+				break;
+			default:
+				ok = logm_bin_emitint(out, va_arg(ap, int), sizeof(int));
+				break;
+			}
+			break;
+
+		case 'u':
+		case 'o':
+		case 'x':
+		case 'X':
+			switch (spec.len) {
+			case LOGM_LEN_L:
+				ok = logm_bin_emitint(out, va_arg(ap, unsigned long), sizeof(unsigned long));
+				break;
+			case LOGM_LEN_LL:
+				ok = logm_bin_emitint(out, va_arg(ap, unsigned long long), sizeof(unsigned long long));
+				break;
+			case LOGM_LEN_Z:
+				ok = logm_bin_emitint(out, va_arg(ap, size_t), sizeof(size_t));
+				break;
+			case LOGM_LEN_J:
+				ok = logm_bin_emitint(out, va_arg(ap, uintmax_t), sizeof(uintmax_t));
+				break;
+			case LOGM_LEN_T:
+				ok = logm_bin_emitint(out, va_arg(ap, ptrdiff_t), sizeof(ptrdiff_t));
+				break;
+			default:
+				ok = logm_bin_emitint(out, va_arg(ap, unsigned int), sizeof(unsigned int));
+				break;
+			}
+			break;
+
+		case 'c':
+			ok = logm_bin_emitint(out, va_arg(ap, int), sizeof(int));
+			break;
+
+		case 'p':
+			ok = logm_bin_emitint(out, (uintptr_t)va_arg(ap, FAR void *), sizeof(uintptr_t));
+			break;
+
+		case 's':
+			ok = logm_bin_emitstr(out, va_arg(ap, FAR const char *), spec.prec);
+			break;
+
+		case 'f':
+		case 'F':
+		case 'e':
+		case 'E':
+		case 'g':
+		case 'G':
+		case 'a':
+		case 'A':
+			if (spec.len == LOGM_LEN_BIGL) {
+				dval = (double)va_arg(ap, long double);
+			} else {
+				dval = va_arg(ap, double);
+			}
+			ok = logm_bin_emit(out, LOGM_ARG_DOUBLE, &dval, sizeof(dval));
+			break;
+
+		case 'n':
+			/* Nothing is printed yet, so there is no count to store */
+
+			ptr = va_arg(ap, FAR void *);
+			(void)ptr;
+			break;
+
+		default:
+			break;
+		}
+	}
+
+	return ok;
+}
+
+/****************************************************************************
+ * Name: logm_bin_pop
+ ****************************************************************************/
+
+static bool logm_bin_pop(FAR struct logm_bin_in_s *in, FAR struct logm_bin_arg_s *arg)
+{
+	int32_t value32;
+
+	if (in->ptr >= in->end) {
+		return false;
+	}
+
+	arg->tag = *in->ptr++;
+	switch (arg->tag) {
+	case LOGM_ARG_INT32:
+		if (in->end - in->ptr < (ptrdiff_t)sizeof(value32)) {
+			return false;
+		}
+		memcpy(&value32, in->ptr, sizeof(value32));
+		arg->ival = value32;
+		in->ptr += sizeof(value32);
+		break;
+	case LOGM_ARG_INT64:
+		if (in->end - in->ptr < (ptrdiff_t)sizeof(arg->ival)) {
+			return false;
+		}
+		memcpy(&arg->ival, in->ptr, sizeof(arg->ival));
+		in->ptr += sizeof(arg->ival);
+		break;
+	case LOGM_ARG_DOUBLE:
+		if (in->end - in->ptr < (ptrdiff_t)sizeof(arg->dval)) {
+			return false;
+		}
+		memcpy(&arg->dval, in->ptr, sizeof(arg->dval));
+		in->ptr += sizeof(arg->dval);
+		break;
+	case LOGM_ARG_STRING:
+		if (in->ptr >= in->end || in->end - in->ptr - 1 < *in->ptr) {
+			return false;
+		}
+		arg->slen = *in->ptr++;
+		arg->str = (FAR const char *)in->ptr;
+		in->ptr += arg->slen;
+		break;
+	default:
+		in->ptr = in->end;
+		return false;
+	}
+
+	return true;
+}
+
+/****************************************************************************
+ * Name: logm_bin_putspec
+ *
+ * Description:
+ *   Print one argument with lib_sprintf().  'spec' is the conversion
+ *   specification with the '*' already replaced by their values.
+ *
+ ****************************************************************************/
+
+static void logm_bin_putspec(FAR struct lib_outstream_s *stream, FAR const char *spec, FAR const struct logm_bin_spec_s *info, FAR const struct logm_bin_arg_s *arg)
+{
+	int64_t v = arg->ival;
+
+	switch (info->conv) {
+	case 'd':
+	case 'i':
+		switch (info->len) {
+		case LOGM_LEN_L:
+			lib_sprintf(stream, spec, (long)v);
+			break;
+		case LOGM_LEN_LL:
+			lib_sprintf(stream, spec, (long long)v);
+			break;
+		case LOGM_LEN_Z:
+			lib_sprintf(stream, spec, (ssize_t)v);
+			break;
+		case LOGM_LEN_J:
+			lib_sprintf(stream, spec, (intmax_t)v);
+			break;
+		case LOGM_LEN_T:
+			lib_sprintf(stream, spec, (ptrdiff_t)v);
+			break;
+		default:
+			lib_sprintf(stream, spec, (int)v);
+			break;
+		}
+		break;
+
+	case 'u':
+	case 'o':
+	case 'x':
+	case 'X':
+		switch (info->len) {
+		case LOGM_LEN_L:
+			lib_sprintf(stream, spec, (unsigned long)v);
+			break;
+		case LOGM_LEN_LL:
+			lib_sprintf(stream, spec, (unsigned long long)v);
+			break;
+		case LOGM_LEN_Z:
+			lib_sprintf(stream, spec, (size_t)v);
+			break;
+		case LOGM_LEN_J:
+			lib_sprintf(stream, spec, (uintmax_t)v);
+			break;
+		case LOGM_LEN_T:
+			lib_sprintf(stream, spec, (ptrdiff_t)v);
+			break;
+		default:
+			lib_sprintf(stream, spec, (unsigned int)v);
+			break;
+		}
+		break;
+
+	case 'c':
+		lib_sprintf(stream, spec, (int)v);
+		break;
+
+	case 'p':
+		lib_sprintf(stream, spec, (FAR void *)(uintptr_t)v);
+		break;
+
+	case 's':
+		memcpy(g_logm_bin_str, arg->str, arg->slen);
+		g_logm_bin_str[arg->slen] = '\0';
+		lib_sprintf(stream, spec, g_logm_bin_str);
+		break;
+
+	default:
+		if (info->len == LOGM_LEN_BIGL) {
+			lib_sprintf(stream, spec, (long double)arg->dval);
+		} else {
+			lib_sprintf(stream, spec, arg->dval);
+		}
+		break;
+	}
+}
+
+/****************************************************************************
+ * Name: logm_bin_format
+ *
+ * Description:
+ *   Print a record as text, the way lib_vsprintf() would have printed the
+ *   message in the caller.
+ *
+ ****************************************************************************/
+
+static void logm_bin_format(FAR struct lib_outstream_s *stream, FAR const uint8_t *rec, uint32_t hdr)
+{
+	struct logm_bin_spec_s info;
+	struct logm_bin_arg_s arg;
+	struct logm_bin_in_s in;
+	FAR const char *start;
+	FAR const char *fmt;
+	FAR const char *p;
+	char spec[LOGM_BIN_SPECLEN];
+	uintptr_t addr;
+	uint32_t ticks;
+	bool ok;
+	int len;
+
+	in.end = rec + LOGM_BIN_HDR_SIZE(hdr);
+	in.ptr = rec + sizeof(uint32_t);
+
+	memcpy(&ticks, in.ptr, sizeof(ticks));
+	in.ptr += sizeof(ticks);
+
+	if (LOGM_BIN_HDR_FLAGS(hdr) & LOGM_BIN_FMTPTR) {
+		memcpy(&addr, in.ptr, sizeof(addr));
+		fmt = (FAR const char *)addr;
+		in.ptr += sizeof(addr);
+	} else {
+		fmt = (FAR const char *)in.ptr;
+		in.ptr += strlen(fmt) + 1;
+	}
+
+#ifdef CONFIG_LOGM_TIMESTAMP
+	(void)lib_sprintf(stream, "[%4d.%4d] ", (int)(ticks / TICK_PER_SEC), (int)(TICK2USEC(ticks % TICK_PER_SEC) / 100));
+#else
+	(void)ticks;
+#endif
+
+	while (*fmt != '\0') {
+		if (*fmt != '%') {
+			stream->put(stream, *fmt++);
+			continue;
+		}
+
+		start = fmt++;
+		if (*fmt == '%') {
+			stream->put(stream, *fmt++);
+			continue;
+		}
+
+		fmt = logm_bin_parse(fmt, &info);
+
+		/* Rebuild the specification with the '*' replaced by their values */
+
+		ok = true;
+		len = 0;
+		for (p = start; ok && p < fmt; p++) {
+			if (*p != '*') {
+				if (len < LOGM_BIN_SPECLEN - 1) {
+					spec[len++] = *p;
+				} else {
+					ok = false;
+				}
+			} else if (!logm_bin_pop(&in, &arg) || arg.tag != LOGM_ARG_INT32) {
+				ok = false;
+			} else if (arg.ival < 0 && p[-1] == '.') {
+				/* A negative precision is taken as if it was omitted */
+
+				len--;
+			} else {
+				len += snprintf(&spec[len], LOGM_BIN_SPECLEN - len, "%d", (int)arg.ival);
+				if (len >= LOGM_BIN_SPECLEN) {
+					ok = false;
+				}
+			}
+		}
+
+		if (ok) {
+			spec[len] = '\0';
+			switch (info.conv) {
+			case 'n':
+				break;
+			case 'd': case 'i': case 'u': case 'o': case 'x': case 'X': case 'c': case 'p':
+				ok = logm_bin_pop(&in, &arg) && (arg.tag == LOGM_ARG_INT32 || arg.tag == LOGM_ARG_INT64);
+				break;
+			case 's':
+				ok = logm_bin_pop(&in, &arg) && arg.tag == LOGM_ARG_STRING;
+				break;
+			case 'f': case 'F': case 'e': case 'E': case 'g': case 'G': case 'a': case 'A':
+				ok = logm_bin_pop(&in, &arg) && arg.tag == LOGM_ARG_DOUBLE;
+				break;
+			default:
+				ok = false;
+				break;
+			}
+		}
+
+		if (!ok) {
+			/* Unknown conversion or arguments missing, print it as is */
+
+			while (start < fmt) {
+				stream->put(stream, *start++);
+			}
+		} else if (info.conv != 'n') {
+			logm_bin_putspec(stream, spec, &info, &arg);
+		}
+	}
+}
+
+/****************************************************************************
+ * Name: logm_bin_putc / logm_bin_flushout
+ *
+ * Description:
+ *   Output stream of the logm task which collects the text and writes it
+ *   out in chunks of LOGM_BIN_OUTBUF bytes.
+ *
+ ****************************************************************************/
+
+static void logm_bin_flushout(FAR struct logm_bin_outstream_s *stream)
+{
+	int done = 0;
+	ssize_t ret;
+
+	while (done < stream->len) {
+		ret = write(STDOUT_FILENO, &g_logm_bin_outbuf[done], stream->len - done);
+		if (ret <= 0) {
+			break;
+		}
+		done += ret;
+	}
+
+	stream->len = 0;
+}
+
+static void logm_bin_putc(FAR struct lib_outstream_s *this, int ch)
+{
+	FAR struct logm_bin_outstream_s *stream = (FAR struct logm_bin_outstream_s *)this;
+
+	if (stream->len == LOGM_BIN_OUTBUF) {
+		logm_bin_flushout(stream);
+	}
+
+	g_logm_bin_outbuf[stream->len++] = ch;
+	this->nput++;
+}
+
+#ifdef CONFIG_LOGM_BINARY_RAW
+/****************************************************************************
+ * Name: logm_bin_putraw
+ *
+ * Description:
+ *   Write a record as it is for tools/logm_decoder, preceded by the "LM"
+ *   sync marker so that the decoder can skip any other console output.
+ *
+ ****************************************************************************/
+
+static void logm_bin_putraw(FAR struct lib_outstream_s *stream, FAR const uint8_t *rec, uint32_t hdr)
+{
+	uint32_t size = LOGM_BIN_HDR_SIZE(hdr);
+	uint32_t i;
+
+	stream->put(stream, 'L');
+	stream->put(stream, 'M');
+	for (i = 0; i < sizeof(hdr); i++) {
+		stream->put(stream, ((FAR const uint8_t *)&hdr)[i]);
+	}
+
+	for (i = sizeof(hdr); i < size; i++) {
+		stream->put(stream, rec[i]);
+	}
+}
+
+static void logm_bin_putinfo(FAR struct lib_outstream_s *stream)
+{
+	uint8_t rec[16];
+	uint32_t usec = USEC_PER_TICK;
+	uint32_t one = 1;
+
+	/* The header word itself is passed separately to logm_bin_putraw() */
+
+	memset(rec, 0, sizeof(rec));
+	rec[4] = LOGM_BIN_VERSION;
+	rec[5] = sizeof(uintptr_t);
+	rec[6] = *(FAR uint8_t *)&one;	/* 1 on little endian */
+	memcpy(&rec[8], &usec, sizeof(usec));
+
+	logm_bin_putraw(stream, rec, LOGM_BIN_HDR(sizeof(rec), LOGM_BIN_INFO, 0));
+}
+#endif
+
+/****************************************************************************
+ * Name: logm_bin_peek
+ *
+ * Description:
+ *   Return the oldest complete record of a ring, skipping the padding.
+ *
+ ****************************************************************************/
+
+static FAR const uint8_t *logm_bin_peek(FAR struct logm_bin_ring_s *ring, FAR uint32_t *hdr)
+{
+	FAR const uint8_t *rec;
+
+	while (ring->head != ring->tail) {
+		LOGM_BIN_RMB();
+
+		rec = &ring->buf[ring->head & LOGM_BIN_MASK];
+		*hdr = *(FAR volatile const uint32_t *)rec;
+		if (*hdr == 0) {
+			/* Reserved but still being written */
+
+			return NULL;
+		}
+
+		LOGM_BIN_RMB();
+		if ((LOGM_BIN_HDR_FLAGS(*hdr) & LOGM_BIN_PAD) == 0) {
+			return rec;
+		}
+
+		ring->head += LOGM_BIN_HDR_SIZE(*hdr);
+	}
+
+	return NULL;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: logm_binary_initialize
+ *
+ * Description:
+ *   Allocate the ring buffers, called by the logm task before it sets
+ *   LOGM_READY.
+ *
+ ****************************************************************************/
+
+int logm_binary_initialize(void)
+{
+	int cpu;
+
+	for (cpu = 0; cpu < CONFIG_SMP_NCPUS; cpu++) {
+		g_logm_bin[cpu].buf = (FAR uint8_t *)kmm_malloc(LOGM_BIN_SIZE);
+		if (g_logm_bin[cpu].buf == NULL) {
+			return ERROR;
+		}
+		g_logm_bin[cpu].head = 0;
+		g_logm_bin[cpu].tail = 0;
+		g_logm_bin[cpu].dropped = 0;
+		g_logm_bin[cpu].reported = 0;
+	}
+
+	logm_bufsize = LOGM_BIN_SIZE;
+	return OK;
+}
+
+/****************************************************************************
+ * Name: logm_binary_put
+ *
+ * Description:
+ *   Queue a message in the ring of the current CPU.  Interrupts are only
+ *   disabled to reserve the space for the record, the record itself is
+ *   filled in afterwards.
+ *
+ * Return Value:
+ *   Always 0, the message is not formatted yet.
+ *
+ ****************************************************************************/
+
+int logm_binary_put(int priority, FAR const char *fmt, va_list ap)
+{
+	FAR struct logm_bin_ring_s *ring;
+	struct logm_bin_out_s out;
+	FAR uint8_t *rec;
+	irqstate_t flags;
+	va_list ap2;
+	uint32_t ticks;
+	uint32_t tail;
+	uint32_t size;
+	uint32_t pos;
+	uint32_t pad;
+	size_t fmtlen;
+	uint8_t recflags;
+#ifdef CONFIG_LOGM_TEST
+	struct timespec ts;
+#endif
+
+	ticks = (uint32_t)clock_systimer();
+
+#ifdef CONFIG_LOGM_BINARY_FMTPTR
+	fmtlen = sizeof(uintptr_t);
+	recflags = LOGM_BIN_FMTPTR;
+#else
+	fmtlen = strlen(fmt) + 1;
+	recflags = 0;
+#endif
+
+	/* Size the record first so that the reservation is a few stores */
+
+	size = sizeof(uint32_t) + sizeof(ticks) + fmtlen;
+	out.dst = NULL;
+	out.len = 0;
+	out.max = size < LOGM_BIN_MAXREC ? LOGM_BIN_MAXREC - size : 0;
+
+	va_copy(ap2, ap);
+	if (out.max == 0 || !logm_bin_capture(&out, fmt, ap2)) {
+		va_end(ap2);
+		flags = irqsave();
+		g_logm_bin[up_cpu_index()].dropped++;
+		irqrestore(flags);
+		return 0;
+	}
+	va_end(ap2);
+
+	size = LOGM_BIN_ALIGN(size + out.len);
+
+	flags = irqsave();
+#ifdef CONFIG_LOGM_TEST
+	LOGM_IRQOFF_BEGIN(ts);
+#endif
+	ring = &g_logm_bin[up_cpu_index()];
+	tail = ring->tail;
+	pos = tail & LOGM_BIN_MASK;
+
+	/* Records never wrap, fill the end of the ring if this one does not fit */
+
+	pad = pos + size > LOGM_BIN_SIZE ? LOGM_BIN_SIZE - pos : 0;
+	if (tail + pad + size - ring->head > LOGM_BIN_SIZE) {
+		ring->dropped++;
+#ifdef CONFIG_LOGM_TEST
+		LOGM_IRQOFF_END(ts);
+#endif
+		irqrestore(flags);
+		return 0;
+	}
+
+	if (pad) {
+		*(FAR volatile uint32_t *)&ring->buf[pos] = LOGM_BIN_HDR(pad, LOGM_BIN_PAD, 0);
+		pos = 0;
+	}
+
+	rec = &ring->buf[pos];
+	*(FAR volatile uint32_t *)rec = 0;
+	LOGM_BIN_WMB();
+	ring->tail = tail + pad + size;
+#ifdef CONFIG_LOGM_TEST
+	LOGM_IRQOFF_END(ts);
+#endif
+	irqrestore(flags);
+
+	/* Fill in the record, the logm task does not look at it before the
+	 * header is set.
+	 */
+
+	memcpy(rec + sizeof(uint32_t), &ticks, sizeof(ticks));
+#ifdef CONFIG_LOGM_BINARY_FMTPTR
+	{
+		uintptr_t addr = (uintptr_t)fmt;
+		memcpy(rec + sizeof(uint32_t) + sizeof(ticks), &addr, sizeof(addr));
+	}
+#else
+	memcpy(rec + sizeof(uint32_t) + sizeof(ticks), fmt, fmtlen);
+#endif
+
+	/* A string argument could have grown since the sizing.  Then its
+	 * trailing arguments are missing and the conversions get printed as
+	 * they are.
+	 */
+
+	out.dst = rec + sizeof(uint32_t) + sizeof(ticks) + fmtlen;
+	out.max = out.len;
+	out.len = 0;
+	(void)logm_bin_capture(&out, fmt, ap);
+
+	LOGM_BIN_WMB();
+	*(FAR volatile uint32_t *)rec = LOGM_BIN_HDR(size, recflags, priority);
+
+	return 0;
+}
+
+/****************************************************************************
+ * Name: logm_binary_flush
+ *
+ * Description:
+ *   Print all complete records of all CPUs in time order, called by the
+ *   logm task.
+ *
+ ****************************************************************************/
+
+void logm_binary_flush(void)
+{
+	struct logm_bin_outstream_s stream;
+	FAR struct logm_bin_ring_s *best;
+	FAR const uint8_t *bestrec;
+	FAR const uint8_t *rec;
+	uint32_t besthdr;
+	uint32_t bestticks;
+	uint32_t ticks;
+	uint32_t hdr;
+	uint32_t dropped;
+	int cpu;
+
+	stream.public.put = logm_bin_putc;
+#ifdef CONFIG_STDIO_LINEBUFFER
+	stream.public.flush = lib_noflush;
+#endif
+	stream.public.nput = 0;
+	stream.len = 0;
+
+	for (;;) {
+		best = NULL;
+		bestrec = NULL;
+		besthdr = 0;
+		bestticks = 0;
+
+		for (cpu = 0; cpu < CONFIG_SMP_NCPUS; cpu++) {
+			rec = logm_bin_peek(&g_logm_bin[cpu], &hdr);
+			if (rec == NULL) {
+				continue;
+			}
+
+			memcpy(&ticks, rec + sizeof(uint32_t), sizeof(ticks));
+			if (best == NULL || (int32_t)(ticks - bestticks) < 0) {
+				best = &g_logm_bin[cpu];
+				bestrec = rec;
+				besthdr = hdr;
+				bestticks = ticks;
+			}
+		}
+
+		if (best == NULL) {
+			break;
+		}
+
+#ifdef CONFIG_LOGM_BINARY_RAW
+		if (stream.public.nput == 0) {
+			logm_bin_putinfo(&stream.public);
+		}
+		logm_bin_putraw(&stream.public, bestrec, besthdr);
+#else
+		logm_bin_format(&stream.public, bestrec, besthdr);
+#endif
+
+		LOGM_BIN_RMB();
+		best->head += LOGM_BIN_HDR_SIZE(besthdr);
+	}
+
+	for (cpu = 0; cpu < CONFIG_SMP_NCPUS; cpu++) {
+		dropped = g_logm_bin[cpu].dropped;
+		if (dropped != g_logm_bin[cpu].reported) {
+			lib_sprintf(&stream.public, "\n[LOGM BUFFER OVERFLOW] %u messages are dropped\n", dropped - g_logm_bin[cpu].reported);
+			g_logm_bin[cpu].reported = dropped;
+		}
+	}
+
+	logm_bin_flushout(&stream);
+}
+
+#endif							/* CONFIG_LOGM_BINARY */
@@ -19,6 +19,8 @@
 #include <stdlib.h>
 #include <string.h>
 #include <stdint.h>
+#include <unistd.h>
+#include <debug.h>
 #include <sys/types.h>
 #include <arch/irq.h>
 #include <tinyara/logm.h>
@@ -34,6 +36,7 @@ int logm_bufsize = LOGM_BUFFER_SIZE;
 char * g_logm_rsvbuf = NULL;
 volatile int logm_print_interval = LOGM_PRINT_INTERVAL * 1000;
 
+#ifndef CONFIG_LOGM_BINARY
 static int logm_change_bufsize(int buflen)
 {
 	/* Keep using old size if a parameter is invalid */
@@ -63,12 +66,52 @@ static int logm_change_bufsize(int buflen)
 	return OK;
 }
 
+static void logm_flush_buffer(void)
+{
+	int tail;
+	int end;
+	char msg[64];
+
+	/* Write out the queued text in contiguous chunks, stopping at the
+	 * point where the messages were dropped to report them there.
+	 */
+	while (g_logm_head != g_logm_tail) {
+		tail = g_logm_tail;
+		end = (tail > g_logm_head) ? tail : logm_bufsize;
+		if (g_logm_overflow_offset > g_logm_head && g_logm_overflow_offset < end) {
+			end = g_logm_overflow_offset;
+		}
+
+		(void)write(STDOUT_FILENO, &g_logm_rsvbuf[g_logm_head], end - g_logm_head);
+		g_logm_head = end % logm_bufsize;
+		if (LOGM_STATUS(LOGM_BUFFER_OVERFLOW)) {
+			LOGM_STATUS_CLEAR(LOGM_BUFFER_OVERFLOW);
+		}
+		if (g_logm_overflow_offset >= 0 && g_logm_overflow_offset == g_logm_head) {
+			snprintf(msg, sizeof(msg), "\n[LOGM BUFFER OVERFLOW] %d messages are dropped\n", g_logm_dropmsg_count);
+			(void)write(STDOUT_FILENO, msg, strlen(msg));
+			g_logm_overflow_offset = -1;
+		}
+	}
+}
+#endif
+
 int logm_task(int argc, char *argv[])
 {
+#ifndef CONFIG_LOGM_BINARY
 	irqstate_t flags;
+#endif
 
+#ifdef CONFIG_LOGM_BINARY
+	if (logm_binary_initialize() != OK) {
+		/* Messages keep going to the low level output */
+		wdbg("Failed to allocate logm buffers\n");
+		return ERROR;
+	}
+#else
 	g_logm_rsvbuf = (char *)kmm_malloc(logm_bufsize);
 	memset(g_logm_rsvbuf, 0, logm_bufsize);
+#endif
 
 	/* Now logm is ready */
 	LOGM_STATUS_SET(LOGM_READY);
@@ -78,17 +121,15 @@ int logm_task(int argc, char *argv[])
 #endif
 
 	while (1) {
-		while (g_logm_head != g_logm_tail) {
-			fputc(g_logm_rsvbuf[g_logm_head], stdout);
-			g_logm_head = (g_logm_head + 1) % logm_bufsize;
-			if (LOGM_STATUS(LOGM_BUFFER_OVERFLOW)) {
-				LOGM_STATUS_CLEAR(LOGM_BUFFER_OVERFLOW);
-			}
-			if (g_logm_overflow_offset >= 0 && g_logm_overflow_offset == g_logm_head) {
-				fprintf(stdout, "\n[LOGM BUFFER OVERFLOW] %d messages are dropped\n", g_logm_dropmsg_count);
-				g_logm_overflow_offset = -1;
-			}
+#ifdef CONFIG_LOGM_BINARY
+		logm_binary_flush();
+
+		if (LOGM_STATUS(LOGM_BUFFER_RESIZE_REQ)) {
+			fprintf(stdout, "\n[LOGM] Buffer size is fixed in binary mode\n");
+			LOGM_STATUS_CLEAR(LOGM_BUFFER_RESIZE_REQ);
 		}
+#else
+		logm_flush_buffer();
 
 		if (LOGM_STATUS(LOGM_BUFFER_RESIZE_REQ)) {
 			flags = enter_critical_section();
@@ -97,6 +138,7 @@ int logm_task(int argc, char *argv[])
 			}
 			leave_critical_section(flags);
 		}
+#endif
 		usleep(logm_print_interval);
 	}
 
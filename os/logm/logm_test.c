@@ -16,19 +16,87 @@
  *
  ****************************************************************************/
 #include <stdio.h>
+#include <stdint.h>
+#include <time.h>
 #include <unistd.h>
 #include <syslog.h>
+#include <tinyara/clock.h>
 #include <tinyara/kthread.h>
 #include <tinyara/logm.h>
 
 #include "logm.h"
 
+#define LOGMTEST_BURST 100
+#define LOGMTEST_ROUNDS 10
+
 /* Global Variables */
 static int g_logmtest_handle = 123;
 
+/* Time spent with interrupts disabled by the logging calls.  With a tick
+ * based clock_systimespec(), a section measures either 0 or 1 tick, but
+ * the average over many sections still approaches the real time.
+ */
+static volatile uint32_t g_logmtest_irqoff_count;
+static volatile uint64_t g_logmtest_irqoff_nsec;
+static volatile uint32_t g_logmtest_irqoff_max;
+
+void logmtest_irqoff(const struct timespec *start)
+{
+	struct timespec now;
+	uint32_t nsec;
+
+	(void)clock_systimespec(&now);
+	nsec = (now.tv_sec - start->tv_sec) * NSEC_PER_SEC + now.tv_nsec - start->tv_nsec;
+
+	g_logmtest_irqoff_count++;
+	g_logmtest_irqoff_nsec += nsec;
+	if (nsec > g_logmtest_irqoff_max) {
+		g_logmtest_irqoff_max = nsec;
+	}
+}
+
+/* Measure logs/second and interrupt-off time of bursts of logm calls.
+ * The logm task flushes the buffer between the rounds so that no message
+ * is dropped.
+ */
+static void logmtest_perf(void)
+{
+	struct timespec start;
+	struct timespec end;
+	unsigned long usec = 0;
+	int round;
+	int i;
+
+	g_logmtest_irqoff_count = 0;
+	g_logmtest_irqoff_nsec = 0;
+	g_logmtest_irqoff_max = 0;
+
+	for (round = 0; round < LOGMTEST_ROUNDS; round++) {
+		clock_gettime(CLOCK_REALTIME, &start);
+		for (i = 0; i < LOGMTEST_BURST; i++) {
+			logm(LOGM_NORMAL, 0, LOGM_INF, "logm perf %d/%d %s 0x%08x\n", round, i, "burst", g_logmtest_handle);
+		}
+		clock_gettime(CLOCK_REALTIME, &end);
+
+		usec += (end.tv_sec - start.tv_sec) * 1000000UL + (end.tv_nsec - start.tv_nsec) / 1000;
+		usleep(logm_print_interval * 2);
+	}
+
+	if (usec == 0) {
+		usec = 1;
+	}
+
+	printf("[LOGM TEST] %d logs in %lu usec, %lu logs/s\n", LOGMTEST_BURST * LOGMTEST_ROUNDS, usec, (unsigned long)((uint64_t)LOGMTEST_BURST * LOGMTEST_ROUNDS * 1000000 / usec));
+	if (g_logmtest_irqoff_count > 0) {
+		printf("[LOGM TEST] interrupts off %u times, avg %lu nsec, max %u nsec\n", (unsigned int)g_logmtest_irqoff_count, (unsigned long)(g_logmtest_irqoff_nsec / g_logmtest_irqoff_count), (unsigned int)g_logmtest_irqoff_max);
+	}
+}
+
 /* LOGM test routine */
 static int logmtest_kthread(int argc, char *argv[])
 {
+	logmtest_perf();
+
 	while (1) {
 		logm(1, 0, 3, "lom direct call test1 %d\n", g_logmtest_handle);
 		logm(1, 0, 3, "lom direct call test2 %d\n", g_logmtest_handle);
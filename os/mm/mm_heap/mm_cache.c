@@ -0,0 +1,357 @@
+/****************************************************************************
+ *
+ * Copyright 2025 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <tinyara/config.h>
+
+#include <string.h>
+#include <debug.h>
+
+#include <tinyara/arch.h>
+#include <tinyara/irq.h>
+#include <tinyara/mm/mm.h>
+
+#include "mm_node.h"
+
+#ifdef CONFIG_MM_PERCPU_CACHE
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* The cache of one CPU is only ever touched with local interrupts disabled.
+ * On SMP, the lock additionally allows mm_cache_flush() running on another
+ * CPU to drain it.  It is never contended in the alloc/free fast path.
+ */
+
+#ifdef CONFIG_SMP
+#define MM_CACHE_LOCK(c)   spin_lock(&(c)->lock)
+#define MM_CACHE_UNLOCK(c) spin_unlock(&(c)->lock)
+#else
+#define MM_CACHE_LOCK(c)
+#define MM_CACHE_UNLOCK(c)
+#endif
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+#ifdef CONFIG_DEBUG_MM_HEAPINFO
+/****************************************************************************
+ * Name: mm_cache_account
+ *
+ * Description:
+ *   Keep the per-pid heap information exact for chunks moving in and out
+ *   of the cache.  A cached chunk is accounted as free.  The alloc_list is
+ *   protected by the heap semaphore, so this is the only part of the fast
+ *   path which still needs it.
+ *
+ ****************************************************************************/
+
+static bool mm_cache_account(FAR struct mm_heap_s *heap, FAR struct mm_allocnode_s *node, bool alloc, mmaddress_t caller_retaddr)
+{
+	if (mm_takesemaphore(heap) == false) {
+		return false;
+	}
+
+	if (alloc) {
+		heapinfo_update_node(node, caller_retaddr);
+		heapinfo_add_size(heap, node->pid, node->size);
+		heapinfo_update_total_size(heap, node->size, node->pid);
+	} else {
+		heapinfo_subtract_size(heap, node->pid, node->size);
+		heapinfo_update_total_size(heap, ((-1) * node->size), node->pid);
+		node->alloc_call_addr = 0;
+	}
+
+	mm_givesemaphore(heap);
+	return true;
+}
+#endif
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: mm_cache_initialize
+ *
+ * Description:
+ *   Empty the per-CPU caches of the heap.
+ *
+ ****************************************************************************/
+
+void mm_cache_initialize(FAR struct mm_heap_s *heap)
+{
+	memset(heap->mm_cache, 0, sizeof(heap->mm_cache));
+#ifdef CONFIG_SMP
+	int cpu;
+
+	for (cpu = 0; cpu < CONFIG_SMP_NCPUS; cpu++) {
+		heap->mm_cache[cpu].lock = SP_UNLOCKED;
+	}
+#endif
+}
+
+/****************************************************************************
+ * Name: mm_cache_alloc
+ *
+ * Description:
+ *   Take a chunk of exactly 'size' bytes from the cache of the current CPU.
+ *   'size' is the chunk size, already including SIZEOF_MM_ALLOCNODE and
+ *   aligned to MM_MIN_CHUNK.
+ *
+ * Return Value:
+ *   The user address of the chunk, or NULL if the cache has none.
+ *
+ ****************************************************************************/
+
+FAR void *mm_cache_alloc(FAR struct mm_heap_s *heap, size_t size, mmaddress_t caller_retaddr)
+{
+	FAR struct mm_cache_s *cache;
+	FAR struct mm_delaynode_s *mem;
+	irqstate_t flags;
+	int ndx;
+
+	if (size > MM_CACHE_MAXCHUNK) {
+		return NULL;
+	}
+
+	ndx = MM_CACHE_NDX(size);
+
+	flags = irqsave();
+	cache = &heap->mm_cache[up_cpu_index()];
+	MM_CACHE_LOCK(cache);
+
+	mem = cache->head[ndx];
+	if (mem) {
+		cache->head[ndx] = mem->flink;
+		cache->count[ndx]--;
+		cache->hits++;
+	} else {
+		cache->misses++;
+	}
+
+	MM_CACHE_UNLOCK(cache);
+	irqrestore(flags);
+
+#ifdef CONFIG_DEBUG_MM_HEAPINFO
+	if (mem) {
+		(void)mm_cache_account(heap, (FAR struct mm_allocnode_s *)((FAR char *)mem - SIZEOF_MM_ALLOCNODE), true, caller_retaddr);
+	}
+#endif
+
+	return (FAR void *)mem;
+}
+
+/****************************************************************************
+ * Name: mm_cache_free
+ *
+ * Description:
+ *   Try to park an allocated chunk in the cache of the current CPU.
+ *
+ * Return Value:
+ *   true if the chunk was cached; false if the caller has to release it to
+ *   the heap (chunk too large, cache full, not an allocated chunk).
+ *
+ ****************************************************************************/
+
+bool mm_cache_free(FAR struct mm_heap_s *heap, FAR void *mem)
+{
+	FAR struct mm_allocnode_s *node;
+	FAR struct mm_delaynode_s *entry;
+	FAR struct mm_cache_s *cache;
+	irqstate_t flags;
+	int ndx;
+
+	node = (FAR struct mm_allocnode_s *)((FAR char *)mem - SIZEOF_MM_ALLOCNODE);
+
+	/* Leave unallocated chunks to mm_free_nocache() which reports them */
+
+	if ((node->preceding & MM_ALLOC_BIT) != MM_ALLOC_BIT || node->size > MM_CACHE_MAXCHUNK) {
+		return false;
+	}
+
+	ndx = MM_CACHE_NDX(node->size);
+
+	/* Cheap, unlocked check before doing any accounting */
+
+	if (heap->mm_cache[up_cpu_index()].count[ndx] >= CONFIG_MM_PERCPU_CACHE_DEPTH) {
+		return false;
+	}
+
+#ifdef CONFIG_DEBUG_MM_HEAPINFO
+	if (!mm_cache_account(heap, node, false, 0)) {
+		return false;
+	}
+#endif
+
+	flags = irqsave();
+	cache = &heap->mm_cache[up_cpu_index()];
+	MM_CACHE_LOCK(cache);
+
+	if (cache->count[ndx] < CONFIG_MM_PERCPU_CACHE_DEPTH) {
+		/* The lists are short, so a double free of a cached chunk is
+		 * cheap to catch here before it corrupts the list.
+		 */
+
+		for (entry = cache->head[ndx]; entry; entry = entry->flink) {
+			if (entry == (FAR struct mm_delaynode_s *)mem) {
+				break;
+			}
+		}
+
+		if (entry == NULL) {
+			entry = (FAR struct mm_delaynode_s *)mem;
+			entry->flink = cache->head[ndx];
+			cache->head[ndx] = entry;
+			cache->count[ndx]++;
+
+			MM_CACHE_UNLOCK(cache);
+			irqrestore(flags);
+			return true;
+		}
+
+		mdbg("Attempt for double freeing a cached pointer %p\n", mem);
+		MM_CACHE_UNLOCK(cache);
+		irqrestore(flags);
+		return true;
+	}
+
+	MM_CACHE_UNLOCK(cache);
+	irqrestore(flags);
+
+#ifdef CONFIG_DEBUG_MM_HEAPINFO
+	/* Lost the race against another free on this CPU, undo the accounting */
+
+	(void)mm_cache_account(heap, node, true, node->alloc_call_addr);
+#endif
+	return false;
+}
+
+/****************************************************************************
+ * Name: mm_cache_flush
+ *
+ * Description:
+ *   Return every cached chunk of every CPU to the nodelist of the heap so
+ *   that they can be merged with their neighbours again.  Called when an
+ *   allocation from the heap fails.
+ *
+ ****************************************************************************/
+
+void mm_cache_flush(FAR struct mm_heap_s *heap)
+{
+	FAR struct mm_delaynode_s *list[MM_CACHE_NCLASSES];
+	FAR struct mm_delaynode_s *mem;
+	FAR struct mm_cache_s *cache;
+	irqstate_t flags;
+	int cpu;
+	int ndx;
+
+	for (cpu = 0; cpu < CONFIG_SMP_NCPUS; cpu++) {
+		cache = &heap->mm_cache[cpu];
+
+		/* Detach all lists at once, then release them without the lock */
+
+		flags = irqsave();
+		MM_CACHE_LOCK(cache);
+		for (ndx = 0; ndx < MM_CACHE_NCLASSES; ndx++) {
+			list[ndx] = cache->head[ndx];
+			cache->head[ndx] = NULL;
+			cache->count[ndx] = 0;
+		}
+		cache->flushes++;
+		MM_CACHE_UNLOCK(cache);
+		irqrestore(flags);
+
+		for (ndx = 0; ndx < MM_CACHE_NCLASSES; ndx++) {
+			while (list[ndx]) {
+				mem = list[ndx];
+				list[ndx] = mem->flink;
+#ifdef CONFIG_DEBUG_MM_HEAPINFO
+				/* mm_free_nocache() subtracts the chunk from its owner again */
+
+				(void)mm_cache_account(heap, (FAR struct mm_allocnode_s *)((FAR char *)mem - SIZEOF_MM_ALLOCNODE), true, 0);
+#endif
+				mm_free_nocache(heap, mem);
+			}
+		}
+	}
+}
+
+/****************************************************************************
+ * Name: mm_cache_trim
+ *
+ * Description:
+ *   Flush the caches of the heap if together they hold more than
+ *   'threshold' bytes.  The counts are read without the locks, an estimate
+ *   is good enough here.
+ *
+ ****************************************************************************/
+
+void mm_cache_trim(FAR struct mm_heap_s *heap, size_t threshold)
+{
+	size_t cached = 0;
+	int cpu;
+	int ndx;
+
+	for (cpu = 0; cpu < CONFIG_SMP_NCPUS; cpu++) {
+		for (ndx = 0; ndx < MM_CACHE_NCLASSES; ndx++) {
+			cached += (size_t)heap->mm_cache[cpu].count[ndx] * ((ndx + 1) << MM_MIN_SHIFT);
+		}
+	}
+
+	if (cached > threshold) {
+		mm_cache_flush(heap);
+	}
+}
+
+/****************************************************************************
+ * Name: mm_cache_flush_all
+ *
+ * Description:
+ *   Trim the caches of all kernel heaps and of all user heaps to
+ *   'threshold' bytes each, see mm_cache_trim().  Called from
+ *   sched_garbagecollection().
+ *
+ ****************************************************************************/
+
+void mm_cache_flush_all(size_t threshold)
+{
+#if defined(CONFIG_BUILD_FLAT) || defined(__KERNEL__)
+	int heap_idx;
+
+	for (heap_idx = 0; heap_idx < CONFIG_KMM_NHEAPS; heap_idx++) {
+		mm_cache_trim(&g_kmmheap[heap_idx], threshold);
+	}
+#endif
+#if defined(CONFIG_APP_BINARY_SEPARATION) && defined(__KERNEL__)
+	/* Every loaded binary has its own heap */
+
+	mm_cache_trim_app_heaps(threshold);
+#elif !defined(CONFIG_BUILD_FLAT)
+	if (BASE_HEAP) {
+		mm_cache_trim(BASE_HEAP, threshold);
+	}
+#endif
+}
+
+#endif							/* CONFIG_MM_PERCPU_CACHE */
@@ -106,10 +106,6 @@ static void mm_add_delaylist(FAR struct mm_heap_s *heap, FAR void *mem)
  ****************************************************************************/
 void mm_free(FAR struct mm_heap_s *heap, FAR void *mem)
 {
-	FAR struct mm_freenode_s *node;
-	FAR struct mm_freenode_s *prev;
-	FAR struct mm_freenode_s *next;
-
 	mvdbg("Freeing %p\n", mem);
 
 	/* Protect against attempts to free a NULL reference */
@@ -126,6 +122,31 @@ void mm_free(FAR struct mm_heap_s *heap, FAR void *mem)
 		return;
 	}
 
+#ifdef CONFIG_MM_PERCPU_CACHE
+	/* Park small chunks in the cache of this CPU if there is room */
+
+	if (mm_cache_free(heap, mem)) {
+		return;
+	}
+#endif
+
+	mm_free_nocache(heap, mem);
+}
+
+/****************************************************************************
+ * Name: mm_free_nocache
+ *
+ * Description:
+ *   Same as mm_free() but always returns the chunk to the nodelist, even
+ *   if CONFIG_MM_PERCPU_CACHE is enabled.
+ *
+ ****************************************************************************/
+void mm_free_nocache(FAR struct mm_heap_s *heap, FAR void *mem)
+{
+	FAR struct mm_freenode_s *node;
+	FAR struct mm_freenode_s *prev;
+	FAR struct mm_freenode_s *next;
+
 	/* We need to hold the MM semaphore while we muck with the
 	 * nodelist.
 	 */
@@ -172,6 +172,21 @@ char *mm_get_app_heap_name(void *address)
 	mdbg("address 0x%x is not in any app heap region.\n", address);
 	return NULL;
 }
+
+#ifdef CONFIG_MM_PERCPU_CACHE
+void mm_cache_trim_app_heaps(size_t threshold)
+{
+	app_heap_s *node = (app_heap_s *)dq_peek(&app_heap_q);
+
+	/* Heaps of binaries being unloaded are disabled before they are freed */
+	while (node) {
+		if (node->is_active) {
+			mm_cache_trim(node->heap, threshold);
+		}
+		node = dq_next(node);
+	}
+}
+#endif
 #endif
 
 /****************************************************************************
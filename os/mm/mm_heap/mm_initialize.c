@@ -259,6 +259,10 @@ int mm_initialize(FAR struct mm_heap_s *heap, FAR void *heapstart, size_t heapsi
 		heap->mm_delaylist[i] = NULL;
 	}
 
+#ifdef CONFIG_MM_PERCPU_CACHE
+	mm_cache_initialize(heap);
+#endif
+
 	/* Initialize the malloc semaphore to one (to support one-at-
 	 * a-time access to private data sets).
 	 */
@@ -147,9 +147,6 @@ FAR void *mm_malloc(FAR struct mm_heap_s *heap, size_t size, mmaddress_t caller_
 	int ndx;
 	bool gc_done = false;
 
-	/* Free the delay list first */
-	mm_free_delaylist(heap);
-
 	/* Handle bad sizes */
 
 	if (size > MM_ALIGN_DOWN(MMSIZE_MAX) - SIZEOF_MM_ALLOCNODE) {
@@ -165,6 +162,19 @@ FAR void *mm_malloc(FAR struct mm_heap_s *heap, size_t size, mmaddress_t caller_
 
 	size = MM_ALIGN_UP(size + SIZEOF_MM_ALLOCNODE);
 
+#ifdef CONFIG_MM_PERCPU_CACHE
+	/* Small requests are served from the cache of this CPU if possible */
+
+	ret = mm_cache_alloc(heap, size, caller_retaddr);
+	if (ret) {
+		mvdbg("Allocated %p from cache, size %u\n", ret, size);
+		return ret;
+	}
+#endif
+
+	/* Free the delay list first */
+	mm_free_delaylist(heap);
+
 retry_after_gc:
 	/* We need to hold the MM semaphore while we muck with the nodelist. */
 
@@ -259,6 +269,9 @@ retry_after_gc:
 
 	if (!ret && gc_done == false) {
 		mdbg("Allocation failed!!! We dont have enough memory. Try to free dead task stack areas\n");
+#ifdef CONFIG_MM_PERCPU_CACHE
+		mm_cache_flush(heap);
+#endif
 		sched_garbagecollection();
 		gc_done = true;
 		goto retry_after_gc;
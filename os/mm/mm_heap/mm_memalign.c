@@ -272,6 +272,9 @@ retry_after_gc:
 
 	if (!ret && gc_done == false) {
 		mdbg("Allocation failed!!! We dont have enough memory. Try to free dead task stack areas\n");
+#ifdef CONFIG_MM_PERCPU_CACHE
+		mm_cache_flush(heap);
+#endif
 		sched_garbagecollection();
 		gc_done = true;
 		goto retry_after_gc;
@@ -103,6 +103,12 @@
 #include <tinyara/clock.h>
 #endif
 
+#if LWIP_TCP && defined(CONFIG_NET_SENDFILE)
+#include <tinyara/kmalloc.h>
+#include <tinyara/fs/fs.h>
+#include "lwip/priv/tcp_priv.h"
+#endif
+
 /* If the netconn API is not required publicly, then we include the necessary
    files here to get the implementation */
 #if !LWIP_NETCONN
@@ -1038,6 +1044,234 @@ int lwip_send(int s, const void *data, size_t size, int flags)
 	return (err == ERR_OK ? (int)written : -1);
 }
 
+#if LWIP_TCP && defined(CONFIG_NET_SENDFILE)
+/* sendfile() reads the file into a ring and queues the ring to TCP without
+ * copying it (NETCONN_NOCOPY), so the stack references the ring until the
+ * peer acknowledges the data.  TCP never holds more than TCP_SND_BUF
+ * unacknowledged bytes, so a ring twice as large always has free room
+ * once a write returns.
+ *
+ * That call has to wait for the last acknowledgement, so non-blocking
+ * sockets and sockets with a send timeout copy the file to TCP through a
+ * buffer instead and return as soon as TCP took what it can.
+ *
+ * The waits are woken by the send and error events of the socket.  The
+ * event for an acknowledgement is only posted above the send low-water
+ * mark, so the waits also time out to check again.
+ */
+#define LWIP_SENDFILE_BUFSIZE (2 * TCP_SND_BUF)
+#define LWIP_SENDFILE_WAIT_MS 100
+
+struct lwip_sendfile_seq {
+	struct tcpip_api_call_data call;
+	struct netconn *conn;
+	u32_t lastack;				/* Highest acknowledged seqno */
+	u32_t snd_lbb;				/* Seqno of the next byte to be buffered */
+};
+
+static err_t lwip_sendfile_getseq(struct tcpip_api_call_data *call)
+{
+	struct lwip_sendfile_seq *seq = (struct lwip_sendfile_seq *)call;
+	struct tcp_pcb *pcb = seq->conn->pcb.tcp;
+
+	/* Without a pcb the queued segments, and the references to the
+	 * ring, are gone too.
+	 */
+
+	if (pcb == NULL || pcb->state == LISTEN) {
+		return ERR_CONN;
+	}
+	seq->lastack = pcb->lastack;
+	seq->snd_lbb = pcb->snd_lbb;
+	return ERR_OK;
+}
+
+/* Number of the first 'queued' bytes from 'base' the peer acknowledged,
+ * or -1 once the connection is gone
+ */
+
+static ssize_t lwip_sendfile_acked(struct lwip_sendfile_seq *seq, u32_t base, size_t queued)
+{
+	if (tcpip_api_call(lwip_sendfile_getseq, &seq->call) != ERR_OK) {
+		return -1;
+	}
+	if (TCP_SEQ_LEQ(seq->lastack, base)) {
+		return 0;
+	}
+	if (TCP_SEQ_GEQ(seq->lastack, base + (u32_t)queued)) {
+		return queued;
+	}
+	return seq->lastack - base;
+}
+
+int lwip_sendfile(int s, struct file *filep, size_t count)
+{
+	struct lwip_sock *sock;
+	struct lwip_sendfile_seq seq;
+	sys_sem_t sem;
+	u8_t *ring;
+	u8_t nocopy;
+	size_t size;
+	size_t queued;
+	size_t written;
+	size_t chunk;
+	size_t pos;
+	ssize_t acked;
+	ssize_t nread;
+	u32_t base;
+	err_t err = ERR_OK;
+	int ret;
+	SYS_ARCH_DECL_PROTECT(lev);
+
+	LWIP_DEBUGF(SOCKETS_DEBUG, ("lwip_sendfile(%d, size=%" SZT_F ")\n", s, count));
+
+	sock = get_socket_by_pid(s, getpid());
+	if (!sock) {
+		set_errno(EBADF);
+		return -1;
+	}
+
+	/* Only a connected stream takes the file directly, let the caller
+	 * copy anything else
+	 */
+
+	seq.conn = sock->conn;
+	if (NETCONNTYPE_GROUP(netconn_type(sock->conn)) != NETCONN_TCP || lwip_sendfile_acked(&seq, 0, 0) < 0) {
+		set_errno(ENOSYS);
+		return -1;
+	}
+	if (count == 0) {
+		return 0;
+	}
+
+	/* Without a copy, the ring has to stay until the peer has everything */
+
+	nocopy = !netconn_is_nonblocking(sock->conn);
+#if LWIP_SO_SNDTIMEO
+	if (netconn_get_sendtimeout(sock->conn) != 0) {
+		nocopy = 0;
+	}
+#endif
+	if (nocopy && sys_sem_new(&sem, 0) != ERR_OK) {
+		nocopy = 0;
+	}
+	if (nocopy) {
+		/* Another sendfile() on the same socket already waits for events */
+
+		SYS_ARCH_PROTECT(lev);
+		if (sock->sendfile_sem == NULL) {
+			sock->sendfile_sem = &sem;
+		} else {
+			nocopy = 0;
+		}
+		SYS_ARCH_UNPROTECT(lev);
+		if (!nocopy) {
+			sys_sem_free(&sem);
+		}
+	}
+
+	size = LWIP_MIN(count, nocopy ? LWIP_SENDFILE_BUFSIZE : TCP_SND_BUF);
+	ring = (u8_t *)kmm_malloc(size);
+	if (!ring) {
+		/* The caller may still copy through its smaller buffer */
+
+		ret = -ENOSYS;
+		goto errout;
+	}
+
+	/* Our data takes the sequence numbers from 'base' on */
+
+	base = seq.snd_lbb;
+	queued = 0;
+	while (queued < count) {
+		/* A copied buffer is free again as soon as the write returns */
+
+		acked = queued;
+		pos = 0;
+		if (nocopy) {
+			acked = lwip_sendfile_acked(&seq, base, queued);
+			if (acked < 0) {
+				err = ERR_CONN;
+				break;
+			}
+			if (queued - acked == size) {
+				/* Only when another thread writes the same socket */
+
+				sys_arch_sem_wait(&sem, LWIP_SENDFILE_WAIT_MS);
+				continue;
+			}
+
+			/* Read into the oldest free part of the ring */
+
+			pos = queued % size;
+		}
+
+		chunk = LWIP_MIN(size - (queued - acked), size - pos);
+		chunk = LWIP_MIN(chunk, count - queued);
+		nread = file_read(filep, ring + pos, chunk);
+		if (nread <= 0) {
+			if (nread < 0 && queued == 0) {
+				ret = (int)nread;
+				goto errout_with_ring;
+			}
+			break;
+		}
+
+		/* A non-blocking socket or a send timeout makes this return what
+		 * TCP took so far
+		 */
+
+		written = 0;
+		err = netconn_write_partly(sock->conn, ring + pos, nread, (nocopy ? NETCONN_NOCOPY : NETCONN_COPY) | (queued + nread < count ? NETCONN_MORE : 0), &written);
+		if (err != ERR_OK) {
+			written = 0;
+		}
+		queued += written;
+		if (written < (size_t)nread) {
+			/* Give back what TCP did not take */
+
+			file_seek(filep, (off_t)written - nread, SEEK_CUR);
+			if (err == ERR_OK) {
+				err = ERR_WOULDBLOCK;
+			}
+			break;
+		}
+	}
+
+	/* The ring is only free once the peer has everything */
+
+	if (nocopy) {
+		while ((acked = lwip_sendfile_acked(&seq, base, queued)) >= 0 && (size_t)acked < queued) {
+			sys_arch_sem_wait(&sem, LWIP_SENDFILE_WAIT_MS);
+		}
+	}
+
+	LWIP_DEBUGF(SOCKETS_DEBUG, ("lwip_sendfile(%d) err=%d queued=%" SZT_F "\n", s, err, queued));
+	ret = (int)queued;
+	if (queued == 0 && err != ERR_OK) {
+		/* EWOULDBLOCK for a non-blocking socket or an expired timeout */
+
+		ret = -err_to_errno(err);
+	}
+
+errout_with_ring:
+	kmm_free(ring);
+
+errout:
+	if (nocopy) {
+		SYS_ARCH_PROTECT(lev);
+		sock->sendfile_sem = NULL;
+		SYS_ARCH_UNPROTECT(lev);
+		sys_sem_free(&sem);
+	}
+	if (ret < 0) {
+		sock_set_errno(sock, -ret);
+		return -1;
+	}
+	return ret;
+}
+#endif							/* LWIP_TCP && CONFIG_NET_SENDFILE */
+
 int lwip_sendmsg(int s, const struct msghdr *msg, int flags)
 {
 	struct lwip_sock *sock;
@@ -1886,6 +2120,12 @@ static void event_callback(struct netconn *conn, enum netconn_evt evt, u16_t len
 		break;
 	}
 
+#if LWIP_TCP && defined(CONFIG_NET_SENDFILE)
+	if (sock->sendfile_sem != NULL && (evt == NETCONN_EVT_SENDPLUS || evt == NETCONN_EVT_ERROR)) {
+		sys_sem_signal(sock->sendfile_sem);
+	}
+#endif
+
 	if (sock->select_waiting == 0) {
 		/* none is waiting for this socket, no need to check select_cb_list */
 		SYS_ARCH_UNPROTECT(lev);
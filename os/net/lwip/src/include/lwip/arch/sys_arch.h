@@ -29,7 +29,7 @@
 #define SYS_MBOX_NULL ((sys_mbox_t *)NULL)
 #define SYS_SEM_NULL  ((sys_sem_t *)NULL)
 #define SYS_DEFAULT_THREAD_STACK_DEPTH  PTHREAD_STACK_MIN
-#define SYS_MBOX_MAXSIZE 128
+#define SYS_MBOX_MAXSIZE 128	/* Must be a power of 2 */
 
 // === PROTECTION ===
 typedef int sys_prot_t;
@@ -39,19 +39,33 @@ typedef pid_t sys_thread_t;
 
 // === MAIL BOX ===
 
+/* A poster with ticket t may fill msgs[t % queue_size] when seq[] of the
+ * slot is t, a fetcher with ticket t may empty it when it is t + 1.  Only
+ * the low 16 bits of the tickets are kept in seq[].
+ */
+
 struct sys_mbox {
 	u8_t is_valid;
 	u8_t id;
-	u32_t queue_size;
-	u32_t wait_send;
-	u32_t wait_fetch;
-	u32_t front;
-	u32_t rear;
+	u32_t queue_size;			/* Number of slots, a power of 2 */
+	u32_t wait_send;			/* Posters sleeping on a full mailbox */
+	u32_t wait_fetch;			/* Fetchers sleeping on an empty mailbox */
+	u32_t front;				/* Ticket of the next fetch */
+	u32_t rear;					/* Ticket of the next post */
 	void *msgs[SYS_MBOX_MAXSIZE];
-	sys_sem_t mail;
-	sys_sem_t mutex;
+	u16_t seq[SYS_MBOX_MAXSIZE];
+	sys_sem_t not_empty;
+	sys_sem_t not_full;
 };
 
 typedef struct sys_mbox sys_mbox_t;
 
+/* use in the mailbox performance test */
+struct sys_mbox_perf_args {
+	int producers;				/* Number of posting threads */
+	int messages;				/* Messages posted by each thread */
+	int queue_size;				/* Size of the mailbox */
+	u32_t elapsed_us;			/* Returned: time to pass all the messages */
+};
+
 #endif							/* __ARCH_SYS_ARCH_H__ */
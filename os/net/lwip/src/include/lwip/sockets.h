@@ -65,6 +65,9 @@
 
 #include "lwip/ip_addr.h"
 #include "lwip/err.h"
+#if LWIP_TCP && defined(CONFIG_NET_SENDFILE)
+#include "lwip/sys.h"
+#endif
 #include "lwip/inet.h"
 
 #include <sys/select.h>
@@ -495,6 +498,11 @@ struct lwip_sock {
 	u8_t err;
 	/** counter of how many threads are waiting for this socket using select */
 	SELWAIT_T select_waiting;
+#if LWIP_TCP && defined(CONFIG_NET_SENDFILE)
+	/** signalled by event_callback() on send and error events while
+	    lwip_sendfile() waits for the peer to acknowledge its data */
+	sys_sem_t *sendfile_sem;
+#endif
 	u32_t pid;
 	u8_t pname[CONFIG_TASK_NAME_SIZE];
 };
@@ -529,6 +537,11 @@ int lwip_fcntl(int s, int cmd, int val);
 
 int lwip_poll(int fd, struct pollfd *fds, bool setup);
 
+#if LWIP_TCP && defined(CONFIG_NET_SENDFILE)
+struct file;
+int lwip_sendfile(int s, struct file *filep, size_t count);
+#endif
+
 /*  API for network manager only*/
 struct lwip_sock *get_socket_by_pid(int sd, pid_t pid);
 #ifdef __cplusplus
@@ -19,6 +19,7 @@
 #include <stdio.h>
 #include <string.h>
 #include <stdlib.h>
+#include <stdbool.h>
 
 /* tinyara includes */
 #include <errno.h>
@@ -53,11 +54,107 @@
 
 static u16_t s_nextthread = 0;
 
+/*---------------------------------------------------------------------------*
+ * Mailbox
+ *---------------------------------------------------------------------------*
+ * The mailbox is a bounded lock-free ring of queue_size slots (D. Vyukov's
+ * bounded MPMC queue).  Posters and fetchers claim a ticket with a
+ * compare-and-swap on rear/front, so the semaphores are only touched to
+ * sleep on a full or an empty mailbox.  A sleeper registers itself in
+ * wait_send/wait_fetch before it checks the ring again, and the other side
+ * only signals when it sees a sleeper afterwards, so a wakeup can not be
+ * lost.  A wakeup may be stale though, so a sleeper always checks the ring
+ * again after it woke up.
+ *---------------------------------------------------------------------------*/
+#define MBOX_LOAD(p)         __atomic_load_n((p), __ATOMIC_ACQUIRE)
+#define MBOX_STORE(p, v)     __atomic_store_n((p), (v), __ATOMIC_RELEASE)
+#define MBOX_CAS(p, e, v)    __atomic_compare_exchange_n((p), (e), (v), true, __ATOMIC_RELAXED, __ATOMIC_RELAXED)
+#define MBOX_DEC(p)          __atomic_sub_fetch((p), 1, __ATOMIC_SEQ_CST)
+
+static bool sys_mbox_enqueue(sys_mbox_t *mbox, void *msg)
+{
+	u32_t pos = __atomic_load_n(&mbox->rear, __ATOMIC_RELAXED);
+	u32_t ndx;
+	s16_t diff;
+
+	for (;;) {
+		ndx = pos & (mbox->queue_size - 1);
+		diff = (s16_t)(MBOX_LOAD(&mbox->seq[ndx]) - (u16_t)pos);
+		if (diff == 0) {
+			/* The slot is free, try to claim it.  pos is reloaded on failure */
+			if (MBOX_CAS(&mbox->rear, &pos, pos + 1)) {
+				break;
+			}
+		} else if (diff < 0) {
+			/* The slot still holds the message of the previous round */
+			return false;
+		} else {
+			pos = __atomic_load_n(&mbox->rear, __ATOMIC_RELAXED);
+		}
+	}
+
+	mbox->msgs[ndx] = msg;
+	MBOX_STORE(&mbox->seq[ndx], (u16_t)(pos + 1));
+	return true;
+}
+
+static bool sys_mbox_dequeue(sys_mbox_t *mbox, void **msg)
+{
+	u32_t pos = __atomic_load_n(&mbox->front, __ATOMIC_RELAXED);
+	u32_t ndx;
+	s16_t diff;
+	void *data;
+
+	for (;;) {
+		ndx = pos & (mbox->queue_size - 1);
+		diff = (s16_t)(MBOX_LOAD(&mbox->seq[ndx]) - (u16_t)(pos + 1));
+		if (diff == 0) {
+			if (MBOX_CAS(&mbox->front, &pos, pos + 1)) {
+				break;
+			}
+		} else if (diff < 0) {
+			/* Nothing posted to this slot yet */
+			return false;
+		} else {
+			pos = __atomic_load_n(&mbox->front, __ATOMIC_RELAXED);
+		}
+	}
+
+	data = mbox->msgs[ndx];
+	MBOX_STORE(&mbox->seq[ndx], (u16_t)(pos + mbox->queue_size));
+
+	if (msg != NULL) {
+		*msg = data;
+		LWIP_DEBUGF(SYS_DEBUG, ("mbox %p msg %p\n", (void *)mbox, data));
+	} else {
+		LWIP_DEBUGF(SYS_DEBUG, ("mbox %p, null msg\n", (void *)mbox));
+	}
+	return true;
+}
+
+/* Register as a sleeper before checking the ring a last time */
+static void sys_mbox_register(u32_t *waiters)
+{
+	__atomic_add_fetch(waiters, 1, __ATOMIC_SEQ_CST);
+	__atomic_thread_fence(__ATOMIC_SEQ_CST);
+}
+
+/* Wake up one sleeper of the other side, if there is any */
+static void sys_mbox_wakeup(u32_t *waiters, sys_sem_t *sem)
+{
+	__atomic_thread_fence(__ATOMIC_SEQ_CST);
+	if (__atomic_load_n(waiters, __ATOMIC_RELAXED) != 0) {
+		sys_sem_signal(sem);
+	}
+}
+
 /*---------------------------------------------------------------------------*
  * Routine:  sys_mbox_new
  *---------------------------------------------------------------------------*
  * Description:
- *      Creates a new mailbox
+ *      Creates a new mailbox.  The size is rounded up to a power of 2 of at
+ *      least 2 and limited to SYS_MBOX_MAXSIZE, which is also used for a
+ *      size of 0.
  * Inputs:
  *      sys_mbox_t mbox         -- Handle of mailbox
  *      int queue_sz            -- Size of elements in the mailbox
@@ -66,24 +163,45 @@ static u16_t s_nextthread = 0;
  *---------------------------------------------------------------------------*/
 err_t sys_mbox_new(sys_mbox_t *mbox, int queue_sz)
 {
-	err_t err = ERR_OK;
-	mbox->is_valid = 1;
+	u32_t i;
+
+	if (queue_sz <= 0 || queue_sz > SYS_MBOX_MAXSIZE) {
+		queue_sz = SYS_MBOX_MAXSIZE;
+	}
+
+	/* With a single slot, a posted message would look like a free slot */
+
+	mbox->queue_size = 2;
+	while (mbox->queue_size < (u32_t)queue_sz) {
+		mbox->queue_size <<= 1;
+	}
+
 #if LWIP_STATS
 	mbox->id = lwip_stats.sys.mbox.used + 1;
 #endif
-	mbox->queue_size = queue_sz;
 	mbox->wait_send = 0;
 	mbox->wait_fetch = 0;
 	mbox->front = mbox->rear = 0;
-	sys_sem_new(&(mbox->mail), 0);
-	sys_sem_new(&(mbox->mutex), 1);
+	for (i = 0; i < mbox->queue_size; i++) {
+		mbox->seq[i] = i;
+		mbox->msgs[i] = NULL;
+	}
+
+	if (sys_sem_new(&(mbox->not_empty), 0) != ERR_OK) {
+		return ERR_MEM;
+	}
+	if (sys_sem_new(&(mbox->not_full), 0) != ERR_OK) {
+		sys_sem_free(&(mbox->not_empty));
+		return ERR_MEM;
+	}
+	mbox->is_valid = 1;
 
 #if SYS_STATS
 	SYS_STATS_INC_USED(mbox);
 #endif							/* SYS_STATS */
 
 	LWIP_DEBUGF(SYS_DEBUG, ("Succesfully Created MBOX with id %d", mbox->id));
-	return err;
+	return ERR_OK;
 }
 
 /*---------------------------------------------------------------------------*
@@ -107,8 +225,8 @@ void sys_mbox_free(sys_mbox_t *mbox)
 		mbox->queue_size = 0;
 		mbox->wait_send = 0;
 		mbox->wait_fetch = 0;
-		sys_sem_free(&(mbox->mail));
-		sys_sem_free(&(mbox->mutex));
+		sys_sem_free(&(mbox->not_empty));
+		sys_sem_free(&(mbox->not_full));
 
 		LWIP_DEBUGF(SYS_DEBUG, ("Succesfully deleted MBOX with id %d", mbox->id));
 #if SYS_STATS
@@ -130,48 +248,28 @@ void sys_mbox_free(sys_mbox_t *mbox)
  *---------------------------------------------------------------------------*/
 void sys_mbox_post(sys_mbox_t *mbox, void *msg)
 {
-	u8_t first_msg = 0;
-	u32_t tmp = 0;
-	u32_t status = OK;
-	status = sys_arch_sem_wait(&(mbox->mutex), 0);
-	if (status == SYS_ARCH_CANCELED) {
-		return;
-	}
+	u32_t status;
+
 	LWIP_DEBUGF(SYS_DEBUG, ("mbox %p msg %p\n", (void *)mbox, (void *)msg));
+
 	/* Wait while the queue is full */
-	tmp = (mbox->rear + 1) % mbox->queue_size;
-	if (tmp == mbox->front) {
+	while (!sys_mbox_enqueue(mbox, msg)) {
 		LWIP_DEBUGF(SYS_DEBUG, ("Queue Full, Wait until gets free\n"));
-	}
-	while (tmp == mbox->front) {
-		mbox->wait_send++;
-		sys_sem_signal(&(mbox->mutex));
-		sys_arch_sem_wait(&(mbox->mail), 0);
-		status = sys_arch_sem_wait(&(mbox->mutex), 0);
-		mbox->wait_send--;
+		sys_mbox_register(&mbox->wait_send);
+		if (sys_mbox_enqueue(mbox, msg)) {
+			MBOX_DEC(&mbox->wait_send);
+			break;
+		}
+		status = sys_arch_sem_wait(&(mbox->not_full), 0);
+		MBOX_DEC(&mbox->wait_send);
 		if (status == SYS_ARCH_CANCELED) {
 			return;
 		}
 	}
-
-	if (mbox->rear == mbox->front) {
-		first_msg = 1;
-	} else {
-		first_msg = 0;
-	}
-
-	mbox->rear = tmp;
-	mbox->msgs[mbox->rear] = msg;
 	LWIP_DEBUGF(SYS_DEBUG, ("Post SUCCESS\n"));
 
-	/* If msg was posted to an empty queue, Release semaphore for
-	   some fetch api blocked on this sem due to Empty queue. */
-	if (first_msg && mbox->wait_fetch) {
-		sys_sem_signal(&(mbox->mail));
-	}
-
-	sys_sem_signal(&(mbox->mutex));
-	return;
+	/* Release some fetch api blocked due to Empty queue */
+	sys_mbox_wakeup(&mbox->wait_fetch, &mbox->not_empty);
 }
 
 /*---------------------------------------------------------------------------*
@@ -189,40 +287,17 @@ void sys_mbox_post(sys_mbox_t *mbox, void *msg)
  *---------------------------------------------------------------------------*/
 err_t sys_mbox_trypost(sys_mbox_t *mbox, void *msg)
 {
-	err_t err = ERR_OK;
-	u8_t first_msg = 0;
-	u32_t tmp = 0;
-	sys_arch_sem_wait(&(mbox->mutex), 0);
-
 	LWIP_DEBUGF(SYS_DEBUG, ("mbox %p msg %p\n", (void *)mbox, (void *)msg));
-	/* Check if the queue is full */
-	tmp = (mbox->rear + 1) % mbox->queue_size;
-	if (tmp == mbox->front) {
-		LWIP_DEBUGF(SYS_DEBUG, ("Queue Full, returning error\n"));
-		err = ERR_MEM;
-		goto errout_with_mutex;
-	}
 
-	if (mbox->rear == mbox->front) {
-		first_msg = 1;
-	} else {
-		first_msg = 0;
+	if (!sys_mbox_enqueue(mbox, msg)) {
+		LWIP_DEBUGF(SYS_DEBUG, ("Queue Full, returning error\n"));
+		return ERR_MEM;
 	}
-
-	mbox->rear = tmp;
-	mbox->msgs[mbox->rear] = msg;
 	LWIP_DEBUGF(SYS_DEBUG, ("Post SUCCESS\n"));
 
-	/* If msg was posted to an empty queue, Release semaphore for
-	   some fetch api blocked on this sem due to Empty queue. */
-	if (first_msg && mbox->wait_fetch) {
-		sys_sem_signal(&(mbox->mail));
-	}
-
-errout_with_mutex:
-	sys_sem_signal(&(mbox->mutex));
-
-	return err;
+	/* Release some fetch api blocked due to Empty queue */
+	sys_mbox_wakeup(&mbox->wait_fetch, &mbox->not_empty);
+	return ERR_OK;
 }
 
 /*---------------------------------------------------------------------------*
@@ -254,62 +329,49 @@ errout_with_mutex:
 u32_t sys_arch_mbox_fetch(sys_mbox_t *mbox, void **msg, u32_t timeout)
 {
 	u32_t time = 0;
-	u32_t status = OK;
-
-	/* The mutex lock is quick so we don't bother with the timeout
-	   stuff here. */
-
-	status = sys_arch_sem_wait(&(mbox->mutex), 0);
-	if (status == SYS_ARCH_CANCELED) {
-		return SYS_ARCH_CANCELED;
-	}
+	u32_t remaining;
+	u32_t status;
 
 	/* wait while the queue is empty */
-	while (mbox->front == mbox->rear) {
-		mbox->wait_fetch++;
-		sys_sem_signal(&(mbox->mutex));
+	while (!sys_mbox_dequeue(mbox, msg)) {
+		if (timeout != 0 && time >= timeout) {
+			return SYS_ARCH_TIMEOUT;
+		}
+
+		sys_mbox_register(&mbox->wait_fetch);
+		if (sys_mbox_dequeue(mbox, msg)) {
+			MBOX_DEC(&mbox->wait_fetch);
+			break;
+		}
 
 		/* We block while waiting for a mail to arrive in the mailbox. We
 		   must be prepared to timeout. */
 		if (timeout != 0) {
-
-			if (timeout < MSEC_PER_TICK)
-				timeout = MSEC_PER_TICK;
-
-			time = sys_arch_sem_wait(&(mbox->mail), timeout);
-
-			if (time == SYS_ARCH_TIMEOUT) {
-				sys_arch_sem_wait(&(mbox->mutex), 0);
-				mbox->wait_fetch--;
-				sys_sem_signal(&(mbox->mutex));
-				return SYS_ARCH_TIMEOUT;
+			remaining = timeout - time;
+			if (remaining < MSEC_PER_TICK) {
+				remaining = MSEC_PER_TICK;
 			}
+			status = sys_arch_sem_wait(&(mbox->not_empty), remaining);
 		} else {
-			sys_arch_sem_wait(&(mbox->mail), 0);
+			status = sys_arch_sem_wait(&(mbox->not_empty), 0);
 		}
+		MBOX_DEC(&mbox->wait_fetch);
 
-		status = sys_arch_sem_wait(&(mbox->mutex), 0);
-		mbox->wait_fetch--;
 		if (status == SYS_ARCH_CANCELED) {
 			return SYS_ARCH_CANCELED;
+		} else if (status == SYS_ARCH_TIMEOUT) {
+			/* A message posted right at the timeout is still taken */
+			if (sys_mbox_dequeue(mbox, msg)) {
+				time = timeout;
+				break;
+			}
+			return SYS_ARCH_TIMEOUT;
 		}
+		time += status;
 	}
 
-	mbox->front = (mbox->front + 1) % mbox->queue_size;
-	if (msg != NULL) {
-		*msg = mbox->msgs[mbox->front];
-		LWIP_DEBUGF(SYS_DEBUG, (" mbox %p msg %p\n", (void *)mbox, *msg));
-	} else {
-		LWIP_DEBUGF(SYS_DEBUG, (" mbox %p, null msg\n", (void *)mbox));
-	}
-
-	/* We just fetched a msg, Release semaphore for
-	   some post api blocked on this sem due to queue full. */
-	if (mbox->wait_send) {
-		sys_sem_signal(&(mbox->mail));
-	}
-
-	sys_sem_signal(&(mbox->mutex));
+	/* We just fetched a msg, Release some post api blocked due to queue full */
+	sys_mbox_wakeup(&mbox->wait_send, &mbox->not_full);
 
 	return time;
 }
@@ -330,35 +392,16 @@ u32_t sys_arch_mbox_fetch(sys_mbox_t *mbox, void **msg, u32_t timeout)
  *---------------------------------------------------------------------------*/
 u32_t sys_arch_mbox_tryfetch(sys_mbox_t *mbox, void **msg)
 {
-	u32_t err = ERR_OK;
-	/* The mutex lock is quick so we don't bother with the timeout
-	   stuff here. */
-	sys_arch_sem_wait(&(mbox->mutex), 0);
-
 	/* check if the queue is empty */
-	if (mbox->front == mbox->rear) {
+	if (!sys_mbox_dequeue(mbox, msg)) {
 		LWIP_DEBUGF(SYS_DEBUG, ("SYS_MBOX_EMPTY , returning\n"));
-		err = SYS_MBOX_EMPTY;
-		goto errout_with_mutex;
+		return SYS_MBOX_EMPTY;
 	}
 
-	mbox->front = (mbox->front + 1) % mbox->queue_size;
-	if (msg != NULL) {
-		LWIP_DEBUGF(SYS_DEBUG, ("mbox %p msg %p\n", (void *)mbox, *msg));
-		*msg = mbox->msgs[mbox->front];
-	} else {
-		LWIP_DEBUGF(SYS_DEBUG, ("mbox %p, null msg\n", (void *)mbox));
-	}
+	/* We just fetched a msg, Release some post api blocked due to queue full */
+	sys_mbox_wakeup(&mbox->wait_send, &mbox->not_full);
 
-	/* We just fetched a msg, Release semaphore for
-	   some post api blocked on this sem due to queue full. */
-	if (mbox->wait_send) {
-		sys_sem_signal(&(mbox->mail));
-	}
-
-errout_with_mutex:
-	sys_sem_signal(&(mbox->mutex));
-	return err;
+	return ERR_OK;
 }
 
 /*---------------------------------------------------------------------------*
@@ -82,7 +82,7 @@ void mbox_sync_event3(void)
 
 void mbox_sync_event4(void)
 {
-	if (g_tcpmbox.front == ((g_tcpmbox.rear + 1) % g_tcpmbox.queue_size)) {
+	if (g_tcpmbox.rear - g_tcpmbox.front == g_tcpmbox.queue_size) {
 		printf("[EVT] receive invalid signal in posting\t%s:%d\n",
 				 __FUNCTION__, __LINE__);
 		printf("[EVT] (queue is still full \t%s:%d\n", __FUNCTION__, __LINE__);
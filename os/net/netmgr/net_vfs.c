@@ -129,6 +129,32 @@ int net_poll(int sd, struct pollfd *fds, bool setup)
 	NETSTACK_CALL_BYFD(sd, poll, (sd, fds, setup));
 }
 
+/****************************************************************************
+ * Function: net_sendfile
+ *
+ * Description:
+ *   Send 'count' bytes of an open file through the socket without a user
+ *   buffer.  The data is read from the current position of the file.
+ *
+ * Returned Value:
+ *   The number of bytes sent; -1 on error with errno set appropriately.
+ *   ENOSYS means that the socket can not take the file directly and
+ *   nothing was read from it.
+ *
+ ****************************************************************************/
+#ifdef CONFIG_NET_SENDFILE
+ssize_t net_sendfile(int sd, FAR struct file *filep, size_t count)
+{
+	struct netstack *stk = get_netstack_byfd(sd);
+
+	if (!stk || !stk->ops->sendfile) {
+		set_errno(ENOSYS);
+		return -1;
+	}
+	return stk->ops->sendfile(sd, filep, count);
+}
+#endif
+
 /****************************************************************************
  * Name: net_ioctl
  *
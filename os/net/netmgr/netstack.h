@@ -48,6 +48,10 @@
 		NETSTACK_CALL_RET(stk, method, arg, res);		\
 	} while (0)
 
+#ifdef CONFIG_NET_SENDFILE
+struct file;
+#endif
+
 struct netstack_ops {
 	// start, stop
 	int (*init)(void *data);
@@ -89,6 +93,9 @@ struct netstack_ops {
 	int (*getstats)(void *arg);
 	void (*initlist)(struct socketlist *list);
 	void (*releaselist)(struct socketlist *list);
+#ifdef CONFIG_NET_SENDFILE
+	ssize_t (*sendfile)(int s, struct file *filep, size_t count);
+#endif
 };
 
 struct netstack {
@@ -606,6 +606,13 @@ static ssize_t lwip_ns_sendto(int s, const void *data, size_t size, int flags, c
 	return lwip_sendto(s, data, size, flags, to, tolen);
 }
 
+#ifdef CONFIG_NET_SENDFILE
+static ssize_t lwip_ns_sendfile(int s, struct file *filep, size_t count)
+{
+	return lwip_sendfile(s, filep, count);
+}
+#endif
+
 static int lwip_ns_getsockname(int s, struct sockaddr *name, socklen_t *namelen)
 {
 	return lwip_getsockname(s, name, namelen);
@@ -809,7 +816,11 @@ struct netstack_ops g_lwip_stack_ops = {
 #endif
 	lwip_ns_getstats,
 	lwip_ns_initlist,
-	lwip_ns_releaselist};
+	lwip_ns_releaselist,
+#ifdef CONFIG_NET_SENDFILE
+	lwip_ns_sendfile,
+#endif
+};
 
 struct netstack g_lwip_stack = {&g_lwip_stack_ops, NULL};
 
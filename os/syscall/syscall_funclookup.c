@@ -74,6 +74,7 @@
 #include <sys/prctl.h>
 #include <sys/socket.h>
 #include <sys/mount.h>
+#include <sys/sendfile.h>
 #include <sys/boardctl.h>
 
 #include <stdio.h>
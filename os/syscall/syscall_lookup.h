@@ -175,6 +175,11 @@ SYSCALL_LOOKUP(rmdir,                   1, STUB_rmdir)
 SYSCALL_LOOKUP(umount,                  1, STUB_umount)
 SYSCALL_LOOKUP(unlink,                  1, STUB_unlink)
 SYSCALL_LOOKUP(ftruncate,               2, STUB_ftruncate)
+SYSCALL_LOOKUP(sendfile,                4, STUB_sendfile)
+SYSCALL_LOOKUP(epoll_create,            1, STUB_epoll_create)
+SYSCALL_LOOKUP(epoll_create1,           1, STUB_epoll_create1)
+SYSCALL_LOOKUP(epoll_ctl,               4, STUB_epoll_ctl)
+SYSCALL_LOOKUP(epoll_wait,              4, STUB_epoll_wait)
 SYSCALL_LOOKUP(shmget,                  3, STUB_shmget)
 SYSCALL_LOOKUP(shmat,                   3, STUB_shmat)
 SYSCALL_LOOKUP(shmctl,                  3, STUB_shmctl)
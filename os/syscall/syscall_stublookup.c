@@ -243,11 +243,11 @@ uintptr_t STUB_fs_fdopen(int nbr, uintptr_t parm1, uintptr_t parm2,
 						 uintptr_t parm3);
 uintptr_t STUB_sched_getstreams(int nbr);
 
-ssize_t sendfile(int outfd, int infd, FAR off_t *offset, size_t count);
-
 uintptr_t STUB_fsync(int nbr, uintptr_t parm1);
 uintptr_t STUB_mkdir(int nbr, uintptr_t parm1, uintptr_t parm2);
 uintptr_t STUB_ftruncate(int nbr, uintptr_t parm1, uintptr_t parm2);
+uintptr_t STUB_sendfile(int nbr, uintptr_t parm1, uintptr_t parm2,
+						uintptr_t parm3, uintptr_t parm4);
 uintptr_t STUB_mount(int nbr, uintptr_t parm1, uintptr_t parm2,
 					 uintptr_t parm3, uintptr_t parm4, uintptr_t parm5);
 uintptr_t STUB_rename(int nbr, uintptr_t parm1, uintptr_t parm2);
@@ -255,6 +255,15 @@ uintptr_t STUB_rmdir(int nbr, uintptr_t parm1);
 uintptr_t STUB_umount(int nbr, uintptr_t parm1);
 uintptr_t STUB_unlink(int nbr, uintptr_t parm1);
 
+/* Persistent poll interfaces */
+
+uintptr_t STUB_epoll_create(int nbr, uintptr_t parm1);
+uintptr_t STUB_epoll_create1(int nbr, uintptr_t parm1);
+uintptr_t STUB_epoll_ctl(int nbr, uintptr_t parm1, uintptr_t parm2,
+						 uintptr_t parm3, uintptr_t parm4);
+uintptr_t STUB_epoll_wait(int nbr, uintptr_t parm1, uintptr_t parm2,
+						  uintptr_t parm3, uintptr_t parm4);
+
 /* Shared memory interfaces */
 
 uintptr_t STUB_shmget(int nbr, uintptr_t parm1, uintptr_t parm2,
@@ -209,13 +209,16 @@ int work_lpstart(void)
 {
 	int pid;
 	int wndx;
+#ifdef CONFIG_SCHED_LPWORK_AFFINITY
+	cpu_set_t cpuset;
+#endif
 
 	/* Initialize work queue data structures */
 
 	struct lp_wqueue_s *lwq = get_lpwork();
-	memset(lwq, 0, sizeof(struct wqueue_s));
+	memset(lwq, 0, sizeof(struct lp_wqueue_s));
 
-	dq_init(&lwq->q);
+	work_qinit((FAR struct wqueue_s *)lwq, CONFIG_SCHED_LPNTHREADS);
 
 	/* Don't permit any of the threads to run until we have fully initialized
 	 * g_lpwork.
@@ -242,6 +245,16 @@ int work_lpstart(void)
 
 		lwq->worker[wndx].pid = (pid_t)pid;
 		lwq->worker[wndx].busy = true;
+
+#ifdef CONFIG_SCHED_LPWORK_AFFINITY
+		/* Spread the threads of the pool over the CPUs.  They still share
+		 * one queue, so work runs on whichever CPU has an idle thread.
+		 */
+
+		CPU_ZERO(&cpuset);
+		CPU_SET(wndx % CONFIG_SMP_NCPUS, &cpuset);
+		(void)sched_setaffinity(pid, sizeof(cpu_set_t), &cpuset);
+#endif
 	}
 
 	sched_unlock();
@@ -185,7 +185,7 @@ int work_usrstart(void)
 	/* Initialize work queue data structures */
 
 	struct wqueue_s *usrwq = get_usrwork();
-	dq_init(&usrwq->q);
+	work_qinit(usrwq, 1);
 
 #ifdef CONFIG_BUILD_PROTECTED
 	{
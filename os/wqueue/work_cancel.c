@@ -112,7 +112,7 @@
 
 int work_qcancel(FAR struct wqueue_s *wqueue, FAR struct work_s *work)
 {
-	struct work_s *cur_work;
+	FAR struct dq_queue_s *queue;
 	int ret = -ENOENT;
 
 	DEBUGASSERT(work != NULL);
@@ -131,32 +131,30 @@ int work_qcancel(FAR struct wqueue_s *wqueue, FAR struct work_s *work)
 	if (work->worker != NULL) {
 		/* A little test of the integrity of the work queue */
 
-		DEBUGASSERT(work->dq.flink || (FAR dq_entry_t *)work == wqueue->q.tail);
-		DEBUGASSERT(work->dq.blink || (FAR dq_entry_t *)work == wqueue->q.head);
+		DEBUGASSERT(work->dq.flink || (FAR dq_entry_t *)work == wqueue->q.tail || (FAR dq_entry_t *)work == wqueue->delayq.tail);
+		DEBUGASSERT(work->dq.blink || (FAR dq_entry_t *)work == wqueue->q.head || (FAR dq_entry_t *)work == wqueue->delayq.head);
 
 		/* check whether requested work is in queue list or not */
-		cur_work = (struct work_s *)wqueue->q.head;
-		do {
-			if (cur_work == NULL) {
+		queue = work_qfind(wqueue, work);
+		if (queue == NULL) {
 #if defined(CONFIG_SCHED_USRWORK) && !defined(__KERNEL__)
-				work_unlock();
+			work_unlock();
 #else
-				leave_critical_section(flags);
+			leave_critical_section(flags);
 #endif
-				return -ENOENT;
-			} else if (cur_work == work) {
-				break;
-			}
-
-			cur_work = (struct work_s *)cur_work->dq.flink;
-		} while (1);
+			return -ENOENT;
+		}
 
 		/* Remove the entry from the work queue and make sure that it is
 		 * mark as available (i.e., the worker field is nullified).
 		 */
 
-		dq_rem((FAR dq_entry_t *)work, &wqueue->q);
+		dq_rem((FAR dq_entry_t *)work, queue);
 		work->worker = NULL;
+#ifdef CONFIG_SCHED_WORKQUEUE_STATS
+		wqueue->stats.cancelled++;
+		wqueue->stats.pending--;
+#endif
 		ret = OK;
 	}
 
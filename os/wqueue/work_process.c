@@ -93,6 +93,58 @@ static worker_t cur_worker;
  * Private Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: work_qexpire
+ *
+ * Description:
+ *   Move the delayed work that is due at time 'now' to the end of the
+ *   queue of work ready to run.  The delayed work is sorted by deadline,
+ *   so only the expired entries at the head are visited.
+ *
+ ****************************************************************************/
+
+static void work_qexpire(FAR struct wqueue_s *wqueue, clock_t now)
+{
+	FAR struct work_s *work;
+
+	while ((work = (FAR struct work_s *)wqueue->delayq.head) != NULL && work_remaining(work, now) == 0) {
+		(void)dq_remfirst(&wqueue->delayq);
+		dq_addlast((FAR dq_entry_t *)work, &wqueue->q);
+	}
+}
+
+/****************************************************************************
+ * Name: work_qhelper
+ *
+ * Description:
+ *   Select an idle thread of the pool to help with what is left in the
+ *   queue: more work ready to run, or delayed work that no idle thread is
+ *   waiting for.  The selected thread is marked busy so that it is not
+ *   selected twice.
+ *
+ * Returned Value:
+ *   The pid of the thread to signal, or zero if none is needed or idle.
+ *
+ ****************************************************************************/
+
+static pid_t work_qhelper(FAR struct wqueue_s *wqueue, int wndx)
+{
+	int i;
+
+	if (wqueue->q.head == NULL && (wqueue->delayq.head == NULL || wqueue->timerwndx >= 0)) {
+		return 0;
+	}
+
+	for (i = 0; i < wqueue->nthreads; i++) {
+		if (i != wndx && !wqueue->worker[i].busy) {
+			wqueue->worker[i].busy = true;
+			return wqueue->worker[i].pid;
+		}
+	}
+
+	return 0;
+}
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -116,6 +168,7 @@ worker_t work_get_current(void)
  *
  * Input parameters:
  *   wqueue - Describes the work queue to be processed
+ *   wndx   - Index of the calling thread in wqueue->worker[]
  *
  * Returned Value:
  *   None
@@ -126,16 +179,18 @@ void work_process(FAR struct wqueue_s *wqueue, int wndx)
 	volatile FAR struct work_s *work;
 	worker_t worker;
 	FAR void *arg;
-	clock_t elapsed;
 	clock_t ctick;
 	clock_t next;
+	pid_t helper;
+#ifdef CONFIG_SCHED_WORKQUEUE_STATS
+	clock_t start;
+	clock_t elapsed;
+#endif
 
 	/* Then process queued work.  We need to keep interrupts disabled while
 	 * we process items in the work list.
 	 */
 
-	next = 0;
-
 #if defined(CONFIG_SCHED_USRWORK) && !defined(__KERNEL__)
 	while (work_lock() < 0);
 #else
@@ -143,93 +198,100 @@ void work_process(FAR struct wqueue_s *wqueue, int wndx)
 	flags = enter_critical_section();
 #endif
 
-
-	/* And check each entry in the work queue.  Since we have disabled
-	 * interrupts we know:  (1) we will not be suspended unless we do
-	 * so ourselves, and (2) there will be no changes to the work queue
+	/* Since we have disabled interrupts we know:  (1) we will not be
+	 * suspended unless we do so ourselves, and (2) there will be no changes
+	 * to the work queue.  Move the delayed work that has expired behind the
+	 * work that is ready, then perform the ready work in FIFO order.
 	 */
 
-	work = (FAR struct work_s *)wqueue->q.head;
-	
-	while (work) {
-		
-		/* Is this work ready?  It is ready if there is no delay or if
-		 * the delay has elapsed. qtime is the time that the work was added
-		 * to the work queue.  It will always be greater than or equal to
-		 * zero.  Therefore a delay of zero will always execute immediately.
+	ctick = clock();
+	work_qexpire(wqueue, ctick);
+
+	while ((work = (FAR struct work_s *)dq_remfirst(&wqueue->q)) != NULL) {
+		/* Extract the work description from the entry (in case the work
+		 * instance by the re-used after it has been de-queued).
 		 */
 
-		ctick = clock();
-		elapsed = ctick - work->qtime;
+		worker = work->worker;
 
-		if (elapsed >= work->delay) {
-			/* Remove the ready-to-execute work from the list */
+		/* Check for a race condition where the work may be nullified
+		 * before it is removed from the queue.
+		 */
 
-			(void)dq_rem((struct dq_entry_s *)work, &wqueue->q);
+		if (worker == NULL) {
+			continue;
+		}
 
-			/* Extract the work description from the entry (in case the work
-			 * instance by the re-used after it has been de-queued).
-			 */
+		/* Extract the work argument (before re-enabling interrupts) */
 
-			worker = work->worker;
+		arg = work->arg;
 
-			/* Check for a race condition where the work may be nullified
-			 * before it is removed from the queue.
-			 */
+		/* Mark the work as no longer being queued */
 
-			if (worker != NULL) {
-				/* Extract the work argument (before re-enabling interrupts) */
+		work->worker = NULL;
 
-				arg = work->arg;
+#ifdef CONFIG_SCHED_WORKQUEUE_STATS
+		start = clock();
+		elapsed = start - work->qtime - work->delay;
+		wqueue->stats.pending--;
+		wqueue->stats.totlatency += elapsed;
+		if (elapsed > wqueue->stats.maxlatency) {
+			wqueue->stats.maxlatency = elapsed;
+		}
+#endif
+
+		/* If more work is left, let an idle thread of the pool take it */
 
-				/* Mark the work as no longer being queued */
+		helper = work_qhelper(wqueue, wndx);
 
-				work->worker = NULL;
+		/* Do the work.  Re-enable interrupts while the work is being
+		 * performed... we don't have any idea how long this will take!
+		 */
 
-				/* Do the work.  Re-enable interrupts while the work is being
-				 * performed... we don't have any idea how long this will take!
-				 */
-				
 #if defined(CONFIG_SCHED_USRWORK) && !defined(__KERNEL__)
-				work_unlock();
+		work_unlock();
 #else
-				leave_critical_section(flags);
+		leave_critical_section(flags);
 #endif
+		if (helper > 0) {
+			(void)work_qsignal(helper);
+		}
 #if defined(CONFIG_DEBUG_WORKQUEUE)
 #if defined(CONFIG_BUILD_FLAT) || (defined(CONFIG_BUILD_PROTECTED) && defined(__KERNEL__))
-				cur_worker = worker;
+		cur_worker = worker;
 #endif
 #endif
-				worker(arg);
+		worker(arg);
 
-				/* Now, unfortunately, since we re-enabled interrupts we don't
-				 * know the state of the work list and we will have to start
-				 * back at the head of the list.
-				 */
+		/* Now, unfortunately, since we re-enabled interrupts we don't
+		 * know the state of the work list and we will have to start
+		 * back at the head of the list.
+		 */
 
 #if defined(CONFIG_SCHED_USRWORK) && !defined(__KERNEL__)
-				while (work_lock() < 0);
+		while (work_lock() < 0);
 #else
-				flags = enter_critical_section();
+		flags = enter_critical_section();
 #endif
-				work = (FAR struct work_s *)wqueue->q.head;
-			} else {
-				/* Cancelled.. Just move to the next work in the list with
-				 * interrupts still disabled.
-				 */
-
-				work = (FAR struct work_s *)work->dq.flink;
-			}
-		} else {				/* elapsed < work->delay */
-
-			next = work->delay - elapsed;
-
-			/* Then break at while loop due to sorted list */
-			break;
+		ctick = clock();
+#ifdef CONFIG_SCHED_WORKQUEUE_STATS
+		elapsed = ctick - start;
+		wqueue->stats.completed++;
+		wqueue->stats.totruntime += elapsed;
+		if (elapsed > wqueue->stats.maxruntime) {
+			wqueue->stats.maxruntime = elapsed;
 		}
+#endif
+		work_qexpire(wqueue, ctick);
 	}
 
-	if (wqueue->q.head == NULL) {
+	/* Nothing is ready.  One idle thread waits until the earliest delayed
+	 * work is due, unless another thread already waits for a time no later
+	 * than that.  The others wait for SIGWORK.
+	 */
+
+	work = (FAR struct work_s *)wqueue->delayq.head;
+	if (work == NULL || (wqueue->timerwndx >= 0 && work_remaining((FAR struct work_s *)work, ctick) >= wqueue->timeout - ctick)) {
 #if defined(CONFIG_SCHED_USRWORK) && !defined(__KERNEL__)
 		work_unlock();
 #endif
@@ -241,7 +303,10 @@ void work_process(FAR struct wqueue_s *wqueue, int wndx)
 		wqueue->worker[wndx].busy = false;
 		DEBUGVERIFY(sigwaitinfo(&set, NULL));
 		wqueue->worker[wndx].busy = true;
-	} else if (next > 0) {
+	} else {
+		next = work_remaining((FAR struct work_s *)work, ctick);
+		wqueue->timerwndx = wndx;
+		wqueue->timeout = ctick + next;
 #if defined(CONFIG_SCHED_USRWORK) && !defined(__KERNEL__)
 		work_unlock();
 #endif
@@ -252,13 +317,20 @@ void work_process(FAR struct wqueue_s *wqueue, int wndx)
 		wqueue->worker[wndx].busy = false;
 		usleep(next * USEC_PER_TICK);
 		wqueue->worker[wndx].busy = true;
-	}
+
+		/* Whatever woke us, we no longer wait for the deadline */
+
+#if defined(CONFIG_SCHED_USRWORK) && !defined(__KERNEL__)
+		while (work_lock() < 0);
+#endif
+		if (wqueue->timerwndx == wndx) {
+			wqueue->timerwndx = -1;
+		}
 #if defined(CONFIG_SCHED_USRWORK) && !defined(__KERNEL__)
-	else {
 		work_unlock();
+#endif
 	}
-#else
+#if !defined(CONFIG_SCHED_USRWORK) || defined(__KERNEL__)
 	leave_critical_section(flags);
 #endif
-
 }
@@ -59,6 +59,7 @@
 #include <stdint.h>
 #include <queue.h>
 #include <assert.h>
+#include <string.h>
 #include <errno.h>
 
 #include <tinyara/arch.h>
@@ -87,6 +88,58 @@
  * Private Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: work_qinit
+ *
+ * Description:
+ *   Initialize the queues of a work queue served by 'nthreads' threads.
+ *   The worker[] entries are filled in by the caller.
+ *
+ ****************************************************************************/
+
+void work_qinit(FAR struct wqueue_s *wqueue, int nthreads)
+{
+	dq_init(&wqueue->q);
+	dq_init(&wqueue->delayq);
+	wqueue->timerwndx = -1;
+	wqueue->nthreads = nthreads;
+#ifdef CONFIG_SCHED_WORKQUEUE_STATS
+	memset(&wqueue->stats, 0, sizeof(struct work_stats_s));
+#endif
+}
+
+/****************************************************************************
+ * Name: work_qfind
+ *
+ * Description:
+ *   Find the list of the work queue that holds 'work'.  The caller must
+ *   hold the work queue lock.
+ *
+ ****************************************************************************/
+
+FAR struct dq_queue_s *work_qfind(FAR struct wqueue_s *wqueue, FAR struct work_s *work)
+{
+	FAR dq_entry_t *entry;
+
+	for (entry = wqueue->q.head; entry != NULL; entry = entry->flink) {
+		if (entry == (FAR dq_entry_t *)work) {
+			return &wqueue->q;
+		}
+	}
+
+	for (entry = wqueue->delayq.head; entry != NULL; entry = entry->flink) {
+		if (entry == (FAR dq_entry_t *)work) {
+			return &wqueue->delayq;
+		}
+	}
+
+	return NULL;
+}
+
 /****************************************************************************
  * Name: work_qqueue
  *
@@ -120,9 +173,7 @@ int work_qqueue(FAR struct wqueue_s *wqueue, FAR struct work_s *work, worker_t w
 {
 	DEBUGASSERT(work != NULL);
 
-	struct work_s *next_work = NULL;
 	struct work_s *cur_work;
-	clock_t elapsed;
 	clock_t ctick;
 	ctick = clock();
 
@@ -133,26 +184,17 @@ int work_qqueue(FAR struct wqueue_s *wqueue, FAR struct work_s *work, worker_t w
 	flags = enter_critical_section();
 #endif
 
-	/* check whether requested work is in queue list or not */
-	cur_work = (struct work_s *)wqueue->q.head;
-	while (cur_work != NULL) {
-		if (cur_work == work) {
+	/* Work that is still available (see work_available()) cannot be in the
+	 * queue, so the queue is only searched when the work may be pending.
+	 */
+
+	if (work->worker != NULL && work_qfind(wqueue, work) != NULL) {
 #if defined(CONFIG_SCHED_USRWORK) && !defined(__KERNEL__)
-			work_unlock();
+		work_unlock();
 #else
-			leave_critical_section(flags);
+		leave_critical_section(flags);
 #endif
-			return -EALREADY;
-		}
-
-		if (next_work == NULL) {
-			elapsed = ctick - cur_work->qtime;
-			if (cur_work->delay > elapsed && cur_work->delay - elapsed > delay) {
-				next_work = cur_work;
-			}
-		}
-
-		cur_work = (struct work_s *)cur_work->dq.flink;
+		return -EALREADY;
 	}
 
 	work->worker = worker;		/* Work callback */
@@ -160,11 +202,31 @@ int work_qqueue(FAR struct wqueue_s *wqueue, FAR struct work_s *work, worker_t w
 	work->delay = delay;		/* Delay until work performed */
 	work->qtime = ctick;		/* Time work queued */
 
-	if (next_work) {
-		dq_addbefore((FAR dq_entry_t *)next_work, (FAR dq_entry_t *)work, &wqueue->q);
-	} else {
+	if (delay == 0) {
 		dq_addlast((FAR dq_entry_t *)work, &wqueue->q);
+	} else {
+		/* Keep the delayed work sorted by deadline.  New work is usually due
+		 * after the work already queued, so search from the tail.
+		 */
+
+		cur_work = (struct work_s *)wqueue->delayq.tail;
+		while (cur_work != NULL && work_remaining(cur_work, ctick) > delay) {
+			cur_work = (struct work_s *)cur_work->dq.blink;
+		}
+
+		if (cur_work) {
+			dq_addafter((FAR dq_entry_t *)cur_work, (FAR dq_entry_t *)work, &wqueue->delayq);
+		} else {
+			dq_addfirst((FAR dq_entry_t *)work, &wqueue->delayq);
+		}
 	}
+
+#ifdef CONFIG_SCHED_WORKQUEUE_STATS
+	wqueue->stats.queued++;
+	if (++wqueue->stats.pending > wqueue->stats.maxpending) {
+		wqueue->stats.maxpending = wqueue->stats.pending;
+	}
+#endif
 #if defined(CONFIG_SCHED_USRWORK) && !defined(__KERNEL__)
 	work_unlock();
 #else
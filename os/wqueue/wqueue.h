@@ -60,6 +60,7 @@
 #include <tinyara/config.h>
 
 #include <sys/types.h>
+#include <stdint.h>
 #include <stdbool.h>
 #include <queue.h>
 #include <semaphore.h>
@@ -79,10 +80,23 @@ struct worker_s {
 	volatile bool busy;			/* True: Worker is not available */
 };
 
-/* This structure defines the state of work queue */
+/* This structure defines the state of work queue.  Work that is ready to
+ * run waits in q in FIFO order.  Delayed work waits in delayq, sorted by the
+ * time it becomes due, and is moved to q by the worker when it expires.
+ *
+ * Only one idle worker sleeps until the earliest deadline (the "timer"
+ * worker, timerwndx); the other idle workers of a pool wait for SIGWORK.
+ */
 
 struct wqueue_s {
-	struct dq_queue_s q;		/* The queue of pending work */
+	struct dq_queue_s q;		/* The queue of work ready to run */
+	struct dq_queue_s delayq;	/* The queue of delayed work, by deadline */
+	clock_t timeout;			/* Wake up time of the timer worker */
+	int8_t timerwndx;			/* Index of the timer worker, -1 if none */
+	uint8_t nthreads;			/* Number of threads in worker[] */
+#ifdef CONFIG_SCHED_WORKQUEUE_STATS
+	struct work_stats_s stats;	/* Latency and throughput counters */
+#endif
 	struct worker_s worker[1];	/* Describes a worker thread */
 };
 
@@ -92,7 +106,14 @@ struct wqueue_s {
 
 #ifdef CONFIG_SCHED_HPWORK
 struct hp_wqueue_s {
-	struct dq_queue_s q;		/* The queue of pending work */
+	struct dq_queue_s q;		/* The queue of work ready to run */
+	struct dq_queue_s delayq;	/* The queue of delayed work, by deadline */
+	clock_t timeout;			/* Wake up time of the timer worker */
+	int8_t timerwndx;			/* Index of the timer worker, -1 if none */
+	uint8_t nthreads;			/* Number of threads in worker[] */
+#ifdef CONFIG_SCHED_WORKQUEUE_STATS
+	struct work_stats_s stats;	/* Latency and throughput counters */
+#endif
 	struct worker_s worker[1];	/* Describes the single high priority worker */
 };
 #endif
@@ -103,13 +124,33 @@ struct hp_wqueue_s {
 
 #ifdef CONFIG_SCHED_LPWORK
 struct lp_wqueue_s {
-	struct dq_queue_s q;		/* The queue of pending work */
+	struct dq_queue_s q;		/* The queue of work ready to run */
+	struct dq_queue_s delayq;	/* The queue of delayed work, by deadline */
+	clock_t timeout;			/* Wake up time of the timer worker */
+	int8_t timerwndx;			/* Index of the timer worker, -1 if none */
+	uint8_t nthreads;			/* Number of threads in worker[] */
+#ifdef CONFIG_SCHED_WORKQUEUE_STATS
+	struct work_stats_s stats;	/* Latency and throughput counters */
+#endif
 
 	/* Describes each thread in the low priority queue's thread pool */
 	struct worker_s worker[CONFIG_SCHED_LPNTHREADS];
 };
 #endif
 
+/****************************************************************************
+ * Inline Functions
+ ****************************************************************************/
+
+/* Ticks until delayed work is due at time 'now', zero if it is due */
+
+static inline clock_t work_remaining(FAR struct work_s *work, clock_t now)
+{
+	clock_t elapsed = now - work->qtime;
+
+	return elapsed < work->delay ? work->delay - elapsed : 0;
+}
+
 /****************************************************************************
  * Public Data
  ****************************************************************************/
@@ -228,6 +269,42 @@ int work_qcancel(FAR struct wqueue_s *wqueue, FAR struct work_s *work);
 
 int work_qqueue(FAR struct wqueue_s *wqueue, FAR struct work_s *work, worker_t worker, FAR void *arg, clock_t delay);
 
+/****************************************************************************
+ * Name: work_qinit
+ *
+ * Description:
+ *   Initialize the queues of a work queue served by 'nthreads' threads.
+ *   The worker[] entries are filled in by the caller.
+ *
+ * Input parameters:
+ *   wqueue   - Describes the work queue to be initialized
+ *   nthreads - Number of threads serving the work queue
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void work_qinit(FAR struct wqueue_s *wqueue, int nthreads);
+
+/****************************************************************************
+ * Name: work_qfind
+ *
+ * Description:
+ *   Find the list of the work queue that holds 'work'.  The caller must
+ *   hold the work queue lock.
+ *
+ * Input parameters:
+ *   wqueue - Describes the work queue to search
+ *   work   - The work structure to find
+ *
+ * Returned Value:
+ *   The list holding the work, or NULL if the work is not queued.
+ *
+ ****************************************************************************/
+
+FAR struct dq_queue_s *work_qfind(FAR struct wqueue_s *wqueue, FAR struct work_s *work);
+
 /****************************************************************************
  * Name: work_process
  *
@@ -0,0 +1,236 @@
+#!/usr/bin/env python3
+############################################################################
+#
+# Copyright 2025 Samsung Electronics All Rights Reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+# either express or implied. See the License for the specific
+# language governing permissions and limitations under the License.
+#
+############################################################################
+
+"""Decode the raw output of logm with CONFIG_LOGM_BINARY_RAW.
+
+The records are preceded by the "LM" marker, any other console output in
+between is passed through as it is.  See os/logm/logm_binary.c for the
+record layout.
+"""
+
+import argparse
+import re
+import struct
+import sys
+
+REC_PAD = 0x01
+REC_FMTPTR = 0x02
+REC_INFO = 0x04
+
+ARG_INT32 = 1
+ARG_INT64 = 2
+ARG_DOUBLE = 3
+ARG_STRING = 4
+
+SPEC_RE = re.compile(rb"%([-+ #0]*)(\*|\d+)?(?:\.(\*|\d*))?(hh|h|ll|l|z|j|t|L)?(.?)", re.S)
+
+
+class Elf(object):
+    """Just enough of an ELF reader to fetch strings from the image."""
+
+    def __init__(self, path):
+        with open(path, "rb") as fp:
+            self.data = fp.read()
+        if self.data[:4] != b"\x7fELF":
+            raise ValueError("%s is not an ELF file" % path)
+        is64 = self.data[4] == 2
+        end = "<" if self.data[5] == 1 else ">"
+        if is64:
+            shoff, = struct.unpack_from(end + "Q", self.data, 0x28)
+            shentsize, shnum = struct.unpack_from(end + "HH", self.data, 0x3a)
+            fmt = end + "IIQQQQ"
+        else:
+            shoff, = struct.unpack_from(end + "I", self.data, 0x20)
+            shentsize, shnum = struct.unpack_from(end + "HH", self.data, 0x2e)
+            fmt = end + "IIIIII"
+        self.sections = []
+        for i in range(shnum):
+            _, stype, flags, addr, offset, size = struct.unpack_from(fmt, self.data, shoff + i * shentsize)
+            # SHT_PROGBITS sections which are loaded
+            if stype == 1 and (flags & 0x2) and size:
+                self.sections.append((addr, offset, size))
+
+    def string(self, addr):
+        for start, offset, size in self.sections:
+            if start <= addr < start + size:
+                pos = offset + addr - start
+                end = self.data.find(b"\0", pos, offset + size)
+                return self.data[pos:end if end >= 0 else offset + size]
+        return None
+
+
+class Decoder(object):
+    def __init__(self, elf=None, timestamp=False):
+        self.elf = elf
+        self.timestamp = timestamp
+        self.ptrsize = 4
+        self.little = True
+        self.usec_per_tick = 1000
+
+    def args(self, data, pos, end):
+        order = "<" if self.little else ">"
+        while pos < end:
+            tag = data[pos]
+            pos += 1
+            if tag == ARG_INT32 and pos + 4 <= end:
+                yield tag, struct.unpack_from(order + "i", data, pos)[0]
+                pos += 4
+            elif tag == ARG_INT64 and pos + 8 <= end:
+                yield tag, struct.unpack_from(order + "q", data, pos)[0]
+                pos += 8
+            elif tag == ARG_DOUBLE and pos + 8 <= end:
+                yield tag, struct.unpack_from(order + "d", data, pos)[0]
+                pos += 8
+            elif tag == ARG_STRING and pos < end and pos + 1 + data[pos] <= end:
+                yield tag, data[pos + 1:pos + 1 + data[pos]]
+                pos += 1 + data[pos]
+            else:
+                return
+
+    def convert(self, flags, width, prec, length, conv, tag, value):
+        spec = "%" + flags + width + ("." + prec if prec is not None else "")
+        if conv in "diuoxXcp" and tag not in (ARG_INT32, ARG_INT64):
+            return None
+        if conv in "diuoxX":
+            bits = {"hh": 8, "h": 16}.get(length, 32 if tag == ARG_INT32 else 64)
+            value &= (1 << bits) - 1
+            if conv in "di" and value >= 1 << (bits - 1):
+                value -= 1 << bits
+            return (spec + ("d" if conv in "diu" else conv)) % value
+        if conv == "c":
+            return (spec + "c") % chr(value & 0xff)
+        if conv == "p":
+            return (spec + "s") % ("0x%x" % (value & ((1 << (8 * self.ptrsize)) - 1)))
+        if conv == "s":
+            if tag != ARG_STRING:
+                return None
+            return (spec + "s") % value.decode("latin-1")
+        if conv in "fFeEgG":
+            return (spec + conv) % value if tag == ARG_DOUBLE else None
+        if conv in "aA":
+            text = float.hex(value)
+            return (spec + "s") % (text.upper() if conv == "A" else text)
+        return None
+
+    def format(self, fmt, data, pos, end):
+        args = self.args(data, pos, end)
+        out = []
+        last = 0
+        for m in SPEC_RE.finditer(fmt):
+            out.append(fmt[last:m.start()].decode("latin-1"))
+            last = m.end()
+            flags, width, prec, length, conv = [g.decode("latin-1") if g is not None else None for g in m.groups()]
+            if conv == "%" and not flags and width is None and prec is None:
+                out.append("%")
+                continue
+            try:
+                text = None
+                width = width or ""
+                if width == "*":
+                    tag, width = next(args)
+                    width = str(width)
+                if prec == "*":
+                    tag, prec = next(args)
+                    prec = str(prec) if prec >= 0 else None
+                if conv == "n":
+                    text = ""
+                elif conv and conv in "diuoxXcpsfFeEgGaA":
+                    tag, value = next(args)
+                    text = self.convert(flags, width, prec, length, conv, tag, value)
+            except StopIteration:
+                text = None
+            out.append(text if text is not None else m.group(0).decode("latin-1"))
+        out.append(fmt[last:].decode("latin-1"))
+        return "".join(out)
+
+    def record(self, hdr, data):
+        flags = (hdr >> 16) & 0xff
+        order = "<" if self.little else ">"
+        if flags & REC_INFO:
+            self.ptrsize = data[1]
+            self.little = data[2] == 1
+            self.usec_per_tick, = struct.unpack_from("<I" if self.little else ">I", data, 4)
+            return ""
+
+        ticks, = struct.unpack_from(order + "I", data, 0)
+        pos = 4
+        if flags & REC_FMTPTR:
+            addr, = struct.unpack_from(order + ("Q" if self.ptrsize == 8 else "I"), data, pos)
+            pos += self.ptrsize
+            fmt = self.elf.string(addr) if self.elf else None
+            if fmt is None:
+                fmt = b"<unresolved format 0x%x>\n" % addr
+        else:
+            end = data.find(b"\0", pos)
+            if end < 0:
+                return ""
+            fmt = data[pos:end]
+            pos = end + 1
+
+        text = self.format(fmt, data, pos, len(data))
+        if self.timestamp:
+            usec = ticks * self.usec_per_tick
+            text = "[%4d.%4d] " % (usec // 1000000, (usec % 1000000) // 100) + text
+        return text
+
+    def decode(self, stream):
+        out = []
+        pos = 0
+        while pos < len(stream):
+            mark = stream.find(b"LM", pos)
+            if mark < 0 or mark + 6 > len(stream):
+                out.append(stream[pos:].decode("latin-1"))
+                break
+            out.append(stream[pos:mark].decode("latin-1"))
+            hdr, = struct.unpack_from("<I" if self.little else ">I", stream, mark + 2)
+            size = hdr & 0xffff
+            flags = (hdr >> 16) & 0xff
+            if size < 8 or (flags & ~(REC_FMTPTR | REC_INFO)) or mark + 2 + size > len(stream):
+                # Not a record, just text which happens to contain "LM"
+                out.append("LM")
+                pos = mark + 2
+                continue
+            out.append(self.record(hdr, stream[mark + 6:mark + 2 + size]))
+            pos = mark + 2 + size
+        return "".join(out)
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Decode binary logm output")
+    parser.add_argument("input", help="captured console output")
+    parser.add_argument("-e", "--elf", help="ELF image, needed with CONFIG_LOGM_BINARY_FMTPTR")
+    parser.add_argument("-t", "--timestamp", action="store_true", help="prepend the timestamps")
+    parser.add_argument("-o", "--output", help="output file, default stdout")
+    args = parser.parse_args()
+
+    with open(args.input, "rb") as fp:
+        stream = fp.read()
+
+    decoder = Decoder(Elf(args.elf) if args.elf else None, args.timestamp)
+    text = decoder.decode(stream)
+
+    if args.output:
+        with open(args.output, "w") as fp:
+            fp.write(text)
+    else:
+        sys.stdout.write(text)
+
+
+if __name__ == "__main__":
+    main()
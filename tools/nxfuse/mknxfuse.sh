@@ -42,6 +42,7 @@ mkdir -p $SMARTFS_TMPDIR
 ln -sf $SMARTFSDIR/smartfs.h $SMARTFS_TMPDIR/smartfs.h
 ln -sf $SMARTFSDIR/smartfs_utils.c $SMARTFS_TMPDIR/smartfs_utils.c
 ln -sf $SMARTFSDIR/smartfs_smart.c $SMARTFS_TMPDIR/smartfs_smart.c
+ln -sf $SMARTFSDIR/smartfs_dcache.c $SMARTFS_TMPDIR/smartfs_dcache.c
 ln -sf $SMARTFSDIR/../driver/mtd/smart.c $SMARTFS_TMPDIR/smart.c
 ln -svf $BASE_DIR/lib/libc/queue $SRCDIR/
 
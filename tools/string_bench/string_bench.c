@@ -0,0 +1,335 @@
+/****************************************************************************
+ *
+ * Copyright 2025 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <time.h>
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define BUF_SIZE        (64 * 1024 + 64)
+#define MAX_ALIGN       16
+#define TEST_MAX_LEN    300
+#define BENCH_BYTES     (64UL * 1024 * 1024)
+#define BENCH_MIN_ITER  1000
+
+#define CHECK(cond, ...) \
+	do { \
+		if (!(cond)) { \
+			printf("FAIL %s:%d: ", __func__, __LINE__); \
+			printf(__VA_ARGS__); \
+			printf("\n"); \
+			g_failures++; \
+			return; \
+		} \
+	} while (0)
+
+/****************************************************************************
+ * Public Function Prototypes
+ ****************************************************************************/
+
+/* lib/libc/string built with the default byte loops */
+
+void *byte_memcpy(void *dest, const void *src, size_t n);
+void *byte_memmove(void *dest, const void *src, size_t n);
+int byte_memcmp(const void *s1, const void *s2, size_t n);
+void *byte_memchr(const void *s, int c, size_t n);
+void *byte_memset(void *s, int c, size_t n);
+size_t byte_strlen(const char *s);
+
+/* lib/libc/string built with the *_OPTSPEED options */
+
+void *word_memcpy(void *dest, const void *src, size_t n);
+void *word_memmove(void *dest, const void *src, size_t n);
+int word_memcmp(const void *s1, const void *s2, size_t n);
+void *word_memchr(const void *s, int c, size_t n);
+void *word_memset(void *s, int c, size_t n);
+size_t word_strlen(const char *s);
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static unsigned char g_src[BUF_SIZE] __attribute__((aligned(64)));
+static unsigned char g_dst[BUF_SIZE] __attribute__((aligned(64)));
+static unsigned char g_ref[BUF_SIZE] __attribute__((aligned(64)));
+static int g_failures;
+static volatile uintptr_t g_sink;
+
+static const size_t g_sizes[] = {
+	1, 4, 16, 64, 256, 1024, 4096, 16384, 65536
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+static void fill(unsigned char *buf, size_t len, unsigned seed)
+{
+	size_t i;
+
+	for (i = 0; i < len; i++) {
+		buf[i] = (unsigned char)(seed + i * 7 + (i >> 8));
+	}
+}
+
+static int sign(int v)
+{
+	return (v > 0) - (v < 0);
+}
+
+static void test_memcpy(void)
+{
+	size_t sa;
+	size_t da;
+	size_t n;
+
+	for (sa = 0; sa < MAX_ALIGN; sa++) {
+		for (da = 0; da < MAX_ALIGN; da++) {
+			for (n = 0; n <= TEST_MAX_LEN; n++) {
+				fill(g_src, TEST_MAX_LEN + 2 * MAX_ALIGN, n);
+				memset(g_dst, 0xa5, TEST_MAX_LEN + 2 * MAX_ALIGN);
+				memcpy(g_ref, g_dst, TEST_MAX_LEN + 2 * MAX_ALIGN);
+				memcpy(g_ref + da, g_src + sa, n);
+				CHECK(word_memcpy(g_dst + da, g_src + sa, n) == g_dst + da, "return value");
+				CHECK(memcmp(g_dst, g_ref, TEST_MAX_LEN + 2 * MAX_ALIGN) == 0, "sa %zu da %zu n %zu", sa, da, n);
+			}
+		}
+	}
+}
+
+static void test_memmove(void)
+{
+	size_t sa;
+	size_t da;
+	size_t n;
+
+	/* Overlapping in both directions */
+
+	for (sa = 0; sa < 2 * MAX_ALIGN; sa++) {
+		for (da = 0; da < 2 * MAX_ALIGN; da++) {
+			for (n = 0; n <= TEST_MAX_LEN; n += (n < 40) ? 1 : 13) {
+				fill(g_dst, TEST_MAX_LEN + 4 * MAX_ALIGN, n);
+				memcpy(g_ref, g_dst, TEST_MAX_LEN + 4 * MAX_ALIGN);
+				memmove(g_ref + da, g_ref + sa, n);
+				CHECK(word_memmove(g_dst + da, g_dst + sa, n) == g_dst + da, "return value");
+				CHECK(memcmp(g_dst, g_ref, TEST_MAX_LEN + 4 * MAX_ALIGN) == 0, "sa %zu da %zu n %zu", sa, da, n);
+			}
+		}
+	}
+}
+
+static void test_memset(void)
+{
+	size_t da;
+	size_t n;
+
+	for (da = 0; da < MAX_ALIGN; da++) {
+		for (n = 0; n <= TEST_MAX_LEN; n++) {
+			fill(g_dst, TEST_MAX_LEN + MAX_ALIGN, n);
+			memcpy(g_ref, g_dst, TEST_MAX_LEN + MAX_ALIGN);
+			memset(g_ref + da, 0x100 + (int)n, n);
+			CHECK(word_memset(g_dst + da, 0x100 + (int)n, n) == g_dst + da, "return value");
+			CHECK(memcmp(g_dst, g_ref, TEST_MAX_LEN + MAX_ALIGN) == 0, "da %zu n %zu", da, n);
+		}
+	}
+}
+
+static void test_memcmp(void)
+{
+	size_t sa;
+	size_t da;
+	size_t n;
+	size_t pos;
+
+	for (sa = 0; sa < MAX_ALIGN; sa++) {
+		for (da = 0; da < MAX_ALIGN; da++) {
+			for (n = 0; n <= 80; n++) {
+				fill(g_src + sa, n, 3);
+				fill(g_dst + da, n, 3);
+				CHECK(word_memcmp(g_src + sa, g_dst + da, n) == 0, "equal sa %zu da %zu n %zu", sa, da, n);
+
+				/* One differing byte, both above and below */
+
+				for (pos = 0; pos < n; pos++) {
+					g_dst[da + pos] ^= 0x80;
+					CHECK(sign(word_memcmp(g_src + sa, g_dst + da, n)) == sign(memcmp(g_src + sa, g_dst + da, n)),
+						"sa %zu da %zu n %zu pos %zu", sa, da, n, pos);
+					CHECK(sign(word_memcmp(g_dst + da, g_src + sa, n)) == sign(memcmp(g_dst + da, g_src + sa, n)),
+						"swapped sa %zu da %zu n %zu pos %zu", sa, da, n, pos);
+					g_dst[da + pos] ^= 0x80;
+				}
+			}
+		}
+	}
+}
+
+static void test_memchr(void)
+{
+	size_t sa;
+	size_t n;
+	size_t pos;
+
+	for (sa = 0; sa < MAX_ALIGN; sa++) {
+		for (n = 0; n <= 80; n++) {
+			memset(g_src, 0x11, n + 2 * MAX_ALIGN);
+
+			/* A match right after the end must not be found */
+
+			g_src[sa + n] = 0xfe;
+			CHECK(word_memchr(g_src + sa, 0xfe, n) == NULL, "sa %zu n %zu", sa, n);
+			for (pos = 0; pos < n; pos++) {
+				g_src[sa + pos] = 0xfe;
+				CHECK(word_memchr(g_src + sa, 0xfe, n) == g_src + sa + pos, "sa %zu n %zu pos %zu", sa, n, pos);
+
+				/* 'c' is converted to unsigned char */
+
+				CHECK(word_memchr(g_src + sa, 0x1fe, n) == g_src + sa + pos, "int c, sa %zu n %zu pos %zu", sa, n, pos);
+				g_src[sa + pos] = 0x11;
+			}
+		}
+	}
+	CHECK(word_memchr(NULL, 0, 10) == NULL, "NULL");
+}
+
+static void test_strlen(void)
+{
+	size_t sa;
+	size_t n;
+
+	for (sa = 0; sa < MAX_ALIGN; sa++) {
+		for (n = 0; n <= TEST_MAX_LEN; n++) {
+			memset(g_src, 0x80, n + 2 * MAX_ALIGN);
+			g_src[sa + n] = '\0';
+			CHECK(word_strlen((const char *)g_src + sa) == n, "sa %zu n %zu", sa, n);
+		}
+	}
+	CHECK(word_strlen(NULL) == 0, "NULL");
+}
+
+static double now_sec(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+/* Throughput in MB/s of one routine, 'op' selects it */
+
+static double bench(int op, int word, size_t size)
+{
+	size_t iter = BENCH_BYTES / size;
+	size_t i;
+	double start;
+	double elapsed;
+
+	if (iter < BENCH_MIN_ITER) {
+		iter = BENCH_MIN_ITER;
+	}
+
+	start = now_sec();
+	for (i = 0; i < iter; i++) {
+		switch (op) {
+		case 0:
+			g_sink += (uintptr_t)(word ? word_memcpy(g_dst, g_src, size) : byte_memcpy(g_dst, g_src, size));
+			break;
+		case 1:
+			g_sink += (uintptr_t)(word ? word_memmove(g_dst + 8, g_dst, size) : byte_memmove(g_dst + 8, g_dst, size));
+			break;
+		case 2:
+			g_sink += (uintptr_t)(word ? word_memset(g_dst, (int)i, size) : byte_memset(g_dst, (int)i, size));
+			break;
+		case 3:
+			g_sink += (uintptr_t)(word ? word_memcmp(g_src, g_ref, size) : byte_memcmp(g_src, g_ref, size));
+			break;
+		case 4:
+			g_sink += (uintptr_t)(word ? word_memchr(g_src, 0xff, size) : byte_memchr(g_src, 0xff, size));
+			break;
+		case 5:
+			g_sink += word ? word_strlen((const char *)g_src) : byte_strlen((const char *)g_src);
+			break;
+		}
+	}
+	elapsed = now_sec() - start;
+
+	return (double)iter * size / elapsed / 1e6;
+}
+
+static void run_bench(void)
+{
+	static const char *names[] = {
+		"memcpy", "memmove", "memset", "memcmp", "memchr", "strlen"
+	};
+	size_t s;
+	int op;
+	double byte;
+	double word;
+
+	printf("\n%-8s %8s %12s %12s %8s\n", "routine", "size", "byte MB/s", "word MB/s", "speedup");
+	for (op = 0; op < 6; op++) {
+		for (s = 0; s < sizeof(g_sizes) / sizeof(g_sizes[0]); s++) {
+			/* memcmp compares equal buffers, memchr and strlen scan
+			 * buffers without a match up to 'size'.
+			 */
+
+			memset(g_src, 0x5a, g_sizes[s]);
+			memset(g_ref, 0x5a, g_sizes[s]);
+			g_src[g_sizes[s]] = '\0';
+
+			byte = bench(op, 0, g_sizes[s]);
+			word = bench(op, 1, g_sizes[s]);
+			printf("%-8s %8zu %12.1f %12.1f %7.2fx\n", names[op], g_sizes[s], byte, word, word / byte);
+		}
+	}
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+int main(int argc, char *argv[])
+{
+	test_memcpy();
+	test_memmove();
+	test_memset();
+	test_memcmp();
+	test_memchr();
+	test_strlen();
+
+	if (g_failures) {
+		printf("%d test(s) FAILED\n", g_failures);
+		return 1;
+	}
+	printf("All string routine tests passed\n");
+
+	if (argc > 1 && strcmp(argv[1], "-t") == 0) {
+		return 0;
+	}
+
+	run_bench();
+	return 0;
+}